@@ -0,0 +1,64 @@
+#pragma once
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace NeoMIPS::Benchmark
+{
+    //One statement of a program: its mnemonic or directive and the operands after it, without the comment
+    struct Statement
+    {
+        std::u8string m_mnemonic;
+        std::u8string m_operands;
+    };
+
+    //Reads the statements of every program given, labels in front of a statement are dropped
+    inline std::vector<Statement> read_corpus(int argc, char** argv)
+    {
+        std::vector<Statement> statements;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::ifstream file(argv[i]);
+            if (!file) std::cerr << "Can't open " << argv[i] << "\n";
+            std::string line;
+            while (std::getline(file, line))
+            {
+                line = line.substr(0, line.find('#'));
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) line = line.substr(colon + 1);
+
+                size_t start = line.find_first_not_of(" \t\r");
+                if (start == std::string::npos) continue;
+                size_t end = line.find_first_of(" \t\r", start);
+                if (end == std::string::npos) end = line.size();
+
+                Statement statement;
+                statement.m_mnemonic.assign(line.begin() + start, line.begin() + end);
+                size_t operands = line.find_first_not_of(" \t\r", end);
+                size_t last = line.find_last_not_of(" \t\r");
+                if (operands != std::string::npos) statement.m_operands.assign(line.begin() + operands, line.begin() + last + 1);
+                statements.push_back(std::move(statement));
+            }
+        }
+        return statements;
+    }
+
+    //Runs pass over the corpus until a quarter of a second has gone by and returns the nanoseconds per statement
+    template<typename Pass>
+    double time_per_statement(size_t statements, Pass pass)
+    {
+        using Clock = std::chrono::steady_clock;
+        size_t rounds = 0;
+        auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        while (elapsed < std::chrono::milliseconds(250))
+        {
+            pass();
+            ++rounds;
+            elapsed = Clock::now() - start;
+        }
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(rounds * statements);
+    }
+}
@@ -0,0 +1,53 @@
+# Bitwise CRC-32 of 1 MiB of pseudorandom bytes: shifts, logic and short inner loops.
+# Prints 0xc0f68319
+        .text
+        .globl main
+main:
+        lui     $s1, 0x10               # 1048576 bytes
+        addu    $a0, $s1, $zero
+        addiu   $v0, $zero, 9
+        syscall
+        addu    $s0, $v0, $zero
+
+        addiu   $t0, $zero, 1
+        lui     $t6, 0x19               # 1664525
+        ori     $t6, $t6, 0x660D
+        lui     $t7, 0x3C6E             # 1013904223
+        ori     $t7, $t7, 0xF35F
+        addu    $t1, $s0, $zero
+        addu    $t2, $s0, $s1
+fill:
+        mul     $t0, $t0, $t6
+        addu    $t0, $t0, $t7
+        srl     $t3, $t0, 24
+        sb      $t3, 0($t1)
+        addiu   $t1, $t1, 1
+        bne     $t1, $t2, fill
+
+        addiu   $v1, $zero, -1          # crc
+        lui     $t7, 0xEDB8             # reflected polynomial, 0xEDB88320
+        ori     $t7, $t7, 0x8320
+        addu    $t1, $s0, $zero
+byte:
+        lbu     $t3, 0($t1)
+        xor     $v1, $v1, $t3
+        addiu   $t4, $zero, 8
+bit:
+        andi    $t5, $v1, 1
+        srl     $v1, $v1, 1
+        beq     $t5, $zero, no_xor
+        xor     $v1, $v1, $t7
+no_xor:
+        addiu   $t4, $t4, -1
+        bne     $t4, $zero, bit
+        addiu   $t1, $t1, 1
+        bne     $t1, $t2, byte
+
+        nor     $a0, $v1, $zero
+        addiu   $v0, $zero, 34
+        syscall
+        addiu   $a0, $zero, 10
+        addiu   $v0, $zero, 11
+        syscall
+        addiu   $v0, $zero, 10
+        syscall
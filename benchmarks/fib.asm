@@ -0,0 +1,37 @@
+# Recursive Fibonacci of 32: calls, returns and stack traffic.
+# Prints 2178309
+        .text
+        .globl main
+main:
+        addiu   $a0, $zero, 32
+        jal     fib
+        addu    $a0, $v0, $zero
+        addiu   $v0, $zero, 1
+        syscall
+        addiu   $a0, $zero, 10
+        addiu   $v0, $zero, 11
+        syscall
+        addiu   $v0, $zero, 10
+        syscall
+
+# fib(n) in $v0 for n in $a0
+fib:
+        slti    $t0, $a0, 2
+        beq     $t0, $zero, fib_recurse
+        addu    $v0, $a0, $zero
+        jr      $ra
+fib_recurse:
+        addiu   $sp, $sp, -12
+        sw      $ra, 0($sp)
+        sw      $a0, 4($sp)
+        addiu   $a0, $a0, -1
+        jal     fib
+        sw      $v0, 8($sp)
+        lw      $a0, 4($sp)
+        addiu   $a0, $a0, -2
+        jal     fib
+        lw      $t0, 8($sp)
+        addu    $v0, $v0, $t0
+        lw      $ra, 0($sp)
+        addiu   $sp, $sp, 12
+        jr      $ra
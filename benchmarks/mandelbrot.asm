@@ -0,0 +1,66 @@
+# Mandelbrot set on a 200 x 100 grid over [-2, 1] x [-1.2, 1.2], up to 500 iterations a point: double precision.
+# Prints how many points never escape, 4239
+        .data
+x_min:  .double -2.0
+y_min:  .double -1.2
+x_step: .double 0.015
+y_step: .double 0.024
+four:   .double 4.0
+
+        .text
+        .globl main
+main:
+        ldc1    $f20, x_min
+        ldc1    $f22, y_min
+        ldc1    $f24, x_step
+        ldc1    $f26, y_step
+        ldc1    $f28, four
+        addiu   $s3, $zero, 500         # iterations
+        addiu   $s4, $zero, 200         # columns
+        addiu   $s5, $zero, 100         # rows
+
+        addiu   $s2, $zero, 0           # points inside
+        addiu   $s0, $zero, 0           # row
+row:
+        mtc1    $s0, $f0
+        cvt.d.w $f0, $f0
+        mul.d   $f2, $f0, $f26
+        add.d   $f2, $f2, $f22          # ci
+        addiu   $s1, $zero, 0           # column
+column:
+        mtc1    $s1, $f0
+        cvt.d.w $f0, $f0
+        mul.d   $f4, $f0, $f24
+        add.d   $f4, $f4, $f20          # cr
+        mtc1    $zero, $f6
+        mtc1    $zero, $f7              # zr
+        mov.d   $f8, $f6                # zi
+        addiu   $t0, $zero, 0
+iterate:
+        mul.d   $f10, $f6, $f6
+        mul.d   $f12, $f8, $f8
+        add.d   $f14, $f10, $f12
+        c.lt.d  $f28, $f14
+        bc1t    escaped
+        mul.d   $f16, $f6, $f8
+        add.d   $f16, $f16, $f16
+        add.d   $f8, $f16, $f2
+        sub.d   $f6, $f10, $f12
+        add.d   $f6, $f6, $f4
+        addiu   $t0, $t0, 1
+        bne     $t0, $s3, iterate
+        addiu   $s2, $s2, 1
+escaped:
+        addiu   $s1, $s1, 1
+        bne     $s1, $s4, column
+        addiu   $s0, $s0, 1
+        bne     $s0, $s5, row
+
+        addu    $a0, $s2, $zero
+        addiu   $v0, $zero, 1
+        syscall
+        addiu   $a0, $zero, 10
+        addiu   $v0, $zero, 11
+        syscall
+        addiu   $v0, $zero, 10
+        syscall
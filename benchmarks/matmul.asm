@@ -0,0 +1,80 @@
+# Product of two 160 x 160 integer matrices in i, k, j order: multiplies and sequential word accesses.
+# A[i][j] = i + j and B[i][j] = i - j.
+# Prints the sum of the elements of the product as a word, 147857408
+        .text
+        .globl main
+main:
+        addiu   $s7, $zero, 160         # N
+        mul     $t0, $s7, $s7
+        sll     $s6, $t0, 2             # bytes per matrix
+        sll     $a0, $s6, 1
+        addu    $a0, $a0, $s6
+        addiu   $v0, $zero, 9
+        syscall
+        addu    $s0, $v0, $zero         # A
+        addu    $s1, $s0, $s6           # B
+        addu    $s2, $s1, $s6           # C, zeroed by sbrk
+        sll     $s5, $s7, 2             # bytes per row
+
+        addiu   $t0, $zero, 0
+        addu    $t2, $s0, $zero
+        addu    $t3, $s1, $zero
+fill_i:
+        addiu   $t1, $zero, 0
+fill_j:
+        addu    $t4, $t0, $t1
+        sw      $t4, 0($t2)
+        subu    $t4, $t0, $t1
+        sw      $t4, 0($t3)
+        addiu   $t2, $t2, 4
+        addiu   $t3, $t3, 4
+        addiu   $t1, $t1, 1
+        bne     $t1, $s7, fill_j
+        addiu   $t0, $t0, 1
+        bne     $t0, $s7, fill_i
+
+        addiu   $t0, $zero, 0           # i
+        addu    $t8, $s0, $zero         # &A[i][0]
+        addu    $t9, $s2, $zero         # &C[i][0]
+mul_i:
+        addiu   $t1, $zero, 0           # k
+        addu    $t7, $s1, $zero         # &B[k][0]
+mul_k:
+        sll     $t2, $t1, 2
+        addu    $t2, $t8, $t2
+        lw      $t3, 0($t2)             # A[i][k]
+        addu    $t4, $t7, $zero         # &B[k][j]
+        addu    $t5, $t9, $zero         # &C[i][j]
+        addu    $t6, $t7, $s5           # end of the row of B
+mul_j:
+        lw      $a1, 0($t4)
+        mul     $a1, $a1, $t3
+        lw      $a2, 0($t5)
+        addu    $a2, $a2, $a1
+        sw      $a2, 0($t5)
+        addiu   $t4, $t4, 4
+        addiu   $t5, $t5, 4
+        bne     $t4, $t6, mul_j
+        addu    $t7, $t7, $s5
+        addiu   $t1, $t1, 1
+        bne     $t1, $s7, mul_k
+        addu    $t8, $t8, $s5
+        addu    $t9, $t9, $s5
+        addiu   $t0, $t0, 1
+        bne     $t0, $s7, mul_i
+
+        addiu   $a0, $zero, 0
+        addu    $t0, $s2, $zero
+        addu    $t1, $s2, $s6
+sum:
+        lw      $t2, 0($t0)
+        addu    $a0, $a0, $t2
+        addiu   $t0, $t0, 4
+        bne     $t0, $t1, sum
+        addiu   $v0, $zero, 1
+        syscall
+        addiu   $a0, $zero, 10
+        addiu   $v0, $zero, 11
+        syscall
+        addiu   $v0, $zero, 10
+        syscall
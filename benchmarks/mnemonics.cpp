@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include "benchmarks/corpus.hpp"
+#include "src/lexer_util.hpp"
+#include "src/isadescription.hpp"
+
+//Looks up the first word of every statement the way the lexer does, as an instruction and then as a directive,
+//through the perfect hash and through the linear search over the mnemonics it replaced
+using namespace NeoMIPS;
+using namespace NeoMIPS::ISA;
+
+namespace
+{
+    //The lookups before the perfect hash, one comparison per entry until the word is found
+    std::optional<Instruction> linear_instruction(std::u8string_view str)
+    {
+        auto hit = std::find_if(INSTRUCTION_MNEMONICS.cbegin(), INSTRUCTION_MNEMONICS.cend(), [&](const std::pair<const std::u32string_view, Instruction>& p) {return std::equal(p.first.begin(), p.first.end(), str.begin(), str.end()); });
+        return hit != INSTRUCTION_MNEMONICS.cend() ? std::make_optional(hit->second) : std::nullopt;
+    }
+
+    std::optional<Directive> linear_directive(std::u8string_view str)
+    {
+        auto hit = std::find_if(DIRECTIVES.cbegin(), DIRECTIVES.cend(), [&](const std::pair<const std::u32string_view, Directive>& p) {return std::equal(p.first.begin(), p.first.end(), str.begin(), str.end()); });
+        return hit != DIRECTIVES.cend() ? std::make_optional(hit->second) : std::nullopt;
+    }
+
+    //What a lookup found, folded into one number so the passes can't be optimized away and can be compared
+    uint32_t found(std::optional<Instruction> instruction, std::optional<Directive> directive)
+    {
+        if (instruction) return static_cast<uint32_t>(*instruction) + 1;
+        return directive ? 0x10000 + static_cast<uint32_t>(*directive) : 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Benchmark::Statement> corpus = Benchmark::read_corpus(argc, argv);
+    if (corpus.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " program.asm...\n";
+        return 1;
+    }
+
+    size_t unknown = 0;
+    for (const Benchmark::Statement& statement : corpus)
+    {
+        std::u8string_view word = statement.m_mnemonic;
+        uint32_t hashed = found(is_instruction(word), is_directive(word));
+        uint32_t linear = found(linear_instruction(word), linear_directive(word));
+        if (hashed != linear)
+        {
+            std::cerr << "The lookups disagree on " << std::string(word.begin(), word.end()) << "\n";
+            return 1;
+        }
+        if (hashed == 0) ++unknown;
+    }
+
+    volatile uint32_t sink = 0;
+    double hashed = Benchmark::time_per_statement(corpus.size(), [&] {
+        uint32_t sum = 0;
+        for (const Benchmark::Statement& statement : corpus)
+        {
+            std::u8string_view word = statement.m_mnemonic;
+            std::optional<Instruction> instruction = is_instruction(word);
+            sum += found(instruction, instruction ? std::nullopt : is_directive(word));
+        }
+        sink = sink + sum;
+    });
+    double linear = Benchmark::time_per_statement(corpus.size(), [&] {
+        uint32_t sum = 0;
+        for (const Benchmark::Statement& statement : corpus)
+        {
+            std::u8string_view word = statement.m_mnemonic;
+            std::optional<Instruction> instruction = linear_instruction(word);
+            sum += found(instruction, instruction ? std::nullopt : linear_directive(word));
+        }
+        sink = sink + sum;
+    });
+
+    std::cout << corpus.size() << " words, " << unknown << " neither an instruction nor a directive\n";
+    std::cout << "Perfect hash   " << hashed << " ns per word\n";
+    std::cout << "Linear search  " << linear << " ns per word, " << linear / hashed << "x\n";
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <iostream>
+#include <string_view>
+#include "include/ctre-unicode.hpp"
+#include "benchmarks/corpus.hpp"
+#include "src/lexer_util.hpp"
+#include "src/operandscanner.hpp"
+#include "src/isadescription.hpp"
+
+//Parses the operands of every instruction with the operand scanner and with the regex cascade it replaced,
+//each against the forms its instruction accepts
+using namespace NeoMIPS;
+using namespace NeoMIPS::ISA;
+
+namespace
+{
+    //The patterns the cascade searched for, as they were in lexer_regex.hpp
+    namespace Regex
+    {
+        constexpr auto regPattern = ctll::fixed_string{
+            U"(\\$(?:(?:t[0-9])|(?:s[0-7])|(?:k[01])|(?:v[01])|(?:a[0-3])|(?:[gpf]p)|(?:[r][a])|(?:[z][e][r][o])|(?:\\d{1,2})|(?:[a][t])))" };
+
+        constexpr auto regOffsetForRegPattern = ctll::fixed_string{
+            U"(?:(\\$(?:(?:t[0-9])|(?:s[0-7])|(?:k[01])|(?:v[01])|(?:a[0-3])|(?:[gpf]p)|(?:[r][a])|(?:[z][e][r][o])|(?:\\d{1,2})|(?:[a][t])))[\\s,]+((?:\\b0[xX][\\da-fA-F]{1,8})|(?:[+\\-]?\\d+))\\((\\$(?:(?:t[0-9])|(?:s[0-7])|(?:k[01])|(?:v[01])|(?:a[0-3])|(?:[gpf]p)|(?:[r][a])|(?:[z][e][r][o])|(?:\\d{1,2})|(?:[a][t])))\\))" };
+
+        constexpr auto regLabelPlusImmPattern = ctll::fixed_string{
+            U"(?:(\\$(?:(?:t[0-9])|(?:s[0-7])|(?:k[01])|(?:v[01])|(?:a[0-3])|(?:[gpf]p)|(?:[r][a])|(?:[z][e][r][o])|(?:\\d{1,2})|(?:[a][t])))[\\s,]+((?:\\p{Emoji}+|\\w+)+)[\\s,]*[+\\-][\\s,]*((?:\\b0[xX][\\da-fA-F]{1,8})|(?:[+\\-]?\\d+)))" };
+
+        constexpr auto regLabelPlusImmOffsetForRegPattern = ctll::fixed_string{
+            U"(?:(\\$(?:(?:t[0-9])|(?:s[0-7])|(?:k[01])|(?:v[01])|(?:a[0-3])|(?:[gpf]p)|(?:[r][a])|(?:[z][e][r][o])|(?:\\d{1,2})|(?:[a][t])))[\\s,]+((?:\\p{Emoji}+|\\w+)+)[\\s,]*[+\\-][\\s,]*((?:\\b0[xX][\\da-fA-F]{1,8})|(?:[+\\-]?\\d+))[\\s]*\\((\\$(?:(?:t[0-9])|(?:s[0-7])|(?:k[01])|(?:v[01])|(?:a[0-3])|(?:[gpf]p)|(?:[r][a])|(?:[z][e][r][o])|(?:\\d{1,2})|(?:[a][t])))\\))" };
+
+        constexpr auto regLabelAsOffsetRegPattern = ctll::fixed_string{
+            U"(?:(\\$(?:(?:t[0-9])|(?:s[0-7])|(?:k[01])|(?:v[01])|(?:a[0-3])|(?:[gpf]p)|(?:[r][a])|(?:[z][e][r][o])|(?:\\d{1,2})|(?:[a][t])))[\\s,]+((?:\\p{Emoji}+|\\w+)+)[\\s]*\\((\\$(?:(?:t[0-9])|(?:s[0-7])|(?:k[01])|(?:v[01])|(?:a[0-3])|(?:[gpf]p)|(?:[r][a])|(?:[z][e][r][o])|(?:\\d{1,2})|(?:[a][t])))\\))" };
+    }
+
+    //Register number of a name the way the cascade worked it out, $t0 to $t7 included, which it got wrong
+    template<Char C>
+    uint32_t get_reg_index(const std::basic_string_view<C>& sv)
+    {
+        switch (sv[1])
+        {
+        case U'z':
+            return 0;
+        case U'a':
+            return sv[2] == U't' ? 1 : 4 + sv[2] - 48;
+        case U'v':
+            return 2 + sv[2] - 48;
+        case U't':
+            return sv[2] >= 8 ? 24 + sv[2] - 8 - 48 : 8 + sv[2] - 48;
+        case U's':
+            return sv[2] == U'p' ? 29 : 16 + sv[2] - 48;
+        case U'k':
+            return 26 + sv[2] - 48;
+        case U'g':
+            return 28;
+        case U'f':
+            return sv[2] == U'p' ? 30 : (sv.size() == 3 ? sv[2] - 48 : (sv[2] - 48) * 10 + sv[3] - 48);
+        case U'r':
+            return 31;
+        default:
+            return sv.size() == 2 ? sv[1] - 48 : (sv[1] - 48) * 10 + sv[2] - 48;
+        }
+    }
+
+    //parse_instruction before the operand scanner: one search per form the instruction accepts. Only three
+    //registers and no operands at all were ever taken out of a match, every other form fell through
+    template<Char C>
+    bool parse_with_regex(const std::basic_string_view<C>& line, InstructionParameters& params, InstructionSyntacticArchetypes archetypes)
+    {
+        if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegLabelAsOffsetReg))
+        {
+            if (auto [match, reg1, label, reg2] = ctre::search<Regex::regLabelAsOffsetRegPattern>(line); match)
+            {
+            }
+        }
+        if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+        {
+            if (auto [match, reg1, label, immediate, reg2] = ctre::search<Regex::regLabelPlusImmOffsetForRegPattern>(line); match)
+            {
+            }
+        }
+        if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegLabelPlusImm))
+        {
+            if (auto [match, reg1, label, immediate] = ctre::search<Regex::regLabelPlusImmPattern>(line); match)
+            {
+            }
+        }
+        if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegOffsetForReg))
+        {
+            if (auto [match, reg1, offset, reg2] = ctre::search<Regex::regOffsetForRegPattern>(line); match)
+            {
+            }
+        }
+        if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegRegReg))
+        {
+            int count = 0;
+            std::basic_string_view<C> reg[3];
+            for (auto& match : ctre::range<Regex::regPattern>(line))
+            {
+                if (count < 3) reg[count] = match.to_view();
+                count++;
+            }
+            if (count == 3)
+            {
+                params.m_reg1 = get_reg_index(reg[0]);
+                params.m_reg2 = get_reg_index(reg[1]);
+                params.m_reg3 = get_reg_index(reg[2]);
+                return true;
+            }
+        }
+        return static_cast<bool>(archetypes & InstructionSyntacticArchetypes::NoParams);
+    }
+
+    struct Operands
+    {
+        std::u8string_view m_text;
+        InstructionSyntacticArchetypes m_archetypes;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Operands> corpus;
+    std::vector<Benchmark::Statement> statements = Benchmark::read_corpus(argc, argv);
+    for (const Benchmark::Statement& statement : statements)
+    {
+        if (auto instruction = is_instruction(std::u8string_view(statement.m_mnemonic)))
+        {
+            corpus.push_back({ statement.m_operands, describe(*instruction).m_archetypes });
+        }
+    }
+    if (corpus.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " program.asm...\n";
+        return 1;
+    }
+
+    //the scanner has to take every operand list the cascade took, it takes the forms the cascade ignored too
+    size_t scanned = 0, matched = 0;
+    for (const Operands& operands : corpus)
+    {
+        InstructionParameters params{};
+        bool scanner = parse_instruction(operands.m_text, params, operands.m_archetypes);
+        bool regex = parse_with_regex(operands.m_text, params, operands.m_archetypes);
+        if (regex && !scanner)
+        {
+            std::cerr << "The scanner rejects " << std::string(operands.m_text.begin(), operands.m_text.end()) << "\n";
+            return 1;
+        }
+        scanned += scanner;
+        matched += regex;
+    }
+
+    volatile uint32_t sink = 0;
+    double scanner = Benchmark::time_per_statement(corpus.size(), [&] {
+        uint32_t sum = 0;
+        for (const Operands& operands : corpus)
+        {
+            InstructionParameters params{};
+            sum += parse_instruction(operands.m_text, params, operands.m_archetypes) + params.m_reg1;
+        }
+        sink = sink + sum;
+    });
+    //the scanner without filling in the parameters, which interns every label and the cascade never did
+    double scan = Benchmark::time_per_statement(corpus.size(), [&] {
+        uint32_t sum = 0;
+        for (const Operands& operands : corpus)
+        {
+            OperandList list;
+            if (scan_operands(operands.m_text, list)) sum += static_cast<uint32_t>(classify_operands(list) & operands.m_archetypes);
+        }
+        sink = sink + sum;
+    });
+    double regex = Benchmark::time_per_statement(corpus.size(), [&] {
+        uint32_t sum = 0;
+        for (const Operands& operands : corpus)
+        {
+            InstructionParameters params{};
+            sum += parse_with_regex(operands.m_text, params, operands.m_archetypes) + params.m_reg1;
+        }
+        sink = sink + sum;
+    });
+
+    std::cout << corpus.size() << " instructions, the scanner parses " << scanned << ", the cascade matched " << matched << "\n";
+    std::cout << "Operand scanner  " << scanner << " ns per instruction\n";
+    std::cout << "  scan only      " << scan << " ns per instruction\n";
+    std::cout << "Regex cascade    " << regex << " ns per instruction, " << regex / scanner << "x\n";
+    return 0;
+}
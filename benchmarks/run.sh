@@ -0,0 +1,19 @@
+#!/bin/sh
+# Runs every benchmark with statistics and checks what it prints against the "# Prints" line of its header.
+# The programs only use real instructions, pseudo-instructions like li, la or move aren't assembled.
+# Usage: benchmarks/run.sh path/to/neomips [options passed to every run]
+neomips=${1:?usage: $0 path/to/neomips [options]}
+shift
+dir=$(dirname "$0")
+status=0
+for program in "$dir"/*.asm; do
+    expected=$(sed -n 's/^# Prints.* \([^ ]*\)$/\1/p' "$program" | head -n 1)
+    output=$("$neomips" "$program" --stats "$@")
+    echo "== $(basename "$program")"
+    echo "$output" | grep -E "^Executed"
+    if ! echo "$output" | grep -q -- "$expected"; then
+        echo "   expected $expected"
+        status=1
+    fi
+done
+exit $status
@@ -0,0 +1,56 @@
+# Sieve of Eratosthenes below 4000000, five rounds over one buffer from sbrk: byte loads and stores.
+# Prints 283146
+        .text
+        .globl main
+main:
+        lui     $s1, 0x3D               # N = 4000000, a multiple of 4
+        ori     $s1, $s1, 0x900
+        addu    $a0, $s1, $zero
+        addiu   $v0, $zero, 9
+        syscall
+        addu    $s0, $v0, $zero         # one flag byte per number
+        addiu   $s3, $zero, 5           # rounds left
+        addiu   $t6, $zero, 1
+
+round:
+        addu    $t0, $s0, $zero
+        addu    $t1, $s0, $s1
+clear:
+        sw      $zero, 0($t0)
+        addiu   $t0, $t0, 4
+        bne     $t0, $t1, clear
+
+        addiu   $s2, $zero, 0           # primes found
+        addiu   $t0, $zero, 2
+outer:
+        beq     $t0, $s1, counted
+        addu    $t1, $s0, $t0
+        lbu     $t2, 0($t1)
+        bne     $t2, $zero, next
+        addiu   $s2, $s2, 1
+        sltiu   $t3, $t0, 2000          # only numbers below the square root of N cross anything out
+        beq     $t3, $zero, next
+        mul     $t3, $t0, $t0
+mark:
+        sltu    $t4, $t3, $s1
+        beq     $t4, $zero, next
+        addu    $t5, $s0, $t3
+        sb      $t6, 0($t5)
+        addu    $t3, $t3, $t0
+        beq     $zero, $zero, mark
+next:
+        addiu   $t0, $t0, 1
+        beq     $zero, $zero, outer
+
+counted:
+        addiu   $s3, $s3, -1
+        bne     $s3, $zero, round
+
+        addu    $a0, $s2, $zero
+        addiu   $v0, $zero, 1
+        syscall
+        addiu   $a0, $zero, 10
+        addiu   $v0, $zero, 11
+        syscall
+        addiu   $v0, $zero, 10
+        syscall
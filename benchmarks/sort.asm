@@ -0,0 +1,98 @@
+# Recursive quicksort of 200000 pseudorandom words: data dependent branches, swaps and deep calls.
+# Prints 1 if the result is in order, then the median: 1 2145382856
+        .text
+        .globl main
+main:
+        lui     $s1, 0x3                # N = 200000
+        ori     $s1, $s1, 0xD40
+        sll     $a0, $s1, 2
+        addiu   $v0, $zero, 9
+        syscall
+        addu    $s0, $v0, $zero
+
+        addiu   $t0, $zero, 12345       # linear congruential generator
+        lui     $t6, 0x41C6             # 1103515245
+        ori     $t6, $t6, 0x4E6D
+        addu    $t1, $s0, $zero
+        sll     $t2, $s1, 2
+        addu    $t2, $s0, $t2
+fill:
+        mul     $t0, $t0, $t6
+        addiu   $t0, $t0, 12345
+        sw      $t0, 0($t1)
+        addiu   $t1, $t1, 4
+        bne     $t1, $t2, fill
+
+        addu    $a0, $s0, $zero
+        addiu   $a1, $t2, -4
+        jal     quicksort
+
+        addiu   $s2, $zero, 1           # in order
+        addu    $t1, $s0, $zero
+        sll     $t2, $s1, 2
+        addu    $t2, $s0, $t2
+        addiu   $t2, $t2, -4
+check:
+        lw      $t3, 0($t1)
+        lw      $t4, 4($t1)
+        sltu    $t5, $t4, $t3
+        beq     $t5, $zero, check_next
+        addiu   $s2, $zero, 0
+check_next:
+        addiu   $t1, $t1, 4
+        bne     $t1, $t2, check
+
+        addu    $a0, $s2, $zero
+        addiu   $v0, $zero, 1
+        syscall
+        addiu   $a0, $zero, 32
+        addiu   $v0, $zero, 11
+        syscall
+        srl     $t0, $s1, 1
+        sll     $t0, $t0, 2
+        addu    $t0, $s0, $t0
+        lw      $a0, 0($t0)
+        addiu   $v0, $zero, 36
+        syscall
+        addiu   $a0, $zero, 10
+        addiu   $v0, $zero, 11
+        syscall
+        addiu   $v0, $zero, 10
+        syscall
+
+# Sorts the unsigned words from $a0 to $a1, both included, with the last one as pivot
+quicksort:
+        sltu    $t0, $a0, $a1
+        beq     $t0, $zero, quicksort_done
+        addiu   $sp, $sp, -12
+        sw      $ra, 0($sp)
+        sw      $a1, 4($sp)
+        lw      $t1, 0($a1)             # pivot
+        addu    $t2, $a0, $zero         # where the next smaller word goes
+        addu    $t3, $a0, $zero
+partition:
+        lw      $t4, 0($t3)
+        sltu    $t0, $t4, $t1
+        beq     $t0, $zero, partition_next
+        lw      $t5, 0($t2)
+        sw      $t4, 0($t2)
+        sw      $t5, 0($t3)
+        addiu   $t2, $t2, 4
+partition_next:
+        addiu   $t3, $t3, 4
+        bne     $t3, $a1, partition
+        lw      $t5, 0($t2)
+        sw      $t1, 0($t2)
+        sw      $t5, 0($a1)
+        sw      $t2, 8($sp)
+
+        addiu   $a1, $t2, -4
+        jal     quicksort
+        lw      $t2, 8($sp)
+        addiu   $a0, $t2, 4
+        lw      $a1, 4($sp)
+        jal     quicksort
+        lw      $ra, 0($sp)
+        addiu   $sp, $sp, 12
+quicksort_done:
+        jr      $ra
@@ -17,10 +17,9 @@ int main(int argc, char** argv)
     std::cout << "------------ by charlesdeepk --------------\n";
 
     argmap_t options;
-    ArgumentProcessor::ReadArguments(argc, argv, options);
+    if (!ArgumentProcessor::ReadArguments(argc, argv, options)) return 1;
 
     ExecutionContext context(options);
-    context.Run();
-    
+    return context.Run();
 }
 
@@ -1,90 +1,462 @@
+#include <algorithm>
+#include <memory>
+#include <type_traits>
 #include "Preprocessor.hpp"
-#include "include/ctre-unicode.hpp"
-#include "PreprocessorRegex.hpp"
 #include "filereader.hpp"
 #include "lexer_util.hpp"
-#include <unicode/uchar.h>
-#include <boost/regex.hpp>
+#include "error.hpp"
+
 namespace NeoMIPS
 {
+    namespace
+    {
+        template<Char C>
+        bool is_blank(C c)
+        {
+            return c == U' ' || c == U'\t' || c == U'\r' || c == U'\v' || c == U'\f';
+        }
+
+        //Anything that can be part of a symbol, a register, a number or a macro parameter (%name or $name)
+        template<Char C>
+        bool is_word_character(C c)
+        {
+            return !is_blank(c) && !is_separator(c) && c != U'\'' && c != U'#';
+        }
+
+        template<Char C>
+        std::basic_string_view<C> next_word(std::basic_string_view<C> text, size_t& pos)
+        {
+            while (pos < text.size() && is_blank(text[pos])) ++pos;
+            size_t start = pos;
+            while (pos < text.size() && is_word_character(text[pos])) ++pos;
+            return text.substr(start, pos - start);
+        }
 
+        template<Char C>
+        bool matches(std::basic_string_view<C> word, std::string_view keyword)
+        {
+            return word.size() == keyword.size() && std::equal(word.begin(), word.end(), keyword.begin(), [](C a, char b) { return a == static_cast<C>(b); });
+        }
 
-        void Preprocessor::process_include(std::u32string& input, const auto& toReplaceStart, const auto& toReplaceEnd, const std::u32string& replaceWith)
+        template<Char C>
+        std::basic_string_view<C> trim(std::basic_string_view<C> text)
         {
-            input.replace(toReplaceStart, toReplaceEnd, *FileReader::ReadWithEncoding(to_ascii_string(replaceWith)));
+            while (!text.empty() && is_blank(text.front())) text.remove_prefix(1);
+            while (!text.empty() && is_blank(text.back())) text.remove_suffix(1);
+            return text;
         }
 
-        void Preprocessor::process_eqv(std::u32string& input, const auto& toRemoveStart, const auto& toRemoveEnd, const std::u32string& define, const std::u32string& replaceWith)
+        //Index one past the end of a string literal starting at text[start], or the end of the line if it is unterminated
+        template<Char C>
+        size_t skip_literal(std::basic_string_view<C> text, size_t start)
         {
-            input.erase(toRemoveStart, toRemoveEnd);
-            std::size_t pos = 0;
-            while ((pos = input.find(define, pos+1)) != std::u32string::npos)
+            size_t i = start + 1;
+            while (i < text.size() && text[i] != text[start] && text[i] != U'\n')
             {
-                //check we're not in a string
-                uint32_t hits = 0;
-                for (size_t i = 0; i < pos; ++i)
-                {
-                    if (input[i] == U'\'')
-                    {
-                        if (input[i - 1] != U'\\') ++hits;
-                    }
-                }
-                if (hits % 2 != 0) continue;
+                if (text[i] == U'\\') ++i;
+                ++i;
+            }
+            return std::min(i + 1, text.size());
+        }
 
-                
-                if (is_separator(input[pos-1]) && is_separator(input[pos + std::distance(toRemoveStart, toRemoveEnd)]))
-                {
-                    input.replace(pos, std::distance(toRemoveStart, toRemoveEnd), replaceWith);
-                }
+        //The text of a line before its comment, if there is one
+        template<Char C>
+        std::basic_string_view<C> strip_comment(std::basic_string_view<C> text)
+        {
+            for (size_t i = 0; i < text.size();)
+            {
+                if (text[i] == U'"' || text[i] == U'\'') i = skip_literal(text, i);
+                else if (text[i] == U'#') return text.substr(0, i);
+                else ++i;
             }
+            return text;
         }
 
-        void process_macro(std::u32string& input, const auto& toRemoveStart, const auto& toRemoveEnd, const std::u32string& macroName, const std::u32string& macroArgs, const std::u32string macroBody)
+        //Splits the operands of a macro invocation, written either as name a, b or as name(a, b)
+        template<Char C>
+        std::vector<std::basic_string_view<C>> split_arguments(std::basic_string_view<C> operands)
         {
-            input.erase(toRemoveStart, toRemoveEnd);
+            std::vector<std::basic_string_view<C>> args;
+            operands = trim(operands);
+            if (operands.size() >= 2 && operands.front() == U'(' && operands.back() == U')')
+            {
+                operands = operands.substr(1, operands.size() - 2);
+            }
 
-            std::size_t pos = 0;
-            while ((pos = input.find(macroName, pos+1)) != std::u32string::npos)
+            for (size_t i = 0; i < operands.size();)
             {
-                //check we're not in a string
-                uint32_t hits = 0;
-                for (size_t i = 0; i < pos; ++i)
+                if (is_blank(operands[i]) || operands[i] == U',')
                 {
-                    if (input[i] == U'\'')
-                    {
-                        if (input[i - 1] != U'\\') ++hits;
-                    }
+                    ++i;
+                    continue;
                 }
-                if (hits % 2 != 0) continue;
+                size_t start = i;
+                if (operands[i] == U'"' || operands[i] == U'\'') i = skip_literal(operands, i);
+                else while (i < operands.size() && !is_blank(operands[i]) && operands[i] != U',') ++i;
+                args.push_back(operands.substr(start, i - start));
+            }
+            return args;
+        }
+    }
 
+    template<Char C>
+    typename Preprocessor<C>::string_type Preprocessor<C>::Preprocess(view_type source)
+    {
+        m_output.clear();
+        m_lines = LineMap(m_lines.Files()[0]);
+        m_output.reserve(source.size() + source.size() / 8);
+        Process(source);
+        return std::move(m_output);
+    }
 
-                if (is_separator(input[pos-1]) && is_separator(input[pos + std::distance(toRemoveStart, toRemoveEnd)]))
-                {
+    template<Char C>
+    void Preprocessor<C>::Process(view_type source)
+    {
+        if (++m_nesting > MAX_NESTING)
+        {
+            throw Error::InvalidSyntaxException("", "Too many nested macro expansions or includes, a macro or a file probably refers to itself.");
+        }
 
-                }
+        uint32_t line = 1;
+        for (size_t i = 0; i < source.size(); ++line)
+        {
+            size_t end = source.find(static_cast<C>(U'\n'), i);
+            if (end == view_type::npos) end = source.size();
+            view_type text = source.substr(i, end - i);
+            size_t next = end + 1;
+
+            size_t pos = 0;
+            view_type keyword = next_word(text, pos);
+            if (matches(keyword, ".eqv"))
+            {
+                DefineEqv(text.substr(pos), line);
+                EndLine(line); //keep the line so the following ones are still reported where they are
+            }
+            else if (matches(keyword, ".macro"))
+            {
+                next = DefineMacro(source, text.substr(pos), next, line);
+            }
+            else if (matches(keyword, ".include"))
+            {
+                Include(text.substr(pos), line);
+            }
+            else if (matches(keyword, ".end_macro"))
+            {
+                throw Error::InvalidSyntaxException(Where(line), ".end_macro without a matching .macro.");
+            }
+            else
+            {
+                EmitLine(text, line);
             }
+            i = next;
         }
+        --m_nesting;
+    }
 
-        void Preprocessor::Preprocess(std::u32string& input)
+    template<Char C>
+    size_t Preprocessor<C>::DefineMacro(view_type source, view_type header, size_t next, uint32_t& line)
+    {
+        size_t pos = 0;
+        BasicMacroDeclaration<C> macro;
+        macro.m_name = next_word(header, pos);
+        if (macro.m_name.empty())
         {
-            std::vector<std::tuple<std::u32string, std::u32string>> macros{};
+            throw Error::InvalidSyntaxException(Where(line), ".macro must be followed by the name of the macro.");
+        }
 
-            for (auto& match : ctre::multiline_range<Regex::includeMacroAndEqvPattern>(input))
+        //parameters may be written as (%a, %b) or as %a, %b
+        view_type params = strip_comment(header.substr(pos));
+        for (size_t i = 0; i < params.size();)
+        {
+            if (!is_word_character(params[i]))
+            {
+                ++i;
+                continue;
+            }
+            view_type param = next_word(params, i);
+            if (param[0] != U'%' && param[0] != U'$') //$ for compatibility with other assemblers
             {
-                std::u32string macroType{ match.get<1>() };
-                if (macroType.compare(U".include") == 0)
+                throw Error::InvalidSyntaxException(Where(line), "The parameters of a macro must start with % or $.");
+            }
+            macro.m_params.emplace_back(param);
+        }
+        EndLine(line);
+
+        size_t bodyStart = next;
+        while (next < source.size())
+        {
+            size_t end = source.find(static_cast<C>(U'\n'), next);
+            if (end == view_type::npos) end = source.size();
+            ++line;
+            EndLine(line);
+
+            size_t p = 0;
+            if (matches(next_word(source.substr(next, end - next), p), ".end_macro"))
+            {
+                macro.m_body = source.substr(bodyStart, next - bodyStart);
+                auto& overloads = m_macros[macro.m_name];
+                auto same = std::find_if(overloads.begin(), overloads.end(), [&](const BasicMacroDeclaration<C>& m) { return m.m_params.size() == macro.m_params.size(); });
+                if (same != overloads.end()) *same = std::move(macro);
+                else overloads.push_back(std::move(macro));
+                return end + 1;
+            }
+            next = end + 1;
+        }
+        throw Error::InvalidSyntaxException(Where(line), "Missing .end_macro for macro " + to_ascii_string(macro.m_name) + ".");
+    }
+
+    template<Char C>
+    void Preprocessor<C>::DefineEqv(view_type definition, uint32_t line)
+    {
+        size_t pos = 0;
+        view_type symbol = next_word(definition, pos);
+        if (symbol.empty())
+        {
+            throw Error::InvalidSyntaxException(Where(line), ".eqv must be followed by a symbol and its value.");
+        }
+
+        //earlier symbols are replaced in the value right away, so chains of .eqv cost nothing when they are used
+        string_type value;
+        Substitute(trim(strip_comment(definition.substr(pos))), value);
+        m_eqvs.insert_or_assign(string_type(symbol), std::move(value));
+    }
+
+    template<Char C>
+    void Preprocessor<C>::Include(view_type operand, uint32_t line)
+    {
+        view_type name = trim(strip_comment(operand));
+        if (name.size() >= 2 && (name.front() == U'"' || name.front() == U'\'') && name.back() == name.front())
+        {
+            name = name.substr(1, name.size() - 2);
+        }
+        if (name.empty())
+        {
+            throw Error::InvalidSyntaxException(Where(line), ".include must be followed by the name of a file.");
+        }
+
+        std::string path = canonical_path(to_ascii_string(name));
+        for (const Preprocessor* p = this; p != nullptr; p = p->m_parent)
+        {
+            if (p->m_path == path)
+            {
+                throw Error::InvalidSyntaxException(Where(line), "File " + to_ascii_string(name) + " includes itself.");
+            }
+        }
+
+        m_dependencies.push_back(path);
+        if (m_cache != nullptr)
+        {
+            typename IncludeCache<C>::file_ptr file = m_cache->Get(path, [&](view_type content) { return PreprocessInclude(path, content); });
+            m_contextDependent |= file->m_contextDependent;
+            Splice(*file);
+        }
+        else
+        {
+            SourceFile<C> content(path);
+            Splice(*PreprocessInclude(path, content.View()));
+        }
+    }
+
+    template<Char C>
+    typename IncludeCache<C>::file_ptr Preprocessor<C>::PreprocessInclude(const std::string& path, view_type content) const
+    {
+        Preprocessor child(this, path);
+        child.m_output.reserve(content.size());
+        child.Process(content);
+
+        auto file = std::make_shared<PreprocessedFile<C>>();
+        file->m_output = std::move(child.m_output);
+        file->m_lines = std::move(child.m_lines);
+        file->m_eqvs = std::move(child.m_eqvs);
+        file->m_macros = std::move(child.m_macros);
+        file->m_dependencies = std::move(child.m_dependencies);
+        file->m_contextDependent = child.m_contextDependent;
+        m_contextDependent |= child.m_contextDependent;
+        return file;
+    }
+
+    //Inserts an included file as if its text had been there, definitions included
+    template<Char C>
+    void Preprocessor<C>::Splice(const PreprocessedFile<C>& file)
+    {
+        m_output.append(file.m_output);
+        m_lines.Append(file.m_lines);
+        m_dependencies.insert(m_dependencies.end(), file.m_dependencies.begin(), file.m_dependencies.end());
+        for (const auto& [symbol, value] : file.m_eqvs)
+        {
+            m_eqvs.insert_or_assign(symbol, value);
+        }
+        for (const auto& [name, overloads] : file.m_macros)
+        {
+            auto& own = m_macros[name];
+            for (const BasicMacroDeclaration<C>& macro : overloads)
+            {
+                auto same = std::find_if(own.begin(), own.end(), [&](const BasicMacroDeclaration<C>& m) { return m.m_params.size() == macro.m_params.size(); });
+                if (same != own.end()) *same = macro;
+                else own.push_back(macro);
+            }
+        }
+    }
+
+    template<Char C>
+    void Preprocessor<C>::EmitLine(view_type text, uint32_t line)
+    {
+        if (HasMacros())
+        {
+            //a label can precede a macro invocation on the same line
+            size_t statement = 0;
+            size_t pos = 0;
+            view_type word = next_word(text, pos);
+            if (!word.empty() && pos < text.size() && text[pos] == U':')
+            {
+                statement = ++pos;
+                word = next_word(text, pos);
+            }
+
+            if (!word.empty() && FindOverloads(word) != nullptr)
+            {
+                std::vector<view_type> args = split_arguments(strip_comment(text.substr(pos)));
+                const BasicMacroDeclaration<C>* macro = FindMacro(word, args.size());
+                if (macro == nullptr)
                 {
-                    process_include(input, match.get<0>().begin(), match.get<0>().end(), match.get<9>().to_string());
+                    throw Error::InvalidSyntaxException(Where(line), "No definition of macro " + to_ascii_string(word) + " takes " + std::to_string(args.size()) + " arguments.");
                 }
-                else if (macroType.compare(U".eqv") == 0)
+
+                if (statement != 0)
                 {
-                    process_eqv(input, match.get<0>().begin(), match.get<0>().end(), match.get<6>().to_string(), match.get<7>().to_string());
+                    Substitute(text.substr(0, statement), m_output);
+                    EndLine(line);
                 }
-                else
+                //the expansion goes through the whole pipeline again, so it can use .eqv symbols and other macros.
+                //Its lines are reported at the invocation, the outermost one if macros invoke each other
+                string_type body;
+                Substitute(macro->m_body, body, macro, &args);
+                uint32_t expansionLine = m_expansionLine;
+                if (m_expansionLine == 0) m_expansionLine = line;
+                Process(body);
+                m_expansionLine = expansionLine;
+                return;
+            }
+        }
+
+        Substitute(text, m_output);
+        EndLine(line);
+    }
+
+    template<Char C>
+    void Preprocessor<C>::EndLine(uint32_t line)
+    {
+        m_output += static_cast<C>(U'\n');
+        m_lines.Add(m_expansionLine != 0 ? m_expansionLine : line);
+    }
+
+    template<Char C>
+    void Preprocessor<C>::Substitute(view_type text, string_type& out, const BasicMacroDeclaration<C>* macro, const std::vector<view_type>* args) const
+    {
+        for (size_t i = 0; i < text.size();)
+        {
+            C c = text[i];
+            if (c == U'"' || c == U'\'')
+            {
+                size_t end = skip_literal(text, i);
+                out.append(text.substr(i, end - i));
+                i = end;
+            }
+            else if (c == U'#')
+            {
+                size_t end = std::min(text.find(static_cast<C>(U'\n'), i), text.size());
+                out.append(text.substr(i, end - i));
+                i = end;
+            }
+            else if (is_word_character(c))
+            {
+                size_t start = i;
+                while (i < text.size() && is_word_character(text[i])) ++i;
+                view_type word = text.substr(start, i - start);
+
+                if (macro != nullptr)
                 {
-                    process_macro(input, match.get<0>().begin(), match.get<0>().end(), match.get<2>().to_string(), match.get<3>().to_string(), match.get<4>().to_string());
+                    auto param = std::find(macro->m_params.begin(), macro->m_params.end(), word);
+                    if (param != macro->m_params.end())
+                    {
+                        out.append((*args)[param - macro->m_params.begin()]);
+                        continue;
+                    }
                 }
+
+                const string_type* eqv = FindEqv(word);
+                out.append(eqv != nullptr ? view_type(*eqv) : word);
+            }
+            else
+            {
+                out += c;
+                ++i;
+            }
+        }
+    }
+
+    template<Char C>
+    std::string Preprocessor<C>::Where(uint32_t line) const
+    {
+        if (m_expansionLine != 0) line = m_expansionLine;
+        const std::string& path = m_lines.Files()[0];
+        if (path.empty()) return std::to_string(line);
+        return path + ":" + std::to_string(line);
+    }
+
+    template<Char C>
+    const typename Preprocessor<C>::string_type* Preprocessor<C>::FindEqv(view_type symbol) const
+    {
+        for (const Preprocessor* p = this; p != nullptr; p = p->m_parent)
+        {
+            if (p->m_eqvs.empty()) continue;
+            auto eqv = p->m_eqvs.find(symbol);
+            if (eqv != p->m_eqvs.end())
+            {
+                m_contextDependent |= p != this;
+                return &eqv->second;
             }
         }
+        return nullptr;
+    }
+
+    template<Char C>
+    const std::vector<BasicMacroDeclaration<C>>* Preprocessor<C>::FindOverloads(view_type name) const
+    {
+        for (const Preprocessor* p = this; p != nullptr; p = p->m_parent)
+        {
+            auto overloads = p->m_macros.find(name);
+            if (overloads != p->m_macros.end())
+            {
+                m_contextDependent |= p != this;
+                return &overloads->second;
+            }
+        }
+        return nullptr;
+    }
+
+    template<Char C>
+    const BasicMacroDeclaration<C>* Preprocessor<C>::FindMacro(view_type name, size_t arity) const
+    {
+        const std::vector<BasicMacroDeclaration<C>>* overloads = FindOverloads(name);
+        if (overloads == nullptr) return nullptr;
+        for (const BasicMacroDeclaration<C>& macro : *overloads)
+        {
+            if (macro.m_params.size() == arity) return &macro;
+        }
+        return nullptr;
+    }
+
+    template<Char C>
+    bool Preprocessor<C>::HasMacros() const
+    {
+        for (const Preprocessor* p = this; p != nullptr; p = p->m_parent)
+        {
+            if (!p->m_macros.empty()) return true;
+        }
+        return false;
+    }
 
+    template class Preprocessor<char8_t>;
+    template class Preprocessor<char32_t>;
 }
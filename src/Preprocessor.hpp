@@ -1,14 +1,71 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <vector>
+#include "constraints.hpp"
+#include "types.hpp"
+#include "includecache.hpp"
+#include "lineindex.hpp"
+
 namespace NeoMIPS
 {
+    //Single pass preprocessor. The source is read line by line and the result is appended to a new buffer:
+    //.eqv and .macro definitions go into hash tables and are dropped from the output, macro invocations are
+    //replaced by their bodies with the parameters substituted, .include splices the preprocessed file in place
+    //and every other line is copied with its .eqv symbols replaced. The input buffer is never modified.
+    //Included files are preprocessed by a child preprocessor that falls back to the tables of its parents, so
+    //their result can be cached and spliced in again wherever the same file is included
+    template<Char C>
     class Preprocessor
     {
     public:
-        static void Preprocess(std::u32string& input);
-        static void process_include(std::u32string& input, const auto& toReplaceStart, const auto& toReplaceEnd, const std::u32string& replaceWith);
-        static void process_eqv(std::u32string& input, const auto& toRemoveStart, const auto& toRemoveEnd, const std::u32string& define, const std::u32string& replaceWith);
-        static void process_macro(std::u32string& input, const auto& toRemoveStart, const auto& toRemoveEnd, const std::u32string& macroName, const std::u32string& macroArgs, const std::u32string macroBody);
+        using string_type = std::basic_string<C>;
+        using view_type = std::basic_string_view<C>;
+
+    private:
+        //Bounds macros that expand to themselves
+        static constexpr uint32_t MAX_NESTING = 256;
+
+        symbol_table<C, string_type> m_eqvs;
+        symbol_table<C, std::vector<BasicMacroDeclaration<C>>> m_macros; //overloads by number of parameters, like MARS
+        string_type m_output;
+        LineMap m_lines; //of m_output
+        uint32_t m_expansionLine; //of the outermost macro invocation being expanded, 0 outside of one
+        uint32_t m_nesting;
+        IncludeCache<C>* m_cache;
+        const Preprocessor* m_parent;
+        std::string m_path;
+        std::vector<std::string> m_dependencies;
+        mutable bool m_contextDependent; //a definition of a parent was used
+
+        Preprocessor(const Preprocessor* parent, const std::string& path) : m_lines(path), m_expansionLine(0), m_nesting(parent->m_nesting), m_cache(parent->m_cache), m_parent(parent), m_path(path), m_contextDependent(false) {};
+
+        void Process(view_type source);
+        size_t DefineMacro(view_type source, view_type header, size_t next, uint32_t& line);
+        void DefineEqv(view_type definition, uint32_t line);
+        void Include(view_type operand, uint32_t line);
+        void EmitLine(view_type text, uint32_t line);
+        //Ends a line of the output, which was written on line of this file
+        void EndLine(uint32_t line);
+        void Substitute(view_type text, string_type& out, const BasicMacroDeclaration<C>* macro = nullptr, const std::vector<view_type>* args = nullptr) const;
+        void Splice(const PreprocessedFile<C>& file);
+        typename IncludeCache<C>::file_ptr PreprocessInclude(const std::string& path, view_type content) const;
+        const string_type* FindEqv(view_type symbol) const;
+        const std::vector<BasicMacroDeclaration<C>>* FindOverloads(view_type name) const;
+        const BasicMacroDeclaration<C>* FindMacro(view_type name, size_t arity) const;
+        bool HasMacros() const;
+        //path:line of a line of the file being preprocessed, or of the macro invocation being expanded, like the
+        //errors of the lexer
+        std::string Where(uint32_t line) const;
+
+    public:
+        //cache may be shared by the preprocessors of every translation unit, path is the file source was read from
+        Preprocessor(IncludeCache<C>* cache = nullptr, const std::string& path = "") : m_lines(path), m_expansionLine(0), m_nesting(0), m_cache(cache), m_parent(nullptr), m_path(path.empty() ? path : canonical_path(path)), m_contextDependent(false) {};
+        string_type Preprocess(view_type source);
+        //Canonical paths of every file included while preprocessing
+        const std::vector<std::string>& Dependencies() const { return m_dependencies; }
+        //File and line every line of the output was written on, for the lexer to report errors where they are
+        LineMap ReleaseLines() { return std::move(m_lines); }
     };
 }
@@ -0,0 +1,916 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "aot.hpp"
+#include "interpreter.hpp"
+#include "util.hpp"
+#include "error.hpp"
+
+namespace NeoMIPS
+{
+    namespace
+    {
+        using ISA::Instruction;
+
+        //Start of every translated program, up to the constants that depend on the program
+        constexpr const char* HEADER = R"(//MIPS32 program translated ahead of time by NeoMIPS --aot, build it on its own with C++20 and optimizations
+#include <algorithm>
+#include <bit>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+)";
+
+        //Machine the blocks run on: the registers, memory as regions like the interpreter's, its exceptions and
+        //its syscalls
+        constexpr const char* RUNTIME = R"(
+    struct Region
+    {
+        uint32_t base;
+        uint32_t size;
+        uint8_t* data;
+        bool executable;
+    };
+
+    uint32_t r[32];
+    uint32_t f[32]; //doubles take an even register and the next one, low word first
+    uint32_t cp0[32];
+    [[maybe_unused]] uint32_t hi, lo;
+    uint8_t fcc; //condition flags of the FPU, one bit each
+    uint32_t from; //address of the last jump through a register, where a jump out of the code is raised
+    bool running = true;
+    int exit_code = 0;
+    std::vector<Region> regions; //sorted by base
+    Region read_cache{ 0, 0, nullptr, false }; //region of the last load
+    Region write_cache{ 0, 0, nullptr, false }; //region of the last store, never one with code
+    uint32_t heap_end = HEAP_END; //what sbrk hands out next
+    uint32_t heap_limit = HEAP_END; //end of the heap regions allocated so far
+    std::mt19937 random_engine{ std::random_device{}() };
+
+    inline std::string to_hex(uint32_t value)
+    {
+        constexpr char DIGITS[] = "0123456789abcdef";
+        std::string text = "0x00000000";
+        for (size_t i = 9; value; --i, value >>= 4) text[i] = DIGITS[value & 0xF];
+        return text;
+    }
+
+    [[noreturn]] inline void fail(const std::string& where, const std::string& why)
+    {
+        std::cout.flush();
+        std::cerr << "RuntimeException" << (where.empty() ? "" : " at " + where) << ": " << why << "\n";
+        std::exit(1);
+    }
+
+    inline const Region* find(uint32_t address)
+    {
+        auto next = std::upper_bound(regions.begin(), regions.end(), address, [](uint32_t at, const Region& region) { return at < region.base; });
+        if (next == regions.begin() || address - std::prev(next)->base >= std::prev(next)->size) return nullptr;
+        return &*std::prev(next);
+    }
+
+    inline bool is_free(uint32_t base, uint32_t size)
+    {
+        for (const Region& region : regions)
+        {
+            if (base < region.base + uint64_t{ region.size } && region.base < base + uint64_t{ size }) return false;
+        }
+        return true;
+    }
+
+    inline void allocate(uint32_t base, uint32_t size)
+    {
+        uint8_t* data = static_cast<uint8_t*>(std::calloc(size, 1));
+        if (!data) fail("", "The host is out of memory.");
+        auto next = std::upper_bound(regions.begin(), regions.end(), base, [](uint32_t at, const Region& region) { return at < region.base; });
+        regions.insert(next, Region{ base, size, data, false });
+    }
+
+    //Host address of a load, nullptr if the address is not mapped
+    inline const uint8_t* readable(uint32_t address, uint32_t size)
+    {
+        uint32_t offset = address - read_cache.base;
+        if (offset < read_cache.size && read_cache.size - offset >= size) return read_cache.data + offset;
+        const Region* region = find(address);
+        if (!region || address - region->base + uint64_t{ size } > region->size) return nullptr;
+        read_cache = *region;
+        return region->data + (address - region->base);
+    }
+
+    //Host address of a store, nullptr if the address is not mapped or is code, which can't be written
+    inline uint8_t* writable(uint32_t address, uint32_t size)
+    {
+        uint32_t offset = address - write_cache.base;
+        if (offset < write_cache.size && write_cache.size - offset >= size) return write_cache.data + offset;
+        const Region* region = find(address);
+        if (!region || region->executable || address - region->base + uint64_t{ size } > region->size) return nullptr;
+        write_cache = *region;
+        return region->data + (address - region->base);
+    }
+
+    template<typename T>
+    inline T swap_bytes(T value)
+    {
+        T swapped = 0;
+        for (size_t k = 0; k < sizeof(T); ++k, value >>= 8) swapped = static_cast<T>(swapped << 8 | (value & 0xFF));
+        return swapped;
+    }
+
+    //Values in emulated memory, which is little endian
+    template<typename T>
+    inline T load(const uint8_t* bytes)
+    {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big) value = swap_bytes(value);
+        return value;
+    }
+
+    template<typename T>
+    inline void store(uint8_t* bytes, T value)
+    {
+        if constexpr (std::endian::native == std::endian::big) value = swap_bytes(value);
+        std::memcpy(bytes, &value, sizeof(T));
+    }
+
+    inline float read_single(uint32_t index) { return std::bit_cast<float>(f[index]); }
+    inline void write_single(uint32_t index, float value) { f[index] = std::bit_cast<uint32_t>(value); }
+    inline double read_double(uint32_t index) { return std::bit_cast<double>(uint64_t{ f[(index + 1) & 31] } << 32 | f[index]); }
+
+    inline void write_double(uint32_t index, double value)
+    {
+        uint64_t bits = std::bit_cast<uint64_t>(value);
+        f[index] = static_cast<uint32_t>(bits);
+        f[(index + 1) & 31] = static_cast<uint32_t>(bits >> 32);
+    }
+
+    inline void move_double(uint32_t to, uint32_t index)
+    {
+        f[to] = f[index];
+        f[(to + 1) & 31] = f[(index + 1) & 31];
+    }
+
+    //Conversion to a word as the FPU does it, NaN and values out of range give the largest word
+    inline uint32_t to_word(double value)
+    {
+        if (!(value >= -2147483648.0 && value < 2147483648.0)) return 0x7FFFFFFF;
+        return static_cast<uint32_t>(static_cast<int32_t>(value));
+    }
+
+    inline void set_fcc(uint32_t cc, bool condition)
+    {
+        if (condition) fcc = static_cast<uint8_t>(fcc | 1 << cc);
+        else fcc = static_cast<uint8_t>(fcc & ~(1 << cc));
+    }
+
+    //Condition of a branch that links, $ra is written whether it is taken or not
+    inline bool linked(bool taken, uint32_t pc)
+    {
+        r[31] = pc + 4;
+        return taken;
+    }
+
+    //Records an exception in coprocessor 0 and returns the address of the handler, ends the program if it has none
+    inline uint32_t raise_exception(uint32_t cause, uint32_t bad_address, uint32_t pc)
+    {
+        if (!HAS_HANDLER)
+        {
+            std::string why;
+            switch (cause)
+            {
+            case 4: why = "Address " + to_hex(bad_address) + " can't be read, it is unaligned or not in memory."; break;
+            case 5: why = "Address " + to_hex(bad_address) + " can't be written, it is unaligned, not in memory or code without --selfmodifying."; break;
+            case 9: why = "Break instruction executed."; break;
+            case 10: why = "The word is not an instruction."; break;
+            case 12: why = "Arithmetic overflow."; break;
+            case 13: why = "Trap taken."; break;
+            default: why = "Exception " + std::to_string(cause) + "."; break;
+            }
+            fail(to_hex(pc), why);
+        }
+
+        cp0[14] = pc;
+        cp0[13] = (cp0[13] & ~0x7Cu) | cause << 2;
+        cp0[12] |= 1 << 1;
+        if (cause == 4 || cause == 5) cp0[8] = bad_address;
+        return EXCEPTION_HANDLER;
+    }
+
+    inline uint32_t sbrk(uint32_t bytes)
+    {
+        if (static_cast<int32_t>(bytes) < 0)
+        {
+            fail("", "sbrk can't give back memory, it was asked for " + std::to_string(static_cast<int32_t>(bytes)) + " bytes.");
+        }
+
+        uint32_t address = heap_end;
+        uint64_t end = uint64_t{ heap_end } + ((bytes + 3) & ~3u);
+        if (end > heap_limit)
+        {
+            uint32_t size = static_cast<uint32_t>((end - heap_limit + HEAP_CHUNK - 1) & ~uint64_t{ HEAP_CHUNK - 1 });
+            if (uint64_t{ heap_limit } + size > HEAP_TOP || !is_free(heap_limit, size))
+            {
+                fail("", "The heap is out of memory, sbrk was asked for " + std::to_string(bytes) + " bytes.");
+            }
+            allocate(heap_limit, size);
+            heap_limit += size;
+        }
+        heap_end = static_cast<uint32_t>(end);
+        return address;
+    }
+
+    inline std::string read_string(uint32_t address)
+    {
+        std::string text;
+        for (uint32_t at = address;; ++at)
+        {
+            const uint8_t* c = readable(at, 1);
+            if (!c) fail("", "The string at " + to_hex(address) + " runs out of memory before its null terminator.");
+            if (*c == 0) return text;
+            text.push_back(static_cast<char>(*c));
+        }
+    }
+
+    //Runs the syscall in $v0, returns false if it ends the program
+    inline bool run_syscall(uint32_t pc)
+    {
+        auto readFailed = [pc](const char* what) { fail(to_hex(pc), std::string("The input is not ") + what + "."); };
+
+        switch (r[2])
+        {
+        case 1: std::cout << static_cast<int32_t>(r[4]); break;
+        case 2: std::cout << read_single(12); break;
+        case 3: std::cout << read_double(12); break;
+        case 4: std::cout << read_string(r[4]); break;
+        case 5:
+        {
+            int32_t value = 0;
+            if (!(std::cin >> value)) readFailed("an integer");
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            r[2] = static_cast<uint32_t>(value);
+            break;
+        }
+        case 6:
+        {
+            float value = 0;
+            if (!(std::cin >> value)) readFailed("a float");
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            write_single(0, value);
+            break;
+        }
+        case 7:
+        {
+            double value = 0;
+            if (!(std::cin >> value)) readFailed("a double");
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            write_double(0, value);
+            break;
+        }
+        case 8:
+        {
+            //up to $a1 - 1 characters, the newline included if it fits, and a null terminator
+            if (r[5] == 0) break;
+            std::string line;
+            std::getline(std::cin, line);
+            line.push_back('\n');
+            line.resize(std::min<size_t>(line.size(), r[5] - 1));
+            uint8_t* buffer = writable(r[4], static_cast<uint32_t>(line.size() + 1));
+            if (!buffer) fail(to_hex(pc), "The buffer at " + to_hex(r[4]) + " can't be written.");
+            std::memcpy(buffer, line.data(), line.size());
+            buffer[line.size()] = 0;
+            break;
+        }
+        case 9: r[2] = sbrk(r[4]); break;
+        case 10: exit_code = 0; running = false; return false;
+        case 11: std::cout.put(static_cast<char>(r[4])); break;
+        case 12:
+        {
+            char c = 0;
+            if (!std::cin.get(c)) readFailed("a character");
+            r[2] = static_cast<uint8_t>(c);
+            break;
+        }
+        case 17: exit_code = static_cast<int32_t>(r[4]); running = false; return false;
+        case 30:
+        {
+            uint64_t milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            r[4] = static_cast<uint32_t>(milliseconds);
+            r[5] = static_cast<uint32_t>(milliseconds >> 32);
+            break;
+        }
+        case 32:
+            std::cout.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int32_t>(r[4])));
+            break;
+        case 34: std::cout << to_hex(r[4]); break;
+        case 35: std::cout << std::bitset<32>(r[4]); break;
+        case 36: std::cout << r[4]; break;
+        //every generator id of MARS shares one generator
+        case 40: random_engine.seed(r[5]); break;
+        case 41: r[4] = static_cast<uint32_t>(random_engine()); break;
+        case 42:
+            if (static_cast<int32_t>(r[5]) <= 0) fail(to_hex(pc), "The upper bound of the random number has to be positive.");
+            r[4] = std::uniform_int_distribution<uint32_t>(0, r[5] - 1)(random_engine);
+            break;
+        case 43: write_single(0, std::uniform_real_distribution<float>(0.0f, 1.0f)(random_engine)); break;
+        case 44: write_double(0, std::uniform_real_distribution<double>(0.0, 1.0)(random_engine)); break;
+        default: fail(to_hex(pc), "There is no syscall " + std::to_string(r[2]) + ".");
+        }
+        return true;
+    }
+)";
+
+        //One statement per instruction, with the registers a, b and c, the immediate i and the address pc of the
+        //instruction as the interpreter decodes them. An instruction that raises an exception or jumps through a
+        //register returns from its block with the address to go on from, branches and direct jumps are written
+        //out with the C_ condition of the branch
+        constexpr const char* INSTRUCTIONS = R"(
+#define LOAD_ACCESS(size, b, i, pc) \
+    uint32_t address = r[b] + (i); \
+    const uint8_t* bytes = (address & ((size) - 1)) ? nullptr : readable(address, size); \
+    if (!bytes) return raise_exception(4, address, pc)
+#define STORE_ACCESS(size, b, i, pc) \
+    uint32_t address = r[b] + (i); \
+    uint8_t* bytes = (address & ((size) - 1)) ? nullptr : writable(address, size); \
+    if (!bytes) return raise_exception(5, address, pc)
+#define TRAP(condition, pc) do { if (condition) return raise_exception(13, 0, pc); } while (0)
+
+#define I_ABS_D(a, b, c, i, pc) write_double(a, std::fabs(read_double(b)))
+#define I_ABS_S(a, b, c, i, pc) write_single(a, std::fabs(read_single(b)))
+#define I_ADD(a, b, c, i, pc) do { uint32_t x = r[b], y = r[c], sum = x + y; if ((x ^ sum) & (y ^ sum) & 0x80000000) return raise_exception(12, 0, pc); r[a] = sum; } while (0)
+#define I_ADD_D(a, b, c, i, pc) write_double(a, read_double(b) + read_double(c))
+#define I_ADD_S(a, b, c, i, pc) write_single(a, read_single(b) + read_single(c))
+#define I_ADDI(a, b, c, i, pc) do { uint32_t x = r[b], sum = x + (i); if ((x ^ sum) & ((i) ^ sum) & 0x80000000) return raise_exception(12, 0, pc); r[a] = sum; } while (0)
+#define I_ADDIU(a, b, c, i, pc) r[a] = r[b] + (i)
+#define I_ADDU(a, b, c, i, pc) r[a] = r[b] + r[c]
+#define I_AND(a, b, c, i, pc) r[a] = r[b] & r[c]
+#define I_ANDI(a, b, c, i, pc) r[a] = r[b] & (i)
+#define C_BC1F(a, b, c, i, pc) (!(fcc >> (c) & 1))
+#define C_BC1T(a, b, c, i, pc) (fcc >> (c) & 1)
+#define C_BEQ(a, b, c, i, pc) (r[a] == r[b])
+#define C_BGEZ(a, b, c, i, pc) (static_cast<int32_t>(r[a]) >= 0)
+#define C_BGEZAL(a, b, c, i, pc) linked(static_cast<int32_t>(r[a]) >= 0, pc)
+#define C_BGTZ(a, b, c, i, pc) (static_cast<int32_t>(r[a]) > 0)
+#define C_BLEZ(a, b, c, i, pc) (static_cast<int32_t>(r[a]) <= 0)
+#define C_BLTZ(a, b, c, i, pc) (static_cast<int32_t>(r[a]) < 0)
+#define C_BLTZAL(a, b, c, i, pc) linked(static_cast<int32_t>(r[a]) < 0, pc)
+#define C_BNE(a, b, c, i, pc) (r[a] != r[b])
+#define I_BREAK(a, b, c, i, pc) return raise_exception(9, 0, pc)
+#define I_C_EQ_D(a, b, c, i, pc) set_fcc(i, read_double(a) == read_double(b))
+#define I_C_EQ_S(a, b, c, i, pc) set_fcc(i, read_single(a) == read_single(b))
+#define I_C_LE_D(a, b, c, i, pc) set_fcc(i, read_double(a) <= read_double(b))
+#define I_C_LE_S(a, b, c, i, pc) set_fcc(i, read_single(a) <= read_single(b))
+#define I_C_LT_D(a, b, c, i, pc) set_fcc(i, read_double(a) < read_double(b))
+#define I_C_LT_S(a, b, c, i, pc) set_fcc(i, read_single(a) < read_single(b))
+#define I_CEIL_W_D(a, b, c, i, pc) f[a] = to_word(std::ceil(read_double(b)))
+#define I_CEIL_W_S(a, b, c, i, pc) f[a] = to_word(std::ceil(read_single(b)))
+#define I_CLO(a, b, c, i, pc) r[a] = static_cast<uint32_t>(std::countl_one(r[b]))
+#define I_CLZ(a, b, c, i, pc) r[a] = static_cast<uint32_t>(std::countl_zero(r[b]))
+#define I_CVT_D_S(a, b, c, i, pc) write_double(a, read_single(b))
+#define I_CVT_D_W(a, b, c, i, pc) write_double(a, static_cast<int32_t>(f[b]))
+#define I_CVT_S_D(a, b, c, i, pc) write_single(a, static_cast<float>(read_double(b)))
+#define I_CVT_S_W(a, b, c, i, pc) write_single(a, static_cast<float>(static_cast<int32_t>(f[b])))
+#define I_CVT_W_D(a, b, c, i, pc) f[a] = to_word(std::nearbyint(read_double(b)))
+#define I_CVT_W_S(a, b, c, i, pc) f[a] = to_word(std::nearbyint(read_single(b)))
+#define I_DIV(a, b, c, i, pc) do { \
+        int32_t x = static_cast<int32_t>(r[a]), y = static_cast<int32_t>(r[b]); \
+        if (y == -1) { lo = 0u - static_cast<uint32_t>(x); hi = 0; } \
+        else if (y != 0) { lo = static_cast<uint32_t>(x / y); hi = static_cast<uint32_t>(x % y); } \
+    } while (0)
+#define I_DIV_D(a, b, c, i, pc) write_double(a, read_double(b) / read_double(c))
+#define I_DIV_S(a, b, c, i, pc) write_single(a, read_single(b) / read_single(c))
+#define I_DIVU(a, b, c, i, pc) do { if (r[b] != 0) { lo = r[a] / r[b]; hi = r[a] % r[b]; } } while (0)
+#define I_ERET(a, b, c, i, pc) do { cp0[12] &= ~(1u << 1); from = pc; return cp0[14]; } while (0)
+#define I_FLOOR_W_D(a, b, c, i, pc) f[a] = to_word(std::floor(read_double(b)))
+#define I_FLOOR_W_S(a, b, c, i, pc) f[a] = to_word(std::floor(read_single(b)))
+#define I_JALR_RA(a, b, c, i, pc) do { uint32_t target = r[a]; if (target & 3) return raise_exception(4, target, pc); r[31] = (pc) + 4; from = pc; return target; } while (0)
+#define I_JALR(a, b, c, i, pc) do { uint32_t target = r[b]; if (target & 3) return raise_exception(4, target, pc); r[a] = (pc) + 4; r[0] = 0; from = pc; return target; } while (0)
+#define I_JR(a, b, c, i, pc) do { uint32_t target = r[a]; if (target & 3) return raise_exception(4, target, pc); from = pc; return target; } while (0)
+#define I_LB(a, b, c, i, pc) do { LOAD_ACCESS(1, b, i, pc); r[a] = static_cast<uint32_t>(static_cast<int8_t>(*bytes)); } while (0)
+#define I_LBU(a, b, c, i, pc) do { LOAD_ACCESS(1, b, i, pc); r[a] = *bytes; } while (0)
+#define I_LDC1(a, b, c, i, pc) do { LOAD_ACCESS(8, b, i, pc); f[a] = load<uint32_t>(bytes); f[((a) + 1) & 31] = load<uint32_t>(bytes + 4); } while (0)
+#define I_LH(a, b, c, i, pc) do { LOAD_ACCESS(2, b, i, pc); r[a] = static_cast<uint32_t>(static_cast<int16_t>(load<uint16_t>(bytes))); } while (0)
+#define I_LHU(a, b, c, i, pc) do { LOAD_ACCESS(2, b, i, pc); r[a] = load<uint16_t>(bytes); } while (0)
+#define I_LL(a, b, c, i, pc) do { LOAD_ACCESS(4, b, i, pc); r[a] = load<uint32_t>(bytes); } while (0)
+#define I_LUI(a, b, c, i, pc) r[a] = (i)
+#define I_LW(a, b, c, i, pc) do { LOAD_ACCESS(4, b, i, pc); r[a] = load<uint32_t>(bytes); } while (0)
+#define I_LWC1(a, b, c, i, pc) do { LOAD_ACCESS(4, b, i, pc); f[a] = load<uint32_t>(bytes); } while (0)
+#define I_LWL(a, b, c, i, pc) do { \
+        uint32_t address = r[b] + (i); \
+        const uint8_t* bytes = readable(address & ~3u, 4); \
+        if (!bytes) return raise_exception(4, address, pc); \
+        uint32_t shift = 8 * (3 - (address & 3)); \
+        r[a] = (r[a] & static_cast<uint32_t>((uint64_t{ 1 } << shift) - 1)) | load<uint32_t>(bytes) << shift; \
+    } while (0)
+#define I_LWR(a, b, c, i, pc) do { \
+        uint32_t address = r[b] + (i); \
+        const uint8_t* bytes = readable(address & ~3u, 4); \
+        if (!bytes) return raise_exception(4, address, pc); \
+        uint32_t shift = 8 * (address & 3); \
+        r[a] = (r[a] & ~static_cast<uint32_t>(0xFFFFFFFFull >> shift)) | load<uint32_t>(bytes) >> shift; \
+    } while (0)
+#define I_MADD(a, b, c, i, pc) do { \
+        int64_t accumulator = static_cast<int64_t>(uint64_t{ hi } << 32 | lo); \
+        uint64_t result = static_cast<uint64_t>(accumulator + int64_t{ static_cast<int32_t>(r[a]) } * static_cast<int32_t>(r[b])); \
+        lo = static_cast<uint32_t>(result); hi = static_cast<uint32_t>(result >> 32); \
+    } while (0)
+#define I_MADDU(a, b, c, i, pc) do { \
+        uint64_t result = (uint64_t{ hi } << 32 | lo) + uint64_t{ r[a] } * r[b]; \
+        lo = static_cast<uint32_t>(result); hi = static_cast<uint32_t>(result >> 32); \
+    } while (0)
+#define I_MFC0(a, b, c, i, pc) r[a] = cp0[b]
+#define I_MFC1(a, b, c, i, pc) r[a] = f[b]
+#define I_MFHI(a, b, c, i, pc) r[a] = hi
+#define I_MFLO(a, b, c, i, pc) r[a] = lo
+#define I_MOV_D(a, b, c, i, pc) move_double(a, b)
+#define I_MOV_S(a, b, c, i, pc) f[a] = f[b]
+#define I_MOVF(a, b, c, i, pc) do { if (!(fcc >> (i) & 1)) r[a] = r[b]; } while (0)
+#define I_MOVF_D(a, b, c, i, pc) do { if (!(fcc >> (i) & 1)) move_double(a, b); } while (0)
+#define I_MOVF_S(a, b, c, i, pc) do { if (!(fcc >> (i) & 1)) f[a] = f[b]; } while (0)
+#define I_MOVN(a, b, c, i, pc) do { if (r[c] != 0) r[a] = r[b]; } while (0)
+#define I_MOVN_D(a, b, c, i, pc) do { if (r[c] != 0) move_double(a, b); } while (0)
+#define I_MOVN_S(a, b, c, i, pc) do { if (r[c] != 0) f[a] = f[b]; } while (0)
+#define I_MOVT(a, b, c, i, pc) do { if (fcc >> (i) & 1) r[a] = r[b]; } while (0)
+#define I_MOVT_D(a, b, c, i, pc) do { if (fcc >> (i) & 1) move_double(a, b); } while (0)
+#define I_MOVT_S(a, b, c, i, pc) do { if (fcc >> (i) & 1) f[a] = f[b]; } while (0)
+#define I_MOVZ(a, b, c, i, pc) do { if (r[c] == 0) r[a] = r[b]; } while (0)
+#define I_MOVZ_D(a, b, c, i, pc) do { if (r[c] == 0) move_double(a, b); } while (0)
+#define I_MOVZ_S(a, b, c, i, pc) do { if (r[c] == 0) f[a] = f[b]; } while (0)
+#define I_MSUB(a, b, c, i, pc) do { \
+        int64_t accumulator = static_cast<int64_t>(uint64_t{ hi } << 32 | lo); \
+        uint64_t result = static_cast<uint64_t>(accumulator - int64_t{ static_cast<int32_t>(r[a]) } * static_cast<int32_t>(r[b])); \
+        lo = static_cast<uint32_t>(result); hi = static_cast<uint32_t>(result >> 32); \
+    } while (0)
+#define I_MSUBU(a, b, c, i, pc) do { \
+        uint64_t result = (uint64_t{ hi } << 32 | lo) - uint64_t{ r[a] } * r[b]; \
+        lo = static_cast<uint32_t>(result); hi = static_cast<uint32_t>(result >> 32); \
+    } while (0)
+#define I_MTC0(a, b, c, i, pc) cp0[b] = r[a]
+#define I_MTC1(a, b, c, i, pc) f[b] = r[a]
+#define I_MTHI(a, b, c, i, pc) hi = r[a]
+#define I_MTLO(a, b, c, i, pc) lo = r[a]
+#define I_MUL(a, b, c, i, pc) r[a] = static_cast<uint32_t>(int64_t{ static_cast<int32_t>(r[b]) } * static_cast<int32_t>(r[c]))
+#define I_MUL_D(a, b, c, i, pc) write_double(a, read_double(b) * read_double(c))
+#define I_MUL_S(a, b, c, i, pc) write_single(a, read_single(b) * read_single(c))
+#define I_MULT(a, b, c, i, pc) do { \
+        uint64_t product = static_cast<uint64_t>(int64_t{ static_cast<int32_t>(r[a]) } * static_cast<int32_t>(r[b])); \
+        lo = static_cast<uint32_t>(product); hi = static_cast<uint32_t>(product >> 32); \
+    } while (0)
+#define I_MULTU(a, b, c, i, pc) do { \
+        uint64_t product = uint64_t{ r[a] } * r[b]; \
+        lo = static_cast<uint32_t>(product); hi = static_cast<uint32_t>(product >> 32); \
+    } while (0)
+#define I_NEG_D(a, b, c, i, pc) write_double(a, -read_double(b))
+#define I_NEG_S(a, b, c, i, pc) write_single(a, -read_single(b))
+#define I_NOP(a, b, c, i, pc) do { } while (0)
+#define I_NOR(a, b, c, i, pc) r[a] = ~(r[b] | r[c])
+#define I_OR(a, b, c, i, pc) r[a] = r[b] | r[c]
+#define I_ORI(a, b, c, i, pc) r[a] = r[b] | (i)
+#define I_ROUND_W_D(a, b, c, i, pc) f[a] = to_word(std::nearbyint(read_double(b)))
+#define I_ROUND_W_S(a, b, c, i, pc) f[a] = to_word(std::nearbyint(read_single(b)))
+#define I_SB(a, b, c, i, pc) do { STORE_ACCESS(1, b, i, pc); *bytes = static_cast<uint8_t>(r[a]); } while (0)
+#define I_SC(a, b, c, i, pc) do { STORE_ACCESS(4, b, i, pc); store<uint32_t>(bytes, r[a]); r[a] = 1; } while (0)
+#define I_SDC1(a, b, c, i, pc) do { STORE_ACCESS(8, b, i, pc); store<uint32_t>(bytes, f[a]); store<uint32_t>(bytes + 4, f[((a) + 1) & 31]); } while (0)
+#define I_SH(a, b, c, i, pc) do { STORE_ACCESS(2, b, i, pc); store<uint16_t>(bytes, static_cast<uint16_t>(r[a])); } while (0)
+#define I_SLL(a, b, c, i, pc) r[a] = r[b] << (i)
+#define I_SLLV(a, b, c, i, pc) r[a] = r[b] << (r[c] & 31)
+#define I_SLT(a, b, c, i, pc) r[a] = static_cast<int32_t>(r[b]) < static_cast<int32_t>(r[c])
+#define I_SLTI(a, b, c, i, pc) r[a] = static_cast<int32_t>(r[b]) < static_cast<int32_t>(i)
+#define I_SLTIU(a, b, c, i, pc) r[a] = r[b] < (i)
+#define I_SLTU(a, b, c, i, pc) r[a] = r[b] < r[c]
+#define I_SQRT_D(a, b, c, i, pc) write_double(a, std::sqrt(read_double(b)))
+#define I_SQRT_S(a, b, c, i, pc) write_single(a, std::sqrt(read_single(b)))
+#define I_SRA(a, b, c, i, pc) r[a] = static_cast<uint32_t>(static_cast<int32_t>(r[b]) >> (i))
+#define I_SRAV(a, b, c, i, pc) r[a] = static_cast<uint32_t>(static_cast<int32_t>(r[b]) >> (r[c] & 31))
+#define I_SRL(a, b, c, i, pc) r[a] = r[b] >> (i)
+#define I_SRLV(a, b, c, i, pc) r[a] = r[b] >> (r[c] & 31)
+#define I_SUB(a, b, c, i, pc) do { uint32_t x = r[b], y = r[c], difference = x - y; if ((x ^ y) & (x ^ difference) & 0x80000000) return raise_exception(12, 0, pc); r[a] = difference; } while (0)
+#define I_SUB_D(a, b, c, i, pc) write_double(a, read_double(b) - read_double(c))
+#define I_SUB_S(a, b, c, i, pc) write_single(a, read_single(b) - read_single(c))
+#define I_SUBU(a, b, c, i, pc) r[a] = r[b] - r[c]
+#define I_SW(a, b, c, i, pc) do { STORE_ACCESS(4, b, i, pc); store<uint32_t>(bytes, r[a]); } while (0)
+#define I_SWC1(a, b, c, i, pc) do { STORE_ACCESS(4, b, i, pc); store<uint32_t>(bytes, f[a]); } while (0)
+#define I_SWL(a, b, c, i, pc) do { \
+        uint32_t address = r[b] + (i); \
+        uint8_t* bytes = writable(address & ~3u, 4); \
+        if (!bytes) return raise_exception(5, address, pc); \
+        uint32_t shift = 8 * (3 - (address & 3)); \
+        uint32_t kept = load<uint32_t>(bytes) & ~static_cast<uint32_t>(0xFFFFFFFFull >> shift); \
+        store<uint32_t>(bytes, kept | r[a] >> shift); \
+    } while (0)
+#define I_SWR(a, b, c, i, pc) do { \
+        uint32_t address = r[b] + (i); \
+        uint8_t* bytes = writable(address & ~3u, 4); \
+        if (!bytes) return raise_exception(5, address, pc); \
+        uint32_t shift = 8 * (address & 3); \
+        uint32_t kept = load<uint32_t>(bytes) & static_cast<uint32_t>((uint64_t{ 1 } << shift) - 1); \
+        store<uint32_t>(bytes, kept | r[a] << shift); \
+    } while (0)
+#define I_SYSCALL(a, b, c, i, pc) do { if (!run_syscall(pc)) return pc; } while (0)
+#define I_TEQ(a, b, c, i, pc) TRAP(r[a] == r[b], pc)
+#define I_TEQI(a, b, c, i, pc) TRAP(r[a] == (i), pc)
+#define I_TGE(a, b, c, i, pc) TRAP(static_cast<int32_t>(r[a]) >= static_cast<int32_t>(r[b]), pc)
+#define I_TGEI(a, b, c, i, pc) TRAP(static_cast<int32_t>(r[a]) >= static_cast<int32_t>(i), pc)
+#define I_TGEIU(a, b, c, i, pc) TRAP(r[a] >= (i), pc)
+#define I_TGEU(a, b, c, i, pc) TRAP(r[a] >= r[b], pc)
+#define I_TLT(a, b, c, i, pc) TRAP(static_cast<int32_t>(r[a]) < static_cast<int32_t>(r[b]), pc)
+#define I_TLTI(a, b, c, i, pc) TRAP(static_cast<int32_t>(r[a]) < static_cast<int32_t>(i), pc)
+#define I_TLTIU(a, b, c, i, pc) TRAP(r[a] < (i), pc)
+#define I_TLTU(a, b, c, i, pc) TRAP(r[a] < r[b], pc)
+#define I_TNE(a, b, c, i, pc) TRAP(r[a] != r[b], pc)
+#define I_TNEI(a, b, c, i, pc) TRAP(r[a] != (i), pc)
+#define I_TRUNC_W_D(a, b, c, i, pc) f[a] = to_word(std::trunc(read_double(b)))
+#define I_TRUNC_W_S(a, b, c, i, pc) f[a] = to_word(std::trunc(read_single(b)))
+#define I_XOR(a, b, c, i, pc) r[a] = r[b] ^ r[c]
+#define I_XORI(a, b, c, i, pc) r[a] = r[b] ^ (i)
+#define I_RESERVED(a, b, c, i, pc) return raise_exception(10, 0, pc)
+
+)";
+
+#define NEOMIPS_INSTRUCTION_NAME(name) #name,
+        constexpr const char* NAMES[] = { NEOMIPS_INSTRUCTIONS(NEOMIPS_INSTRUCTION_NAME) "RESERVED" };
+#undef NEOMIPS_INSTRUCTION_NAME
+        static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == ISA::INSTRUCTION_COUNT + 1, "Every instruction needs its statement");
+
+        constexpr uint8_t RESERVED = static_cast<uint8_t>(ISA::INSTRUCTION_COUNT);
+
+        //How an instruction goes on: to the next one, maybe to its immediate, only to its immediate, only
+        //wherever its statement returns to, or to the next one after its statement maybe returned
+        enum class Flow { Next, Branch, Jump, Exit, Syscall };
+
+        Flow flow_of(uint8_t handler)
+        {
+            if (handler == RESERVED) return Flow::Exit;
+            switch (static_cast<Instruction>(handler))
+            {
+            case Instruction::BC1F: case Instruction::BC1T: case Instruction::BEQ: case Instruction::BGEZ: case Instruction::BGEZAL:
+            case Instruction::BGTZ: case Instruction::BLEZ: case Instruction::BLTZ: case Instruction::BLTZAL: case Instruction::BNE:
+                return Flow::Branch;
+            case Instruction::J: case Instruction::JAL:
+                return Flow::Jump;
+            case Instruction::JALR_RA: case Instruction::JALR: case Instruction::JR: case Instruction::ERET: case Instruction::BREAK:
+                return Flow::Exit;
+            case Instruction::SYSCALL:
+                return Flow::Syscall;
+            default:
+                return Flow::Next;
+            }
+        }
+
+        //Whether the instruction can raise an exception, besides the ones of jumping outside the code
+        bool can_raise(uint8_t handler)
+        {
+            if (handler == RESERVED) return true;
+            switch (static_cast<Instruction>(handler))
+            {
+            case Instruction::ADD: case Instruction::ADDI: case Instruction::SUB: case Instruction::BREAK:
+            case Instruction::JALR_RA: case Instruction::JALR: case Instruction::JR: case Instruction::ERET:
+            case Instruction::LB: case Instruction::LBU: case Instruction::LDC1: case Instruction::LH: case Instruction::LHU: case Instruction::LL:
+            case Instruction::LW: case Instruction::LWC1: case Instruction::LWL: case Instruction::LWR:
+            case Instruction::SB: case Instruction::SC: case Instruction::SDC1: case Instruction::SH: case Instruction::SW: case Instruction::SWC1:
+            case Instruction::SWL: case Instruction::SWR:
+            case Instruction::TEQ: case Instruction::TEQI: case Instruction::TGE: case Instruction::TGEI: case Instruction::TGEIU: case Instruction::TGEU:
+            case Instruction::TLT: case Instruction::TLTI: case Instruction::TLTIU: case Instruction::TLTU: case Instruction::TNE: case Instruction::TNEI:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        //Whether the statement writes the general purpose register in m_reg1, which $zero has to be reset after
+        bool writes_reg1(uint8_t handler)
+        {
+            if (handler == RESERVED) return false;
+            switch (static_cast<Instruction>(handler))
+            {
+            case Instruction::ADD: case Instruction::ADDI: case Instruction::ADDIU: case Instruction::ADDU: case Instruction::AND: case Instruction::ANDI:
+            case Instruction::CLO: case Instruction::CLZ: case Instruction::LB: case Instruction::LBU: case Instruction::LH: case Instruction::LHU:
+            case Instruction::LL: case Instruction::LUI: case Instruction::LW: case Instruction::LWL: case Instruction::LWR: case Instruction::MFC0:
+            case Instruction::MFC1: case Instruction::MFHI: case Instruction::MFLO: case Instruction::MOVF: case Instruction::MOVN: case Instruction::MOVT:
+            case Instruction::MOVZ: case Instruction::MUL: case Instruction::NOR: case Instruction::OR: case Instruction::ORI: case Instruction::SC:
+            case Instruction::SLL: case Instruction::SLLV: case Instruction::SLT: case Instruction::SLTI: case Instruction::SLTIU: case Instruction::SLTU:
+            case Instruction::SRA: case Instruction::SRAV: case Instruction::SRL: case Instruction::SRLV: case Instruction::SUB: case Instruction::SUBU:
+            case Instruction::XOR: case Instruction::XORI:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        struct CodeRegion
+        {
+            uint32_t m_base;
+            uint32_t m_size; //in bytes, whole words only
+            std::vector<DecodedInstruction> m_code;
+            std::vector<bool> m_leaders; //one per word and one for the end, where the program stops
+        };
+
+        std::string hex(uint32_t value)
+        {
+            return to_hex(value) + "u";
+        }
+
+        std::string block_name(uint32_t address)
+        {
+            return "b_" + to_hex(address).substr(2);
+        }
+
+        //Bytes of a region, zeros where a paged one was never written
+        std::vector<uint8_t> contents_of(const Memory& memory, const Memory::Region& region)
+        {
+            std::vector<uint8_t> bytes(region.m_size);
+            for (uint32_t offset = 0; offset < region.m_size;)
+            {
+                Memory::Region span = memory.Peek(region.m_base + offset);
+                uint32_t piece = static_cast<uint32_t>(uint64_t{ span.m_base } + span.m_size - (region.m_base + offset));
+                if (span.m_data) std::memcpy(bytes.data() + offset, span.m_data + (region.m_base + offset - span.m_base), piece);
+                offset += piece;
+            }
+            return bytes;
+        }
+
+        class Translator
+        {
+            const Memory& m_memory;
+            std::vector<CodeRegion> m_code;
+            bool m_hasHandler = false;
+            std::ostringstream m_out;
+
+            CodeRegion* FindCode(uint32_t address)
+            {
+                for (CodeRegion& region : m_code)
+                {
+                    if (address - region.m_base <= region.m_size) return &region;
+                }
+                return nullptr;
+            }
+
+            //Makes a basic block start at the address, if it is a word of the code
+            void Lead(uint32_t address)
+            {
+                CodeRegion* region = FindCode(address);
+                if (region && (address & 3) == 0) region->m_leaders[(address - region->m_base) / 4] = true;
+            }
+
+            void FindLeaders(const std::vector<uint32_t>& labels)
+            {
+                Lead(m_memory.Entry());
+                Lead(Interpreter::EXCEPTION_HANDLER);
+                for (uint32_t label : labels) Lead(label);
+
+                for (CodeRegion& region : m_code)
+                {
+                    region.m_leaders[0] = true;
+                    for (size_t k = 0; k < region.m_code.size(); ++k)
+                    {
+                        const DecodedInstruction& d = region.m_code[k];
+                        uint32_t pc = region.m_base + static_cast<uint32_t>(k) * 4;
+                        Flow flow = flow_of(d.m_handler);
+                        bool outside = false;
+                        if (flow == Flow::Branch || flow == Flow::Jump)
+                        {
+                            Lead(d.m_immediate);
+                            outside = !FindCode(d.m_immediate);
+                        }
+                        if (flow != Flow::Next) Lead(pc + 4);
+                        //the handler returns to the instruction that raised the exception or to the next one
+                        if (m_hasHandler && (outside || can_raise(d.m_handler)))
+                        {
+                            Lead(pc);
+                            Lead(pc + 4);
+                        }
+
+                        //addresses la puts together can be jumped to through a register
+                        if (static_cast<Instruction>(d.m_handler) == Instruction::LUI && k + 1 < region.m_code.size())
+                        {
+                            const DecodedInstruction& low = region.m_code[k + 1];
+                            Instruction next = static_cast<Instruction>(low.m_handler);
+                            if (low.m_reg2 == d.m_reg1 && next == Instruction::ORI) Lead(d.m_immediate | low.m_immediate);
+                            if (low.m_reg2 == d.m_reg1 && next == Instruction::ADDIU) Lead(d.m_immediate + low.m_immediate);
+                        }
+                    }
+                }
+
+                //and so can the words of jump tables in the data
+                for (const Memory::Region& region : m_memory.Regions())
+                {
+                    if (region.m_executable) continue;
+                    std::vector<uint8_t> contents = contents_of(m_memory, region);
+                    for (uint32_t offset = 0; offset + 4 <= region.m_size; offset += 4)
+                    {
+                        const uint8_t* bytes = contents.data() + offset;
+                        Lead(uint32_t{ bytes[0] } | uint32_t{ bytes[1] } << 8 | uint32_t{ bytes[2] } << 16 | uint32_t{ bytes[3] } << 24);
+                    }
+                }
+            }
+
+            //Statement that goes on at the target of a branch or a jump from pc in the block at start
+            std::string Transfer(uint32_t target, uint32_t pc, uint32_t start, bool& loops)
+            {
+                if (target == start)
+                {
+                    loops = true;
+                    return "goto top;";
+                }
+                CodeRegion* region = FindCode(target);
+                if (!region) return "return raise_exception(4, " + hex(target) + ", " + hex(pc) + ");";
+                //going forward calls the block, which the compiler turns into a jump, going back returns to the dispatcher
+                if (target > pc && target - region->m_base < region->m_size) return "return " + block_name(target) + "();";
+                return "return " + hex(target) + ";";
+            }
+
+            void WriteBlock(const CodeRegion& region, size_t entry)
+            {
+                uint32_t start = region.m_base + static_cast<uint32_t>(entry) * 4;
+                std::ostringstream body;
+                bool loops = false;
+                for (size_t k = entry;; ++k)
+                {
+                    const DecodedInstruction& d = region.m_code[k];
+                    uint32_t pc = region.m_base + static_cast<uint32_t>(k) * 4;
+                    std::string operands = "(" + std::to_string(d.m_reg1) + ", " + std::to_string(d.m_reg2) + ", " + std::to_string(d.m_reg3) + ", " + hex(d.m_immediate) + ", " + hex(pc) + ")";
+                    Flow flow = flow_of(d.m_handler);
+                    body << "        ";
+                    if (flow == Flow::Branch) body << "if (C_" << NAMES[d.m_handler] << operands << ") " << Transfer(d.m_immediate, pc, start, loops) << "\n";
+                    else if (flow == Flow::Jump)
+                    {
+                        if (static_cast<Instruction>(d.m_handler) == Instruction::JAL) body << "r[31] = " << hex(pc + 4) << ";\n        ";
+                        body << Transfer(d.m_immediate, pc, start, loops) << "\n";
+                    }
+                    else
+                    {
+                        body << "I_" << NAMES[d.m_handler] << operands << ";\n";
+                        if (d.m_reg1 == 0 && writes_reg1(d.m_handler)) body << "        r[0] = 0;\n";
+                    }
+
+                    if (flow == Flow::Jump || flow == Flow::Exit) break;
+                    if (flow != Flow::Next || k + 1 == region.m_code.size() || region.m_leaders[k + 1])
+                    {
+                        uint32_t next = pc + 4;
+                        if (k + 1 == region.m_code.size()) body << "        return " << hex(next) << ";\n";
+                        else body << "        return " << block_name(next) << "();\n";
+                        break;
+                    }
+                }
+
+                m_out << "    uint32_t " << block_name(start) << "()\n    {\n";
+                if (loops) m_out << "    top:\n";
+                m_out << body.str() << "    }\n\n";
+            }
+
+            void WriteDispatch()
+            {
+                m_out << "    //Block of an address only known when running, after a jump through a register or an exception\n";
+                m_out << "    uint32_t dispatch(uint32_t pc)\n    {\n";
+                for (const CodeRegion& region : m_code)
+                {
+                    m_out << "        if (pc - " << hex(region.m_base) << " <= " << hex(region.m_size) << " && (pc & 3) == 0)\n        {\n";
+                    m_out << "            switch ((pc - " << hex(region.m_base) << ") >> 2)\n            {\n";
+                    for (size_t k = 0; k < region.m_code.size(); ++k)
+                    {
+                        if (region.m_leaders[k]) m_out << "            case " << k << ": return " << block_name(region.m_base + static_cast<uint32_t>(k) * 4) << "();\n";
+                    }
+                    //the program ran off the bottom of its code, which ends it like MARS does
+                    m_out << "            case " << region.m_code.size() << ": running = false; return pc;\n";
+                    m_out << "            default: break;\n            }\n";
+                    m_out << "            fail(to_hex(from), \"The jump to \" + to_hex(pc) + \" lands inside a basic block, translated code can only be entered where one starts.\");\n";
+                    m_out << "        }\n";
+                }
+                m_out << "        return raise_exception(4, pc, from);\n    }\n";
+            }
+
+            void WriteMain()
+            {
+                m_out << "int main()\n{\n";
+                m_out << "    regions = {\n";
+                for (size_t s = 0; s < m_memory.Regions().size(); ++s)
+                {
+                    const Memory::Region& region = m_memory.Regions()[s];
+                    m_out << "        { " << hex(region.m_base) << ", " << hex(region.m_size) << ", segment_" << s << ", " << (region.m_executable ? "true" : "false") << " },\n";
+                }
+                m_out << "    };\n";
+
+                //the stack and the area $gp points into are only added where the program left room for them
+                constexpr uint32_t GP_AREA = Interpreter::INITIAL_GP & 0xFFFF0000;
+                m_out << "    if (is_free(" << hex(Interpreter::STACK_TOP - Interpreter::STACK_SIZE) << ", " << hex(Interpreter::STACK_SIZE) << ")) allocate("
+                    << hex(Interpreter::STACK_TOP - Interpreter::STACK_SIZE) << ", " << hex(Interpreter::STACK_SIZE) << ");\n";
+                m_out << "    if (is_free(" << hex(GP_AREA) << ", 0x10000u)) allocate(" << hex(GP_AREA) << ", 0x10000u);\n";
+                m_out << "    r[28] = " << hex(Interpreter::INITIAL_GP) << ";\n";
+                m_out << "    r[29] = " << hex(Interpreter::INITIAL_SP) << ";\n";
+                m_out << "    cp0[12] = 0x0000ff11u;\n\n";
+                m_out << "    uint32_t pc = " << hex(m_memory.Entry()) << ";\n";
+                m_out << "    while (running) pc = dispatch(pc);\n";
+                m_out << "    std::cout.flush();\n    return exit_code;\n}\n";
+            }
+
+        public:
+            explicit Translator(const Memory& memory) : m_memory(memory)
+            {
+                for (const Memory::Region& region : memory.Regions())
+                {
+                    if (!region.m_executable) continue;
+                    CodeRegion code{ region.m_base, region.m_size & ~3u, {}, {} };
+                    for (uint32_t offset = 0; offset < code.m_size; offset += 4)
+                    {
+                        const uint8_t* bytes = region.m_data + offset;
+                        uint32_t word = uint32_t{ bytes[0] } | uint32_t{ bytes[1] } << 8 | uint32_t{ bytes[2] } << 16 | uint32_t{ bytes[3] } << 24;
+                        code.m_code.push_back(predecode(word, region.m_base + offset));
+                    }
+                    code.m_leaders.assign(code.m_code.size() + 1, false);
+                    m_code.push_back(std::move(code));
+                }
+                m_hasHandler = FindCode(Interpreter::EXCEPTION_HANDLER) != nullptr;
+            }
+
+            std::string Translate(const std::vector<uint32_t>& labels)
+            {
+                CodeRegion* entry = FindCode(m_memory.Entry());
+                if (!entry || m_memory.Entry() - entry->m_base == entry->m_size)
+                {
+                    throw Error::RuntimeException("", "The entry point " + to_hex(m_memory.Entry()) + " is not in the code of the program.");
+                }
+                FindLeaders(labels);
+
+                //the heap starts after the data below the stack, like in the Interpreter
+                uint32_t heapEnd = Interpreter::HEAP_BASE;
+                for (const Memory::Region& region : m_memory.Regions())
+                {
+                    uint64_t end = uint64_t{ region.m_base } + region.m_size;
+                    if (!region.m_executable && region.m_base >= (Interpreter::INITIAL_GP & 0xFFFF0000) && end <= Interpreter::STACK_TOP - Interpreter::STACK_SIZE)
+                    {
+                        heapEnd = std::max(heapEnd, static_cast<uint32_t>((end + 7) & ~uint64_t{ 7 }));
+                    }
+                }
+
+                m_out << HEADER;
+                m_out << "    constexpr bool HAS_HANDLER = " << (m_hasHandler ? "true" : "false") << ";\n";
+                m_out << "    constexpr uint32_t EXCEPTION_HANDLER = " << hex(Interpreter::EXCEPTION_HANDLER) << ";\n";
+                m_out << "    constexpr uint32_t HEAP_END = " << hex(heapEnd) << ";\n";
+                m_out << "    constexpr uint32_t HEAP_TOP = " << hex(Interpreter::STACK_TOP - Interpreter::STACK_SIZE) << ";\n";
+                m_out << "    constexpr uint32_t HEAP_CHUNK = " << hex(Interpreter::HEAP_CHUNK) << ";\n";
+                m_out << RUNTIME << INSTRUCTIONS;
+
+                //the segments, up to their last byte that isn't zero
+                for (size_t s = 0; s < m_memory.Regions().size(); ++s)
+                {
+                    const Memory::Region& region = m_memory.Regions()[s];
+                    std::vector<uint8_t> contents = contents_of(m_memory, region);
+                    uint32_t used = region.m_size;
+                    while (used > 0 && contents[used - 1] == 0) --used;
+                    m_out << "    uint8_t segment_" << s << "[" << region.m_size << "] = {";
+                    for (uint32_t b = 0; b < used; ++b) m_out << (b % 32 == 0 ? "\n        " : " ") << static_cast<unsigned>(contents[b]) << ",";
+                    m_out << (used > 0 ? "\n    };\n" : " };\n");
+                }
+                m_out << "\n";
+
+                for (const CodeRegion& region : m_code)
+                {
+                    for (size_t k = 0; k < region.m_code.size(); ++k)
+                    {
+                        if (region.m_leaders[k]) m_out << "    uint32_t " << block_name(region.m_base + static_cast<uint32_t>(k) * 4) << "();\n";
+                    }
+                }
+                m_out << "\n";
+                for (const CodeRegion& region : m_code)
+                {
+                    for (size_t k = 0; k < region.m_code.size(); ++k)
+                    {
+                        if (region.m_leaders[k]) WriteBlock(region, k);
+                    }
+                }
+                WriteDispatch();
+                m_out << "}\n\n";
+                WriteMain();
+                return m_out.str();
+            }
+        };
+    }
+
+    void write_aot_source(const Memory& memory, const std::vector<uint32_t>& labels, const std::string& path)
+    {
+        if (memory.Endianness() != std::endian::little)
+        {
+            throw Error::RuntimeException("", "Big endian programs can't be translated.");
+        }
+
+        std::string source = Translator(memory).Translate(labels);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.write(source.data(), source.size()))
+        {
+            throw Error::FileWriteException(path, "The output file could not be written.");
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "memory.hpp"
+
+namespace NeoMIPS
+{
+    //Writes a C++ translation unit that runs the program in memory natively once compiled on its own: one
+    //function per basic block, a switch from addresses to blocks for the jumps only known when running, the
+    //segments as arrays and the syscalls and exceptions of the Interpreter. Basic blocks start at the entry
+    //point, at every target of a branch or a jump, after every instruction that ends one and at every label,
+    //so jumps through registers to labels and return addresses land on one. Code can't modify itself
+    void write_aot_source(const Memory& memory, const std::vector<uint32_t>& labels, const std::string& path);
+}
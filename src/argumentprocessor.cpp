@@ -1,3 +1,4 @@
+#include <bit>
 #include <filesystem>
 #include <iostream>
 #include "argumentprocessor.hpp"
@@ -13,27 +14,49 @@ namespace NeoMIPS
 		map.emplace(std::string("maxfreq"), new Option<uint32_t>(0xFFFFFFFF));
 		map.emplace(std::string("interactive"), new Option<bool>(false));
 		map.emplace(std::string("selfmodifyingcode"), new Option<bool>(false));
+		map.emplace(std::string("jit"), new Option<bool>(false));
+		map.emplace(std::string("endianness"), new Option<std::endian>(std::endian::little));
 		map.emplace(std::string("maxmem"), new Option<uint32_t>(0xFFFFFFFF));
 		map.emplace(std::string("memchunksize"), new Option<uint32_t>(0xFFFF));
 		map.emplace(std::string("libs"), new Option<std::vector<std::string>>());
 		map.emplace(std::string("sourcefile"), new Option<std::string>());
+		map.emplace(std::string("stats"), new Option<bool>(false));
+		map.emplace(std::string("cachedir"), new Option<std::string>());
+		map.emplace(std::string("jobs"), new Option<uint32_t>(0));
+		map.emplace(std::string("output"), new Option<std::string>());
+		map.emplace(std::string("aot"), new Option<std::string>());
+		map.emplace(std::string("format"), new Option<OutputFormat>(OutputFormat::binary));
 	}
 
-	void ArgumentProcessor::ReadArguments(int argc, char** argv, argmap_t& argMap)
+	bool ArgumentProcessor::ReadArguments(int argc, char** argv, argmap_t& argMap)
 	{
 		SetDefaultOptions(argMap);
 
-		for (int i = 1; i < argc; ++i)
+		//the value of an option is the argument after it, which is missing when the option is the last one
+		int i = 1;
+		auto next_value = [&]() -> const char*
+		{
+			if (i + 1 >= argc)
+			{
+				std::cerr << "Option " << argv[i] << " needs a value.\n";
+				return nullptr;
+			}
+			return argv[++i];
+		};
+
+		for (; i < argc; ++i)
 		{
 			if (is_arg(argv[i], "-u", "--unicode"))
 			{
-				static_cast<Option<bool>*>(argMap.at(std::string("unicode")).get())->SetValue(true);
+				static_cast<Option<Encoding>*>(argMap.at(std::string("unicode")).get())->SetValue(Encoding::utf32);
 				continue;
 			}
 
 			if (is_arg(argv[i], "-f", "--freq"))
 			{
-				static_cast<Option<uint32_t>*>(argMap.at(std::string("maxfreq")).get())->SetValue(to_integer(argv[++i], IntBase::decimal));
+				const char* value = next_value();
+				if (!value) return false;
+				static_cast<Option<uint32_t>*>(argMap.at(std::string("maxfreq")).get())->SetValue(to_integer(value, IntBase::decimal));
 				continue;
 			}
 
@@ -45,13 +68,65 @@ namespace NeoMIPS
 
 			if (is_arg(argv[i], "--maxmemoryusage"))
 			{
-				static_cast<Option<uint32_t>*>(argMap.at(std::string("maxmem")).get())->SetValue(to_integer(argv[++i], IntBase::any));
+				const char* value = next_value();
+				if (!value) return false;
+				static_cast<Option<uint32_t>*>(argMap.at(std::string("maxmem")).get())->SetValue(to_integer(value, IntBase::any));
 				continue;
 			}
 
 			if (is_arg(argv[i], "--memchunksize"))
 			{
-				static_cast<Option<uint32_t>*>(argMap.at(std::string("memchunksize")).get())->SetValue(to_integer(argv[++i], IntBase::any));
+				const char* value = next_value();
+				if (!value) return false;
+				static_cast<Option<uint32_t>*>(argMap.at(std::string("memchunksize")).get())->SetValue(to_integer(value, IntBase::any));
+				continue;
+			}
+
+			if (is_arg(argv[i], "--stats"))
+			{
+				static_cast<Option<bool>*>(argMap.at(std::string("stats")).get())->SetValue(true);
+				continue;
+			}
+
+			if (is_arg(argv[i], "--cache-dir"))
+			{
+				const char* value = next_value();
+				if (!value) return false;
+				static_cast<Option<std::string>*>(argMap.at(std::string("cachedir")).get())->SetValue(std::string(value));
+				continue;
+			}
+
+			if (is_arg(argv[i], "-j", "--jobs"))
+			{
+				const char* value = next_value();
+				if (!value) return false;
+				static_cast<Option<uint32_t>*>(argMap.at(std::string("jobs")).get())->SetValue(to_integer(value, IntBase::decimal));
+				continue;
+			}
+
+			if (is_arg(argv[i], "-o", "--output"))
+			{
+				const char* value = next_value();
+				if (!value) return false;
+				static_cast<Option<std::string>*>(argMap.at(std::string("output")).get())->SetValue(std::string(value));
+				continue;
+			}
+
+			if (is_arg(argv[i], "--format"))
+			{
+				const char* value = next_value();
+				if (!value) return false;
+				if (is_arg(value, "elf")) static_cast<Option<OutputFormat>*>(argMap.at(std::string("format")).get())->SetValue(OutputFormat::elf);
+				else if (is_arg(value, "bin")) static_cast<Option<OutputFormat>*>(argMap.at(std::string("format")).get())->SetValue(OutputFormat::binary);
+				else std::cerr << "Unknown output format " << value << ", it can be bin or elf.\n";
+				continue;
+			}
+
+			if (is_arg(argv[i], "-l", "--lib"))
+			{
+				const char* value = next_value();
+				if (!value) return false;
+				static_cast<Option<std::vector<std::string>>*>(argMap.at(std::string("libs")).get())->GetValue().emplace_back(value);
 				continue;
 			}
 
@@ -61,7 +136,37 @@ namespace NeoMIPS
 				continue;
 			}
 
-			static_cast<Option<std::string>*>(argMap.at(std::string("sourcefile")).get())->SetValue(std::string(argv[i]));
+			if (is_arg(argv[i], "--jit"))
+			{
+				static_cast<Option<bool>*>(argMap.at(std::string("jit")).get())->SetValue(true);
+				continue;
+			}
+
+			//byte order the program is assembled in, which picks the interpreter run for it
+			if (is_arg(argv[i], "--endianness"))
+			{
+				const char* value = next_value();
+				if (!value) return false;
+				if (is_arg(value, "little")) static_cast<Option<std::endian>*>(argMap.at(std::string("endianness")).get())->SetValue(std::endian::little);
+				else if (is_arg(value, "big")) static_cast<Option<std::endian>*>(argMap.at(std::string("endianness")).get())->SetValue(std::endian::big);
+				else std::cerr << "Unknown endianness " << value << ", it can be little or big.\n";
+				continue;
+			}
+
+			//translates the program to a C++ file instead of running it
+			if (is_arg(argv[i], "--aot"))
+			{
+				const char* value = next_value();
+				if (!value) return false;
+				static_cast<Option<std::string>*>(argMap.at(std::string("aot")).get())->SetValue(std::string(value));
+				continue;
+			}
+
+			//the first file is the program, any other one is assembled and linked with it as a library
+			auto sourceFile = static_cast<Option<std::string>*>(argMap.at(std::string("sourcefile")).get());
+			if (sourceFile->GetValue().empty()) sourceFile->SetValue(std::string(argv[i]));
+			else static_cast<Option<std::vector<std::string>>*>(argMap.at(std::string("libs")).get())->GetValue().emplace_back(argv[i]);
 		}
+		return true;
 	}
 }
\ No newline at end of file
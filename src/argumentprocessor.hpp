@@ -20,6 +20,7 @@ namespace NeoMIPS
 	{
 		static void SetDefaultOptions(argmap_t& map);
 	public:
-		static void ReadArguments(int argc, char** argv, argmap_t& argMap);
+		//Fills argMap from the command line, false if it is malformed after reporting why
+		static bool ReadArguments(int argc, char** argv, argmap_t& argMap);
 	};
 }
\ No newline at end of file
@@ -75,6 +75,34 @@ namespace NeoMIPS
 
 			InvalidEscapeSequenceException(const std::string& where, const std::string& why) : NeoMIPSException("InvalidEscapeSequenceException", where, why) {}
 		};
+
+		class LinkException : public NeoMIPSException
+		{
+		public:
+
+			LinkException(const std::string& where, const std::string& why) : NeoMIPSException("LinkException", where, why) {}
+		};
+
+		class FileWriteException : public NeoMIPSException
+		{
+		public:
+
+			FileWriteException(const std::string& where, const std::string& why) : NeoMIPSException("FileWriteException", where, why) {}
+		};
+
+		class MemoryException : public NeoMIPSException
+		{
+		public:
+
+			MemoryException(const std::string& where, const std::string& why) : NeoMIPSException("MemoryException", where, why) {}
+		};
+
+		class RuntimeException : public NeoMIPSException
+		{
+		public:
+
+			RuntimeException(const std::string& where, const std::string& why) : NeoMIPSException("RuntimeException", where, why) {}
+		};
 		
 	}
 }
\ No newline at end of file
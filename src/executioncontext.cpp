@@ -1,22 +1,206 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
 #include "executioncontext.hpp"
 #include "argumentprocessor.hpp"
 #include "lexer.hpp"
+#include "Preprocessor.hpp"
+#include "tokencache.hpp"
 #include "filereader.hpp"
+#include "jobpool.hpp"
+#include "linker.hpp"
+#include "objectfile.hpp"
+#include "memory.hpp"
+#include "interpreter.hpp"
+#include "aot.hpp"
 
 namespace NeoMIPS
 {
-    void ExecutionContext::Run()
+    int ExecutionContext::Run()
     {
         try
         {
-            std::unique_ptr<std::u32string> code(FileReader::ReadWithEncoding(GetSourcePath()));
-            Lexer lexer(m_options);
-            lexer.Tokenize(*code.get());
+            Memory memory(GetMemoryChunkSize(), GetMaxMemory());
+            std::vector<uint32_t> labels;
+            bool mapped = is_flat_image(GetSourcePath());
+            if (mapped)
+            {
+                //a program assembled before with -o is mapped as it is, nothing is read, lexed or encoded
+                auto start = std::chrono::steady_clock::now();
+                memory.MapImage(GetSourcePath());
+                if (!GetLibraries().empty()) std::cerr << "Libraries are ignored when running an image, they were linked into it.\n";
+                if (GetPrintStatistics())
+                {
+                    double mapSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    std::cout << "Mapped " << memory.Regions().size() << " segments of the image in " << mapSeconds * 1000.0 << " ms\n";
+                }
+            }
+            else
+            {
+                std::vector<std::string> paths{ GetSourcePath() };
+                paths.insert(paths.end(), GetLibraries().begin(), GetLibraries().end());
+
+                //-u lexes a fully decoded UTF-32 copy of the sources, the default lexes the UTF-8 bytes as they are
+                Program program = GetEncoding() == Encoding::utf32 ? Assemble<char32_t>(paths) : Assemble<char8_t>(paths);
+                memory.Load(program);
+                for (const ProgramSymbol& symbol : program.m_symbols) labels.push_back(symbol.m_address);
+            }
+
+            //--aot writes the program out as C++ to build natively instead, an image has no labels to start blocks at
+            if (!GetAotPath().empty())
+            {
+                write_aot_source(memory, labels, GetAotPath());
+                return 0;
+            }
+
+            //-o only assembles, the image is run later
+            if (!mapped && !GetOutputPath().empty()) return 0;
+
+            Interpreter interpreter(memory, GetSelfModifyingCode(), GetMaxFrequency(), GetJit());
+            auto start = std::chrono::steady_clock::now();
+            int exitCode = interpreter.Run();
+            if (GetPrintStatistics())
+            {
+                double runSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << "\nExecuted " << interpreter.Executed() << " instructions in " << runSeconds * 1000.0 << " ms, "
+                    << (runSeconds > 0 ? interpreter.Executed() / runSeconds / 1e6 : 0) << " MIPS\n";
+                if (memory.IsFlat()) std::cout << "Reserved " << memory.Resident() << " bytes of flat memory\n";
+                else std::cout << "Allocated " << memory.Resident() << " bytes of memory in chunks of " << memory.ChunkSize() << " bytes\n";
+                std::cout << "Decoded " << interpreter.DecodedBlocks() << " basic blocks, " << interpreter.InvalidatedWords() << " words invalidated by stores into code\n";
+                if (GetJit()) std::cout << "Translated " << interpreter.TranslatedBlocks() << " hot blocks, linked " << interpreter.LinkedExits() << " of their exits, entered native code " << interpreter.NativeEntries() << " times\n";
+                for (const auto& [idiom, count] : interpreter.Fusions())
+                {
+                    if (count != 0) std::cout << "Fused " << idiom << " " << count << " times\n";
+                }
+            }
+            return exitCode;
         }
         catch (Error::NeoMIPSException e)
         {
+            //errors of the whole run, like an option out of range, have no location
+            std::cerr << e.m_what << (e.m_where.empty() ? "" : " at " + e.m_where) << ": " << e.m_why << "\n";
+            return 1;
+        }
+    }
+
+    template<Char C>
+    Program ExecutionContext::Assemble(const std::vector<std::string>& paths)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::unique_ptr<TranslationUnit<C>>> units;
+        for (const std::string& path : paths)
+        {
+            units.emplace_back(new TranslationUnit<C>(path));
+        }
 
+        //every unit is loaded, preprocessed, lexed and measured on its own, then they are linked in the order
+        //they were given and encoded on their own again
+        JobPool pool(GetJobs());
+        for (auto& unit : units)
+        {
+            pool.Submit([this, &unit] { Load(*unit); });
         }
+        pool.Wait();
+
+        auto loaded = std::chrono::steady_clock::now();
+
+        Linker<C> linker(GetEndianness());
+        linker.Link(units);
+
+        auto linked = std::chrono::steady_clock::now();
+
+        for (auto& unit : units)
+        {
+            pool.Submit([&linker, &unit] { linker.Encode(*unit); });
+        }
+        pool.Wait();
+
+        //taken before the output is written, which is I/O and not part of encoding
+        auto encoded = std::chrono::steady_clock::now();
+
+        Program program = linker.Emit(units);
+        if (!GetOutputPath().empty())
+        {
+            if (GetOutputFormat() == OutputFormat::elf) write_elf(program, GetOutputPath());
+            else write_flat_image(program, GetOutputPath());
+        }
+
+        if (GetPrintStatistics())
+        {
+            size_t lines = 0, tokens = 0, words = 0, cached = 0;
+            uint64_t allocations = 0;
+            for (auto& unit : units)
+            {
+                if (unit->m_cached) ++cached;
+                else PrintLoadStatistics(unit->m_path, unit->m_loadStatistics);
+                lines += unit->m_lines.LineCount();
+                tokens += unit->m_tokens.Size();
+                allocations += unit->m_tokens.Allocations();
+                words += unit->m_text.size() + unit->m_ktext.size();
+            }
+
+            IncludeCache<C>& includeCache = std::get<IncludeCache<C>>(m_includeCaches);
+            double loadSeconds = std::chrono::duration<double>(loaded - start).count();
+            double linkSeconds = std::chrono::duration<double>(linked - loaded).count();
+            double encodeSeconds = std::chrono::duration<double>(encoded - linked).count();
+            std::cout << "Preprocessed and lexed " << units.size() << " files (" << cached << " from the token cache), " << lines << " lines, "
+                << tokens << " tokens in " << loadSeconds * 1000.0 << " ms, " << (loadSeconds > 0 ? lines / loadSeconds : 0) << " lines/s\n";
+            std::cout << "Stored the tokens with " << allocations << " allocations, " << (lines > 0 ? allocations * 10000.0 / lines : 0) << " per 10k lines\n";
+            std::cout << "Include cache " << includeCache.Hits() << " hits, " << includeCache.Misses() << " misses\n";
+            std::cout << "Linked " << linker.GlobalCount() << " global labels in " << linkSeconds * 1000.0 << " ms\n";
+            std::cout << "Encoded " << words << " instructions in " << encodeSeconds * 1000.0 << " ms, " << (encodeSeconds > 0 ? words / encodeSeconds : 0) << " words/s\n";
+            std::cout << "Laid out " << program.m_images[static_cast<size_t>(Segment::Text)].size() << " bytes of .text, "
+                << program.m_images[static_cast<size_t>(Segment::Data)].size() << " of .data and " << program.m_symbols.size() << " symbols\n";
+            std::cout << "Used " << pool.Size() << " threads, " << pool.Steals() << " jobs stolen\n";
+        }
+        return program;
+    }
+
+    template<Char C>
+    void ExecutionContext::Load(TranslationUnit<C>& unit)
+    {
+        std::optional<TokenCache<C>> tokenCache;
+        if (!GetCacheDirectory().empty()) tokenCache.emplace(GetCacheDirectory());
+
+        typename TokenCache<C>::Entry cached;
+        if (tokenCache && tokenCache->Load(unit.m_path, cached))
+        {
+            unit.m_lines = LineIndex(std::basic_string_view<C>(cached.m_source), std::move(cached.m_lines));
+            unit.m_tokens = std::move(cached.m_tokens);
+            unit.m_cached = true;
+        }
+        else
+        {
+            //UTF-8 is preprocessed straight from the mapped file, which is unmapped once it is done
+            std::optional<SourceFile<C>> code(std::in_place, unit.m_path, &unit.m_loadStatistics);
+            Preprocessor<C> preprocessor(&std::get<IncludeCache<C>>(m_includeCaches), unit.m_path);
+            std::basic_string<C> source = preprocessor.Preprocess(code->View());
+            code.reset();
+
+            Lexer lexer(m_options);
+            unit.m_tokens = lexer.Tokenize(source, preprocessor.ReleaseLines());
+            unit.m_lines = lexer.ReleaseLines();
+
+            //the tokens own their labels and strings, so the source is freed with this scope
+            if (tokenCache && !tokenCache->Store(unit.m_path, preprocessor.Dependencies(), source, unit.m_lines.Map(), unit.m_tokens) && GetPrintStatistics())
+            {
+                std::cout << "The tokens of " + unit.m_path + " can't be cached\n";
+            }
+        }
+
+        Linker<C>::Measure(unit, GetEndianness());
+    }
+
+    void ExecutionContext::PrintLoadStatistics(const std::string& path, const LoadStatistics& statistics)
+    {
+        if (!GetPrintStatistics()) return;
+
+        std::cout << "Loaded " << path << ": " << statistics.m_bytes << " bytes, "
+            << statistics.m_codePoints << " code points" << (statistics.m_ascii ? " (ASCII)" : "")
+            << " in " << statistics.m_seconds * 1000.0 << " ms, " << statistics.ThroughputMiBps() << " MiB/s\n";
     }
 
 }
\ No newline at end of file
@@ -1,15 +1,26 @@
 #pragma once
 #include "constraints.hpp"
 #include "argumentprocessor.hpp"
+#include "filereader.hpp"
+#include "includecache.hpp"
+#include "linker.hpp"
+#include <bit>
+#include <tuple>
 namespace NeoMIPS
 {
 	class ExecutionContext
 	{
 		const argmap_t& m_options;
+		std::tuple<IncludeCache<char8_t>, IncludeCache<char32_t>> m_includeCaches; //one per source encoding, shared by every file of the run
 
 	public:
 		inline ExecutionContext(const argmap_t& options) : m_options(options) {}
-		void Run();
+		//Assembles or maps the program and runs it, returns its exit code
+		int Run();
+		//Assembles and links the files, writes the program to the output file if there is one and returns it
+		template<Char C> Program Assemble(const std::vector<std::string>& paths);
+		template<Char C> void Load(TranslationUnit<C>& unit);
+		void PrintLoadStatistics(const std::string& path, const LoadStatistics& statistics);
 
 		//Shorthands
 
@@ -17,5 +28,75 @@ namespace NeoMIPS
 		{
 			return static_cast<Option<std::string>*>(m_options.at(std::string("sourcefile")).get())->GetValue();
 		}
+
+		inline std::vector<std::string>& GetLibraries()
+		{
+			return static_cast<Option<std::vector<std::string>>*>(m_options.at(std::string("libs")).get())->GetValue();
+		}
+
+		inline uint32_t GetJobs()
+		{
+			return static_cast<Option<uint32_t>*>(m_options.at(std::string("jobs")).get())->GetValue();
+		}
+
+		inline Encoding GetEncoding()
+		{
+			return static_cast<Option<Encoding>*>(m_options.at(std::string("unicode")).get())->GetValue();
+		}
+
+		inline uint32_t GetMaxFrequency()
+		{
+			return static_cast<Option<uint32_t>*>(m_options.at(std::string("maxfreq")).get())->GetValue();
+		}
+
+		inline bool GetSelfModifyingCode()
+		{
+			return static_cast<Option<bool>*>(m_options.at(std::string("selfmodifyingcode")).get())->GetValue();
+		}
+
+		inline uint32_t GetMaxMemory()
+		{
+			return static_cast<Option<uint32_t>*>(m_options.at(std::string("maxmem")).get())->GetValue();
+		}
+
+		inline uint32_t GetMemoryChunkSize()
+		{
+			return static_cast<Option<uint32_t>*>(m_options.at(std::string("memchunksize")).get())->GetValue();
+		}
+
+		inline bool GetJit()
+		{
+			return static_cast<Option<bool>*>(m_options.at(std::string("jit")).get())->GetValue();
+		}
+
+		inline std::endian GetEndianness()
+		{
+			return static_cast<Option<std::endian>*>(m_options.at(std::string("endianness")).get())->GetValue();
+		}
+
+		inline bool GetPrintStatistics()
+		{
+			return static_cast<Option<bool>*>(m_options.at(std::string("stats")).get())->GetValue();
+		}
+
+		inline std::string GetOutputPath()
+		{
+			return static_cast<Option<std::string>*>(m_options.at(std::string("output")).get())->GetValue();
+		}
+
+		inline std::string GetAotPath()
+		{
+			return static_cast<Option<std::string>*>(m_options.at(std::string("aot")).get())->GetValue();
+		}
+
+		inline OutputFormat GetOutputFormat()
+		{
+			return static_cast<Option<OutputFormat>*>(m_options.at(std::string("format")).get())->GetValue();
+		}
+
+		inline std::string GetCacheDirectory()
+		{
+			return static_cast<Option<std::string>*>(m_options.at(std::string("cachedir")).get())->GetValue();
+		}
 	};
 }
@@ -1,42 +1,133 @@
 #include <string>
-#include <filesystem>
 #include <fstream>
 #include <istream>
-#include <codecvt>
-#include <locale>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include "error.hpp"
 #include "filereader.hpp"
+#include "utf8.hpp"
 
-std::u32string* NeoMIPS::FileReader::ReadWithEncoding(const std::string& path)
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+NeoMIPS::MappedFile::MappedFile(const std::string& path) : m_data(nullptr), m_size(0), m_mapped(false)
 {
-    if (!std::filesystem::exists(path))
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good())
+    {
+        throw Error::FileNotFoundException("", std::string("File \"").append(path).append("\" does not exist."));
+    }
+    m_size = static_cast<size_t>(file.tellg());
+    char8_t* buffer = new char8_t[m_size + 1];
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer), m_size))
+    {
+        delete[] buffer;
+        throw Error::FileReadException("", std::string("Could not read input file!"));
+    }
+    m_data = buffer;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
     {
         throw Error::FileNotFoundException("", std::string("File \"").append(path).append("\" does not exist."));
     }
 
-    std::ifstream file(path, std::ios::binary);
-    if (!file.good())
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
     {
+        close(fd);
         throw Error::FileReadException("", std::string("Could not read input file!"));
     }
 
-    file.imbue(std::locale("en_US.UTF8"));
-    std::u8string sourceEncodingStr{};
-    std::u32string* destEncodingStr = new std::u32string();
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size != 0)
+    {
+        void* map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            close(fd);
+            throw Error::FileReadException("", std::string("Could not map input file \"").append(path).append("\" into memory."));
+        }
+        madvise(map, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char8_t*>(map);
+        m_mapped = true;
+    }
+    close(fd);
+#endif
+}
+
+NeoMIPS::MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    delete[] m_data;
+#else
+    if (m_mapped) munmap(const_cast<char8_t*>(m_data), m_size);
+#endif
+}
+
+std::u32string* NeoMIPS::FileReader::ReadWithEncoding(const std::string& path, LoadStatistics* statistics)
+{
+    auto start = std::chrono::steady_clock::now();
 
-    sourceEncodingStr.resize(std::filesystem::file_size(path));
-    destEncodingStr->resize(std::filesystem::file_size(path));
+    MappedFile file(path);
+    std::u8string_view bytes = file.Text();
 
-    file.read((char*)sourceEncodingStr.data(), std::filesystem::file_size(path));
+    std::u32string* destEncodingStr = new std::u32string();
+    bool ascii = Utf8::is_ascii(bytes.data(), bytes.size());
+    if (ascii)
+    {
+        destEncodingStr->resize(bytes.size());
+        Utf8::widen_ascii(bytes.data(), bytes.size(), destEncodingStr->data());
+    }
+    else
+    {
+        destEncodingStr->resize(Utf8::count_code_points(bytes.data(), bytes.size()));
+        if (Utf8::decode(bytes.data(), bytes.size(), destEncodingStr->data()) != destEncodingStr->size())
+        {
+            delete destEncodingStr;
+            throw Error::EncodingTranslationException("", std::string("Failed to convert input from UTF-8 to UTF-32"));
+        }
+    }
 
-    auto& facet = std::use_facet<std::codecvt<char32_t, char8_t, std::mbstate_t>>(std::locale("en_US.UTF8"));
-    std::mbstate_t state{};
-    const char8_t* from_next{};
-    char32_t* to_next;
-    if (facet.in(state, sourceEncodingStr.data(), &sourceEncodingStr.data()[sourceEncodingStr.size()], from_next, destEncodingStr->data(), &destEncodingStr->data()[destEncodingStr->size() - 1], to_next) != std::codecvt_base::ok)
+    if (statistics)
     {
-        throw Error::EncodingTranslationException("", std::string("Failed to convert input from UTF-8 to UTF-32"));
+        statistics->m_bytes = file.Size();
+        statistics->m_codePoints = destEncodingStr->size();
+        statistics->m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        statistics->m_ascii = ascii;
     }
 
     return destEncodingStr;
+}
+
+
+NeoMIPS::MappedFile* NeoMIPS::FileReader::Read(const std::string& path, LoadStatistics* statistics)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<MappedFile> file(new MappedFile(path));
+    std::u8string_view bytes = file->Text();
+
+    bool ascii = Utf8::is_ascii(bytes.data(), bytes.size());
+    if (!ascii && !Utf8::validate(bytes.data(), bytes.size()))
+    {
+        throw Error::EncodingTranslationException("", std::string("File \"").append(path).append("\" is not valid UTF-8"));
+    }
+
+    if (statistics)
+    {
+        statistics->m_bytes = file->Size();
+        statistics->m_codePoints = ascii ? bytes.size() : Utf8::count_code_points(bytes.data(), bytes.size());
+        statistics->m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        statistics->m_ascii = ascii;
+    }
+
+    return file.release();
 }
\ No newline at end of file
@@ -1,13 +1,79 @@
 #pragma once
 #include <string>
-//#include "filereader.hpp"
+#include <string_view>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include "constraints.hpp"
 
 namespace NeoMIPS
 {
+    //Read-only view of a whole file. On POSIX systems the file is memory mapped, elsewhere it is read into memory
+    class MappedFile
+    {
+        const char8_t* m_data;
+        size_t m_size;
+        bool m_mapped;
+
+    public:
+        explicit MappedFile(const std::string& path);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        inline std::u8string_view View() const { return std::u8string_view(m_data, m_size); }
+        inline size_t Size() const { return m_size; }
+
+        //The content without the byte order mark some editors insert
+        inline std::u8string_view Text() const
+        {
+            std::u8string_view text = View();
+            if (text.starts_with(u8"\xEF\xBB\xBF")) text.remove_prefix(3);
+            return text;
+        }
+    };
+
+    struct LoadStatistics
+    {
+        uint64_t m_bytes;
+        uint64_t m_codePoints;
+        double m_seconds;
+        bool m_ascii;
+
+        inline double ThroughputMiBps() const
+        {
+            return m_seconds > 0 ? m_bytes / m_seconds / (1024.0 * 1024.0) : 0;
+        }
+    };
+
     class FileReader
     {
     public:
-        static std::u32string* ReadWithEncoding(const std::string& path);
+        static std::u32string* ReadWithEncoding(const std::string& path, LoadStatistics* statistics = nullptr);
+        //Validates the file as UTF-8 and returns its mapping, the bytes are preprocessed from it as they are
+        static MappedFile* Read(const std::string& path, LoadStatistics* statistics = nullptr);
+    };
+
+    //Source file in the code units it is preprocessed in. UTF-8 is a view of the mapped file, nothing is copied
+    //as the preprocessor writes its own buffer anyway, UTF-32 is a decoded copy
+    template<Char C>
+    class SourceFile
+    {
+        std::unique_ptr<MappedFile> m_mapped;
+        std::unique_ptr<std::u32string> m_decoded;
+
+    public:
+        explicit SourceFile(const std::string& path, LoadStatistics* statistics = nullptr)
+        {
+            if constexpr (std::is_same_v<C, char8_t>) m_mapped.reset(FileReader::Read(path, statistics));
+            else m_decoded.reset(FileReader::ReadWithEncoding(path, statistics));
+        }
+
+        std::basic_string_view<C> View() const
+        {
+            if constexpr (std::is_same_v<C, char8_t>) return m_mapped->Text();
+            else return *m_decoded;
+        }
     };
 
 
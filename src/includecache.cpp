@@ -0,0 +1,59 @@
+#include <memory>
+#include <type_traits>
+#include "includecache.hpp"
+#include "filereader.hpp"
+#include "util.hpp"
+
+namespace NeoMIPS
+{
+    std::string canonical_path(const std::string& path)
+    {
+        std::error_code error;
+        std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+        return error ? path : canonical.string();
+    }
+
+    template<Char C>
+    typename IncludeCache<C>::file_ptr IncludeCache<C>::Get(const std::string& canonicalPath, const producer_t& produce)
+    {
+        std::error_code error;
+        std::filesystem::file_time_type modified = std::filesystem::last_write_time(canonicalPath, error);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto entry = m_entries.find(canonicalPath);
+            if (!error && entry != m_entries.end() && entry->second.m_modified == modified)
+            {
+                ++m_hits;
+                return entry->second.m_file;
+            }
+        }
+
+        SourceFile<C> content(canonicalPath);
+        uint64_t hash = hash_bytes(content.View().data(), content.View().size() * sizeof(C));
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto entry = m_entries.find(canonicalPath);
+            if (entry != m_entries.end() && entry->second.m_hash == hash)
+            {
+                entry->second.m_modified = modified; //touched but not edited
+                ++m_hits;
+                return entry->second.m_file;
+            }
+        }
+
+        //the lock is not held while preprocessing, the file may include others that go through the cache too
+        ++m_misses;
+        file_ptr file = produce(content.View());
+        if (!file->m_contextDependent && !error)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_entries.insert_or_assign(canonicalPath, Entry{ modified, hash, file });
+        }
+        return file;
+    }
+
+    template class IncludeCache<char8_t>;
+    template class IncludeCache<char32_t>;
+}
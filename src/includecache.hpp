@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "constraints.hpp"
+#include "types.hpp"
+#include "lineindex.hpp"
+
+namespace NeoMIPS
+{
+    //Lets symbol tables be searched with a view of the source, without building a string for every word
+    template<Char C>
+    struct ViewHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::basic_string_view<C> str) const { return std::hash<std::basic_string_view<C>>{}(str); }
+    };
+
+    template<Char C, typename T>
+    using symbol_table = std::unordered_map<std::basic_string<C>, T, ViewHash<C>, std::equal_to<>>;
+
+    //Result of preprocessing one file on its own: its text plus the .eqv and .macro definitions it leaves behind
+    //for the file that includes it
+    template<Char C>
+    struct PreprocessedFile
+    {
+        std::basic_string<C> m_output;
+        LineMap m_lines; //of the output back to this file and the ones it includes, wherever it is spliced
+        symbol_table<C, std::basic_string<C>> m_eqvs;
+        symbol_table<C, std::vector<BasicMacroDeclaration<C>>> m_macros; //overloads by number of parameters
+        std::vector<std::string> m_dependencies; //canonical paths of the files it includes, directly or not
+        bool m_contextDependent = false; //used definitions made before it was included, so it can't be reused
+    };
+
+    //Preprocessed files shared by every translation unit of a run, so a library included from many places is
+    //read and preprocessed once. Entries are keyed by canonical path, they are reused while the modification
+    //time is unchanged, and when it changed they are still reused if the content hashes the same
+    template<Char C>
+    class IncludeCache
+    {
+    public:
+        using file_ptr = std::shared_ptr<const PreprocessedFile<C>>;
+        using producer_t = std::function<file_ptr(std::basic_string_view<C>)>;
+
+    private:
+        struct Entry
+        {
+            std::filesystem::file_time_type m_modified;
+            uint64_t m_hash;
+            file_ptr m_file;
+        };
+
+        std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+        std::atomic<uint64_t> m_hits;
+        std::atomic<uint64_t> m_misses;
+
+    public:
+        IncludeCache() : m_hits(0), m_misses(0) {};
+
+        //Returns the preprocessed file at canonicalPath, calling produce on its content when nothing usable is cached
+        file_ptr Get(const std::string& canonicalPath, const producer_t& produce);
+
+        uint64_t Hits() const { return m_hits; }
+        uint64_t Misses() const { return m_misses; }
+    };
+
+    //Canonical form of a path for the include cache and for detecting files that include themselves
+    std::string canonical_path(const std::string& path);
+}
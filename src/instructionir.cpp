@@ -0,0 +1,111 @@
+#include "instructionir.hpp"
+#include "isadescription.hpp"
+#include "token.hpp"
+
+namespace NeoMIPS
+{
+    void InstructionIR::Reserve(size_t instructions)
+    {
+        m_instructions.reserve(instructions);
+        m_reg1.reserve(instructions);
+        m_reg2.reserve(instructions);
+        m_reg3.reserve(instructions);
+        m_immediates.reserve(instructions);
+        m_offsets.reserve(instructions);
+        m_labels.reserve(instructions);
+        m_relocations.reserve(instructions);
+    }
+
+    void InstructionIR::Append(const InstructionTokenBase& token)
+    {
+        const InstructionParameters& parameters = token.m_parameters;
+        m_instructions.push_back(token.GetInstruction());
+        m_reg1.push_back(static_cast<uint8_t>(parameters.m_reg1));
+        m_reg2.push_back(static_cast<uint8_t>(parameters.m_reg2));
+        m_reg3.push_back(static_cast<uint8_t>(parameters.m_reg3));
+        m_immediates.push_back(parameters.m_immediate);
+        m_offsets.push_back(parameters.m_offset);
+        m_relocations.push_back(ISA::describe(token.GetInstruction()).m_relocation);
+
+        if (parameters.m_label == NeoMIPS::NO_LABEL)
+        {
+            m_labels.push_back(NO_LABEL);
+            return;
+        }
+        auto [index, added] = m_labelIndices.emplace(parameters.m_label, static_cast<uint32_t>(m_labelIds.size()));
+        if (added)
+        {
+            m_labelIds.push_back(parameters.m_label);
+            m_labelPositions.push_back(token.m_position);
+        }
+        m_labels.push_back(index->second);
+
+        //The expansions of la and of loads and stores of a label put the upper half in $at with a lui. Loads,
+        //stores and addi sign extend the lower half, so the upper half of their lui has to be rounded up
+        switch (m_relocations.back())
+        {
+        case ISA::Relocation::High:
+            m_pendingHigh = m_instructions.size() - 1;
+            break;
+        case ISA::Relocation::Absolute:
+            if (m_pendingHigh != NO_HIGH && m_labels[m_pendingHigh] == index->second)
+            {
+                m_relocations[m_pendingHigh] = ISA::Relocation::HighAdjusted;
+            }
+            m_pendingHigh = NO_HIGH;
+            break;
+        default:
+            m_pendingHigh = NO_HIGH;
+            break;
+        }
+    }
+
+    void InstructionIR::Pad(size_t words)
+    {
+        m_instructions.insert(m_instructions.end(), words, ISA::Instruction::NOP);
+        m_reg1.insert(m_reg1.end(), words, 0);
+        m_reg2.insert(m_reg2.end(), words, 0);
+        m_reg3.insert(m_reg3.end(), words, 0);
+        m_immediates.insert(m_immediates.end(), words, 0);
+        m_offsets.insert(m_offsets.end(), words, 0);
+        m_labels.insert(m_labels.end(), words, NO_LABEL);
+        m_relocations.insert(m_relocations.end(), words, ISA::Relocation::Absolute);
+    }
+
+    void InstructionIR::Encode(const std::vector<uint32_t>& labelAddresses, uint32_t base, uint32_t* out) const
+    {
+        //relocate the labels first, so the encoding itself is one pass of the batch kernel
+        std::vector<uint32_t> addresses(m_offsets);
+        std::vector<uint32_t> immediates(m_immediates);
+        uint32_t address = base;
+        for (size_t i = 0; i < m_instructions.size(); ++i, address += 4)
+        {
+            if (m_labels[i] == NO_LABEL) continue;
+
+            uint32_t target = labelAddresses[m_labels[i]];
+            switch (m_relocations[i])
+            {
+            case ISA::Relocation::Absolute:
+                addresses[i] += target;
+                break;
+            case ISA::Relocation::Branch:
+                addresses[i] += (target - (address + 4)) >> 2;
+                break;
+            case ISA::Relocation::Jump:
+                addresses[i] += (target >> 2) & 0x03FFFFFF;
+                break;
+            case ISA::Relocation::High:
+                immediates[i] = (target + immediates[i]) >> 16;
+                break;
+            case ISA::Relocation::HighAdjusted:
+                immediates[i] = (target + immediates[i] + 0x8000) >> 16;
+                break;
+            case ISA::Relocation::Low:
+                immediates[i] = (target + immediates[i]) & 0xFFFF;
+                break;
+            }
+        }
+
+        ISA::encode_batch(m_instructions.data(), m_reg1.data(), m_reg2.data(), m_reg3.data(), immediates.data(), addresses.data(), m_instructions.size(), out);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "isadescription.hpp"
+#include "mips32isa.hpp"
+#include "types.hpp"
+
+namespace NeoMIPS
+{
+    class InstructionTokenBase;
+
+    //Instructions of one segment in struct of arrays form, one entry per machine word in program order.
+    //Encoding walks these arrays in a single loop through the batch kernel of the ISA description, instead
+    //of making a virtual call on a separately allocated token per instruction
+    class InstructionIR
+    {
+    public:
+        static constexpr uint32_t NO_LABEL = 0xFFFFFFFF;
+
+    private:
+        static constexpr size_t NO_HIGH = SIZE_MAX;
+
+    private:
+        std::vector<ISA::Instruction> m_instructions;
+        std::vector<uint8_t> m_reg1;
+        std::vector<uint8_t> m_reg2;
+        std::vector<uint8_t> m_reg3;
+        std::vector<uint32_t> m_immediates;
+        std::vector<uint32_t> m_offsets;
+        std::vector<uint32_t> m_labels; //index into m_labelIds or NO_LABEL
+        std::vector<ISA::Relocation> m_relocations;
+        size_t m_pendingHigh = NO_HIGH; //last lui of a label, until the instruction that takes the lower half
+
+        std::vector<uint32_t> m_labelIds;
+        std::vector<uint32_t> m_labelPositions; //source position of the first use of each label, for errors
+        std::unordered_map<uint32_t, uint32_t> m_labelIndices; //from label ID to index into m_labelIds
+
+    public:
+        void Reserve(size_t instructions);
+        void Append(const InstructionTokenBase& token);
+        //Fills words of the segment that hold no instruction, like the gap left by .align or by a segment
+        //directive with an address further on, with nops
+        void Pad(size_t words);
+
+        size_t Size() const { return m_instructions.size(); }
+        ISA::Instruction GetInstruction(size_t index) const { return m_instructions[index]; }
+
+        //IDs of the labels used by the instructions, each one once. Encode takes their addresses in the same order
+        const std::vector<uint32_t>& Labels() const { return m_labelIds; }
+        uint32_t LabelPosition(uint32_t label) const { return m_labelPositions[label]; }
+
+        //Encodes every instruction into out, which must hold Size() words. base is the address of the first
+        //instruction, labelAddresses has the address of every label in Labels()
+        void Encode(const std::vector<uint32_t>& labelAddresses, uint32_t base, uint32_t* out) const;
+    };
+}
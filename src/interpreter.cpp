@@ -0,0 +1,1207 @@
+#include <algorithm>
+#include <bit>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include "interpreter.hpp"
+#include "jit.hpp"
+#include "util.hpp"
+#include "error.hpp"
+
+//Handlers are chained with computed gotos where the compiler has labels as values, and with a switch elsewhere.
+//Labels as values are an extension, so -Wpedantic is quiet about them in this file
+#if defined(__GNUC__)
+#define NEOMIPS_THREADED
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+//Superinstructions: name, how many instructions they run and the idiom they stand for. The first one of the
+//idiom becomes the superinstruction, the others keep their own entries so jumps into the middle still work
+#define NEOMIPS_SUPERINSTRUCTIONS(X) \
+    X(LI, 2, "lui+ori") \
+    X(LI_ADD, 3, "lui+ori+add") X(LI_ADDU, 3, "lui+ori+addu") X(LI_SUB, 3, "lui+ori+sub") X(LI_SUBU, 3, "lui+ori+subu") \
+    X(LI_AND, 3, "lui+ori+and") X(LI_OR, 3, "lui+ori+or") X(LI_XOR, 3, "lui+ori+xor") X(LI_SLT, 3, "lui+ori+slt") X(LI_SLTU, 3, "lui+ori+sltu") \
+    X(LUI_LW, 2, "lui+lw") X(LUI_LB, 2, "lui+lb") X(LUI_LBU, 2, "lui+lbu") X(LUI_SW, 2, "lui+sw") X(LUI_SB, 2, "lui+sb") \
+    X(SLT_BNE, 2, "slt+bne") X(SLT_BEQ, 2, "slt+beq") X(SLTU_BNE, 2, "sltu+bne") X(SLTU_BEQ, 2, "sltu+beq") \
+    X(SLTI_BNE, 2, "slti+bne") X(SLTI_BEQ, 2, "slti+beq") X(SLTIU_BNE, 2, "sltiu+bne") X(SLTIU_BEQ, 2, "sltiu+beq") \
+    X(ADDIU_BNE, 2, "addiu+bne")
+
+namespace NeoMIPS
+{
+    namespace
+    {
+        //Handlers of the instructions share their numbers, the ones only the interpreter has come after them
+        enum class Handler : uint8_t
+        {
+#define NEOMIPS_HANDLER_ENUM(name) name,
+            NEOMIPS_INSTRUCTIONS(NEOMIPS_HANDLER_ENUM)
+#undef NEOMIPS_HANDLER_ENUM
+            RESERVED, //word that is no instruction, in the place of ISA::Instruction::invalid
+            END,      //one past the last word of a code region
+            DECODE,   //word whose basic block hasn't been decoded yet
+#define NEOMIPS_HANDLER_ENUM(name, length, idiom) name,
+            NEOMIPS_SUPERINSTRUCTIONS(NEOMIPS_HANDLER_ENUM)
+#undef NEOMIPS_HANDLER_ENUM
+            COUNT
+        };
+
+        constexpr size_t FIRST_SUPERINSTRUCTION = static_cast<size_t>(Handler::DECODE) + 1;
+        static_assert(static_cast<size_t>(Handler::COUNT) - FIRST_SUPERINSTRUCTION == Interpreter::SUPERINSTRUCTION_COUNT, "Interpreter::SUPERINSTRUCTION_COUNT is out of date");
+        static_assert(static_cast<size_t>(Handler::COUNT) <= 256, "Handlers have to fit in DecodedInstruction::m_handler");
+
+        constexpr std::array<uint8_t, Interpreter::SUPERINSTRUCTION_COUNT> SUPERINSTRUCTION_LENGTHS{
+#define NEOMIPS_SUPERINSTRUCTION_LENGTH(name, length, idiom) length,
+            NEOMIPS_SUPERINSTRUCTIONS(NEOMIPS_SUPERINSTRUCTION_LENGTH)
+#undef NEOMIPS_SUPERINSTRUCTION_LENGTH
+        };
+
+        constexpr std::array<std::string_view, Interpreter::SUPERINSTRUCTION_COUNT> SUPERINSTRUCTION_IDIOMS{
+#define NEOMIPS_SUPERINSTRUCTION_IDIOM(name, length, idiom) idiom,
+            NEOMIPS_SUPERINSTRUCTIONS(NEOMIPS_SUPERINSTRUCTION_IDIOM)
+#undef NEOMIPS_SUPERINSTRUCTION_IDIOM
+        };
+
+        //Instructions the entry runs, more than one for a superinstruction
+        constexpr size_t length_of(uint8_t handler)
+        {
+            return handler >= FIRST_SUPERINSTRUCTION && handler < static_cast<size_t>(Handler::COUNT) ? SUPERINSTRUCTION_LENGTHS[handler - FIRST_SUPERINSTRUCTION] : 1;
+        }
+
+#define NEOMIPS_HANDLER_ORDER(name) static_assert(static_cast<size_t>(Handler::name) == static_cast<size_t>(ISA::Instruction::name), "NEOMIPS_INSTRUCTIONS is out of the order of Instruction");
+        NEOMIPS_INSTRUCTIONS(NEOMIPS_HANDLER_ORDER)
+#undef NEOMIPS_HANDLER_ORDER
+        static_assert(static_cast<size_t>(Handler::RESERVED) == ISA::INSTRUCTION_COUNT, "NEOMIPS_INSTRUCTIONS misses instructions");
+
+        //Exception codes of the Cause register
+        constexpr uint32_t CAUSE_ADDRESS_LOAD = 4;
+        constexpr uint32_t CAUSE_ADDRESS_STORE = 5;
+        constexpr uint32_t CAUSE_BREAKPOINT = 9;
+        constexpr uint32_t CAUSE_RESERVED_INSTRUCTION = 10;
+        constexpr uint32_t CAUSE_OVERFLOW = 12;
+        constexpr uint32_t CAUSE_TRAP = 13;
+
+        //Registers of coprocessor 0
+        constexpr uint32_t CP0_BAD_ADDRESS = 8;
+        constexpr uint32_t CP0_STATUS = 12;
+        constexpr uint32_t CP0_CAUSE = 13;
+        constexpr uint32_t CP0_EPC = 14;
+        constexpr uint32_t STATUS_EXL = 1 << 1;
+        constexpr uint32_t STATUS_INITIAL = 0x0000FF11;
+
+        constexpr uint32_t sign_extend16(uint32_t value)
+        {
+            return static_cast<uint32_t>(static_cast<int32_t>(static_cast<int16_t>(value)));
+        }
+
+        template<typename T>
+        T swap_bytes(T value)
+        {
+            static_assert(sizeof(T) == 2 || sizeof(T) == 4, "Memory is accessed in halves and words");
+            if constexpr (sizeof(T) == 2) return __builtin_bswap16(value);
+            else return __builtin_bswap32(value);
+        }
+
+        //Values in emulated memory, which is in the byte order E of the program. The host order is a plain copy
+        template<std::endian E, typename T>
+        T load(const uint8_t* bytes)
+        {
+            T value;
+            std::memcpy(&value, bytes, sizeof(T));
+            if constexpr (E != std::endian::native) value = swap_bytes(value);
+            return value;
+        }
+
+        template<std::endian E, typename T>
+        void store(uint8_t* bytes, T value)
+        {
+            if constexpr (E != std::endian::native) value = swap_bytes(value);
+            std::memcpy(bytes, &value, sizeof(T));
+        }
+
+        float read_single(const uint32_t* fpr, uint32_t index)
+        {
+            return std::bit_cast<float>(fpr[index]);
+        }
+
+        void write_single(uint32_t* fpr, uint32_t index, float value)
+        {
+            fpr[index] = std::bit_cast<uint32_t>(value);
+        }
+
+        double read_double(const uint32_t* fpr, uint32_t index)
+        {
+            return std::bit_cast<double>(uint64_t{ fpr[(index + 1) & 31] } << 32 | fpr[index]);
+        }
+
+        void write_double(uint32_t* fpr, uint32_t index, double value)
+        {
+            uint64_t bits = std::bit_cast<uint64_t>(value);
+            fpr[index] = static_cast<uint32_t>(bits);
+            fpr[(index + 1) & 31] = static_cast<uint32_t>(bits >> 32);
+        }
+
+        //Conversion to a word as the FPU does it, NaN and values out of range give the largest word
+        uint32_t to_word(double value)
+        {
+            if (!(value >= -2147483648.0 && value < 2147483648.0)) return 0x7FFFFFFF;
+            return static_cast<uint32_t>(static_cast<int32_t>(value));
+        }
+
+        constexpr DecodedInstruction UNDECODED{ static_cast<uint8_t>(Handler::DECODE), 0, 0, 0, 0 };
+
+        //Whether the instruction can go anywhere but the next one, which ends its basic block
+        constexpr bool ends_block(uint8_t handler)
+        {
+            switch (static_cast<Handler>(handler))
+            {
+            case Handler::BC1F: case Handler::BC1T: case Handler::BEQ: case Handler::BGEZ: case Handler::BGEZAL: case Handler::BGTZ:
+            case Handler::BLEZ: case Handler::BLTZ: case Handler::BLTZAL: case Handler::BNE: case Handler::J: case Handler::JAL:
+            case Handler::JALR_RA: case Handler::JALR: case Handler::JR: case Handler::ERET: case Handler::SYSCALL: case Handler::BREAK:
+            case Handler::RESERVED:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        //Whether the instruction always goes somewhere else than the next one, which ends what the Jit is given
+        constexpr bool ends_superblock(uint8_t handler)
+        {
+            switch (static_cast<Handler>(handler))
+            {
+            case Handler::J: case Handler::JAL: case Handler::JALR_RA: case Handler::JALR: case Handler::JR:
+            case Handler::ERET: case Handler::SYSCALL: case Handler::BREAK: case Handler::RESERVED:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        //Superinstruction for the idiom that starts at the first entry, or Handler::COUNT if there is none.
+        //following is how many decoded entries after it the idiom may use
+        Handler fuse(const DecodedInstruction* code, size_t following)
+        {
+            if (following == 0) return Handler::COUNT;
+            const DecodedInstruction& a = code[0];
+            const DecodedInstruction& b = code[1];
+            Handler first = static_cast<Handler>(a.m_handler);
+            Handler second = static_cast<Handler>(b.m_handler);
+
+            //constants and addresses built in $at by the pseudoinstructions of the assembler
+            if (first == Handler::LUI && a.m_reg1 != 0)
+            {
+                if (second == Handler::ORI && b.m_reg1 == a.m_reg1 && b.m_reg2 == a.m_reg1)
+                {
+                    if (following >= 2 && code[2].m_reg3 == a.m_reg1)
+                    {
+                        switch (static_cast<Handler>(code[2].m_handler))
+                        {
+                        case Handler::ADD: return Handler::LI_ADD;
+                        case Handler::ADDU: return Handler::LI_ADDU;
+                        case Handler::SUB: return Handler::LI_SUB;
+                        case Handler::SUBU: return Handler::LI_SUBU;
+                        case Handler::AND: return Handler::LI_AND;
+                        case Handler::OR: return Handler::LI_OR;
+                        case Handler::XOR: return Handler::LI_XOR;
+                        case Handler::SLT: return Handler::LI_SLT;
+                        case Handler::SLTU: return Handler::LI_SLTU;
+                        default: break;
+                        }
+                    }
+                    return Handler::LI;
+                }
+
+                if (b.m_reg2 == a.m_reg1)
+                {
+                    switch (second)
+                    {
+                    case Handler::LW: return Handler::LUI_LW;
+                    case Handler::LB: return Handler::LUI_LB;
+                    case Handler::LBU: return Handler::LUI_LBU;
+                    case Handler::SW: return Handler::LUI_SW;
+                    case Handler::SB: return Handler::LUI_SB;
+                    default: break;
+                    }
+                }
+            }
+
+            //comparisons that only feed a branch on zero, like blt and bge
+            bool testsResult = a.m_reg1 != 0 && ((b.m_reg1 == a.m_reg1 && b.m_reg2 == 0) || (b.m_reg1 == 0 && b.m_reg2 == a.m_reg1));
+            if (testsResult && (second == Handler::BNE || second == Handler::BEQ))
+            {
+                bool taken = second == Handler::BNE;
+                switch (first)
+                {
+                case Handler::SLT: return taken ? Handler::SLT_BNE : Handler::SLT_BEQ;
+                case Handler::SLTU: return taken ? Handler::SLTU_BNE : Handler::SLTU_BEQ;
+                case Handler::SLTI: return taken ? Handler::SLTI_BNE : Handler::SLTI_BEQ;
+                case Handler::SLTIU: return taken ? Handler::SLTIU_BNE : Handler::SLTIU_BEQ;
+                default: break;
+                }
+            }
+
+            //counted loops, the fused handler branches on the sum it wrote, which $zero doesn't keep
+            if (first == Handler::ADDIU && second == Handler::BNE && a.m_reg1 != 0) return Handler::ADDIU_BNE;
+            return Handler::COUNT;
+        }
+    }
+
+    DecodedInstruction predecode(uint32_t word, uint32_t address)
+    {
+        InstructionParameters parameters;
+        ISA::Instruction instruction = ISA::decode(word, parameters);
+        if (instruction == ISA::Instruction::invalid) return DecodedInstruction{ static_cast<uint8_t>(Handler::RESERVED), 0, 0, 0, word };
+
+        DecodedInstruction decoded{ static_cast<uint8_t>(instruction), static_cast<uint8_t>(parameters.m_reg1),
+            static_cast<uint8_t>(parameters.m_reg2), static_cast<uint8_t>(parameters.m_reg3), parameters.m_immediate };
+        const ISA::InstructionDescription& description = ISA::describe(instruction);
+        if (description.m_fields[static_cast<size_t>(ISA::EncodedOperand::Address)].m_width != 0)
+        {
+            uint32_t field = parameters.m_resolvedLabel;
+            switch (description.m_relocation)
+            {
+            case ISA::Relocation::Branch:
+                decoded.m_immediate = address + 4 + (sign_extend16(field) << 2);
+                //the condition flag bc1f and bc1t test goes where the target doesn't
+                decoded.m_reg3 = static_cast<uint8_t>(parameters.m_immediate);
+                break;
+            case ISA::Relocation::Jump:
+                decoded.m_immediate = ((address + 4) & 0xF0000000) | field << 2;
+                break;
+            default:
+                decoded.m_immediate = sign_extend16(field); //offset of a load or a store
+                break;
+            }
+        }
+
+        switch (instruction)
+        {
+        case ISA::Instruction::ADDI: case ISA::Instruction::ADDIU: case ISA::Instruction::SLTI: case ISA::Instruction::SLTIU:
+        case ISA::Instruction::TEQI: case ISA::Instruction::TGEI: case ISA::Instruction::TGEIU: case ISA::Instruction::TLTI: case ISA::Instruction::TLTIU: case ISA::Instruction::TNEI:
+            decoded.m_immediate = sign_extend16(parameters.m_immediate);
+            break;
+        case ISA::Instruction::LUI:
+            decoded.m_immediate = parameters.m_immediate << 16;
+            break;
+        default:
+            break;
+        }
+        return decoded;
+    }
+
+    Interpreter::Interpreter(Memory& memory, bool selfModifyingCode, uint32_t maxFrequency, bool jit)
+        : m_memory(memory), m_selfModifyingCode(selfModifyingCode), m_maxFrequency(maxFrequency), m_random(std::random_device{}())
+    {
+        //the stack, the area $gp points into and the heap are only added where the program left room for them
+        if (m_memory.IsFree(STACK_TOP - STACK_SIZE, STACK_SIZE)) m_memory.Allocate(STACK_TOP - STACK_SIZE, STACK_SIZE);
+        if (m_memory.IsFree(INITIAL_GP & 0xFFFF0000, 0x10000)) m_memory.Allocate(INITIAL_GP & 0xFFFF0000, 0x10000);
+        for (const Memory::Region& region : m_memory.Regions())
+        {
+            uint64_t end = uint64_t{ region.m_base } + region.m_size;
+            if (!region.m_executable && region.m_base >= (INITIAL_GP & 0xFFFF0000) && end <= STACK_TOP - STACK_SIZE)
+            {
+                m_heapEnd = std::max(m_heapEnd, static_cast<uint32_t>((end + 7) & ~uint64_t{ 7 }));
+            }
+        }
+        m_heapLimit = m_heapEnd;
+
+        for (const Memory::Region& region : m_memory.Regions())
+        {
+            if (!region.m_executable) continue;
+            uint32_t size = region.m_size & ~3u;
+            m_codeRegions.push_back(CodeRegion{ region.m_base, size, region.m_data, std::vector<DecodedInstruction>(size / 4 + 1, UNDECODED), {}, {} });
+            m_codeRegions.back().m_code.back() = DecodedInstruction{ static_cast<uint8_t>(Handler::END), 0, 0, 0, 0 };
+        }
+
+        //a throttled run has to stop between any two instructions, translated blocks don't, and they only
+        //access little endian memory
+        if (jit && maxFrequency == 0xFFFFFFFF && memory.Endianness() == std::endian::little)
+        {
+            m_jit = std::make_unique<Jit>();
+            if (!m_jit->Available()) m_jit.reset();
+            for (CodeRegion& region : m_codeRegions)
+            {
+                if (m_jit) region.m_profile.assign(region.m_code.size(), 0);
+            }
+        }
+
+        m_state.m_gpr[28] = INITIAL_GP;
+        m_state.m_gpr[29] = INITIAL_SP;
+        m_state.m_cp0[CP0_STATUS] = STATUS_INITIAL;
+        m_state.m_pc = m_memory.Entry();
+    }
+
+    Interpreter::~Interpreter() = default;
+
+    template<std::endian E>
+    void Interpreter::DecodeBlock(CodeRegion& region, size_t entry)
+    {
+        size_t count = region.m_size / 4;
+        size_t end = entry;
+        while (end < count)
+        {
+            if (end != entry && region.m_code[end].m_handler != static_cast<uint8_t>(Handler::DECODE)) break;
+
+            uint32_t offset = static_cast<uint32_t>(end * 4);
+            region.m_code[end] = predecode(load<E, uint32_t>(region.m_words + offset), region.m_base + offset);
+            if (ends_block(region.m_code[end++].m_handler)) break;
+        }
+
+        //idioms are only looked for inside what was just decoded, the entries after them are original
+        for (size_t i = entry; i + 1 < end; ++i)
+        {
+            Handler fused = fuse(&region.m_code[i], end - i - 1);
+            if (fused != Handler::COUNT) region.m_code[i].m_handler = static_cast<uint8_t>(fused);
+        }
+        ++m_decodedBlocks;
+    }
+
+    void Interpreter::Invalidate(uint32_t address, uint32_t size)
+    {
+        CodeRegion* region = FindCode(address);
+        if (!region) return;
+
+        uint64_t end = std::min(uint64_t{ address } + size, uint64_t{ region->m_base } + region->m_size);
+        for (uint64_t word = address & ~3u; word < end; word += 4)
+        {
+            size_t entry = static_cast<size_t>((word - region->m_base) / 4);
+            region->m_code[entry] = UNDECODED;
+            ++m_invalidatedWords;
+
+            //superinstructions that ran the word too
+            for (size_t before = 1; before < 3 && before <= entry; ++before)
+            {
+                if (length_of(region->m_code[entry - before].m_handler) > before) region->m_code[entry - before] = UNDECODED;
+            }
+
+            //and translations, their entries get profiled again and the exits linked to them go back to the interpreter
+            for (Translation& translation : region->m_translations)
+            {
+                if (!translation.m_block || entry < translation.m_entry || entry >= translation.m_end) continue;
+                translation.m_block = nullptr;
+                for (uint8_t* link : translation.m_links) m_jit->Unlink(link);
+                translation.m_links.clear();
+                region->m_profile[translation.m_entry] = 0;
+            }
+        }
+    }
+
+    uint32_t Interpreter::Translate(CodeRegion& region, size_t entry)
+    {
+        //from the words themselves, the decoded entries may be superinstructions. Only little endian programs
+        //are translated, the Jit takes what it can of the words up to the first jump
+        std::vector<DecodedInstruction> block;
+        for (size_t i = entry; i < region.m_size / 4 && block.size() < MAX_TRANSLATED; ++i)
+        {
+            uint32_t offset = static_cast<uint32_t>(i * 4);
+            block.push_back(predecode(load<std::endian::little, uint32_t>(region.m_words + offset), region.m_base + offset));
+            if (ends_superblock(block.back().m_handler)) break;
+        }
+
+        uint32_t address = region.m_base + static_cast<uint32_t>(entry * 4);
+        size_t count = block.size();
+        NativeBlock native = m_jit->Translate(block.data(), count, address, region.m_base, region.m_size);
+        if (!native && m_jit->Full())
+        {
+            //a full cache starts over, hot blocks get translated again as they are jumped to
+            m_jit->Flush();
+            for (CodeRegion& flushed : m_codeRegions)
+            {
+                flushed.m_translations.clear();
+                std::fill(flushed.m_profile.begin(), flushed.m_profile.end(), 0);
+            }
+            count = block.size();
+            native = m_jit->Translate(block.data(), count, address, region.m_base, region.m_size);
+        }
+        if (!native) return COLD;
+
+        ++m_translatedBlocks;
+        //in the slot of an invalidated translation if there is one, nothing is profiled with its index anymore,
+        //so code that keeps storing into itself doesn't grow the table
+        Translation translation{ entry, entry + count, native, {} };
+        auto reused = std::find_if(region.m_translations.begin(), region.m_translations.end(),
+            [](const Translation& old) { return !old.m_block; });
+        if (reused != region.m_translations.end()) *reused = translation;
+        else reused = region.m_translations.insert(reused, translation);
+        return HOT_THRESHOLD + 1 + static_cast<uint32_t>(reused - region.m_translations.begin());
+    }
+
+    std::vector<std::pair<std::string_view, uint64_t>> Interpreter::Fusions() const
+    {
+        std::vector<std::pair<std::string_view, uint64_t>> fusions;
+        for (size_t i = 0; i < SUPERINSTRUCTION_COUNT; ++i) fusions.emplace_back(SUPERINSTRUCTION_IDIOMS[i], m_fusions[i]);
+        return fusions;
+    }
+
+    Interpreter::CodeRegion* Interpreter::FindCode(uint32_t address)
+    {
+        //the end of a region is still in it, as the entry that ends the program
+        for (CodeRegion& region : m_codeRegions)
+        {
+            if (address - region.m_base <= region.m_size) return &region;
+        }
+        return nullptr;
+    }
+
+    const uint8_t* Interpreter::ReadableSlow(uint32_t address, uint32_t size)
+    {
+        Memory::Region span = m_memory.Span(address);
+        if (address - span.m_base + uint64_t{ size } > span.m_size) return nullptr;
+        m_readCache = span;
+        return span.m_data + (address - span.m_base);
+    }
+
+    uint8_t* Interpreter::WritableSlow(uint32_t address, uint32_t size)
+    {
+        Memory::Region span = m_memory.Span(address);
+        if (address - span.m_base + uint64_t{ size } > span.m_size) return nullptr;
+        if (span.m_executable)
+        {
+            //stores into code stay on this path, so every one of them invalidates what it overwrites
+            if (!m_selfModifyingCode) return nullptr;
+            Invalidate(address, size);
+        }
+        else m_writeCache = span;
+        return span.m_data + (address - span.m_base);
+    }
+
+    void Interpreter::Raise(uint32_t cause, uint32_t badAddress, uint32_t pc)
+    {
+        if (!FindCode(EXCEPTION_HANDLER))
+        {
+            std::string why;
+            switch (cause)
+            {
+            case CAUSE_ADDRESS_LOAD: why = "Address " + to_hex(badAddress) + " can't be read, it is unaligned or not in memory."; break;
+            case CAUSE_ADDRESS_STORE: why = "Address " + to_hex(badAddress) + " can't be written, it is unaligned, not in memory or code without --selfmodifying."; break;
+            case CAUSE_BREAKPOINT: why = "Break instruction executed."; break;
+            case CAUSE_RESERVED_INSTRUCTION: why = "The word is not an instruction."; break;
+            case CAUSE_OVERFLOW: why = "Arithmetic overflow."; break;
+            case CAUSE_TRAP: why = "Trap taken."; break;
+            default: why = "Exception " + std::to_string(cause) + "."; break;
+            }
+            throw Error::RuntimeException(to_hex(pc), why);
+        }
+
+        std::array<uint32_t, 32>& cp0 = m_state.m_cp0;
+        cp0[CP0_EPC] = pc;
+        cp0[CP0_CAUSE] = (cp0[CP0_CAUSE] & ~0x7Cu) | cause << 2;
+        cp0[CP0_STATUS] |= STATUS_EXL;
+        if (cause == CAUSE_ADDRESS_LOAD || cause == CAUSE_ADDRESS_STORE) cp0[CP0_BAD_ADDRESS] = badAddress;
+    }
+
+    uint32_t Interpreter::Sbrk(uint32_t bytes)
+    {
+        if (static_cast<int32_t>(bytes) < 0)
+        {
+            throw Error::RuntimeException("", "sbrk can't give back memory, it was asked for " + std::to_string(static_cast<int32_t>(bytes)) + " bytes.");
+        }
+
+        uint32_t address = m_heapEnd;
+        uint64_t end = uint64_t{ m_heapEnd } + ((bytes + 3) & ~3u);
+        if (end > m_heapLimit)
+        {
+            uint32_t size = static_cast<uint32_t>((end - m_heapLimit + HEAP_CHUNK - 1) & ~uint64_t{ HEAP_CHUNK - 1 });
+            if (uint64_t{ m_heapLimit } + size > STACK_TOP - STACK_SIZE || !m_memory.IsFree(m_heapLimit, size))
+            {
+                throw Error::RuntimeException("", "The heap is out of memory, sbrk was asked for " + std::to_string(bytes) + " bytes.");
+            }
+            m_memory.Allocate(m_heapLimit, size);
+            m_heapLimit += size;
+        }
+        m_heapEnd = static_cast<uint32_t>(end);
+        return address;
+    }
+
+    std::string Interpreter::ReadString(uint32_t address)
+    {
+        std::string text;
+        for (uint32_t at = address;; ++at)
+        {
+            const uint8_t* c = Readable(at, 1);
+            if (!c) throw Error::RuntimeException("", "The string at " + to_hex(address) + " runs out of memory before its null terminator.");
+            if (*c == 0) return text;
+            text.push_back(static_cast<char>(*c));
+        }
+    }
+
+    bool Interpreter::Syscall(uint32_t pc)
+    {
+        uint32_t* r = m_state.m_gpr.data();
+        uint32_t* f = m_state.m_fpr.data();
+        auto readFailed = [pc](const char* what)
+        {
+            return Error::RuntimeException(to_hex(pc), std::string("The input is not ") + what + ".");
+        };
+
+        switch (r[2])
+        {
+        case 1: std::cout << static_cast<int32_t>(r[4]); break;
+        case 2: std::cout << read_single(f, 12); break;
+        case 3: std::cout << read_double(f, 12); break;
+        case 4: std::cout << ReadString(r[4]); break;
+        case 5:
+        {
+            int32_t value = 0;
+            if (!(std::cin >> value)) throw readFailed("an integer");
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            r[2] = static_cast<uint32_t>(value);
+            break;
+        }
+        case 6:
+        {
+            float value = 0;
+            if (!(std::cin >> value)) throw readFailed("a float");
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            write_single(f, 0, value);
+            break;
+        }
+        case 7:
+        {
+            double value = 0;
+            if (!(std::cin >> value)) throw readFailed("a double");
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            write_double(f, 0, value);
+            break;
+        }
+        case 8:
+        {
+            //up to $a1 - 1 characters, the newline included if it fits, and a null terminator
+            if (r[5] == 0) break;
+            std::string line;
+            std::getline(std::cin, line);
+            line.push_back('\n');
+            line.resize(std::min<size_t>(line.size(), r[5] - 1));
+            //byte by byte, the buffer can go across chunks
+            for (size_t i = 0; i <= line.size(); ++i)
+            {
+                uint8_t* c = Writable(r[4] + static_cast<uint32_t>(i), 1);
+                if (!c) throw Error::RuntimeException(to_hex(pc), "The buffer at " + to_hex(r[4]) + " can't be written.");
+                *c = i < line.size() ? static_cast<uint8_t>(line[i]) : 0;
+            }
+            break;
+        }
+        case 9: r[2] = Sbrk(r[4]); break;
+        case 10: m_exitCode = 0; return false;
+        case 11: std::cout.put(static_cast<char>(r[4])); break;
+        case 12:
+        {
+            char c = 0;
+            if (!std::cin.get(c)) throw readFailed("a character");
+            r[2] = static_cast<uint8_t>(c);
+            break;
+        }
+        case 17: m_exitCode = static_cast<int32_t>(r[4]); return false;
+        case 30:
+        {
+            uint64_t milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            r[4] = static_cast<uint32_t>(milliseconds);
+            r[5] = static_cast<uint32_t>(milliseconds >> 32);
+            break;
+        }
+        case 32:
+            std::cout.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int32_t>(r[4])));
+            break;
+        case 34: std::cout << to_hex(r[4]); break;
+        case 35: std::cout << std::bitset<32>(r[4]); break;
+        case 36: std::cout << r[4]; break;
+        //every generator id of MARS shares one generator
+        case 40: m_random.seed(r[5]); break;
+        case 41: r[4] = static_cast<uint32_t>(m_random()); break;
+        case 42:
+            if (static_cast<int32_t>(r[5]) <= 0) throw Error::RuntimeException(to_hex(pc), "The upper bound of the random number has to be positive.");
+            r[4] = std::uniform_int_distribution<uint32_t>(0, r[5] - 1)(m_random);
+            break;
+        case 43: write_single(f, 0, std::uniform_real_distribution<float>(0.0f, 1.0f)(m_random)); break;
+        case 44: write_double(f, 0, std::uniform_real_distribution<double>(0.0, 1.0)(m_random)); break;
+        default: throw Error::RuntimeException(to_hex(pc), "There is no syscall " + std::to_string(r[2]) + ".");
+        }
+        return true;
+    }
+
+    int Interpreter::Run()
+    {
+        return m_memory.Endianness() == std::endian::big ? Execute<std::endian::big>() : Execute<std::endian::little>();
+    }
+
+    template<std::endian E>
+    int Interpreter::Execute()
+    {
+        static CodeRegion NO_CODE{ 0, 0, nullptr, {}, {}, {} };
+
+        uint32_t* const r = m_state.m_gpr.data();
+        uint32_t* const f = m_state.m_fpr.data();
+        CodeRegion* code = &NO_CODE;
+        const DecodedInstruction* ip = nullptr;
+        const DecodedInstruction* d = nullptr;
+        uint64_t executed = m_executed;
+        const bool jit = m_jit != nullptr;
+
+        //a throttled run sleeps every hundredth of a second of instructions until the clock catches up
+        const bool throttled = m_maxFrequency != 0xFFFFFFFF;
+        const uint64_t slice = std::max<uint64_t>(1, m_maxFrequency / 100);
+        const uint64_t firstExecuted = executed;
+        uint64_t sliceEnd = throttled ? executed + slice : std::numeric_limits<uint64_t>::max();
+        const auto started = std::chrono::steady_clock::now();
+
+        //the word of a double at the lower address, and what turns the offset of an unaligned access into
+        //its offset from the most significant byte of the word
+        constexpr uint32_t LOW_WORD = E == std::endian::little ? 0 : 4;
+        constexpr uint32_t UNALIGNED_FLIP = E == std::endian::little ? 0 : 3;
+
+#define R1 r[d->m_reg1]
+#define R2 r[d->m_reg2]
+#define R3 r[d->m_reg3]
+#define IMM d->m_immediate
+#define PC() (code->m_base + static_cast<uint32_t>(d - code->m_code.data()) * 4)
+
+        //Continues at a code address, in the same block whenever it can
+#define GOTO(target) do { \
+            uint32_t target_ = (target); \
+            if (target_ - code->m_base > code->m_size) \
+            { \
+                CodeRegion* found_ = FindCode(target_); \
+                if (!found_) { m_state.m_pc = target_; goto outside; } \
+                code = found_; \
+            } \
+            ip = code->m_code.data() + (target_ - code->m_base) / 4; \
+        } while (0)
+        //Same for jumps of the program, which the JIT profiles
+#define JUMP(target) do { \
+            GOTO(target); \
+            if (jit) \
+            { \
+                uint32_t& heat_ = code->m_profile[static_cast<size_t>(ip - code->m_code.data())]; \
+                if (heat_ >= HOT_THRESHOLD || ++heat_ == HOT_THRESHOLD) goto native; \
+            } \
+        } while (0)
+
+#ifdef NEOMIPS_THREADED
+#define NEOMIPS_HANDLER_ADDRESS(name) &&H_##name,
+        static void* const HANDLERS[] = { NEOMIPS_INSTRUCTIONS(NEOMIPS_HANDLER_ADDRESS) &&H_RESERVED, &&H_END, &&H_DECODE,
+#define NEOMIPS_SUPERINSTRUCTION_ADDRESS(name, length, idiom) &&H_##name,
+            NEOMIPS_SUPERINSTRUCTIONS(NEOMIPS_SUPERINSTRUCTION_ADDRESS) };
+#undef NEOMIPS_SUPERINSTRUCTION_ADDRESS
+#undef NEOMIPS_HANDLER_ADDRESS
+        static_assert(sizeof(HANDLERS) / sizeof(HANDLERS[0]) == static_cast<size_t>(Handler::COUNT), "Every handler needs its label");
+
+#define HANDLER(name) H_##name:
+#define EXECUTE() goto *HANDLERS[d->m_handler]
+#define DISPATCH() do { d = ip++; if (++executed >= sliceEnd) goto slice; r[0] = 0; EXECUTE(); } while (0)
+#else
+#define HANDLER(name) case Handler::name:
+#define EXECUTE() goto execute
+#define DISPATCH() goto next
+#endif
+
+#define RAISE(cause, address) do { m_executed = executed; Raise(cause, address, PC()); JUMP(EXCEPTION_HANDLER); DISPATCH(); } while (0)
+#define TRAP(condition) do { if (condition) RAISE(CAUSE_TRAP, 0); DISPATCH(); } while (0)
+
+        //Host address of an access of size bytes at R2 + IMM, raising the exception if it is unaligned or unmapped
+#define LOAD_ACCESS(size) \
+        uint32_t address = R2 + IMM; \
+        const uint8_t* bytes = (address & ((size) - 1)) ? nullptr : Readable(address, size); \
+        if (!bytes) RAISE(CAUSE_ADDRESS_LOAD, address)
+#define STORE_ACCESS(size) \
+        uint32_t address = R2 + IMM; \
+        uint8_t* bytes = (address & ((size) - 1)) ? nullptr : Writable(address, size); \
+        if (!bytes) RAISE(CAUSE_ADDRESS_STORE, address)
+
+#define SET_FCC(condition) do { \
+            if (condition) m_state.m_fcc = static_cast<uint8_t>(m_state.m_fcc | 1 << IMM); \
+            else m_state.m_fcc = static_cast<uint8_t>(m_state.m_fcc & ~(1 << IMM)); \
+        } while (0)
+#define FCC(cc) (m_state.m_fcc >> (cc) & 1)
+
+        //Superinstructions count what they fused, then step through the entries of the idiom after the first
+#define FUSION(name) ++m_fusions[static_cast<size_t>(Handler::name) - FIRST_SUPERINSTRUCTION]
+#define STEP() do { ++d; ++ip; ++executed; } while (0)
+#define FUSED_LI(name, operation) HANDLER(name) { FUSION(name); R1 = IMM | d[1].m_immediate; STEP(); STEP(); operation; DISPATCH(); }
+#define FUSED_BRANCH(name, condition, taken) HANDLER(name) { FUSION(name); uint32_t value = (condition); R1 = value; STEP(); if (taken) JUMP(IMM); DISPATCH(); }
+
+        JUMP(m_state.m_pc);
+        DISPATCH();
+
+#ifndef NEOMIPS_THREADED
+    next:
+        d = ip++;
+        if (++executed >= sliceEnd) goto slice;
+        r[0] = 0;
+    execute:
+        switch (static_cast<Handler>(d->m_handler))
+        {
+#endif
+        HANDLER(ABS_D) { write_double(f, d->m_reg1, std::fabs(read_double(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(ABS_S) { write_single(f, d->m_reg1, std::fabs(read_single(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(ADD)
+        {
+            uint32_t a = R2, b = R3, sum = a + b;
+            if ((a ^ sum) & (b ^ sum) & 0x80000000) RAISE(CAUSE_OVERFLOW, 0);
+            R1 = sum;
+            DISPATCH();
+        }
+        HANDLER(ADD_D) { write_double(f, d->m_reg1, read_double(f, d->m_reg2) + read_double(f, d->m_reg3)); DISPATCH(); }
+        HANDLER(ADD_S) { write_single(f, d->m_reg1, read_single(f, d->m_reg2) + read_single(f, d->m_reg3)); DISPATCH(); }
+        HANDLER(ADDI)
+        {
+            uint32_t a = R2, sum = a + IMM;
+            if ((a ^ sum) & (IMM ^ sum) & 0x80000000) RAISE(CAUSE_OVERFLOW, 0);
+            R1 = sum;
+            DISPATCH();
+        }
+        HANDLER(ADDIU) { R1 = R2 + IMM; DISPATCH(); }
+        HANDLER(ADDU) { R1 = R2 + R3; DISPATCH(); }
+        HANDLER(AND) { R1 = R2 & R3; DISPATCH(); }
+        HANDLER(ANDI) { R1 = R2 & IMM; DISPATCH(); }
+        HANDLER(BC1F) { if (!FCC(d->m_reg3)) JUMP(IMM); DISPATCH(); }
+        HANDLER(BC1T) { if (FCC(d->m_reg3)) JUMP(IMM); DISPATCH(); }
+        HANDLER(BEQ) { if (R1 == R2) JUMP(IMM); DISPATCH(); }
+        HANDLER(BGEZ) { if (static_cast<int32_t>(R1) >= 0) JUMP(IMM); DISPATCH(); }
+        HANDLER(BGEZAL)
+        {
+            bool taken = static_cast<int32_t>(R1) >= 0;
+            r[31] = PC() + 4;
+            if (taken) JUMP(IMM);
+            DISPATCH();
+        }
+        HANDLER(BGTZ) { if (static_cast<int32_t>(R1) > 0) JUMP(IMM); DISPATCH(); }
+        HANDLER(BLEZ) { if (static_cast<int32_t>(R1) <= 0) JUMP(IMM); DISPATCH(); }
+        HANDLER(BLTZ) { if (static_cast<int32_t>(R1) < 0) JUMP(IMM); DISPATCH(); }
+        HANDLER(BLTZAL)
+        {
+            bool taken = static_cast<int32_t>(R1) < 0;
+            r[31] = PC() + 4;
+            if (taken) JUMP(IMM);
+            DISPATCH();
+        }
+        HANDLER(BNE) { if (R1 != R2) JUMP(IMM); DISPATCH(); }
+        HANDLER(BREAK) { RAISE(CAUSE_BREAKPOINT, 0); }
+        HANDLER(C_EQ_D) { SET_FCC(read_double(f, d->m_reg1) == read_double(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(C_EQ_S) { SET_FCC(read_single(f, d->m_reg1) == read_single(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(C_LE_D) { SET_FCC(read_double(f, d->m_reg1) <= read_double(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(C_LE_S) { SET_FCC(read_single(f, d->m_reg1) <= read_single(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(C_LT_D) { SET_FCC(read_double(f, d->m_reg1) < read_double(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(C_LT_S) { SET_FCC(read_single(f, d->m_reg1) < read_single(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(CEIL_W_D) { f[d->m_reg1] = to_word(std::ceil(read_double(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(CEIL_W_S) { f[d->m_reg1] = to_word(std::ceil(read_single(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(CLO) { R1 = static_cast<uint32_t>(std::countl_one(R2)); DISPATCH(); }
+        HANDLER(CLZ) { R1 = static_cast<uint32_t>(std::countl_zero(R2)); DISPATCH(); }
+        HANDLER(CVT_D_S) { write_double(f, d->m_reg1, read_single(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(CVT_D_W) { write_double(f, d->m_reg1, static_cast<int32_t>(f[d->m_reg2])); DISPATCH(); }
+        HANDLER(CVT_S_D) { write_single(f, d->m_reg1, static_cast<float>(read_double(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(CVT_S_W) { write_single(f, d->m_reg1, static_cast<float>(static_cast<int32_t>(f[d->m_reg2]))); DISPATCH(); }
+        HANDLER(CVT_W_D) { f[d->m_reg1] = to_word(std::nearbyint(read_double(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(CVT_W_S) { f[d->m_reg1] = to_word(std::nearbyint(read_single(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(DIV)
+        {
+            //division by zero leaves hi and lo as they were, like MARS
+            int32_t a = static_cast<int32_t>(R1), b = static_cast<int32_t>(R2);
+            if (b == -1)
+            {
+                m_state.m_lo = 0u - static_cast<uint32_t>(a);
+                m_state.m_hi = 0;
+            }
+            else if (b != 0)
+            {
+                m_state.m_lo = static_cast<uint32_t>(a / b);
+                m_state.m_hi = static_cast<uint32_t>(a % b);
+            }
+            DISPATCH();
+        }
+        HANDLER(DIV_D) { write_double(f, d->m_reg1, read_double(f, d->m_reg2) / read_double(f, d->m_reg3)); DISPATCH(); }
+        HANDLER(DIV_S) { write_single(f, d->m_reg1, read_single(f, d->m_reg2) / read_single(f, d->m_reg3)); DISPATCH(); }
+        HANDLER(DIVU)
+        {
+            if (R2 != 0)
+            {
+                m_state.m_lo = R1 / R2;
+                m_state.m_hi = R1 % R2;
+            }
+            DISPATCH();
+        }
+        HANDLER(ERET)
+        {
+            m_state.m_cp0[CP0_STATUS] &= ~STATUS_EXL;
+            JUMP(m_state.m_cp0[CP0_EPC]);
+            DISPATCH();
+        }
+        HANDLER(FLOOR_W_D) { f[d->m_reg1] = to_word(std::floor(read_double(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(FLOOR_W_S) { f[d->m_reg1] = to_word(std::floor(read_single(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(J) { JUMP(IMM); DISPATCH(); }
+        HANDLER(JAL) { r[31] = PC() + 4; JUMP(IMM); DISPATCH(); }
+        HANDLER(JALR_RA)
+        {
+            uint32_t target = R1;
+            if (target & 3) RAISE(CAUSE_ADDRESS_LOAD, target);
+            r[31] = PC() + 4;
+            JUMP(target);
+            DISPATCH();
+        }
+        HANDLER(JALR)
+        {
+            uint32_t target = R2;
+            if (target & 3) RAISE(CAUSE_ADDRESS_LOAD, target);
+            R1 = PC() + 4;
+            JUMP(target);
+            DISPATCH();
+        }
+        HANDLER(JR)
+        {
+            uint32_t target = R1;
+            if (target & 3) RAISE(CAUSE_ADDRESS_LOAD, target);
+            JUMP(target);
+            DISPATCH();
+        }
+        HANDLER(LB) { LOAD_ACCESS(1); R1 = static_cast<uint32_t>(static_cast<int8_t>(*bytes)); DISPATCH(); }
+        HANDLER(LBU) { LOAD_ACCESS(1); R1 = *bytes; DISPATCH(); }
+        HANDLER(LDC1)
+        {
+            LOAD_ACCESS(8);
+            f[d->m_reg1] = load<E, uint32_t>(bytes + LOW_WORD);
+            f[(d->m_reg1 + 1) & 31] = load<E, uint32_t>(bytes + (4 - LOW_WORD));
+            DISPATCH();
+        }
+        HANDLER(LH) { LOAD_ACCESS(2); R1 = static_cast<uint32_t>(static_cast<int16_t>(load<E, uint16_t>(bytes))); DISPATCH(); }
+        HANDLER(LHU) { LOAD_ACCESS(2); R1 = load<E, uint16_t>(bytes); DISPATCH(); }
+        HANDLER(LL) { LOAD_ACCESS(4); R1 = load<E, uint32_t>(bytes); DISPATCH(); }
+        HANDLER(LUI) { R1 = IMM; DISPATCH(); }
+        HANDLER(LW) { LOAD_ACCESS(4); R1 = load<E, uint32_t>(bytes); DISPATCH(); }
+        HANDLER(LWC1) { LOAD_ACCESS(4); f[d->m_reg1] = load<E, uint32_t>(bytes); DISPATCH(); }
+        HANDLER(LWL)
+        {
+            //the bytes from the address to the least significant end of the word, into the top of the register
+            uint32_t address = R2 + IMM;
+            const uint8_t* bytes = Readable(address & ~3u, 4);
+            if (!bytes) RAISE(CAUSE_ADDRESS_LOAD, address);
+            uint32_t shift = 8 * (3 - ((address & 3) ^ UNALIGNED_FLIP));
+            R1 = (R1 & static_cast<uint32_t>((uint64_t{ 1 } << shift) - 1)) | load<E, uint32_t>(bytes) << shift;
+            DISPATCH();
+        }
+        HANDLER(LWR)
+        {
+            //the bytes from the address to the most significant end of the word, into the bottom of the register
+            uint32_t address = R2 + IMM;
+            const uint8_t* bytes = Readable(address & ~3u, 4);
+            if (!bytes) RAISE(CAUSE_ADDRESS_LOAD, address);
+            uint32_t shift = 8 * ((address & 3) ^ UNALIGNED_FLIP);
+            R1 = (R1 & ~static_cast<uint32_t>(0xFFFFFFFFull >> shift)) | load<E, uint32_t>(bytes) >> shift;
+            DISPATCH();
+        }
+        HANDLER(MADD)
+        {
+            int64_t accumulator = static_cast<int64_t>(uint64_t{ m_state.m_hi } << 32 | m_state.m_lo);
+            uint64_t result = static_cast<uint64_t>(accumulator + int64_t{ static_cast<int32_t>(R1) } * static_cast<int32_t>(R2));
+            m_state.m_lo = static_cast<uint32_t>(result);
+            m_state.m_hi = static_cast<uint32_t>(result >> 32);
+            DISPATCH();
+        }
+        HANDLER(MADDU)
+        {
+            uint64_t result = (uint64_t{ m_state.m_hi } << 32 | m_state.m_lo) + uint64_t{ R1 } * R2;
+            m_state.m_lo = static_cast<uint32_t>(result);
+            m_state.m_hi = static_cast<uint32_t>(result >> 32);
+            DISPATCH();
+        }
+        HANDLER(MFC0) { R1 = m_state.m_cp0[d->m_reg2]; DISPATCH(); }
+        HANDLER(MFC1) { R1 = f[d->m_reg2]; DISPATCH(); }
+        HANDLER(MFHI) { R1 = m_state.m_hi; DISPATCH(); }
+        HANDLER(MFLO) { R1 = m_state.m_lo; DISPATCH(); }
+        HANDLER(MOV_D) { f[d->m_reg1] = f[d->m_reg2]; f[(d->m_reg1 + 1) & 31] = f[(d->m_reg2 + 1) & 31]; DISPATCH(); }
+        HANDLER(MOV_S) { f[d->m_reg1] = f[d->m_reg2]; DISPATCH(); }
+        HANDLER(MOVF) { if (!FCC(IMM)) R1 = R2; DISPATCH(); }
+        HANDLER(MOVF_D) { if (!FCC(IMM)) { f[d->m_reg1] = f[d->m_reg2]; f[(d->m_reg1 + 1) & 31] = f[(d->m_reg2 + 1) & 31]; } DISPATCH(); }
+        HANDLER(MOVF_S) { if (!FCC(IMM)) f[d->m_reg1] = f[d->m_reg2]; DISPATCH(); }
+        HANDLER(MOVN) { if (R3 != 0) R1 = R2; DISPATCH(); }
+        HANDLER(MOVN_D) { if (R3 != 0) { f[d->m_reg1] = f[d->m_reg2]; f[(d->m_reg1 + 1) & 31] = f[(d->m_reg2 + 1) & 31]; } DISPATCH(); }
+        HANDLER(MOVN_S) { if (R3 != 0) f[d->m_reg1] = f[d->m_reg2]; DISPATCH(); }
+        HANDLER(MOVT) { if (FCC(IMM)) R1 = R2; DISPATCH(); }
+        HANDLER(MOVT_D) { if (FCC(IMM)) { f[d->m_reg1] = f[d->m_reg2]; f[(d->m_reg1 + 1) & 31] = f[(d->m_reg2 + 1) & 31]; } DISPATCH(); }
+        HANDLER(MOVT_S) { if (FCC(IMM)) f[d->m_reg1] = f[d->m_reg2]; DISPATCH(); }
+        HANDLER(MOVZ) { if (R3 == 0) R1 = R2; DISPATCH(); }
+        HANDLER(MOVZ_D) { if (R3 == 0) { f[d->m_reg1] = f[d->m_reg2]; f[(d->m_reg1 + 1) & 31] = f[(d->m_reg2 + 1) & 31]; } DISPATCH(); }
+        HANDLER(MOVZ_S) { if (R3 == 0) f[d->m_reg1] = f[d->m_reg2]; DISPATCH(); }
+        HANDLER(MSUB)
+        {
+            int64_t accumulator = static_cast<int64_t>(uint64_t{ m_state.m_hi } << 32 | m_state.m_lo);
+            uint64_t result = static_cast<uint64_t>(accumulator - int64_t{ static_cast<int32_t>(R1) } * static_cast<int32_t>(R2));
+            m_state.m_lo = static_cast<uint32_t>(result);
+            m_state.m_hi = static_cast<uint32_t>(result >> 32);
+            DISPATCH();
+        }
+        HANDLER(MSUBU)
+        {
+            uint64_t result = (uint64_t{ m_state.m_hi } << 32 | m_state.m_lo) - uint64_t{ R1 } * R2;
+            m_state.m_lo = static_cast<uint32_t>(result);
+            m_state.m_hi = static_cast<uint32_t>(result >> 32);
+            DISPATCH();
+        }
+        HANDLER(MTC0) { m_state.m_cp0[d->m_reg2] = R1; DISPATCH(); }
+        HANDLER(MTC1) { f[d->m_reg2] = R1; DISPATCH(); }
+        HANDLER(MTHI) { m_state.m_hi = R1; DISPATCH(); }
+        HANDLER(MTLO) { m_state.m_lo = R1; DISPATCH(); }
+        HANDLER(MUL) { R1 = static_cast<uint32_t>(int64_t{ static_cast<int32_t>(R2) } * static_cast<int32_t>(R3)); DISPATCH(); }
+        HANDLER(MUL_D) { write_double(f, d->m_reg1, read_double(f, d->m_reg2) * read_double(f, d->m_reg3)); DISPATCH(); }
+        HANDLER(MUL_S) { write_single(f, d->m_reg1, read_single(f, d->m_reg2) * read_single(f, d->m_reg3)); DISPATCH(); }
+        HANDLER(MULT)
+        {
+            uint64_t product = static_cast<uint64_t>(int64_t{ static_cast<int32_t>(R1) } * static_cast<int32_t>(R2));
+            m_state.m_lo = static_cast<uint32_t>(product);
+            m_state.m_hi = static_cast<uint32_t>(product >> 32);
+            DISPATCH();
+        }
+        HANDLER(MULTU)
+        {
+            uint64_t product = uint64_t{ R1 } * R2;
+            m_state.m_lo = static_cast<uint32_t>(product);
+            m_state.m_hi = static_cast<uint32_t>(product >> 32);
+            DISPATCH();
+        }
+        HANDLER(NEG_D) { write_double(f, d->m_reg1, -read_double(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(NEG_S) { write_single(f, d->m_reg1, -read_single(f, d->m_reg2)); DISPATCH(); }
+        HANDLER(NOP) { DISPATCH(); }
+        HANDLER(NOR) { R1 = ~(R2 | R3); DISPATCH(); }
+        HANDLER(OR) { R1 = R2 | R3; DISPATCH(); }
+        HANDLER(ORI) { R1 = R2 | IMM; DISPATCH(); }
+        HANDLER(ROUND_W_D) { f[d->m_reg1] = to_word(std::nearbyint(read_double(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(ROUND_W_S) { f[d->m_reg1] = to_word(std::nearbyint(read_single(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(SB) { STORE_ACCESS(1); *bytes = static_cast<uint8_t>(R1); DISPATCH(); }
+        HANDLER(SC)
+        {
+            //with one hart nothing can break the link, so the store always succeeds
+            STORE_ACCESS(4);
+            store<E, uint32_t>(bytes, R1);
+            R1 = 1;
+            DISPATCH();
+        }
+        HANDLER(SDC1)
+        {
+            STORE_ACCESS(8);
+            store<E, uint32_t>(bytes + LOW_WORD, f[d->m_reg1]);
+            store<E, uint32_t>(bytes + (4 - LOW_WORD), f[(d->m_reg1 + 1) & 31]);
+            DISPATCH();
+        }
+        HANDLER(SH) { STORE_ACCESS(2); store<E, uint16_t>(bytes, static_cast<uint16_t>(R1)); DISPATCH(); }
+        HANDLER(SLL) { R1 = R2 << IMM; DISPATCH(); }
+        HANDLER(SLLV) { R1 = R2 << (R3 & 31); DISPATCH(); }
+        HANDLER(SLT) { R1 = static_cast<int32_t>(R2) < static_cast<int32_t>(R3); DISPATCH(); }
+        HANDLER(SLTI) { R1 = static_cast<int32_t>(R2) < static_cast<int32_t>(IMM); DISPATCH(); }
+        HANDLER(SLTIU) { R1 = R2 < IMM; DISPATCH(); }
+        HANDLER(SLTU) { R1 = R2 < R3; DISPATCH(); }
+        HANDLER(SQRT_D) { write_double(f, d->m_reg1, std::sqrt(read_double(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(SQRT_S) { write_single(f, d->m_reg1, std::sqrt(read_single(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(SRA) { R1 = static_cast<uint32_t>(static_cast<int32_t>(R2) >> IMM); DISPATCH(); }
+        HANDLER(SRAV) { R1 = static_cast<uint32_t>(static_cast<int32_t>(R2) >> (R3 & 31)); DISPATCH(); }
+        HANDLER(SRL) { R1 = R2 >> IMM; DISPATCH(); }
+        HANDLER(SRLV) { R1 = R2 >> (R3 & 31); DISPATCH(); }
+        HANDLER(SUB)
+        {
+            uint32_t a = R2, b = R3, difference = a - b;
+            if ((a ^ b) & (a ^ difference) & 0x80000000) RAISE(CAUSE_OVERFLOW, 0);
+            R1 = difference;
+            DISPATCH();
+        }
+        HANDLER(SUB_D) { write_double(f, d->m_reg1, read_double(f, d->m_reg2) - read_double(f, d->m_reg3)); DISPATCH(); }
+        HANDLER(SUB_S) { write_single(f, d->m_reg1, read_single(f, d->m_reg2) - read_single(f, d->m_reg3)); DISPATCH(); }
+        HANDLER(SUBU) { R1 = R2 - R3; DISPATCH(); }
+        HANDLER(SW) { STORE_ACCESS(4); store<E, uint32_t>(bytes, R1); DISPATCH(); }
+        HANDLER(SWC1) { STORE_ACCESS(4); store<E, uint32_t>(bytes, f[d->m_reg1]); DISPATCH(); }
+        HANDLER(SWL)
+        {
+            //the top of the register, into the bytes from the address to the least significant end of the word
+            uint32_t address = R2 + IMM;
+            uint8_t* bytes = Writable(address & ~3u, 4);
+            if (!bytes) RAISE(CAUSE_ADDRESS_STORE, address);
+            uint32_t shift = 8 * (3 - ((address & 3) ^ UNALIGNED_FLIP));
+            uint32_t kept = load<E, uint32_t>(bytes) & ~static_cast<uint32_t>(0xFFFFFFFFull >> shift);
+            store<E, uint32_t>(bytes, kept | R1 >> shift);
+            DISPATCH();
+        }
+        HANDLER(SWR)
+        {
+            //the bottom of the register, into the bytes from the address to the most significant end of the word
+            uint32_t address = R2 + IMM;
+            uint8_t* bytes = Writable(address & ~3u, 4);
+            if (!bytes) RAISE(CAUSE_ADDRESS_STORE, address);
+            uint32_t shift = 8 * ((address & 3) ^ UNALIGNED_FLIP);
+            uint32_t kept = load<E, uint32_t>(bytes) & static_cast<uint32_t>((uint64_t{ 1 } << shift) - 1);
+            store<E, uint32_t>(bytes, kept | R1 << shift);
+            DISPATCH();
+        }
+        HANDLER(SYSCALL)
+        {
+            m_executed = executed;
+            m_state.m_pc = PC();
+            if (!Syscall(m_state.m_pc)) goto finished;
+            DISPATCH();
+        }
+        HANDLER(TEQ) { TRAP(R1 == R2); }
+        HANDLER(TEQI) { TRAP(R1 == IMM); }
+        HANDLER(TGE) { TRAP(static_cast<int32_t>(R1) >= static_cast<int32_t>(R2)); }
+        HANDLER(TGEI) { TRAP(static_cast<int32_t>(R1) >= static_cast<int32_t>(IMM)); }
+        HANDLER(TGEIU) { TRAP(R1 >= IMM); }
+        HANDLER(TGEU) { TRAP(R1 >= R2); }
+        HANDLER(TLT) { TRAP(static_cast<int32_t>(R1) < static_cast<int32_t>(R2)); }
+        HANDLER(TLTI) { TRAP(static_cast<int32_t>(R1) < static_cast<int32_t>(IMM)); }
+        HANDLER(TLTIU) { TRAP(R1 < IMM); }
+        HANDLER(TLTU) { TRAP(R1 < R2); }
+        HANDLER(TNE) { TRAP(R1 != R2); }
+        HANDLER(TNEI) { TRAP(R1 != IMM); }
+        HANDLER(TRUNC_W_D) { f[d->m_reg1] = to_word(std::trunc(read_double(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(TRUNC_W_S) { f[d->m_reg1] = to_word(std::trunc(read_single(f, d->m_reg2))); DISPATCH(); }
+        HANDLER(XOR) { R1 = R2 ^ R3; DISPATCH(); }
+        HANDLER(XORI) { R1 = R2 ^ IMM; DISPATCH(); }
+        HANDLER(RESERVED) { RAISE(CAUSE_RESERVED_INSTRUCTION, 0); }
+        HANDLER(DECODE)
+        {
+            //runs the entry again once its block is decoded, it counts then
+            DecodeBlock<E>(*code, static_cast<size_t>(d - code->m_code.data()));
+            ip = d;
+            --executed;
+            DISPATCH();
+        }
+        HANDLER(END)
+        {
+            //the program ran off the bottom of its code, which ends it like MARS does
+            --executed;
+            m_state.m_pc = PC();
+            goto finished;
+        }
+
+        //superinstructions, the register written first is always the one the rest of the idiom reads
+        HANDLER(LI) { FUSION(LI); R1 = IMM | d[1].m_immediate; STEP(); DISPATCH(); }
+        HANDLER(LI_ADD)
+        {
+            FUSION(LI_ADD);
+            R1 = IMM | d[1].m_immediate;
+            STEP();
+            STEP();
+            uint32_t a = R2, b = R3, sum = a + b;
+            if ((a ^ sum) & (b ^ sum) & 0x80000000) RAISE(CAUSE_OVERFLOW, 0);
+            R1 = sum;
+            DISPATCH();
+        }
+        FUSED_LI(LI_ADDU, R1 = R2 + R3)
+        HANDLER(LI_SUB)
+        {
+            FUSION(LI_SUB);
+            R1 = IMM | d[1].m_immediate;
+            STEP();
+            STEP();
+            uint32_t a = R2, b = R3, difference = a - b;
+            if ((a ^ b) & (a ^ difference) & 0x80000000) RAISE(CAUSE_OVERFLOW, 0);
+            R1 = difference;
+            DISPATCH();
+        }
+        FUSED_LI(LI_SUBU, R1 = R2 - R3)
+        FUSED_LI(LI_AND, R1 = R2 & R3)
+        FUSED_LI(LI_OR, R1 = R2 | R3)
+        FUSED_LI(LI_XOR, R1 = R2 ^ R3)
+        FUSED_LI(LI_SLT, R1 = static_cast<int32_t>(R2) < static_cast<int32_t>(R3))
+        FUSED_LI(LI_SLTU, R1 = R2 < R3)
+        HANDLER(LUI_LW) { FUSION(LUI_LW); R1 = IMM; STEP(); LOAD_ACCESS(4); R1 = load<E, uint32_t>(bytes); DISPATCH(); }
+        HANDLER(LUI_LB) { FUSION(LUI_LB); R1 = IMM; STEP(); LOAD_ACCESS(1); R1 = static_cast<uint32_t>(static_cast<int8_t>(*bytes)); DISPATCH(); }
+        HANDLER(LUI_LBU) { FUSION(LUI_LBU); R1 = IMM; STEP(); LOAD_ACCESS(1); R1 = *bytes; DISPATCH(); }
+        HANDLER(LUI_SW) { FUSION(LUI_SW); R1 = IMM; STEP(); STORE_ACCESS(4); store<E, uint32_t>(bytes, R1); DISPATCH(); }
+        HANDLER(LUI_SB) { FUSION(LUI_SB); R1 = IMM; STEP(); STORE_ACCESS(1); *bytes = static_cast<uint8_t>(R1); DISPATCH(); }
+        FUSED_BRANCH(SLT_BNE, static_cast<int32_t>(R2) < static_cast<int32_t>(R3), value)
+        FUSED_BRANCH(SLT_BEQ, static_cast<int32_t>(R2) < static_cast<int32_t>(R3), !value)
+        FUSED_BRANCH(SLTU_BNE, R2 < R3, value)
+        FUSED_BRANCH(SLTU_BEQ, R2 < R3, !value)
+        FUSED_BRANCH(SLTI_BNE, static_cast<int32_t>(R2) < static_cast<int32_t>(IMM), value)
+        FUSED_BRANCH(SLTI_BEQ, static_cast<int32_t>(R2) < static_cast<int32_t>(IMM), !value)
+        FUSED_BRANCH(SLTIU_BNE, R2 < IMM, value)
+        FUSED_BRANCH(SLTIU_BEQ, R2 < IMM, !value)
+        HANDLER(ADDIU_BNE) { FUSION(ADDIU_BNE); R1 = R2 + IMM; STEP(); if (R1 != R2) JUMP(IMM); DISPATCH(); }
+#ifndef NEOMIPS_THREADED
+        default: RAISE(CAUSE_RESERVED_INSTRUCTION, 0);
+        }
+#endif
+
+    slice:
+        {
+            auto due = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(static_cast<double>(executed - firstExecuted) / m_maxFrequency));
+            std::cout.flush();
+            std::this_thread::sleep_until(due);
+            sliceEnd += slice;
+        }
+        r[0] = 0;
+        EXECUTE();
+
+    native:
+        {
+            //the entry jumped to is hot: its block is translated the first time and runs natively from then on. A
+            //translation may flush the cache the block that jumped here is in, so that one is linked the next time
+            size_t entry = static_cast<size_t>(ip - code->m_code.data());
+            uint32_t& heat = code->m_profile[entry];
+            if (heat == HOT_THRESHOLD)
+            {
+                heat = Translate(*code, entry);
+                m_jitContext.m_link = nullptr;
+            }
+            if (heat == COLD)
+            {
+                m_jitContext.m_link = nullptr;
+                DISPATCH();
+            }
+
+            //the exit of the block that just left to this one jumps straight into it from now on
+            Translation& translation = code->m_translations[heat - HOT_THRESHOLD - 1];
+            if (m_jitContext.m_link)
+            {
+                m_jit->Link(m_jitContext.m_link, translation.m_block);
+                translation.m_links.push_back(m_jitContext.m_link);
+                ++m_linkedExits;
+            }
+
+            ++m_nativeEntries;
+            m_jitContext.m_executed = executed;
+            uint64_t next = translation.m_block(&m_jitContext);
+            executed = m_jitContext.m_executed;
+            if (next & Jit::INTERPRET) GOTO(static_cast<uint32_t>(next));
+            else JUMP(static_cast<uint32_t>(next));
+            m_jitContext.m_link = nullptr;
+            DISPATCH();
+        }
+
+    outside:
+        //a jump out of the code is an exception when fetching, the program just started if nothing ran yet. A
+        //block that left to there isn't linked to the handler
+        m_jitContext.m_link = nullptr;
+        m_executed = executed;
+        if (!d) throw Error::RuntimeException("", "The entry point " + to_hex(m_state.m_pc) + " is not in the code of the program.");
+        Raise(CAUSE_ADDRESS_LOAD, m_state.m_pc, PC());
+        JUMP(EXCEPTION_HANDLER);
+        DISPATCH();
+
+    finished:
+        m_executed = executed;
+        std::cout.flush();
+        return m_exitCode;
+
+#undef R1
+#undef R2
+#undef R3
+#undef IMM
+#undef PC
+#undef GOTO
+#undef JUMP
+#undef HANDLER
+#undef EXECUTE
+#undef DISPATCH
+#undef RAISE
+#undef TRAP
+#undef LOAD_ACCESS
+#undef STORE_ACCESS
+#undef SET_FCC
+#undef FCC
+#undef FUSION
+#undef STEP
+#undef FUSED_LI
+#undef FUSED_BRANCH
+    }
+}
@@ -0,0 +1,208 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "isadescription.hpp"
+#include "memory.hpp"
+
+//Every instruction, in the order of the Instruction enum, for code that needs one of something per instruction
+#define NEOMIPS_INSTRUCTIONS(X) \
+    X(ABS_D) X(ABS_S) X(ADD) X(ADD_D) X(ADD_S) X(ADDI) X(ADDIU) X(ADDU) X(AND) X(ANDI) \
+    X(BC1F) X(BC1T) X(BEQ) X(BGEZ) X(BGEZAL) X(BGTZ) X(BLEZ) X(BLTZ) X(BLTZAL) X(BNE) X(BREAK) \
+    X(C_EQ_D) X(C_EQ_S) X(C_LE_D) X(C_LE_S) X(C_LT_D) X(C_LT_S) X(CEIL_W_D) X(CEIL_W_S) X(CLO) X(CLZ) \
+    X(CVT_D_S) X(CVT_D_W) X(CVT_S_D) X(CVT_S_W) X(CVT_W_D) X(CVT_W_S) X(DIV) X(DIV_D) X(DIV_S) X(DIVU) \
+    X(ERET) X(FLOOR_W_D) X(FLOOR_W_S) X(J) X(JAL) X(JALR_RA) X(JALR) X(JR) \
+    X(LB) X(LBU) X(LDC1) X(LH) X(LHU) X(LL) X(LUI) X(LW) X(LWC1) X(LWL) X(LWR) \
+    X(MADD) X(MADDU) X(MFC0) X(MFC1) X(MFHI) X(MFLO) X(MOV_D) X(MOV_S) X(MOVF) X(MOVF_D) X(MOVF_S) \
+    X(MOVN) X(MOVN_D) X(MOVN_S) X(MOVT) X(MOVT_D) X(MOVT_S) X(MOVZ) X(MOVZ_D) X(MOVZ_S) X(MSUB) X(MSUBU) \
+    X(MTC0) X(MTC1) X(MTHI) X(MTLO) X(MUL) X(MUL_D) X(MUL_S) X(MULT) X(MULTU) X(NEG_D) X(NEG_S) \
+    X(NOP) X(NOR) X(OR) X(ORI) X(ROUND_W_D) X(ROUND_W_S) X(SB) X(SC) X(SDC1) X(SH) \
+    X(SLL) X(SLLV) X(SLT) X(SLTI) X(SLTIU) X(SLTU) X(SQRT_D) X(SQRT_S) X(SRA) X(SRAV) X(SRL) X(SRLV) \
+    X(SUB) X(SUB_D) X(SUB_S) X(SUBU) X(SW) X(SWC1) X(SWL) X(SWR) X(SYSCALL) \
+    X(TEQ) X(TEQI) X(TGE) X(TGEI) X(TGEIU) X(TGEU) X(TLT) X(TLTI) X(TLTIU) X(TLTU) X(TNE) X(TNEI) \
+    X(TRUNC_W_D) X(TRUNC_W_S) X(XOR) X(XORI)
+
+namespace NeoMIPS
+{
+    //Instruction as the interpreter runs it. The handler and the operands are pulled out of the word once,
+    //immediates are already extended and branch and jump targets are absolute addresses
+    struct DecodedInstruction
+    {
+        uint8_t m_handler; //an ISA::Instruction, or one of the handlers only the interpreter has
+        uint8_t m_reg1;
+        uint8_t m_reg2;
+        uint8_t m_reg3;
+        uint32_t m_immediate;
+    };
+
+    static_assert(sizeof(DecodedInstruction) == 8, "Decoded instructions are meant to be two per 16 bytes");
+
+    //Decodes the word at the address. A word that is no instruction gets ISA::INSTRUCTION_COUNT as its handler
+    //and itself as the immediate
+    DecodedInstruction predecode(uint32_t word, uint32_t address);
+
+    struct CpuState
+    {
+        std::array<uint32_t, 32> m_gpr{};
+        std::array<uint32_t, 32> m_fpr{}; //doubles take an even register and the next one, low word first
+        std::array<uint32_t, 32> m_cp0{};
+        uint32_t m_hi = 0;
+        uint32_t m_lo = 0;
+        uint32_t m_pc = 0;
+        uint8_t m_fcc = 0; //condition flags of the FPU, one bit each
+    };
+
+    //What a block translated by the Jit runs with: the registers, the memory its accesses look up regions in
+    //and the count of instructions run, which the block adds to. The block leaves the exit it took in m_link,
+    //nullptr if that exit can't be linked to another block
+    struct JitContext
+    {
+        CpuState* m_state;
+        Memory* m_memory;
+        uint64_t m_executed;
+        uint8_t* m_link;
+    };
+
+    //Translated basic block, returns the address to go on from, with Jit::INTERPRET set if it has to be interpreted
+    using NativeBlock = uint64_t (*)(JitContext* context);
+
+    class Jit;
+
+    //MIPS32 interpreter over the encoded words in memory. Every executable region gets an array of
+    //DecodedInstruction with one entry per word, plus one past its end that stops the program when it falls
+    //off the bottom. Entries start out as a handler that decodes the basic block from there up to the next
+    //branch, jump or syscall, so code is decoded the first time it runs and never again. With self-modifying
+    //code allowed, a store into code puts back that handler on the words it wrote and nothing else; without
+    //it, code can't be written, like in MARS. Handlers are labels of one function chained with computed gotos, so every handler ends with
+    //its own indirect jump to the next one, which branch predictors follow far better than a shared switch.
+    //Compilers without labels as values get the switch. Idioms of the assembler's pseudoinstructions and of
+    //loops, like lui+ori or slt+bne, are fused into superinstructions that run them with one dispatch; the
+    //entries after the first stay as they are, so a branch into the middle of an idiom still works.
+    //With the JIT, jumps count how often they land on every entry, and an entry that gets hot has the code from
+    //there translated to native code, which jumps to it run from then on until a store into the block invalidates
+    //it. An exit of a block that goes to another translated block is linked to it, and unlinked when it is invalidated.
+    //Like MARS, branches have no delay slot, syscalls follow its numbering and exceptions go to the handler at
+    //0x80000180 if the program has one. The handlers are instantiated once per byte order, Run picks the one of
+    //the program, so memory in the byte order of the host is accessed without any swap and the other one swaps
+    //every access, with no test of the byte order in any handler. Only little endian programs are translated
+    class Interpreter
+    {
+    public:
+        static constexpr uint32_t EXCEPTION_HANDLER = 0x80000180;
+        static constexpr uint32_t STACK_TOP = 0x80000000;
+        static constexpr uint32_t STACK_SIZE = 0x00400000;
+        static constexpr uint32_t INITIAL_SP = 0x7FFFEFFC;
+        static constexpr uint32_t INITIAL_GP = 0x10008000;
+        static constexpr uint32_t HEAP_BASE = 0x10040000;
+        static constexpr uint32_t HEAP_CHUNK = 0x00010000;
+        static constexpr size_t SUPERINSTRUCTION_COUNT = 24;
+        static constexpr uint32_t HOT_THRESHOLD = 256; //jumps to an entry before its block is translated
+        static constexpr size_t MAX_TRANSLATED = 256; //instructions in one translated block
+
+    private:
+        struct Translation
+        {
+            size_t m_entry;
+            size_t m_end; //entry after the last word it was translated from
+            NativeBlock m_block; //nullptr once a store into its words invalidated it, the next translation takes its slot
+            std::vector<uint8_t*> m_links; //exits of blocks linked to this one
+        };
+
+        static constexpr uint32_t COLD = 0xFFFFFFFF; //profile of an entry whose block can't be translated
+
+        struct CodeRegion
+        {
+            uint32_t m_base;
+            uint32_t m_size; //in bytes, without the entry that ends the region
+            const uint8_t* m_words;
+            std::vector<DecodedInstruction> m_code;
+            //with the JIT, one per entry: the jumps to it up to HOT_THRESHOLD, then HOT_THRESHOLD + 1 + the
+            //index of its translation, or COLD
+            std::vector<uint32_t> m_profile;
+            std::vector<Translation> m_translations;
+        };
+
+        Memory& m_memory;
+        CpuState m_state;
+        std::vector<CodeRegion> m_codeRegions;
+        Memory::Region m_readCache{ 0, 0, nullptr, false }; //region of the last load
+        Memory::Region m_writeCache{ 0, 0, nullptr, false }; //region of the last store, never one with code
+        bool m_selfModifyingCode;
+        std::unique_ptr<Jit> m_jit; //nullptr when only interpreting
+        JitContext m_jitContext{ &m_state, &m_memory, 0, nullptr };
+        uint64_t m_translatedBlocks = 0;
+        uint64_t m_linkedExits = 0;
+        uint64_t m_nativeEntries = 0;
+        uint32_t m_heapEnd = HEAP_BASE; //what sbrk hands out next
+        uint32_t m_heapLimit = HEAP_BASE; //end of the heap regions allocated so far
+        uint32_t m_maxFrequency;
+        uint64_t m_executed = 0;
+        uint64_t m_decodedBlocks = 0;
+        uint64_t m_invalidatedWords = 0;
+        std::array<uint64_t, SUPERINSTRUCTION_COUNT> m_fusions{}; //times each superinstruction ran
+        int m_exitCode = 0;
+        std::mt19937 m_random;
+
+        //Decodes the basic block at the entry, stopping early at an entry that is already decoded
+        template<std::endian E> void DecodeBlock(CodeRegion& region, size_t entry);
+        //Makes the words in the bytes, and superinstructions that run them, decode again the next time they run
+        void Invalidate(uint32_t address, uint32_t size);
+        CodeRegion* FindCode(uint32_t address);
+        //Translates the block at the entry, returns its profile from then on
+        uint32_t Translate(CodeRegion& region, size_t entry);
+
+        //Host address of a load, nullptr if the address is not mapped
+        const uint8_t* Readable(uint32_t address, uint32_t size)
+        {
+            uint32_t offset = address - m_readCache.m_base;
+            if (offset < m_readCache.m_size && m_readCache.m_size - offset >= size) return m_readCache.m_data + offset;
+            return ReadableSlow(address, size);
+        }
+        const uint8_t* ReadableSlow(uint32_t address, uint32_t size);
+
+        //Host address of a store, nullptr if the address is not mapped or is code that can't be written
+        uint8_t* Writable(uint32_t address, uint32_t size)
+        {
+            uint32_t offset = address - m_writeCache.m_base;
+            if (offset < m_writeCache.m_size && m_writeCache.m_size - offset >= size) return m_writeCache.m_data + offset;
+            return WritableSlow(address, size);
+        }
+        uint8_t* WritableSlow(uint32_t address, uint32_t size);
+
+        //Records an exception in coprocessor 0, throws if the program has no handler for it
+        void Raise(uint32_t cause, uint32_t badAddress, uint32_t pc);
+        //Runs the syscall in $v0, returns false if it ends the program
+        bool Syscall(uint32_t pc);
+        uint32_t Sbrk(uint32_t bytes);
+        std::string ReadString(uint32_t address);
+        //Runs the handlers with the loads and stores of the byte order E
+        template<std::endian E> int Execute();
+
+    public:
+        //Lays out the stack, $gp and the heap around the program already in memory. maxFrequency caps the
+        //instructions run per second, 0xFFFFFFFF runs as fast as possible. jit translates hot blocks where the
+        //host allows it, a throttled run is only interpreted
+        Interpreter(Memory& memory, bool selfModifyingCode = false, uint32_t maxFrequency = 0xFFFFFFFF, bool jit = false);
+        Interpreter(const Interpreter&) = delete;
+        Interpreter& operator=(const Interpreter&) = delete;
+        ~Interpreter();
+
+        //Runs from the entry point of the memory until the program exits, returns its exit code
+        int Run();
+
+        uint64_t Executed() const { return m_executed; }
+        uint64_t DecodedBlocks() const { return m_decodedBlocks; }
+        uint64_t InvalidatedWords() const { return m_invalidatedWords; }
+        uint64_t TranslatedBlocks() const { return m_translatedBlocks; }
+        uint64_t LinkedExits() const { return m_linkedExits; }
+        uint64_t NativeEntries() const { return m_nativeEntries; }
+        //Idiom of every superinstruction, like "lui+ori", and the times it ran
+        std::vector<std::pair<std::string_view, uint64_t>> Fusions() const;
+        CpuState& State() { return m_state; }
+    };
+}
@@ -0,0 +1,275 @@
+#include <bit>
+#include "isadescription.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(__GNUC__)
+//Like the UTF-8 kernels, the AVX2 encoder is compiled through target attributes and picked at runtime
+#define NEOMIPS_AVX2
+#endif
+#endif
+
+namespace NeoMIPS
+{
+    namespace ISA
+    {
+        namespace
+        {
+            //The descriptions in the layout the batch encoder reads them, one array per column
+            struct EncodeKernel
+            {
+                std::array<uint32_t, INSTRUCTION_COUNT> m_bases{};
+                std::array<std::array<uint32_t, INSTRUCTION_COUNT>, OPERAND_COUNT> m_masks{};
+                std::array<std::array<uint32_t, INSTRUCTION_COUNT>, OPERAND_COUNT> m_shifts{};
+            };
+
+            consteval EncodeKernel make_encode_kernel()
+            {
+                EncodeKernel kernel;
+                for (size_t i = 0; i < INSTRUCTION_COUNT; ++i)
+                {
+                    kernel.m_bases[i] = INSTRUCTION_DESCRIPTIONS[i].BaseWord();
+                    for (size_t operand = 0; operand < OPERAND_COUNT; ++operand)
+                    {
+                        kernel.m_masks[operand][i] = INSTRUCTION_DESCRIPTIONS[i].m_fields[operand].Mask();
+                        kernel.m_shifts[operand][i] = INSTRUCTION_DESCRIPTIONS[i].m_fields[operand].m_shift;
+                    }
+                }
+                return kernel;
+            }
+
+            constexpr EncodeKernel ENCODE_KERNEL = make_encode_kernel();
+
+            constexpr size_t OPCODE_COUNT = 64;
+
+            //Descriptions grouped by opcode, and inside each opcode the ones with more constant bits first, so
+            //nop is tried before sll and jalr with the implicit $ra before the general jalr
+            struct DecodeTable
+            {
+                std::array<uint8_t, INSTRUCTION_COUNT> m_order{};
+                std::array<uint8_t, OPCODE_COUNT + 1> m_starts{}; //where the descriptions of each opcode start in m_order
+            };
+
+            consteval DecodeTable make_decode_table()
+            {
+                auto precedes = [](const InstructionDescription& a, const InstructionDescription& b)
+                {
+                    if (a.m_opcode != b.m_opcode) return a.m_opcode < b.m_opcode;
+                    return std::popcount(a.FixedMask()) > std::popcount(b.FixedMask());
+                };
+
+                DecodeTable table;
+                for (size_t i = 0; i < INSTRUCTION_COUNT; ++i)
+                {
+                    size_t j = i;
+                    for (; j > 0 && precedes(INSTRUCTION_DESCRIPTIONS[i], INSTRUCTION_DESCRIPTIONS[table.m_order[j - 1]]); --j)
+                    {
+                        table.m_order[j] = table.m_order[j - 1];
+                    }
+                    table.m_order[j] = static_cast<uint8_t>(i);
+                }
+
+                size_t position = 0;
+                for (size_t opcode = 0; opcode <= OPCODE_COUNT; ++opcode)
+                {
+                    while (position < INSTRUCTION_COUNT && INSTRUCTION_DESCRIPTIONS[table.m_order[position]].m_opcode < opcode) ++position;
+                    table.m_starts[opcode] = static_cast<uint8_t>(position);
+                }
+                return table;
+            }
+
+            constexpr DecodeTable DECODE_TABLE = make_decode_table();
+
+            constexpr Instruction decode_word(uint32_t word, InstructionParameters& parameters)
+            {
+                uint32_t opcode = word >> 26;
+                for (uint32_t i = DECODE_TABLE.m_starts[opcode]; i < DECODE_TABLE.m_starts[opcode + 1]; ++i)
+                {
+                    const InstructionDescription& description = INSTRUCTION_DESCRIPTIONS[DECODE_TABLE.m_order[i]];
+                    if ((word & description.FixedMask()) != description.BaseWord()) continue;
+
+                    parameters = InstructionParameters{};
+                    parameters.m_reg1 = description.m_fields[static_cast<size_t>(EncodedOperand::Reg1)].Extract(word);
+                    parameters.m_reg2 = description.m_fields[static_cast<size_t>(EncodedOperand::Reg2)].Extract(word);
+                    parameters.m_reg3 = description.m_fields[static_cast<size_t>(EncodedOperand::Reg3)].Extract(word);
+                    parameters.m_immediate = description.m_fields[static_cast<size_t>(EncodedOperand::Immediate)].Extract(word);
+                    parameters.m_resolvedLabel = description.m_fields[static_cast<size_t>(EncodedOperand::Address)].Extract(word);
+                    return description.m_instruction;
+                }
+                return Instruction::invalid;
+            }
+
+            //Encoding any operands and decoding the word has to give the same instruction and operands back.
+            //The operands are all ones, so every field is filled up to its last bit
+            consteval bool round_trips()
+            {
+                for (const InstructionDescription& description : INSTRUCTION_DESCRIPTIONS)
+                {
+                    //jalr $ra, rs is the same word as jalr rs
+                    if (description.m_instruction == Instruction::JALR) continue;
+
+                    InstructionParameters parameters{};
+                    parameters.m_reg1 = description.m_fields[static_cast<size_t>(EncodedOperand::Reg1)].Mask();
+                    parameters.m_reg2 = description.m_fields[static_cast<size_t>(EncodedOperand::Reg2)].Mask();
+                    parameters.m_reg3 = description.m_fields[static_cast<size_t>(EncodedOperand::Reg3)].Mask();
+                    parameters.m_immediate = description.m_fields[static_cast<size_t>(EncodedOperand::Immediate)].Mask();
+                    parameters.m_resolvedLabel = description.m_fields[static_cast<size_t>(EncodedOperand::Address)].Mask();
+
+                    InstructionParameters decoded{};
+                    if (decode_word(encode(description.m_instruction, parameters), decoded) != description.m_instruction) return false;
+                    if (decoded.m_reg1 != parameters.m_reg1 || decoded.m_reg2 != parameters.m_reg2 || decoded.m_reg3 != parameters.m_reg3) return false;
+                    if (decoded.m_immediate != parameters.m_immediate || decoded.m_resolvedLabel != parameters.m_resolvedLabel) return false;
+                }
+                return true;
+            }
+
+            static_assert(round_trips(), "Two rows of INSTRUCTION_DESCRIPTIONS encode to the same words");
+
+            //Parameters as parse_instruction leaves them, memory operands have their displacement in both fields
+            consteval InstructionParameters operands(uint32_t reg1, uint32_t reg2 = 0, uint32_t reg3 = 0, uint32_t immediate = 0, uint32_t offset = 0)
+            {
+                InstructionParameters parameters{};
+                parameters.m_reg1 = reg1;
+                parameters.m_reg2 = reg2;
+                parameters.m_reg3 = reg3;
+                parameters.m_immediate = immediate;
+                parameters.m_offset = offset;
+                return parameters;
+            }
+
+            static_assert(encode(Instruction::NOP, InstructionParameters{}) == 0);
+            static_assert(encode(Instruction::ADD, operands(8, 9, 10)) == 0x012A4020); //add $t0, $t1, $t2
+            static_assert(encode(Instruction::ADDI, operands(8, 9, 0, 0xFFFFFFFF)) == 0x2128FFFF); //addi $t0, $t1, -1
+            static_assert(encode(Instruction::LW, operands(8, 29, 0, 4, 4)) == 0x8FA80004); //lw $t0, 4($sp)
+            static_assert(encode(Instruction::JR, operands(31)) == 0x03E00008); //jr $ra
+            static_assert(encode(Instruction::C_LT_S, operands(0, 2)) == 0x4602003C); //c.lt.s $f0, $f2
+            static_assert(encode(Instruction::MFC1, operands(8, 1)) == 0x44080800); //mfc1 $t0, $f1
+
+            void encode_scalar(const Instruction* instructions, const uint8_t* reg1, const uint8_t* reg2, const uint8_t* reg3,
+                const uint32_t* immediates, const uint32_t* addresses, size_t i, size_t count, uint32_t* out)
+            {
+                const EncodeKernel& k = ENCODE_KERNEL;
+                for (; i < count; ++i)
+                {
+                    size_t d = static_cast<size_t>(instructions[i]);
+                    out[i] = k.m_bases[d]
+                        | (reg1[i] & k.m_masks[0][d]) << k.m_shifts[0][d]
+                        | (reg2[i] & k.m_masks[1][d]) << k.m_shifts[1][d]
+                        | (reg3[i] & k.m_masks[2][d]) << k.m_shifts[2][d]
+                        | (immediates[i] & k.m_masks[3][d]) << k.m_shifts[3][d]
+                        | (addresses[i] & k.m_masks[4][d]) << k.m_shifts[4][d];
+                }
+            }
+
+#ifdef NEOMIPS_AVX2
+            const bool hasAvx2 = __builtin_cpu_supports("avx2");
+
+            static_assert(sizeof(Instruction) == sizeof(int32_t), "The AVX2 encoder indexes the kernel with the instructions as they are");
+
+            __attribute__((target("avx2"))) inline __m256i load_registers(const uint8_t* registers)
+            {
+                return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(registers)));
+            }
+
+            __attribute__((target("avx2"))) inline __m256i load_words(const uint32_t* words)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+            }
+
+            //A run of the same instruction, as unrolled code has. Its masks and shifts are broadcast once and every
+            //word is five and, shift and or operations over eight lanes. Returns how many words it encoded
+            __attribute__((target("avx2"))) size_t encode_run_avx2(size_t d, const uint8_t* reg1, const uint8_t* reg2, const uint8_t* reg3,
+                const uint32_t* immediates, const uint32_t* addresses, size_t count, uint32_t* out)
+            {
+                const EncodeKernel& k = ENCODE_KERNEL;
+                const __m256i base = _mm256_set1_epi32(static_cast<int32_t>(k.m_bases[d]));
+                __m256i masks[OPERAND_COUNT];
+                __m128i shifts[OPERAND_COUNT];
+                for (size_t operand = 0; operand < OPERAND_COUNT; ++operand)
+                {
+                    masks[operand] = _mm256_set1_epi32(static_cast<int32_t>(k.m_masks[operand][d]));
+                    shifts[operand] = _mm_cvtsi32_si128(static_cast<int32_t>(k.m_shifts[operand][d]));
+                }
+
+                size_t i = 0;
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i word = base;
+                    word = _mm256_or_si256(word, _mm256_sll_epi32(_mm256_and_si256(load_registers(reg1 + i), masks[0]), shifts[0]));
+                    word = _mm256_or_si256(word, _mm256_sll_epi32(_mm256_and_si256(load_registers(reg2 + i), masks[1]), shifts[1]));
+                    word = _mm256_or_si256(word, _mm256_sll_epi32(_mm256_and_si256(load_registers(reg3 + i), masks[2]), shifts[2]));
+                    word = _mm256_or_si256(word, _mm256_sll_epi32(_mm256_and_si256(load_words(immediates + i), masks[3]), shifts[3]));
+                    word = _mm256_or_si256(word, _mm256_sll_epi32(_mm256_and_si256(load_words(addresses + i), masks[4]), shifts[4]));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), word);
+                }
+                return i;
+            }
+
+            __attribute__((target("avx2"))) inline __m256i gather(const std::array<uint32_t, INSTRUCTION_COUNT>& column, __m256i instructions)
+            {
+                return _mm256_i32gather_epi32(reinterpret_cast<const int*>(column.data()), instructions, 4);
+            }
+
+            __attribute__((target("avx2"))) inline __m256i place(__m256i value, size_t operand, __m256i instructions)
+            {
+                const EncodeKernel& k = ENCODE_KERNEL;
+                return _mm256_sllv_epi32(_mm256_and_si256(value, gather(k.m_masks[operand], instructions)), gather(k.m_shifts[operand], instructions));
+            }
+
+            //Eight words of any instructions, the base, masks and shifts of every lane are gathered from the kernel
+            __attribute__((target("avx2"))) void encode_mixed_avx2(const Instruction* instructions, const uint8_t* reg1, const uint8_t* reg2, const uint8_t* reg3,
+                const uint32_t* immediates, const uint32_t* addresses, uint32_t* out)
+            {
+                const __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(instructions));
+
+                __m256i word = gather(ENCODE_KERNEL.m_bases, index);
+                word = _mm256_or_si256(word, place(load_registers(reg1), 0, index));
+                word = _mm256_or_si256(word, place(load_registers(reg2), 1, index));
+                word = _mm256_or_si256(word, place(load_registers(reg3), 2, index));
+                word = _mm256_or_si256(word, place(load_words(immediates), 3, index));
+                word = _mm256_or_si256(word, place(load_words(addresses), 4, index));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), word);
+            }
+
+            //Encodes blocks of eight words while there are any, using the broadcast kernel for runs of one instruction.
+            //Returns where the scalar kernel has to go on
+            __attribute__((target("avx2"))) size_t encode_avx2(const Instruction* instructions, const uint8_t* reg1, const uint8_t* reg2, const uint8_t* reg3,
+                const uint32_t* immediates, const uint32_t* addresses, size_t count, uint32_t* out)
+            {
+                size_t i = 0;
+                while (i + 8 <= count)
+                {
+                    size_t run = 1;
+                    while (i + run < count && instructions[i + run] == instructions[i]) ++run;
+
+                    if (run >= 8)
+                    {
+                        i += encode_run_avx2(static_cast<size_t>(instructions[i]), reg1 + i, reg2 + i, reg3 + i, immediates + i, addresses + i, run, out + i);
+                    }
+                    else
+                    {
+                        encode_mixed_avx2(instructions + i, reg1 + i, reg2 + i, reg3 + i, immediates + i, addresses + i, out + i);
+                        i += 8;
+                    }
+                }
+                return i;
+            }
+#endif
+        }
+
+        void encode_batch(const Instruction* instructions, const uint8_t* reg1, const uint8_t* reg2, const uint8_t* reg3,
+            const uint32_t* immediates, const uint32_t* addresses, size_t count, uint32_t* out)
+        {
+            size_t i = 0;
+#ifdef NEOMIPS_AVX2
+            if (hasAvx2) i = encode_avx2(instructions, reg1, reg2, reg3, immediates, addresses, count, out);
+#endif
+            encode_scalar(instructions, reg1, reg2, reg3, immediates, addresses, i, count, out);
+        }
+
+        Instruction decode(uint32_t word, InstructionParameters& parameters)
+        {
+            return decode_word(word, parameters);
+        }
+    }
+}
@@ -0,0 +1,343 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include "mips32isa.hpp"
+#include "types.hpp"
+
+namespace NeoMIPS
+{
+    namespace ISA
+    {
+        //Bits of the machine word an operand is placed in
+        struct Field
+        {
+            uint8_t m_shift;
+            uint8_t m_width; //0 when the instruction doesn't encode the operand
+
+            constexpr uint32_t Mask() const { return static_cast<uint32_t>((1ULL << m_width) - 1); }
+            constexpr uint32_t Place(uint32_t value) const { return (value & Mask()) << m_shift; }
+            constexpr uint32_t Extract(uint32_t word) const { return (word >> m_shift) & Mask(); }
+        };
+
+        namespace Fields
+        {
+            constexpr Field NONE{ 0, 0 };
+            constexpr Field RS{ 21, 5 };
+            constexpr Field RT{ 16, 5 };
+            constexpr Field RD{ 11, 5 };
+            constexpr Field SA{ 6, 5 };
+            constexpr Field FT{ 16, 5 };
+            constexpr Field FS{ 11, 5 };
+            constexpr Field FD{ 6, 5 };
+            constexpr Field IMM16{ 0, 16 };
+            constexpr Field TARGET{ 0, 26 };
+            constexpr Field CODE{ 6, 20 };   //of syscall and break, free for the software that handles them
+            constexpr Field CC{ 18, 3 };     //condition flag read by bc1f, bc1t and the movf and movt family
+            constexpr Field COND_CC{ 8, 3 }; //condition flag written by c.cond.fmt
+        }
+
+        //Members of InstructionParameters an instruction can encode, in the order of InstructionDescription::m_fields.
+        //Address is m_resolvedLabel + m_offset, the offset is only set for memory operands
+        enum class EncodedOperand : uint8_t
+        {
+            Reg1,
+            Reg2,
+            Reg3,
+            Immediate,
+            Address,
+            Count
+        };
+
+        constexpr size_t OPERAND_COUNT = static_cast<size_t>(EncodedOperand::Count);
+
+        //How the address of a label becomes the Address operand
+        enum class Relocation : uint8_t
+        {
+            Absolute,     //the address itself, loads and stores add their offset to it
+            Branch,       //words from the instruction after the branch
+            Jump,         //word index inside the 256 MiB region of the jump
+            High,         //upper half of the address plus the immediate, into the immediate, for lui
+            HighAdjusted, //like High, for a lui whose partner sign extends the lower half
+            Low           //lower half of the address plus the immediate, into the immediate, for ori
+        };
+
+        //Everything there is to know about one machine instruction. The encoder, the decoder, the mnemonic
+        //table and the operand checks are all generated from INSTRUCTION_DESCRIPTIONS
+        struct InstructionDescription
+        {
+            Instruction m_instruction;
+            std::u32string_view m_mnemonic;
+            InstructionSyntacticArchetypes m_archetypes; //operand forms accepted, pseudoinstruction forms included
+            uint32_t m_opcode;
+            uint32_t m_fmt;   //rs field, holds the format or the operation of coprocessor instructions
+            uint32_t m_funct;
+            uint32_t m_fixed; //any other constant bits, already in place
+            std::array<Field, OPERAND_COUNT> m_fields;
+            Relocation m_relocation = Relocation::Absolute;
+
+            constexpr uint32_t BaseWord() const { return m_opcode << 26 | m_fmt << 21 | m_fixed | m_funct; }
+
+            //Bits that hold no operand, a word is this instruction if they match the base word
+            constexpr uint32_t FixedMask() const
+            {
+                uint32_t operands = 0;
+                for (const Field& field : m_fields) operands |= field.Mask() << field.m_shift;
+                return ~operands;
+            }
+        };
+
+        constexpr size_t INSTRUCTION_COUNT = static_cast<size_t>(Instruction::invalid);
+
+        consteval std::array<InstructionDescription, INSTRUCTION_COUNT> make_instruction_descriptions()
+        {
+            using enum InstructionSyntacticArchetypes;
+            using namespace Encoding;
+            using namespace Fields;
+            namespace L = Instructions::Literals;
+
+            constexpr InstructionSyntacticArchetypes MEMORY = RegMemReg | RegImm | RegOffsetForReg | RegLabel | RegLabelAsOffsetReg | RegLabelPlusImm | RegLabelPlusImmOffsetForReg;
+            constexpr uint32_t TF = 1 << 16; //true instead of false, for the instructions that test a condition flag
+
+            return { {
+                { Instruction::ABS_D, L::ABS_D, RegReg, cop::COP1, fmt::D, 0b000101, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::ABS_S, L::ABS_S, RegReg, cop::COP1, fmt::S, 0b000101, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::ADD, L::ADD, RegRegReg | RegRegImm, cop::SPECIAL, 0, 0b100000, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::ADD_D, L::ADD_D, RegRegReg, cop::COP1, fmt::D, 0b000000, 0, { FD, FS, FT, NONE, NONE } },
+                { Instruction::ADD_S, L::ADD_S, RegRegReg, cop::COP1, fmt::S, 0b000000, 0, { FD, FS, FT, NONE, NONE } },
+                { Instruction::ADDI, L::ADDI, RegRegImm, 0b001000, 0, 0, 0, { RT, RS, NONE, IMM16, NONE } },
+                { Instruction::ADDIU, L::ADDIU, RegRegImm, 0b001001, 0, 0, 0, { RT, RS, NONE, IMM16, NONE } },
+                { Instruction::ADDU, L::ADDU, RegRegReg | RegRegImm, cop::SPECIAL, 0, 0b100001, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::AND, L::AND, RegRegReg | RegRegImm | RegImm, cop::SPECIAL, 0, 0b100100, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::ANDI, L::ANDI, RegRegImm | RegImm, 0b001100, 0, 0, 0, { RT, RS, NONE, IMM16, NONE } },
+                { Instruction::BC1F, L::BC1F, Label | ImmLabel, cop::COP1, fmt::BC, 0, 0, { NONE, NONE, NONE, CC, IMM16 }, Relocation::Branch },
+                { Instruction::BC1T, L::BC1T, Label | ImmLabel, cop::COP1, fmt::BC, 0, TF, { NONE, NONE, NONE, CC, IMM16 }, Relocation::Branch },
+                { Instruction::BEQ, L::BEQ, RegRegLabel | RegImmLabel, 0b000100, 0, 0, 0, { RS, RT, NONE, NONE, IMM16 }, Relocation::Branch },
+                { Instruction::BGEZ, L::BGEZ, RegLabel, cop::REGIMM, 0, 0, 0b00001 << 16, { RS, NONE, NONE, NONE, IMM16 }, Relocation::Branch },
+                { Instruction::BGEZAL, L::BGEZAL, RegLabel, cop::REGIMM, 0, 0, 0b10001 << 16, { RS, NONE, NONE, NONE, IMM16 }, Relocation::Branch },
+                { Instruction::BGTZ, L::BGTZ, RegLabel, 0b000111, 0, 0, 0, { RS, NONE, NONE, NONE, IMM16 }, Relocation::Branch },
+                { Instruction::BLEZ, L::BLEZ, RegLabel, 0b000110, 0, 0, 0, { RS, NONE, NONE, NONE, IMM16 }, Relocation::Branch },
+                { Instruction::BLTZ, L::BLTZ, RegLabel, cop::REGIMM, 0, 0, 0b00000 << 16, { RS, NONE, NONE, NONE, IMM16 }, Relocation::Branch },
+                { Instruction::BLTZAL, L::BLTZAL, RegLabel, cop::REGIMM, 0, 0, 0b10000 << 16, { RS, NONE, NONE, NONE, IMM16 }, Relocation::Branch },
+                { Instruction::BNE, L::BNE, RegRegLabel | RegImmLabel, 0b000101, 0, 0, 0, { RS, RT, NONE, NONE, IMM16 }, Relocation::Branch },
+                { Instruction::BREAK, L::BREAK, NoParams | Imm, cop::SPECIAL, 0, 0b001101, 0, { NONE, NONE, NONE, CODE, NONE } },
+                { Instruction::C_EQ_D, L::C_EQ_D, ImmRegReg | RegReg, cop::COP1, fmt::D, 0b110010, 0, { FS, FT, NONE, COND_CC, NONE } },
+                { Instruction::C_EQ_S, L::C_EQ_S, ImmRegReg | RegReg, cop::COP1, fmt::S, 0b110010, 0, { FS, FT, NONE, COND_CC, NONE } },
+                { Instruction::C_LE_D, L::C_LE_D, ImmRegReg | RegReg, cop::COP1, fmt::D, 0b111110, 0, { FS, FT, NONE, COND_CC, NONE } },
+                { Instruction::C_LE_S, L::C_LE_S, ImmRegReg | RegReg, cop::COP1, fmt::S, 0b111110, 0, { FS, FT, NONE, COND_CC, NONE } },
+                { Instruction::C_LT_D, L::C_LT_D, ImmRegReg | RegReg, cop::COP1, fmt::D, 0b111100, 0, { FS, FT, NONE, COND_CC, NONE } },
+                { Instruction::C_LT_S, L::C_LT_S, ImmRegReg | RegReg, cop::COP1, fmt::S, 0b111100, 0, { FS, FT, NONE, COND_CC, NONE } },
+                { Instruction::CEIL_W_D, L::CEIL_W_D, RegReg, cop::COP1, fmt::D, 0b001110, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::CEIL_W_S, L::CEIL_W_S, RegReg, cop::COP1, fmt::S, 0b001110, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::CLO, L::CLO, RegReg, cop::SPECIAL2, 0, 0b100001, 0, { RD, RS, NONE, NONE, NONE } },
+                { Instruction::CLZ, L::CLZ, RegReg, cop::SPECIAL2, 0, 0b100000, 0, { RD, RS, NONE, NONE, NONE } },
+                { Instruction::CVT_D_S, L::CVT_D_S, RegReg, cop::COP1, fmt::S, 0b100001, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::CVT_D_W, L::CVT_D_W, RegReg, cop::COP1, fmt::W, 0b100001, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::CVT_S_D, L::CVT_S_D, RegReg, cop::COP1, fmt::D, 0b100000, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::CVT_S_W, L::CVT_S_W, RegReg, cop::COP1, fmt::W, 0b100000, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::CVT_W_D, L::CVT_W_D, RegReg, cop::COP1, fmt::D, 0b100100, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::CVT_W_S, L::CVT_W_S, RegReg, cop::COP1, fmt::S, 0b100100, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::DIV, L::DIV, RegReg | RegRegReg | RegRegImm, cop::SPECIAL, 0, 0b011010, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::DIV_D, L::DIV_D, RegRegReg, cop::COP1, fmt::D, 0b000011, 0, { FD, FS, FT, NONE, NONE } },
+                { Instruction::DIV_S, L::DIV_S, RegRegReg, cop::COP1, fmt::S, 0b000011, 0, { FD, FS, FT, NONE, NONE } },
+                { Instruction::DIVU, L::DIVU, RegReg | RegRegReg | RegRegImm, cop::SPECIAL, 0, 0b011011, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::ERET, L::ERET, NoParams, cop::COP0, 0, 0b011000, 1 << 25, { NONE, NONE, NONE, NONE, NONE } },
+                { Instruction::FLOOR_W_D, L::FLOOR_W_D, RegReg, cop::COP1, fmt::D, 0b001111, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::FLOOR_W_S, L::FLOOR_W_S, RegReg, cop::COP1, fmt::S, 0b001111, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::J, L::J, Label, 0b000010, 0, 0, 0, { NONE, NONE, NONE, NONE, TARGET }, Relocation::Jump },
+                { Instruction::JAL, L::JAL, Label, 0b000011, 0, 0, 0, { NONE, NONE, NONE, NONE, TARGET }, Relocation::Jump },
+                { Instruction::JALR_RA, L::JALR_RA, Reg, cop::SPECIAL, 0, 0b001001, 31 << 11, { RS, NONE, NONE, NONE, NONE } },
+                { Instruction::JALR, L::JALR, Reg | RegReg, cop::SPECIAL, 0, 0b001001, 0, { RD, RS, NONE, NONE, NONE } },
+                { Instruction::JR, L::JR, Reg, cop::SPECIAL, 0, 0b001000, 0, { RS, NONE, NONE, NONE, NONE } },
+                { Instruction::LB, L::LB, MEMORY, 0b100000, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LBU, L::LBU, MEMORY, 0b100100, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LDC1, L::LDC1, MEMORY, 0b110101, 0, 0, 0, { FT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LH, L::LH, MEMORY, 0b100001, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LHU, L::LHU, MEMORY, 0b100101, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LL, L::LL, MEMORY, 0b110000, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LUI, L::LUI, RegImm | RegLabel, 0b001111, 0, 0, 0, { RT, NONE, NONE, IMM16, NONE }, Relocation::High },
+                { Instruction::LW, L::LW, MEMORY, 0b100011, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LWC1, L::LWC1, MEMORY, 0b110001, 0, 0, 0, { FT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LWL, L::LWL, MEMORY, 0b100010, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::LWR, L::LWR, MEMORY, 0b100110, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::MADD, L::MADD, RegReg, cop::SPECIAL2, 0, 0b000000, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::MADDU, L::MADDU, RegReg, cop::SPECIAL2, 0, 0b000001, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::MFC0, L::MFC0, RegReg, cop::COP0, fmt::MF, 0, 0, { RT, RD, NONE, NONE, NONE } },
+                { Instruction::MFC1, L::MFC1, RegReg, cop::COP1, fmt::MF, 0, 0, { RT, FS, NONE, NONE, NONE } },
+                { Instruction::MFHI, L::MFHI, Reg, cop::SPECIAL, 0, 0b010000, 0, { RD, NONE, NONE, NONE, NONE } },
+                { Instruction::MFLO, L::MFLO, Reg, cop::SPECIAL, 0, 0b010010, 0, { RD, NONE, NONE, NONE, NONE } },
+                { Instruction::MOV_D, L::MOV_D, RegReg, cop::COP1, fmt::D, 0b000110, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::MOV_S, L::MOV_S, RegReg, cop::COP1, fmt::S, 0b000110, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::MOVF, L::MOVF, RegReg | RegRegImm, cop::SPECIAL, 0, 0b000001, 0, { RD, RS, NONE, CC, NONE } },
+                { Instruction::MOVF_D, L::MOVF_D, RegReg | RegRegImm, cop::COP1, fmt::D, 0b010001, 0, { FD, FS, NONE, CC, NONE } },
+                { Instruction::MOVF_S, L::MOVF_S, RegReg | RegRegImm, cop::COP1, fmt::S, 0b010001, 0, { FD, FS, NONE, CC, NONE } },
+                { Instruction::MOVN, L::MOVN, RegRegReg, cop::SPECIAL, 0, 0b001011, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::MOVN_D, L::MOVN_D, RegRegReg, cop::COP1, fmt::D, 0b010011, 0, { FD, FS, RT, NONE, NONE } },
+                { Instruction::MOVN_S, L::MOVN_S, RegRegReg, cop::COP1, fmt::S, 0b010011, 0, { FD, FS, RT, NONE, NONE } },
+                { Instruction::MOVT, L::MOVT, RegReg | RegRegImm, cop::SPECIAL, 0, 0b000001, TF, { RD, RS, NONE, CC, NONE } },
+                { Instruction::MOVT_D, L::MOVT_D, RegReg | RegRegImm, cop::COP1, fmt::D, 0b010001, TF, { FD, FS, NONE, CC, NONE } },
+                { Instruction::MOVT_S, L::MOVT_S, RegReg | RegRegImm, cop::COP1, fmt::S, 0b010001, TF, { FD, FS, NONE, CC, NONE } },
+                { Instruction::MOVZ, L::MOVZ, RegRegReg, cop::SPECIAL, 0, 0b001010, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::MOVZ_D, L::MOVZ_D, RegRegReg, cop::COP1, fmt::D, 0b010010, 0, { FD, FS, RT, NONE, NONE } },
+                { Instruction::MOVZ_S, L::MOVZ_S, RegRegReg, cop::COP1, fmt::S, 0b010010, 0, { FD, FS, RT, NONE, NONE } },
+                { Instruction::MSUB, L::MSUB, RegReg, cop::SPECIAL2, 0, 0b000100, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::MSUBU, L::MSUBU, RegReg, cop::SPECIAL2, 0, 0b000101, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::MTC0, L::MTC0, RegReg, cop::COP0, fmt::MT, 0, 0, { RT, RD, NONE, NONE, NONE } },
+                { Instruction::MTC1, L::MTC1, RegReg, cop::COP1, fmt::MT, 0, 0, { RT, FS, NONE, NONE, NONE } },
+                { Instruction::MTHI, L::MTHI, Reg, cop::SPECIAL, 0, 0b010001, 0, { RS, NONE, NONE, NONE, NONE } },
+                { Instruction::MTLO, L::MTLO, Reg, cop::SPECIAL, 0, 0b010011, 0, { RS, NONE, NONE, NONE, NONE } },
+                { Instruction::MUL, L::MUL, RegRegReg | RegRegImm, cop::SPECIAL2, 0, 0b000010, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::MUL_D, L::MUL_D, RegRegReg, cop::COP1, fmt::D, 0b000010, 0, { FD, FS, FT, NONE, NONE } },
+                { Instruction::MUL_S, L::MUL_S, RegRegReg, cop::COP1, fmt::S, 0b000010, 0, { FD, FS, FT, NONE, NONE } },
+                { Instruction::MULT, L::MULT, RegReg, cop::SPECIAL, 0, 0b011000, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::MULTU, L::MULTU, RegReg, cop::SPECIAL, 0, 0b011001, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::NEG_D, L::NEG_D, RegReg, cop::COP1, fmt::D, 0b000111, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::NEG_S, L::NEG_S, RegReg, cop::COP1, fmt::S, 0b000111, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::NOP, L::NOP, NoParams, cop::SPECIAL, 0, 0, 0, { NONE, NONE, NONE, NONE, NONE } },
+                { Instruction::NOR, L::NOR, RegRegReg, cop::SPECIAL, 0, 0b100111, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::OR, L::OR, RegRegReg | RegRegImm | RegImm, cop::SPECIAL, 0, 0b100101, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::ORI, L::ORI, RegRegImm | RegImm, 0b001101, 0, 0, 0, { RT, RS, NONE, IMM16, NONE }, Relocation::Low },
+                { Instruction::ROUND_W_D, L::ROUND_W_D, RegReg, cop::COP1, fmt::D, 0b001100, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::ROUND_W_S, L::ROUND_W_S, RegReg, cop::COP1, fmt::S, 0b001100, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::SB, L::SB, MEMORY, 0b101000, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::SC, L::SC, MEMORY, 0b111000, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::SDC1, L::SDC1, MEMORY, 0b111101, 0, 0, 0, { FT, RS, NONE, NONE, IMM16 } },
+                { Instruction::SH, L::SH, MEMORY, 0b101001, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::SLL, L::SLL, RegRegImm, cop::SPECIAL, 0, 0b000000, 0, { RD, RT, NONE, SA, NONE } },
+                { Instruction::SLLV, L::SLLV, RegRegReg, cop::SPECIAL, 0, 0b000100, 0, { RD, RT, RS, NONE, NONE } },
+                { Instruction::SLT, L::SLT, RegRegReg, cop::SPECIAL, 0, 0b101010, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::SLTI, L::SLTI, RegRegImm, 0b001010, 0, 0, 0, { RT, RS, NONE, IMM16, NONE } },
+                { Instruction::SLTIU, L::SLTIU, RegRegImm, 0b001011, 0, 0, 0, { RT, RS, NONE, IMM16, NONE } },
+                { Instruction::SLTU, L::SLTU, RegRegReg, cop::SPECIAL, 0, 0b101011, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::SQRT_D, L::SQRT_D, RegReg, cop::COP1, fmt::D, 0b000100, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::SQRT_S, L::SQRT_S, RegReg, cop::COP1, fmt::S, 0b000100, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::SRA, L::SRA, RegRegImm, cop::SPECIAL, 0, 0b000011, 0, { RD, RT, NONE, SA, NONE } },
+                { Instruction::SRAV, L::SRAV, RegRegReg, cop::SPECIAL, 0, 0b000111, 0, { RD, RT, RS, NONE, NONE } },
+                { Instruction::SRL, L::SRL, RegRegImm, cop::SPECIAL, 0, 0b000010, 0, { RD, RT, NONE, SA, NONE } },
+                { Instruction::SRLV, L::SRLV, RegRegReg, cop::SPECIAL, 0, 0b000110, 0, { RD, RT, RS, NONE, NONE } },
+                { Instruction::SUB, L::SUB, RegRegReg | RegRegImm, cop::SPECIAL, 0, 0b100010, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::SUB_D, L::SUB_D, RegRegReg, cop::COP1, fmt::D, 0b000001, 0, { FD, FS, FT, NONE, NONE } },
+                { Instruction::SUB_S, L::SUB_S, RegRegReg, cop::COP1, fmt::S, 0b000001, 0, { FD, FS, FT, NONE, NONE } },
+                { Instruction::SUBU, L::SUBU, RegRegReg | RegRegImm, cop::SPECIAL, 0, 0b100011, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::SW, L::SW, MEMORY, 0b101011, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::SWC1, L::SWC1, MEMORY, 0b111001, 0, 0, 0, { FT, RS, NONE, NONE, IMM16 } },
+                { Instruction::SWL, L::SWL, MEMORY, 0b101010, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::SWR, L::SWR, MEMORY, 0b101110, 0, 0, 0, { RT, RS, NONE, NONE, IMM16 } },
+                { Instruction::SYSCALL, L::SYSCALL, NoParams, cop::SPECIAL, 0, 0b001100, 0, { NONE, NONE, NONE, CODE, NONE } },
+                { Instruction::TEQ, L::TEQ, RegReg, cop::SPECIAL, 0, 0b110100, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::TEQI, L::TEQI, RegImm, cop::REGIMM, 0, 0, 0b01100 << 16, { RS, NONE, NONE, IMM16, NONE } },
+                { Instruction::TGE, L::TGE, RegReg, cop::SPECIAL, 0, 0b110000, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::TGEI, L::TGEI, RegImm, cop::REGIMM, 0, 0, 0b01000 << 16, { RS, NONE, NONE, IMM16, NONE } },
+                { Instruction::TGEIU, L::TGEIU, RegImm, cop::REGIMM, 0, 0, 0b01001 << 16, { RS, NONE, NONE, IMM16, NONE } },
+                { Instruction::TGEU, L::TGEU, RegReg, cop::SPECIAL, 0, 0b110001, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::TLT, L::TLT, RegReg, cop::SPECIAL, 0, 0b110010, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::TLTI, L::TLTI, RegImm, cop::REGIMM, 0, 0, 0b01010 << 16, { RS, NONE, NONE, IMM16, NONE } },
+                { Instruction::TLTIU, L::TLTIU, RegImm, cop::REGIMM, 0, 0, 0b01011 << 16, { RS, NONE, NONE, IMM16, NONE } },
+                { Instruction::TLTU, L::TLTU, RegReg, cop::SPECIAL, 0, 0b110011, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::TNE, L::TNE, RegReg, cop::SPECIAL, 0, 0b110110, 0, { RS, RT, NONE, NONE, NONE } },
+                { Instruction::TNEI, L::TNEI, RegImm, cop::REGIMM, 0, 0, 0b01110 << 16, { RS, NONE, NONE, IMM16, NONE } },
+                { Instruction::TRUNC_W_D, L::TRUNC_W_D, RegReg, cop::COP1, fmt::D, 0b001101, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::TRUNC_W_S, L::TRUNC_W_S, RegReg, cop::COP1, fmt::S, 0b001101, 0, { FD, FS, NONE, NONE, NONE } },
+                { Instruction::XOR, L::XOR, RegRegReg | RegRegImm | RegImm, cop::SPECIAL, 0, 0b100110, 0, { RD, RS, RT, NONE, NONE } },
+                { Instruction::XORI, L::XORI, RegRegImm | RegImm, 0b001110, 0, 0, 0, { RT, RS, NONE, IMM16, NONE } }
+            } };
+        }
+
+        //Indexed by Instruction
+        constexpr std::array<InstructionDescription, INSTRUCTION_COUNT> INSTRUCTION_DESCRIPTIONS = make_instruction_descriptions();
+
+        constexpr const InstructionDescription& describe(Instruction instruction)
+        {
+            return INSTRUCTION_DESCRIPTIONS[static_cast<size_t>(instruction)];
+        }
+
+        //Every row is in the place of its instruction, and no operand overlaps another one or a constant field
+        consteval bool well_formed(const std::array<InstructionDescription, INSTRUCTION_COUNT>& descriptions)
+        {
+            for (size_t i = 0; i < descriptions.size(); ++i)
+            {
+                const InstructionDescription& description = descriptions[i];
+                if (static_cast<size_t>(description.m_instruction) != i) return false;
+
+                uint32_t used = description.BaseWord();
+                for (const Field& field : description.m_fields)
+                {
+                    uint32_t bits = field.Mask() << field.m_shift;
+                    if ((used & bits) != 0) return false;
+                    used |= bits;
+                }
+            }
+            return true;
+        }
+
+        static_assert(well_formed(INSTRUCTION_DESCRIPTIONS), "Broken row in INSTRUCTION_DESCRIPTIONS");
+
+        //Mnemonics in the form the mnemonic table is built from
+        template<size_t... Is>
+        consteval auto make_instruction_mnemonics(std::index_sequence<Is...>)
+        {
+            return std::array<std::pair<const std::u32string_view, Instruction>, sizeof...(Is)>{ {
+                { INSTRUCTION_DESCRIPTIONS[Is].m_mnemonic, INSTRUCTION_DESCRIPTIONS[Is].m_instruction }...
+            } };
+        }
+
+        constexpr auto INSTRUCTION_MNEMONICS = make_instruction_mnemonics(std::make_index_sequence<INSTRUCTION_COUNT>());
+
+        constexpr uint32_t operand_value(const InstructionParameters& parameters, EncodedOperand operand)
+        {
+            switch (operand)
+            {
+            case EncodedOperand::Reg1: return parameters.m_reg1;
+            case EncodedOperand::Reg2: return parameters.m_reg2;
+            case EncodedOperand::Reg3: return parameters.m_reg3;
+            case EncodedOperand::Immediate: return parameters.m_immediate;
+            case EncodedOperand::Address: return parameters.m_resolvedLabel + parameters.m_offset;
+            default: return 0;
+            }
+        }
+
+        //Machine word of an instruction whose label is already resolved and relocated as m_relocation says
+        constexpr uint32_t encode(Instruction instruction, const InstructionParameters& parameters)
+        {
+            const InstructionDescription& description = describe(instruction);
+            uint32_t word = description.BaseWord();
+            for (size_t i = 0; i < OPERAND_COUNT; ++i)
+            {
+                word |= description.m_fields[i].Place(operand_value(parameters, static_cast<EncodedOperand>(i)));
+            }
+            return word;
+        }
+
+        //Encodes count instructions given as parallel arrays of operands, addresses holding the relocated labels
+        //plus the offsets. Operands the instruction doesn't have are masked with zero instead of being skipped,
+        //so the loop has no branches and every word takes the same path. With AVX2, runs of one instruction take
+        //eight words per step with broadcast fields and mixed code gathers the fields of each lane
+        void encode_batch(const Instruction* instructions, const uint8_t* reg1, const uint8_t* reg2, const uint8_t* reg3,
+            const uint32_t* immediates, const uint32_t* addresses, size_t count, uint32_t* out);
+
+        //Whether the operands fit the fields the instruction puts them in. Registers have to be below 32 and
+        //immediates have to fit either as unsigned or as sign extended values. Addresses are checked once linked
+        constexpr bool operands_fit(Instruction instruction, const InstructionParameters& parameters)
+        {
+            const InstructionDescription& description = describe(instruction);
+            for (size_t i = 0; i < static_cast<size_t>(EncodedOperand::Address); ++i)
+            {
+                const Field& field = description.m_fields[i];
+                if (field.m_width == 0) continue;
+
+                uint32_t value = operand_value(parameters, static_cast<EncodedOperand>(i));
+                bool isRegister = i != static_cast<size_t>(EncodedOperand::Immediate);
+                bool fitsUnsigned = value <= field.Mask();
+                bool fitsSigned = (value | (field.Mask() >> 1)) == 0xFFFFFFFF;
+                if (!fitsUnsigned && (isRegister || !fitsSigned)) return false;
+            }
+            return true;
+        }
+
+        //Instruction of a machine word, with its operands put back where the lexer had them. The Address operand
+        //is returned raw in m_resolvedLabel, as the relocated field and not as the label address
+        Instruction decode(uint32_t word, InstructionParameters& parameters);
+    }
+}
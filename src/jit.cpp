@@ -0,0 +1,872 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+#include "jit.hpp"
+
+#ifdef NEOMIPS_JIT
+#include <sys/mman.h>
+#endif
+
+namespace NeoMIPS
+{
+#ifdef NEOMIPS_JIT
+    namespace
+    {
+        using ISA::Instruction;
+
+        enum Register : uint8_t { RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15 };
+
+        enum Condition : uint8_t
+        {
+            OVERFLOW = 0x0, BELOW = 0x2, ABOVE_EQUAL = 0x3, EQUAL = 0x4, NOT_EQUAL = 0x5, ABOVE = 0x7,
+            NOT_PARITY = 0xB, LESS = 0xC, GREATER_EQUAL = 0xD, LESS_EQUAL = 0xE, GREATER = 0xF
+        };
+        constexpr int ALWAYS = -1;
+
+        //Digits of the opcodes that take their operation in the ModRM byte, and opcodes of the register forms
+        enum Digit : uint8_t { ADD = 0, OR = 1, AND = 4, SUB = 5, XOR = 6, CMP = 7, NOT = 2, MUL = 4, IMUL = 5, SHL = 4, SHR = 5, SAR = 7 };
+        constexpr uint8_t ADD_RM = 0x03, OR_RM = 0x0B, AND_RM = 0x23, SUB_RM = 0x2B, XOR_RM = 0x33, CMP_RM = 0x3B, TEST_RM = 0x85;
+        constexpr uint8_t MOV_RM = 0x8B, MOV_MR = 0x89, LEA = 0x8D;
+        //Second bytes of the SSE opcodes, after 0F, the prefix picks the single or the double form
+        constexpr uint8_t SSE_LOAD = 0x10, SSE_STORE = 0x11, SSE_FROM_INT = 0x2A, SSE_COMPARE = 0x2E;
+        constexpr uint8_t SSE_ADD = 0x58, SSE_MUL = 0x59, SSE_SUB = 0x5C, SSE_DIV = 0x5E;
+        constexpr uint8_t SINGLE = 0xF3, DOUBLE = 0xF2;
+
+        //Host registers the guest registers of a block are pinned to. rax, rcx, rdx and rsi are scratch, rbx
+        //holds the CpuState and rbp the JitContext
+        constexpr std::array<uint8_t, 9> PINNED{ RDI, R8, R9, R10, R11, R12, R13, R14, R15 };
+        constexpr std::array<uint8_t, 6> SAVED{ RBX, RBP, R12, R13, R14, R15 };
+        //Pinned registers a call doesn't keep, five pushes also align the stack for it
+        constexpr std::array<uint8_t, 5> CLOBBERED{ RDI, R8, R9, R10, R11 };
+
+        constexpr uint8_t NO_INDEX = 0xFF;
+        constexpr uint8_t RIP = 0x10; //base of an operand addressed from the end of the instruction
+        constexpr int8_t NOT_PINNED = -1;
+
+        //Register, or memory at base + index + displacement
+        struct Operand
+        {
+            bool m_memory;
+            uint8_t m_register;
+            uint8_t m_index;
+            int32_t m_displacement;
+        };
+
+        constexpr Operand reg(uint8_t r) { return Operand{ false, r, NO_INDEX, 0 }; }
+        constexpr Operand mem(uint8_t base, int32_t displacement, uint8_t index = NO_INDEX) { return Operand{ true, base, index, displacement }; }
+        //Memory in the code itself, the displacement is patched in later like a jump
+        constexpr Operand rip() { return Operand{ true, RIP, NO_INDEX, 0 }; }
+
+        constexpr int32_t GPR = static_cast<int32_t>(offsetof(CpuState, m_gpr));
+        constexpr int32_t FPR = static_cast<int32_t>(offsetof(CpuState, m_fpr));
+        constexpr int32_t FCC = static_cast<int32_t>(offsetof(CpuState, m_fcc));
+        constexpr int32_t HI = static_cast<int32_t>(offsetof(CpuState, m_hi));
+        constexpr int32_t LO = static_cast<int32_t>(offsetof(CpuState, m_lo));
+        constexpr int32_t STATE = static_cast<int32_t>(offsetof(JitContext, m_state));
+        constexpr int32_t EXECUTED = static_cast<int32_t>(offsetof(JitContext, m_executed));
+        constexpr int32_t LINK = static_cast<int32_t>(offsetof(JitContext, m_link));
+
+        //Region of memory one load or store of a block last went to, kept in the code of the block after its
+        //instructions. Offsets from m_base below m_end can be accessed with the size of the access, m_end is 0
+        //until the first access
+        struct AccessSlot
+        {
+            uint32_t m_base;
+            uint32_t m_end;
+            uint8_t* m_data;
+        };
+
+        constexpr int32_t SLOT_BASE = static_cast<int32_t>(offsetof(AccessSlot, m_base));
+        constexpr int32_t SLOT_END = static_cast<int32_t>(offsetof(AccessSlot, m_end));
+        constexpr int32_t SLOT_DATA = static_cast<int32_t>(offsetof(AccessSlot, m_data));
+
+        //Called by a block whose access missed the region in its slot. false leaves the access to the interpreter,
+        //which raises the exception of an address that isn't mapped, invalidates the code a store goes into or
+        //reports that memory ran out, nothing may be thrown through the native code
+        bool refill(JitContext* context, AccessSlot* slot, uint32_t address, uint32_t size, uint32_t store)
+        {
+            try
+            {
+                Memory::Region span = context->m_memory->Span(address);
+                if (address - span.m_base + uint64_t{ size } > span.m_size || (store && span.m_executable)) return false;
+                *slot = AccessSlot{ span.m_base, span.m_size - size + 1, span.m_data };
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        //Writes x86-64 machine code into a buffer, branches are rel32 so the code can be copied anywhere
+        class Emitter
+        {
+            std::vector<uint8_t> m_code;
+
+        public:
+            const std::vector<uint8_t>& Code() const { return m_code; }
+            size_t Here() const { return m_code.size(); }
+
+            void Byte(uint8_t value) { m_code.push_back(value); }
+            void Dword(uint32_t value) { for (int i = 0; i < 4; ++i) Byte(static_cast<uint8_t>(value >> 8 * i)); }
+            void Qword(uint64_t value) { for (int i = 0; i < 8; ++i) Byte(static_cast<uint8_t>(value >> 8 * i)); }
+
+            //Opcode with a ModRM byte, reg is a register or the digit of the opcode. size is the operand size
+            void Op(std::initializer_list<uint8_t> opcode, uint8_t r, const Operand& rm, int size = 4)
+            {
+                if (size == 2) Byte(0x66);
+                uint8_t rex = (size == 8 ? 0x8 : 0) | (r & 8 ? 0x4 : 0) | (rm.m_memory && rm.m_index != NO_INDEX && (rm.m_index & 8) ? 0x2 : 0) | (rm.m_register & 8 ? 0x1 : 0);
+                //without a REX prefix, the byte registers of rsp to rdi are ah to bh
+                bool byteRegister = size == 1 && (r >= 4 || (!rm.m_memory && rm.m_register >= 4));
+                if (rex || byteRegister) Byte(0x40 | rex);
+                for (uint8_t byte : opcode) Byte(byte);
+
+                uint8_t field = static_cast<uint8_t>((r & 7) << 3);
+                if (!rm.m_memory)
+                {
+                    Byte(0xC0 | field | (rm.m_register & 7));
+                    return;
+                }
+                if (rm.m_register == RIP)
+                {
+                    Byte(field | 5);
+                    Dword(0);
+                    return;
+                }
+
+                bool noDisplacement = rm.m_displacement == 0 && (rm.m_register & 7) != RBP;
+                bool shortDisplacement = rm.m_displacement >= -128 && rm.m_displacement <= 127;
+                uint8_t mod = noDisplacement ? 0x00 : shortDisplacement ? 0x40 : 0x80;
+                if (rm.m_index != NO_INDEX || (rm.m_register & 7) == RSP)
+                {
+                    Byte(mod | field | 4);
+                    Byte(static_cast<uint8_t>((rm.m_index == NO_INDEX ? 4 : rm.m_index & 7) << 3 | (rm.m_register & 7)));
+                }
+                else Byte(mod | field | (rm.m_register & 7));
+                if (mod == 0x40) Byte(static_cast<uint8_t>(rm.m_displacement));
+                else if (mod == 0x80) Dword(static_cast<uint32_t>(rm.m_displacement));
+            }
+
+            void MovImmediate(uint8_t r, uint32_t value)
+            {
+                if (r & 8) Byte(0x41);
+                Byte(0xB8 | (r & 7));
+                Dword(value);
+            }
+            void MovImmediate64(uint8_t r, uint64_t value)
+            {
+                Byte(r & 8 ? 0x49 : 0x48);
+                Byte(0xB8 | (r & 7));
+                Qword(value);
+            }
+            void AluImmediate(uint8_t digit, const Operand& rm, uint32_t value, int size = 4)
+            {
+                if (static_cast<int32_t>(value) >= -128 && static_cast<int32_t>(value) <= 127)
+                {
+                    Op({ 0x83 }, digit, rm, size);
+                    Byte(static_cast<uint8_t>(value));
+                }
+                else
+                {
+                    Op({ 0x81 }, digit, rm, size);
+                    Dword(value);
+                }
+            }
+            //Scalar SSE operation of the prefix, between xmm and rm
+            void Sse(uint8_t prefix, uint8_t opcode, uint8_t xmm, const Operand& rm, int size = 4)
+            {
+                Byte(prefix);
+                Op({ 0x0F, opcode }, xmm, rm, size);
+            }
+            void Push(uint8_t r) { if (r & 8) Byte(0x41); Byte(0x50 | (r & 7)); }
+            void Pop(uint8_t r) { if (r & 8) Byte(0x41); Byte(0x58 | (r & 7)); }
+            void Ret() { Byte(0xC3); }
+            //lea r, [rip + ...] of a position in this code, which stays right wherever the code is copied to
+            void LeaPosition(uint8_t r, size_t position)
+            {
+                Byte(r & 8 ? 0x4C : 0x48);
+                Byte(0x8D);
+                Byte(static_cast<uint8_t>(0x05 | (r & 7) << 3));
+                Dword(static_cast<uint32_t>(static_cast<int64_t>(position) - static_cast<int64_t>(Here() + 4)));
+            }
+
+            //Jump whose target isn't known yet, it returns the position to Patch
+            size_t Jump(int condition = ALWAYS)
+            {
+                if (condition == ALWAYS) Byte(0xE9);
+                else
+                {
+                    Byte(0x0F);
+                    Byte(static_cast<uint8_t>(0x80 | condition));
+                }
+                Dword(0);
+                return Here() - 4;
+            }
+            void Patch(size_t position, size_t target)
+            {
+                uint32_t relative = static_cast<uint32_t>(static_cast<int64_t>(target) - static_cast<int64_t>(position + 4));
+                std::memcpy(m_code.data() + position, &relative, 4);
+            }
+        };
+
+        //Where a linked exit enters a block, past the prologue a call runs: six pushes (10 bytes), mov rbp, rdi (3)
+        //and mov rbx, [rbp] (4). From there on every block runs with the same host registers saved
+        constexpr size_t CHAIN_ENTRY = 17;
+        static_assert(STATE == 0, "The prologue loads the state without a displacement");
+
+        enum class ExitKind : uint8_t
+        {
+            Linkable, //to a known address, which can be linked to the block there
+            Interpret, //to the interpreter, at the instruction the block can't run
+            Computed, //to the address in eax, of a jump through a register
+            Inside //to an instruction of the block itself
+        };
+
+        //Translates the block from an entry up to the first jump. Registers are loaded into their host registers at
+        //the entry and stored back by every exit that leaves the block, branches to an instruction of the block
+        //just jump there. The count of instructions run is added to whenever the block leaves or a branch of its
+        //own goes back, each time for what ran since the last one, so the instructions branched to start a new count
+        class BlockTranslator
+        {
+            struct Exit
+            {
+                size_t m_jump; //position of the jump to patch
+                uint32_t m_executed; //instructions the block ran since it last counted them
+                uint64_t m_next; //what the block returns
+                ExitKind m_kind;
+            };
+
+            //Access that missed its slot, the slot is refilled out of the way of the code that hits
+            struct Miss
+            {
+                size_t m_jump; //position of the jump to patch
+                size_t m_access; //where the access starts, which runs again once the slot is refilled
+                size_t m_slot;
+                uint32_t m_executed; //instructions the block ran since it last counted them
+                size_t m_instruction;
+                const DecodedInstruction* m_decoded;
+                uint32_t m_size;
+                bool m_store;
+            };
+
+            //Displacement of an operand in a slot
+            struct SlotReference
+            {
+                size_t m_position;
+                size_t m_slot;
+                int32_t m_field;
+            };
+
+            static constexpr size_t NOT_EMITTED = ~size_t{ 0 };
+
+            Emitter m_emitter;
+            std::array<int8_t, 32> m_host;
+            uint32_t m_written = 0; //pinned guest registers the block writes
+            std::vector<Exit> m_exits;
+            std::vector<size_t> m_starts; //where the code of every instruction starts
+            std::vector<Miss> m_misses;
+            std::vector<SlotReference> m_slotReferences;
+            size_t m_slots = 0;
+            size_t m_counted = 0; //instruction the count of what ran starts from
+            uint32_t m_address;
+            uint32_t m_codeBase;
+            uint32_t m_codeSize;
+
+            Operand Guest(uint8_t g) const
+            {
+                return m_host[g] != NOT_PINNED ? reg(static_cast<uint8_t>(m_host[g])) : mem(RBX, GPR + 4 * g);
+            }
+
+            void Load(uint8_t host, uint8_t g)
+            {
+                if (g == 0) m_emitter.Op({ XOR_RM }, host, reg(host));
+                else m_emitter.Op({ MOV_RM }, host, Guest(g));
+            }
+
+            void Store(uint8_t g, uint8_t host)
+            {
+                if (g == 0) return;
+                m_emitter.Op({ MOV_MR }, host, Guest(g));
+                if (m_host[g] != NOT_PINNED) m_written |= 1u << g;
+            }
+
+            //host = host op g, with the register form of the operation or the digit of its immediate form
+            void Alu(uint8_t opcode, uint8_t digit, uint8_t host, uint8_t g)
+            {
+                if (g == 0) m_emitter.AluImmediate(digit, reg(host), 0);
+                else m_emitter.Op({ opcode }, host, Guest(g));
+            }
+
+            //Instructions run since the last count, up to the instruction i
+            uint32_t Ran(size_t i) const { return static_cast<uint32_t>(i - m_counted); }
+
+            //Leaves to interpret the instruction i of the block, when the condition holds
+            void Interpret(size_t i, int condition)
+            {
+                m_exits.push_back(Exit{ m_emitter.Jump(condition), Ran(i), Jit::INTERPRET | (m_address + 4 * static_cast<uint32_t>(i)), ExitKind::Interpret });
+            }
+
+            //The instruction i goes to target when the condition holds, or else on to the next one
+            void Branch(size_t i, uint32_t target, int condition)
+            {
+                bool inside = target - m_address < 4 * m_starts.size();
+                m_exits.push_back(Exit{ m_emitter.Jump(condition), Ran(i + 1), target, inside ? ExitKind::Inside : ExitKind::Linkable });
+            }
+
+            //Stores the pinned registers the block wrote, for the code it leaves to
+            void WriteBack()
+            {
+                for (uint8_t g = 1; g < 32; ++g)
+                {
+                    if (m_written & 1u << g) m_emitter.Op({ MOV_MR }, static_cast<uint8_t>(m_host[g]), mem(RBX, GPR + 4 * g));
+                }
+            }
+
+            //op r, [the field of the slot], the slot is placed after the code
+            void SlotOperand(uint8_t opcode, uint8_t r, size_t slot, int32_t field, int size = 4)
+            {
+                m_emitter.Op({ opcode }, r, rip(), size);
+                m_slotReferences.push_back(SlotReference{ m_emitter.Here() - 4, slot, field });
+            }
+
+            //Host address of a size bytes access at R2 + IMM in rcx + rdx, through the region in the slot of the
+            //access. It leaves to the interpreter if the address is unaligned, or outside the region and the slot
+            //can't be refilled with the one it is in
+            void Access(size_t i, const DecodedInstruction& in, uint32_t size, bool store)
+            {
+                size_t access = m_emitter.Here();
+                Load(RAX, in.m_reg2);
+                if (in.m_immediate != 0) m_emitter.AluImmediate(ADD, reg(RAX), in.m_immediate);
+                if (size > 1)
+                {
+                    m_emitter.Byte(0xA8); //test al, imm8
+                    m_emitter.Byte(static_cast<uint8_t>(size - 1));
+                    Interpret(i, NOT_EQUAL);
+                }
+                size_t slot = m_slots++;
+                m_emitter.Op({ MOV_RM }, RDX, reg(RAX));
+                SlotOperand(SUB_RM, RDX, slot, SLOT_BASE);
+                SlotOperand(CMP_RM, RDX, slot, SLOT_END);
+                m_misses.push_back(Miss{ m_emitter.Jump(ABOVE_EQUAL), access, slot, Ran(i), i, &in, size, store });
+                SlotOperand(MOV_RM, RCX, slot, SLOT_DATA, 8);
+            }
+
+            //Calls refill for every access that missed its slot, saving the pinned registers the call doesn't
+            void EmitMisses()
+            {
+                for (const Miss& miss : m_misses)
+                {
+                    m_emitter.Patch(miss.m_jump, m_emitter.Here());
+                    for (uint8_t r : CLOBBERED) m_emitter.Push(r);
+                    Load(RDX, miss.m_decoded->m_reg2);
+                    if (miss.m_decoded->m_immediate != 0) m_emitter.AluImmediate(ADD, reg(RDX), miss.m_decoded->m_immediate);
+                    m_emitter.Op({ MOV_RM }, RDI, reg(RBP), 8);
+                    SlotOperand(LEA, RSI, miss.m_slot, 0, 8);
+                    m_emitter.MovImmediate(RCX, miss.m_size);
+                    m_emitter.MovImmediate(R8, miss.m_store ? 1 : 0);
+                    m_emitter.MovImmediate64(RAX, reinterpret_cast<uint64_t>(&refill));
+                    m_emitter.Op({ 0xFF }, 2, reg(RAX)); //call rax
+                    for (auto r = CLOBBERED.rbegin(); r != CLOBBERED.rend(); ++r) m_emitter.Pop(*r);
+                    m_emitter.Op({ 0x84 }, RAX, reg(RAX), 1); //test al, al
+                    uint64_t next = Jit::INTERPRET | (m_address + 4 * static_cast<uint32_t>(miss.m_instruction));
+                    m_exits.push_back(Exit{ m_emitter.Jump(EQUAL), miss.m_executed, next, ExitKind::Interpret });
+                    m_emitter.Patch(m_emitter.Jump(), miss.m_access);
+                }
+            }
+
+            void SetIf(uint8_t condition, uint8_t r = RAX)
+            {
+                m_emitter.Op({ 0x0F, static_cast<uint8_t>(0x90 | condition) }, 0, reg(r), 1);
+            }
+
+            //FPU register f, a double takes the next one too. Doubles in $f31 would go on in $f0, they aren't translated
+            static Operand Fpu(uint8_t f) { return mem(RBX, FPR + 4 * f); }
+
+            //f1 = f2 op f3 in single or double precision
+            void Arithmetic(const DecodedInstruction& in, uint8_t prefix, uint8_t opcode)
+            {
+                m_emitter.Sse(prefix, SSE_LOAD, 0, Fpu(in.m_reg2));
+                m_emitter.Sse(prefix, opcode, 0, Fpu(in.m_reg3));
+                m_emitter.Sse(prefix, SSE_STORE, 0, Fpu(in.m_reg1));
+            }
+
+            //Sets or clears the condition flag in IMM as the comparison of f1 and f2 turns out. Swapped, less and
+            //less or equal are above and above or equal, which are false when the operands are unordered like in MIPS
+            void Compare(const DecodedInstruction& in, uint8_t prefix, int condition)
+            {
+                bool swap = condition != EQUAL;
+                m_emitter.Sse(prefix, SSE_LOAD, 0, Fpu(swap ? in.m_reg2 : in.m_reg1));
+                if (prefix == DOUBLE) m_emitter.Byte(0x66);
+                m_emitter.Op({ 0x0F, SSE_COMPARE }, 0, Fpu(swap ? in.m_reg1 : in.m_reg2));
+                SetIf(static_cast<uint8_t>(condition));
+                if (condition == EQUAL)
+                {
+                    SetIf(NOT_PARITY, RCX);
+                    m_emitter.Op({ 0x20 }, RCX, reg(RAX), 1); //and al, cl
+                }
+                uint8_t flag = static_cast<uint8_t>(in.m_immediate & 7);
+                m_emitter.Op({ 0x80 }, AND, mem(RBX, FCC), 1);
+                m_emitter.Byte(static_cast<uint8_t>(~(1u << flag)));
+                if (flag != 0)
+                {
+                    m_emitter.Op({ 0xC0 }, SHL, reg(RAX), 1);
+                    m_emitter.Byte(flag);
+                }
+                m_emitter.Op({ 0x08 }, RAX, mem(RBX, FCC), 1); //or [fcc], al
+            }
+
+            //Pins the guest registers the block names most often
+            void Pin(const DecodedInstruction* block, size_t count)
+            {
+                std::array<uint32_t, 32> uses{};
+                for (size_t i = 0; i < count; ++i)
+                {
+                    for (uint8_t g : integer_registers(block[i])) ++uses[g];
+                }
+                uses[0] = 0;
+
+                std::array<uint8_t, 32> order{};
+                for (uint8_t g = 0; g < 32; ++g) order[g] = g;
+                std::stable_sort(order.begin(), order.end(), [&uses](uint8_t a, uint8_t b) { return uses[a] > uses[b]; });
+
+                m_host.fill(NOT_PINNED);
+                for (size_t p = 0; p < PINNED.size() && uses[order[p]] > 0; ++p) m_host[order[p]] = static_cast<int8_t>(PINNED[p]);
+            }
+
+            //Emits the instruction i, false if it can't be translated, which leaves to the interpreter there
+            bool Emit(size_t i, const DecodedInstruction& in)
+            {
+                if (in.m_handler >= ISA::INSTRUCTION_COUNT) return false;
+
+                uint32_t pc = m_address + 4 * static_cast<uint32_t>(i);
+                uint32_t target = in.m_immediate;
+                bool inCode = target - m_codeBase <= m_codeSize;
+                switch (static_cast<Instruction>(in.m_handler))
+                {
+                case Instruction::ADD: case Instruction::SUB:
+                {
+                    bool add = static_cast<Instruction>(in.m_handler) == Instruction::ADD;
+                    Load(RAX, in.m_reg2);
+                    Alu(add ? ADD_RM : SUB_RM, add ? ADD : SUB, RAX, in.m_reg3);
+                    Interpret(i, OVERFLOW);
+                    Store(in.m_reg1, RAX);
+                    return true;
+                }
+                case Instruction::ADDU: Load(RAX, in.m_reg2); Alu(ADD_RM, ADD, RAX, in.m_reg3); Store(in.m_reg1, RAX); return true;
+                case Instruction::SUBU: Load(RAX, in.m_reg2); Alu(SUB_RM, SUB, RAX, in.m_reg3); Store(in.m_reg1, RAX); return true;
+                case Instruction::AND: Load(RAX, in.m_reg2); Alu(AND_RM, AND, RAX, in.m_reg3); Store(in.m_reg1, RAX); return true;
+                case Instruction::OR: Load(RAX, in.m_reg2); Alu(OR_RM, OR, RAX, in.m_reg3); Store(in.m_reg1, RAX); return true;
+                case Instruction::XOR: Load(RAX, in.m_reg2); Alu(XOR_RM, XOR, RAX, in.m_reg3); Store(in.m_reg1, RAX); return true;
+                case Instruction::NOR:
+                    Load(RAX, in.m_reg2);
+                    Alu(OR_RM, OR, RAX, in.m_reg3);
+                    m_emitter.Op({ 0xF7 }, NOT, reg(RAX));
+                    Store(in.m_reg1, RAX);
+                    return true;
+                case Instruction::SLT: case Instruction::SLTU:
+                    Load(RCX, in.m_reg2);
+                    m_emitter.Op({ XOR_RM }, RAX, reg(RAX));
+                    Alu(CMP_RM, CMP, RCX, in.m_reg3);
+                    SetIf(static_cast<Instruction>(in.m_handler) == Instruction::SLT ? LESS : BELOW);
+                    Store(in.m_reg1, RAX);
+                    return true;
+
+                case Instruction::ADDI:
+                    Load(RAX, in.m_reg2);
+                    m_emitter.AluImmediate(ADD, reg(RAX), in.m_immediate);
+                    Interpret(i, OVERFLOW);
+                    Store(in.m_reg1, RAX);
+                    return true;
+                case Instruction::ADDIU: Load(RAX, in.m_reg2); m_emitter.AluImmediate(ADD, reg(RAX), in.m_immediate); Store(in.m_reg1, RAX); return true;
+                case Instruction::ANDI: Load(RAX, in.m_reg2); m_emitter.AluImmediate(AND, reg(RAX), in.m_immediate); Store(in.m_reg1, RAX); return true;
+                case Instruction::ORI: Load(RAX, in.m_reg2); m_emitter.AluImmediate(OR, reg(RAX), in.m_immediate); Store(in.m_reg1, RAX); return true;
+                case Instruction::XORI: Load(RAX, in.m_reg2); m_emitter.AluImmediate(XOR, reg(RAX), in.m_immediate); Store(in.m_reg1, RAX); return true;
+                case Instruction::SLTI: case Instruction::SLTIU:
+                    Load(RCX, in.m_reg2);
+                    m_emitter.Op({ XOR_RM }, RAX, reg(RAX));
+                    m_emitter.AluImmediate(CMP, reg(RCX), in.m_immediate);
+                    SetIf(static_cast<Instruction>(in.m_handler) == Instruction::SLTI ? LESS : BELOW);
+                    Store(in.m_reg1, RAX);
+                    return true;
+                case Instruction::LUI: m_emitter.MovImmediate(RAX, in.m_immediate); Store(in.m_reg1, RAX); return true;
+
+                case Instruction::SLL: case Instruction::SRL: case Instruction::SRA:
+                {
+                    Instruction op = static_cast<Instruction>(in.m_handler);
+                    Load(RAX, in.m_reg2);
+                    m_emitter.Op({ 0xC1 }, op == Instruction::SLL ? SHL : op == Instruction::SRL ? SHR : SAR, reg(RAX));
+                    m_emitter.Byte(static_cast<uint8_t>(in.m_immediate & 31));
+                    Store(in.m_reg1, RAX);
+                    return true;
+                }
+                case Instruction::SLLV: case Instruction::SRLV: case Instruction::SRAV:
+                {
+                    //32-bit shifts by cl only use its low 5 bits, like MIPS
+                    Instruction op = static_cast<Instruction>(in.m_handler);
+                    Load(RCX, in.m_reg3);
+                    Load(RAX, in.m_reg2);
+                    m_emitter.Op({ 0xD3 }, op == Instruction::SLLV ? SHL : op == Instruction::SRLV ? SHR : SAR, reg(RAX));
+                    Store(in.m_reg1, RAX);
+                    return true;
+                }
+
+                case Instruction::MUL:
+                    Load(RAX, in.m_reg2);
+                    if (in.m_reg3 == 0) m_emitter.Op({ XOR_RM }, RAX, reg(RAX));
+                    else m_emitter.Op({ 0x0F, 0xAF }, RAX, Guest(in.m_reg3));
+                    Store(in.m_reg1, RAX);
+                    return true;
+                case Instruction::MULT: case Instruction::MULTU:
+                    Load(RAX, in.m_reg1);
+                    Load(RCX, in.m_reg2);
+                    m_emitter.Op({ 0xF7 }, static_cast<Instruction>(in.m_handler) == Instruction::MULT ? IMUL : MUL, reg(RCX));
+                    m_emitter.Op({ MOV_MR }, RAX, mem(RBX, LO));
+                    m_emitter.Op({ MOV_MR }, RDX, mem(RBX, HI));
+                    return true;
+                case Instruction::MFHI: m_emitter.Op({ MOV_RM }, RAX, mem(RBX, HI)); Store(in.m_reg1, RAX); return true;
+                case Instruction::MFLO: m_emitter.Op({ MOV_RM }, RAX, mem(RBX, LO)); Store(in.m_reg1, RAX); return true;
+                case Instruction::MTHI: Load(RAX, in.m_reg1); m_emitter.Op({ MOV_MR }, RAX, mem(RBX, HI)); return true;
+                case Instruction::MTLO: Load(RAX, in.m_reg1); m_emitter.Op({ MOV_MR }, RAX, mem(RBX, LO)); return true;
+                case Instruction::MOVN: case Instruction::MOVZ:
+                    Load(RAX, in.m_reg1);
+                    Load(RCX, in.m_reg2);
+                    Load(RDX, in.m_reg3);
+                    m_emitter.Op({ TEST_RM }, RDX, reg(RDX));
+                    m_emitter.Op({ 0x0F, static_cast<uint8_t>(0x40 | (static_cast<Instruction>(in.m_handler) == Instruction::MOVN ? NOT_EQUAL : EQUAL)) }, RAX, reg(RCX));
+                    Store(in.m_reg1, RAX);
+                    return true;
+
+                case Instruction::LW: Access(i, in, 4, false); m_emitter.Op({ MOV_RM }, RAX, mem(RCX, 0, RDX)); Store(in.m_reg1, RAX); return true;
+                case Instruction::LH: Access(i, in, 2, false); m_emitter.Op({ 0x0F, 0xBF }, RAX, mem(RCX, 0, RDX)); Store(in.m_reg1, RAX); return true;
+                case Instruction::LHU: Access(i, in, 2, false); m_emitter.Op({ 0x0F, 0xB7 }, RAX, mem(RCX, 0, RDX)); Store(in.m_reg1, RAX); return true;
+                case Instruction::LB: Access(i, in, 1, false); m_emitter.Op({ 0x0F, 0xBE }, RAX, mem(RCX, 0, RDX)); Store(in.m_reg1, RAX); return true;
+                case Instruction::LBU: Access(i, in, 1, false); m_emitter.Op({ 0x0F, 0xB6 }, RAX, mem(RCX, 0, RDX)); Store(in.m_reg1, RAX); return true;
+                //slots of stores never hold a region with code, so stores into code always leave
+                case Instruction::SW: Access(i, in, 4, true); Load(RAX, in.m_reg1); m_emitter.Op({ MOV_MR }, RAX, mem(RCX, 0, RDX)); return true;
+                case Instruction::SH: Access(i, in, 2, true); Load(RAX, in.m_reg1); m_emitter.Op({ MOV_MR }, RAX, mem(RCX, 0, RDX), 2); return true;
+                case Instruction::SB: Access(i, in, 1, true); Load(RAX, in.m_reg1); m_emitter.Op({ 0x88 }, RAX, mem(RCX, 0, RDX), 1); return true;
+                case Instruction::LWC1: Access(i, in, 4, false); m_emitter.Op({ MOV_RM }, RAX, mem(RCX, 0, RDX)); m_emitter.Op({ MOV_MR }, RAX, Fpu(in.m_reg1)); return true;
+                case Instruction::SWC1: Access(i, in, 4, true); m_emitter.Op({ MOV_RM }, RAX, Fpu(in.m_reg1)); m_emitter.Op({ MOV_MR }, RAX, mem(RCX, 0, RDX)); return true;
+                case Instruction::LDC1:
+                    if (in.m_reg1 == 31) return false;
+                    Access(i, in, 8, false);
+                    m_emitter.Op({ MOV_RM }, RAX, mem(RCX, 0, RDX), 8);
+                    m_emitter.Op({ MOV_MR }, RAX, Fpu(in.m_reg1), 8);
+                    return true;
+                case Instruction::SDC1:
+                    if (in.m_reg1 == 31) return false;
+                    Access(i, in, 8, true);
+                    m_emitter.Op({ MOV_RM }, RAX, Fpu(in.m_reg1), 8);
+                    m_emitter.Op({ MOV_MR }, RAX, mem(RCX, 0, RDX), 8);
+                    return true;
+
+                //the FPU registers stay in the CpuState, SSE computes like the interpreter does on the host
+                case Instruction::ADD_S: Arithmetic(in, SINGLE, SSE_ADD); return true;
+                case Instruction::SUB_S: Arithmetic(in, SINGLE, SSE_SUB); return true;
+                case Instruction::MUL_S: Arithmetic(in, SINGLE, SSE_MUL); return true;
+                case Instruction::DIV_S: Arithmetic(in, SINGLE, SSE_DIV); return true;
+                case Instruction::ADD_D: case Instruction::SUB_D: case Instruction::MUL_D: case Instruction::DIV_D:
+                {
+                    if (in.m_reg1 == 31 || in.m_reg2 == 31 || in.m_reg3 == 31) return false;
+                    Instruction op = static_cast<Instruction>(in.m_handler);
+                    Arithmetic(in, DOUBLE, op == Instruction::ADD_D ? SSE_ADD : op == Instruction::SUB_D ? SSE_SUB : op == Instruction::MUL_D ? SSE_MUL : SSE_DIV);
+                    return true;
+                }
+                case Instruction::MOV_S: m_emitter.Op({ MOV_RM }, RAX, Fpu(in.m_reg2)); m_emitter.Op({ MOV_MR }, RAX, Fpu(in.m_reg1)); return true;
+                case Instruction::MOV_D:
+                    if (in.m_reg1 == 31 || in.m_reg2 == 31) return false;
+                    m_emitter.Op({ MOV_RM }, RAX, Fpu(in.m_reg2), 8);
+                    m_emitter.Op({ MOV_MR }, RAX, Fpu(in.m_reg1), 8);
+                    return true;
+                case Instruction::MTC1: Load(RAX, in.m_reg1); m_emitter.Op({ MOV_MR }, RAX, Fpu(in.m_reg2)); return true;
+                case Instruction::MFC1: m_emitter.Op({ MOV_RM }, RAX, Fpu(in.m_reg2)); Store(in.m_reg1, RAX); return true;
+                case Instruction::CVT_S_W:
+                    m_emitter.Sse(SINGLE, SSE_FROM_INT, 0, Fpu(in.m_reg2));
+                    m_emitter.Sse(SINGLE, SSE_STORE, 0, Fpu(in.m_reg1));
+                    return true;
+                case Instruction::CVT_D_W:
+                    if (in.m_reg1 == 31) return false;
+                    m_emitter.Sse(DOUBLE, SSE_FROM_INT, 0, Fpu(in.m_reg2));
+                    m_emitter.Sse(DOUBLE, SSE_STORE, 0, Fpu(in.m_reg1));
+                    return true;
+                case Instruction::C_EQ_S: Compare(in, SINGLE, EQUAL); return true;
+                case Instruction::C_LT_S: Compare(in, SINGLE, ABOVE); return true;
+                case Instruction::C_LE_S: Compare(in, SINGLE, ABOVE_EQUAL); return true;
+                case Instruction::C_EQ_D: case Instruction::C_LT_D: case Instruction::C_LE_D:
+                {
+                    if (in.m_reg1 == 31 || in.m_reg2 == 31) return false;
+                    Instruction op = static_cast<Instruction>(in.m_handler);
+                    Compare(in, DOUBLE, op == Instruction::C_EQ_D ? EQUAL : op == Instruction::C_LT_D ? ABOVE : ABOVE_EQUAL);
+                    return true;
+                }
+
+                //branches that go out of the code are left to the interpreter, which raises the exception
+                case Instruction::BEQ: case Instruction::BNE:
+                    if (!inCode) return false;
+                    Load(RAX, in.m_reg1);
+                    Alu(CMP_RM, CMP, RAX, in.m_reg2);
+                    Branch(i, target, static_cast<Instruction>(in.m_handler) == Instruction::BEQ ? EQUAL : NOT_EQUAL);
+                    return true;
+                case Instruction::BLEZ: case Instruction::BGTZ: case Instruction::BLTZ: case Instruction::BGEZ:
+                {
+                    if (!inCode) return false;
+                    Instruction op = static_cast<Instruction>(in.m_handler);
+                    Load(RAX, in.m_reg1);
+                    m_emitter.Op({ TEST_RM }, RAX, reg(RAX));
+                    Branch(i, target, op == Instruction::BLEZ ? LESS_EQUAL : op == Instruction::BGTZ ? GREATER : op == Instruction::BLTZ ? LESS : GREATER_EQUAL);
+                    return true;
+                }
+                case Instruction::BC1F: case Instruction::BC1T:
+                    if (!inCode) return false;
+                    m_emitter.Op({ 0xF6 }, 0, mem(RBX, FCC), 1); //test byte [fcc], imm8
+                    m_emitter.Byte(static_cast<uint8_t>(1u << (in.m_reg3 & 7)));
+                    Branch(i, target, static_cast<Instruction>(in.m_handler) == Instruction::BC1T ? NOT_EQUAL : EQUAL);
+                    return true;
+                case Instruction::J:
+                    if (!inCode) return false;
+                    Branch(i, target, ALWAYS);
+                    return true;
+                case Instruction::JAL:
+                    if (!inCode) return false;
+                    m_emitter.MovImmediate(RAX, pc + 4);
+                    Store(31, RAX);
+                    Branch(i, target, ALWAYS);
+                    return true;
+                //the interpreter takes the address the block returns, and raises the exception if it is outside the code
+                case Instruction::JR: case Instruction::JALR_RA: case Instruction::JALR:
+                {
+                    Instruction op = static_cast<Instruction>(in.m_handler);
+                    Load(RAX, op == Instruction::JALR ? in.m_reg2 : in.m_reg1);
+                    m_emitter.Byte(0xA8); //test al, imm8
+                    m_emitter.Byte(3);
+                    Interpret(i, NOT_EQUAL);
+                    if (op != Instruction::JR)
+                    {
+                        m_emitter.MovImmediate(RCX, pc + 4);
+                        Store(op == Instruction::JALR ? in.m_reg1 : 31, RCX);
+                    }
+                    m_exits.push_back(Exit{ m_emitter.Jump(), Ran(i + 1), 0, ExitKind::Computed });
+                    return true;
+                }
+
+                default:
+                    return false;
+                }
+            }
+
+        public:
+            BlockTranslator(uint32_t address, uint32_t codeBase, uint32_t codeSize) : m_address(address), m_codeBase(codeBase), m_codeSize(codeSize) {}
+
+            //Machine code of the block, empty if its first instruction can't be translated. count is cut to the
+            //instructions translated
+            std::vector<uint8_t> Translate(const DecodedInstruction* block, size_t& count)
+            {
+                Pin(block, count);
+                m_starts.assign(count, NOT_EMITTED);
+
+                //what the branches of the block go to inside it
+                std::vector<bool> targets(count, false);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    uint32_t offset = block[i].m_immediate - m_address;
+                    if (branches(block[i]) && offset < 4 * count) targets[offset / 4] = true;
+                }
+
+                for (uint8_t r : SAVED) m_emitter.Push(r);
+                m_emitter.Op({ MOV_RM }, RBP, reg(RDI), 8);
+                m_emitter.Op({ MOV_RM }, RBX, mem(RBP, STATE), 8);
+                if (m_emitter.Here() != CHAIN_ENTRY) return {};
+                for (uint8_t g = 1; g < 32; ++g)
+                {
+                    if (m_host[g] != NOT_PINNED) m_emitter.Op({ MOV_RM }, static_cast<uint8_t>(m_host[g]), mem(RBX, GPR + 4 * g));
+                }
+
+                //Emit refuses before it writes anything, so a refused instruction is just where the block leaves
+                size_t i = 0;
+                bool fallsThrough = true;
+                for (; i < count; ++i)
+                {
+                    if (targets[i] && i > m_counted)
+                    {
+                        m_emitter.AluImmediate(ADD, mem(RBP, EXECUTED), Ran(i), 8);
+                        m_counted = i;
+                    }
+                    m_starts[i] = m_emitter.Here();
+                    if (!Emit(i, block[i]))
+                    {
+                        if (i == 0) return {};
+                        m_starts[i] = NOT_EMITTED;
+                        Interpret(i, ALWAYS);
+                        fallsThrough = false;
+                        break;
+                    }
+                    if (ends(block[i]))
+                    {
+                        ++i;
+                        fallsThrough = false;
+                        break;
+                    }
+                }
+                if (fallsThrough) m_exits.push_back(Exit{ m_emitter.Jump(), Ran(i), m_address + 4 * static_cast<uint32_t>(i), ExitKind::Linkable });
+                count = i;
+                EmitMisses();
+
+                //exits count what they ran, the ones that leave store the registers back and return the next address
+                //through the epilogue, with the jump the interpreter links in rcx
+                std::vector<size_t> epilogueJumps;
+                for (const Exit& exit : m_exits)
+                {
+                    m_emitter.Patch(exit.m_jump, m_emitter.Here());
+                    if (exit.m_executed != 0) m_emitter.AluImmediate(ADD, mem(RBP, EXECUTED), exit.m_executed, 8);
+
+                    size_t inside = (static_cast<uint32_t>(exit.m_next) - m_address) / 4;
+                    if (exit.m_kind == ExitKind::Inside && inside < count && m_starts[inside] != NOT_EMITTED)
+                    {
+                        m_emitter.Patch(m_emitter.Jump(), m_starts[inside]);
+                        continue;
+                    }
+
+                    WriteBack();
+                    switch (exit.m_kind)
+                    {
+                    case ExitKind::Interpret:
+                        m_emitter.Op({ XOR_RM }, RCX, reg(RCX));
+                        m_emitter.MovImmediate64(RAX, exit.m_next);
+                        break;
+                    case ExitKind::Computed:
+                        m_emitter.Op({ XOR_RM }, RCX, reg(RCX));
+                        break;
+                    default:
+                    {
+                        //falls through to the return until it is linked
+                        size_t link = m_emitter.Jump();
+                        m_emitter.LeaPosition(RCX, link);
+                        m_emitter.MovImmediate(RAX, static_cast<uint32_t>(exit.m_next));
+                        break;
+                    }
+                    }
+                    epilogueJumps.push_back(m_emitter.Jump());
+                }
+                for (size_t jump : epilogueJumps) m_emitter.Patch(jump, m_emitter.Here());
+                m_emitter.Op({ MOV_MR }, RCX, mem(RBP, LINK), 8);
+                for (auto r = SAVED.rbegin(); r != SAVED.rend(); ++r) m_emitter.Pop(*r);
+                m_emitter.Ret();
+
+                //the slots, aligned and empty, the cache places blocks on 16 bytes
+                while (m_emitter.Here() % alignof(AccessSlot) != 0) m_emitter.Byte(0xCC);
+                size_t slots = m_emitter.Here();
+                for (size_t slot = 0; slot < m_slots * sizeof(AccessSlot); ++slot) m_emitter.Byte(0);
+                for (const SlotReference& reference : m_slotReferences)
+                {
+                    m_emitter.Patch(reference.m_position, slots + reference.m_slot * sizeof(AccessSlot) + reference.m_field);
+                }
+                return m_emitter.Code();
+            }
+
+            //Jumps, which end the block
+            static bool ends(const DecodedInstruction& in)
+            {
+                switch (static_cast<Instruction>(in.m_handler))
+                {
+                case Instruction::J: case Instruction::JAL: case Instruction::JR: case Instruction::JALR_RA: case Instruction::JALR:
+                    return true;
+                default:
+                    return false;
+                }
+            }
+
+            //Branches and jumps to the address in their immediate
+            static bool branches(const DecodedInstruction& in)
+            {
+                switch (static_cast<Instruction>(in.m_handler))
+                {
+                case Instruction::BEQ: case Instruction::BNE: case Instruction::BLEZ: case Instruction::BGTZ:
+                case Instruction::BLTZ: case Instruction::BGEZ: case Instruction::BC1F: case Instruction::BC1T:
+                case Instruction::J: case Instruction::JAL:
+                    return true;
+                default:
+                    return false;
+                }
+            }
+
+            //Guest registers of the instruction that are integer ones, 0 for the fields that name FPU registers
+            static std::array<uint8_t, 3> integer_registers(const DecodedInstruction& in)
+            {
+                switch (static_cast<Instruction>(in.m_handler))
+                {
+                case Instruction::MTC1: case Instruction::MFC1:
+                    return { in.m_reg1, 0, 0 };
+                case Instruction::LWC1: case Instruction::SWC1: case Instruction::LDC1: case Instruction::SDC1:
+                    return { 0, in.m_reg2, 0 };
+                case Instruction::ADD_S: case Instruction::SUB_S: case Instruction::MUL_S: case Instruction::DIV_S:
+                case Instruction::ADD_D: case Instruction::SUB_D: case Instruction::MUL_D: case Instruction::DIV_D:
+                case Instruction::MOV_S: case Instruction::MOV_D: case Instruction::CVT_S_W: case Instruction::CVT_D_W:
+                case Instruction::C_EQ_S: case Instruction::C_LT_S: case Instruction::C_LE_S:
+                case Instruction::C_EQ_D: case Instruction::C_LT_D: case Instruction::C_LE_D:
+                case Instruction::BC1F: case Instruction::BC1T:
+                    return { 0, 0, 0 };
+                default:
+                    return { in.m_reg1, in.m_reg2, in.m_reg3 };
+                }
+            }
+        };
+    }
+
+    Jit::Jit()
+    {
+        void* cache = mmap(nullptr, CACHE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (cache != MAP_FAILED) m_cache = static_cast<uint8_t*>(cache);
+    }
+
+    Jit::~Jit()
+    {
+        if (m_cache) munmap(m_cache, CACHE_SIZE);
+    }
+
+    NativeBlock Jit::Translate(const DecodedInstruction* block, size_t& count, uint32_t address, uint32_t codeBase, uint32_t codeSize)
+    {
+        if (!m_cache || count == 0) return nullptr;
+        std::vector<uint8_t> code = BlockTranslator(address, codeBase, codeSize).Translate(block, count);
+        if (code.empty()) return nullptr;
+        if (code.size() > CACHE_SIZE - m_used)
+        {
+            m_full = true;
+            return nullptr;
+        }
+
+        uint8_t* native = m_cache + m_used;
+        std::memcpy(native, code.data(), code.size());
+        m_used = (m_used + code.size() + 15) & ~size_t{ 15 };
+        return reinterpret_cast<NativeBlock>(native);
+    }
+
+    void Jit::Flush()
+    {
+        m_used = 0;
+        m_full = false;
+    }
+
+    void Jit::Link(uint8_t* exit, NativeBlock target)
+    {
+        uint8_t* entry = reinterpret_cast<uint8_t*>(target) + CHAIN_ENTRY;
+        uint32_t relative = static_cast<uint32_t>(entry - (exit + 4));
+        std::memcpy(exit, &relative, 4);
+    }
+
+    void Jit::Unlink(uint8_t* exit)
+    {
+        //the jump goes on to the return right after it
+        std::memset(exit, 0, 4);
+    }
+#else
+    Jit::Jit() {}
+    Jit::~Jit() {}
+    NativeBlock Jit::Translate(const DecodedInstruction*, size_t&, uint32_t, uint32_t, uint32_t) { return nullptr; }
+    void Jit::Flush() {}
+    void Jit::Link(uint8_t*, NativeBlock) {}
+    void Jit::Unlink(uint8_t*) {}
+#endif
+}
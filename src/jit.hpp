@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "interpreter.hpp"
+
+//Translation needs an x86-64 host that hands out executable memory through mmap
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(_WIN32)
+#define NEOMIPS_JIT
+#endif
+
+namespace NeoMIPS
+{
+    //Second tier of the interpreter: translates hot code into x86-64 in an executable code cache. A block runs
+    //from its entry past conditional branches up to the first jump, so a loop with branches inside is one block,
+    //and its branches into itself never leave it. The guest registers a block uses most stay in host registers
+    //from its entry to its exits, the FPU ones are computed with SSE, and every load and store keeps the region
+    //it last went to, looking up another one natively when it misses. Every exit to a known address can be
+    //linked to the block translated there, so hot code runs from block to block without going back to the
+    //interpreter. Whatever a block can't do natively, an instruction it doesn't know, an access outside memory,
+    //an overflow or a store into code, is left to the interpreter there
+    class Jit
+    {
+    public:
+        static constexpr size_t CACHE_SIZE = 16 << 20;
+        //Set in what a block returns when the instruction at the address has to be interpreted
+        static constexpr uint64_t INTERPRET = uint64_t{ 1 } << 32;
+
+    private:
+        uint8_t* m_cache = nullptr;
+        size_t m_used = 0;
+        bool m_full = false;
+
+    public:
+        Jit();
+        Jit(const Jit&) = delete;
+        Jit& operator=(const Jit&) = delete;
+        ~Jit();
+
+        //Whether this build can translate, and the code cache could be mapped
+        bool Available() const { return m_cache != nullptr; }
+
+        //Translates a block of the count instructions decoded from address, whose branches may only go into the
+        //code between codeBase and codeBase + codeSize, and cuts count to the instructions it took. nullptr if
+        //the first instruction can't be translated or the cache is full
+        NativeBlock Translate(const DecodedInstruction* block, size_t& count, uint32_t address, uint32_t codeBase, uint32_t codeSize);
+        //Makes the exit a block left by, as JitContext::m_link, jump straight into the target block from then on
+        void Link(uint8_t* exit, NativeBlock target);
+        //Makes a linked exit leave its block again, when the block it went to is invalidated
+        void Unlink(uint8_t* exit);
+        //Drops every translation, none of them may be running
+        void Flush();
+
+        bool Full() const { return m_full; }
+        size_t Used() const { return m_used; }
+    };
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include "jobpool.hpp"
+
+namespace NeoMIPS
+{
+    namespace
+    {
+        //Lets Submit know it is called from a job, and by which worker
+        thread_local const JobPool* t_pool = nullptr;
+        thread_local uint32_t t_worker = 0;
+    }
+
+    JobPool::JobPool(uint32_t threads) : m_queued(0), m_pending(0), m_next(0), m_stop(false), m_steals(0)
+    {
+        if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+
+        for (uint32_t i = 0; i < threads; ++i)
+        {
+            m_queues.emplace_back(new Queue());
+        }
+        for (uint32_t i = 0; i < threads; ++i)
+        {
+            m_workers.emplace_back(&JobPool::Work, this, i);
+        }
+    }
+
+    JobPool::~JobPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void JobPool::Submit(job_t job)
+    {
+        uint32_t target;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            target = t_pool == this ? t_worker : m_next++ % Size();
+            ++m_pending;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_queues[target]->m_mutex);
+            m_queues[target]->m_jobs.push_back(std::move(job));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_queued;
+        }
+        m_wake.notify_one();
+    }
+
+    void JobPool::Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_pending == 0; });
+
+        if (m_error)
+        {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    bool JobPool::Pop(uint32_t worker, job_t& job)
+    {
+        bool found = false;
+        {
+            Queue& own = *m_queues[worker];
+            std::lock_guard<std::mutex> lock(own.m_mutex);
+            if (!own.m_jobs.empty())
+            {
+                job = std::move(own.m_jobs.back());
+                own.m_jobs.pop_back();
+                found = true;
+            }
+        }
+
+        for (uint32_t i = 1; i < Size() && !found; ++i)
+        {
+            Queue& victim = *m_queues[(worker + i) % Size()];
+            std::lock_guard<std::mutex> lock(victim.m_mutex);
+            if (!victim.m_jobs.empty())
+            {
+                job = std::move(victim.m_jobs.front());
+                victim.m_jobs.pop_front();
+                found = true;
+                ++m_steals;
+            }
+        }
+
+        if (found)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_queued;
+        }
+        return found;
+    }
+
+    void JobPool::Work(uint32_t worker)
+    {
+        t_pool = this;
+        t_worker = worker;
+
+        job_t job;
+        while (true)
+        {
+            if (!Pop(worker, job))
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stop || m_queued > 0; });
+                if (m_stop && m_queued <= 0) return;
+                continue;
+            }
+
+            try
+            {
+                job();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_error) m_error = std::current_exception();
+            }
+            job = nullptr;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0) m_idle.notify_all();
+        }
+    }
+}
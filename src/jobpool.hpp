@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NeoMIPS
+{
+    //Fixed set of worker threads, each with its own queue of jobs. A worker runs the newest job of its own
+    //queue and, once it is empty, steals the oldest job of another queue, so a few long translation units
+    //don't leave the other cores idle while they wait behind them. Jobs submitted from inside a job go to
+    //the queue of the worker running it
+    class JobPool
+    {
+    public:
+        using job_t = std::function<void()>;
+
+    private:
+        struct Queue
+        {
+            std::mutex m_mutex;
+            std::deque<job_t> m_jobs;
+        };
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake; //jobs were queued or the pool is stopping
+        std::condition_variable m_idle; //every submitted job has finished
+        int64_t m_queued;
+        uint64_t m_pending;
+        uint32_t m_next;
+        bool m_stop;
+        std::exception_ptr m_error;
+        std::atomic<uint64_t> m_steals;
+
+        bool Pop(uint32_t worker, job_t& job);
+        void Work(uint32_t worker);
+
+    public:
+        //0 threads means one per hardware thread
+        explicit JobPool(uint32_t threads = 0);
+        ~JobPool();
+
+        JobPool(const JobPool&) = delete;
+        JobPool& operator=(const JobPool&) = delete;
+
+        void Submit(job_t job);
+        //Blocks until every submitted job has run, then rethrows the first exception a job threw, if any
+        void Wait();
+
+        uint32_t Size() const { return static_cast<uint32_t>(m_workers.size()); }
+        uint64_t Steals() const { return m_steals; }
+    };
+}
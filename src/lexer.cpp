@@ -8,7 +8,6 @@
 #include <optional>
 #include "include/ctre-unicode.hpp"
 #include "lexer.hpp"
-#include "lexer_regex.hpp"
 #include "argumentprocessor.hpp"
 #include "util.hpp"
 #include "lexer_util.hpp"
@@ -21,184 +20,18 @@ namespace NeoMIPS
     using namespace ISA::Directives;
     using namespace ISA::Instructions;
 
-    //TODO: process macros and eqv in the order they appear in the source file
-    std::unique_ptr<std::vector<TokenBase*>> Lexer::Tokenize(std::u32string& source)
+    template<Char C>
+    TokenArena Lexer::Tokenize(std::basic_string<C>& source, LineMap lines)
     {
-        ResolveEQV(source);
-        ResolveMacros(source);
+        m_lines = LineIndex(std::basic_string_view<C>(source), std::move(lines));
+        m_tokens.Reserve(m_lines.LineCount()); //about one token per line, so the list is rarely reallocated
         InitialState(source);
         return std::move(m_tokens);
     }
 
 
-
-    void Lexer::GetMacroDeclaratios(std::u32string& source, std::vector<MacroDeclaration>& macros)
-    {
-        size_t i = 0;
-        auto startSearchIt = source.cbegin();
-        auto macroStartIt = source.cbegin();
-        while ((i = source.find(U".macro", i)) != std::string::npos)
-        {
-            std::advance(macroStartIt, i);
-            int numberOfQuotations = std::count(startSearchIt, macroStartIt, U'\"') + std::count(startSearchIt, macroStartIt, U'\'');
-            if (numberOfQuotations != 0)
-            {
-                for (auto startItAf = startSearchIt; startItAf < macroStartIt; startItAf++)
-                {
-                    startItAf = std::adjacent_find(startSearchIt, macroStartIt, [](const char32_t a, const char32_t b) -> bool {return a == U'\\' && (b == U'\"' || b == U'\''); });
-                    if (startItAf != macroStartIt) numberOfQuotations++;
-                }
-                i--;
-            }
-            if (numberOfQuotations % 2 == 0)
-            {
-                int strtindex = i;
-                i += 6; //skip over .macro statement
-
-                MacroDeclaration macro;
-                std::vector<std::u32string> macroParams;
-                while (is_space(source[i])) i++;
-                while (!is_space(source[i])) macro.m_name += source[i++];
-                //while (is_space(source[i])) i++;
-                while (source[i] != U'\n')
-                {
-                    if (source[i] == U'%' || source[i] == U'$') //$ for compatibility with other assemblers
-                    {
-                        std::u32string paramName;
-                        while (!is_space(source[i]))
-                        {
-                            if (source[i] == U',' || source[i] == U')')
-                            {
-                                i++;
-                                break;
-                            }
-                            paramName += source[i++];
-                        }
-                        if (paramName.empty()) throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, i)), "The name of a parameter in a macro must not be empty");
-                        macro.m_params.push_back(paramName);
-                    }
-                    else i++;
-                }
-                i++;
-                size_t macroBodyEnd = source.find(U".end_macro", i);
-                macro.m_body = source.substr(i, macroBodyEnd - i);
-                macros.push_back(macro);
-                source.erase(std::distance(source.cbegin(), macroStartIt), macroBodyEnd + 10 - std::distance(source.cbegin(), macroStartIt));
-            }
-            startSearchIt = macroStartIt;
-            macroStartIt = source.cbegin();
-        }
-    }
-
-
-    void Lexer::ResolveMacros(std::u32string& source)
-    {
-        std::vector<MacroDeclaration> macros;
-        GetMacroDeclaratios(source, macros);
-        ExpandMacros(macros, source);
-    }
-
-
-    //void NeoMIPS::Lexer::ExpandMacros(std::vector<NeoMIPS::MacroDeclaration>& macros, std::u32string& source)
-    //{
-    //    for (const MacroDeclaration& m : macros)
-    //    {
-    //        size_t i;
-    //        while ((i = source.find(m.m_name)) != std::string::npos)
-    //        {
-    //            auto startIt = source.cbegin();
-    //            std::advance(startIt, i);
-    //            auto endIt = startIt;
-    //            while (*endIt != U'\n') endIt++;
-    //            //std::advance(endIt, m.m_name.size());
-
-    //            if (m.m_params.empty())
-    //            {
-    //                //simply expand macro
-    //                source.replace(startIt, endIt, m.m_body);
-    //            }
-    //            else
-    //            {
-    //                size_t index = i + m.m_name.size();
-    //                std::u32string macroInstantiation = m.m_body;
-    //                for (int c = 0; c < m.m_params.size(); c++)
-    //                {
-    //                    std::u32string param;
-    //                    while (is_separator(source[index])) index++;
-    //                    while (!is_separator(source[index])) param += source[index++];
-    //                    size_t next;
-    //                    while ((next = macroInstantiation.find(m.m_params[c])) != std::string::npos)
-    //                    {
-    //                        auto s = macroInstantiation.cbegin();
-    //                        std::advance(s, next);
-    //                        macroInstantiation.replace(s, s + m.m_params[c].size(), param);
-    //                    }
-    //                }
-    //                source.replace(startIt, endIt, macroInstantiation);
-    //            }
-    //        }
-    //    }
-    //}
-
-    //void Lexer::ResolveEQV(std::u32string& source)
-    //{
-    //    size_t i = 0;
-    //    auto startIt = source.cbegin();
-    //    auto endIt = source.cbegin();
-    //    while ((i = source.find(U".eqv", i)) != std::string::npos)
-    //    {
-    //        endIt = source.cbegin();
-    //        std::advance(endIt, i);
-    //        int numberOfQuotations = std::count(startIt, endIt, U'\"') + std::count(startIt, endIt, U'\'');
-    //        if (numberOfQuotations != 0)
-    //        {
-    //            for (auto startItAf = startIt; startItAf < endIt; startItAf++)
-    //            {
-    //                startItAf = std::adjacent_find(startIt, endIt, [](const char32_t a, const char32_t b) -> bool {return a == U'\\' && (b == U'\"' || b == U'\''); });
-    //                if (startItAf != endIt) numberOfQuotations++;
-    //            }
-    //            i--;
-    //        }
-    //        if (numberOfQuotations % 2 == 0)
-    //        {
-    //            int p = i;
-    //            std::u32string symbol, expression;
-    //            bool expectingSomething = true;
-    //            i += 4; //skip over .eqv statement
-    //            while (is_space(source[i]))i++;
-    //            while (!is_separator(source[i])) symbol += source[i++];
-    //            while (is_space(source[i]))
-    //            {
-    //                if (source[i] == U'\n')
-    //                {
-    //                    expectingSomething = false;
-    //                }
-    //                i++;
-    //            }
-    //            if (expectingSomething) while (!is_separator(source[i])) expression += source[i++];
-
-    //            int diff = i - p;
-    //            source.erase(p, diff);
-    //            i -= diff;
-    //            //replace all occurences of define from here to the end of file
-    //            size_t hit = 0;
-    //            while ((hit = source.find(symbol, i)) != std::string::npos)
-    //            {
-    //                auto x = source.cbegin();
-    //                auto y = source.cbegin();
-    //                std::advance(x, hit);
-    //                std::advance(y, hit + symbol.length());
-    //                source.replace(x, y, expression);
-    //                //source.erase(i, i + symbol.length());
-    //                //source.insert(i, expression);
-    //            }
-    //        }
-    //        startIt = endIt;
-    //    }
-    //}
-
-
-    void Lexer::InitialState(const std::u32string& source)
+    template<Char C>
+    void Lexer::InitialState(const std::basic_string<C>& source)
     {
         for (m_index = 0; m_index < source.length(); ++m_index)
         {
@@ -213,7 +46,7 @@ namespace NeoMIPS
                 break;
             default:
                 if (isdigit(source[m_index])) //can be used because digits in utf32 are the same as in ascii
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, m_index)), "Statements cannot start with a number.");
+                    throw Error::InvalidSyntaxException(m_lines.Where(m_index), "Statements cannot start with a number.");
                 else ParseAlphabetCharacters(source);
                 break;
             }
@@ -221,7 +54,8 @@ namespace NeoMIPS
     }
 
 
-    void NeoMIPS::Lexer::ParseAlphabetCharacters(const std::u32string& source)
+    template<Char C>
+    void NeoMIPS::Lexer::ParseAlphabetCharacters(const std::basic_string<C>& source)
     {
         if (is_tag(source, m_index))
         {
@@ -232,408 +66,556 @@ namespace NeoMIPS
             //std::u32string_view view(source.data() + m_index * sizeof(char32_t), source.find_first_of(U'\n', m_index));
             //
             //auto match = ctre::search<Regex::instructionPattern>(view);
-            std::u32string word = get_next_word(source, m_index);
-            m_index++;
+            //m_index is left on the separator after the mnemonic, which is the '\n' of an instruction without operands
+            uint32_t position = m_index;
+            std::basic_string_view<C> word = get_next_word(source, m_index);
 
             auto ins = is_instruction(word);
             if (ins)
             {
-                ParseInstructionStatement(source, *ins);
+                ParseInstructionStatement(source, *ins, position);
             }
-            else throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, m_index)), to_ascii_string(word) + " is not a valid instruction statement.");
+            else throw Error::InvalidSyntaxException(m_lines.Where(position), to_ascii_string(word) + " is not a valid instruction statement.");
 
         }
     }
 
 
-    void Lexer::skip_comment(const std::u32string& source)
+    template<Char C>
+    void Lexer::skip_comment(const std::basic_string<C>& source)
     {
-        while (source[m_index++] != U'\n');
-        m_index--;
-        return;
+        while (m_index < source.size() && source[m_index] != U'\n') ++m_index;
     }
 
 
-    void Lexer::ParseDirective(const std::u32string& source)
+    template<Char C>
+    void Lexer::ParseDirective(const std::basic_string<C>& source)
     {
-        int i = m_index;
-        std::u32string word = get_next_word(source, m_index);
+        uint32_t position = m_index;
+        std::basic_string_view<C> word = get_next_word(source, m_index);
 
         auto dir = is_directive(word);
         if (dir)
         {
-            ParseDirectiveStatement(source, *dir);
+            ParseDirectiveStatement(source, *dir, position);
         }
-        else throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, m_index)), to_ascii_string(word) + " is not a valid directive statement.");
+        else throw Error::InvalidSyntaxException(m_lines.Where(position), to_ascii_string(word) + " is not a valid directive statement.");
     }
 
 
-    void Lexer::ParseTag(const std::u32string& source)
+    template<Char C>
+    void Lexer::ParseTag(const std::basic_string<C>& source)
     {
-        std::u32string tag;
-        while (!is_separator(source[m_index]))
-        {
-            tag += source[m_index++];
-        }
-        ++m_index;
-        //add token to list
+        while (is_separator(source[m_index])) ++m_index;
+        uint32_t position = m_index;
+        while (!is_separator(source[m_index])) ++m_index;
+
+        TagToken* tag = m_tokens.Emplace<TagToken>(to_label(std::basic_string_view<C>(source.data() + position, m_index - position)));
+        tag->m_position = position; //m_index is left on the ':' for InitialState to step over
     }
 
 
-    void Lexer::ParseDirectiveStatement(const std::u32string& source, Directive directive)
+    template<Char C>
+    void Lexer::ParseDirectiveStatement(const std::basic_string<C>& source, Directive directive, uint32_t position)
     {
-        std::vector<TokenBase*> v;
+        size_t first = m_tokens.Size();
         switch (directive)
         {
         case Directive::ALIGN:
-            v = DirectiveToken<Directive::ALIGN>::Parse(source, m_index);
+            DirectiveToken<Directive::ALIGN>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::ASCII:
-            v = DirectiveToken<Directive::ASCII>::Parse(source, m_index);
+            DirectiveToken<Directive::ASCII>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::ASCIIZ:
-            v = DirectiveToken<Directive::ASCIIZ>::Parse(source, m_index);
+            DirectiveToken<Directive::ASCIIZ>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::BYTE:
-            v = DirectiveToken<Directive::BYTE>::Parse(source, m_index);
+            DirectiveToken<Directive::BYTE>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::DATA:
-            v = DirectiveToken<Directive::DATA>::Parse(source, m_index);
+            DirectiveToken<Directive::DATA>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::DOUBLE:
-            v = DirectiveToken<Directive::DOUBLE>::Parse(source, m_index);
+            DirectiveToken<Directive::DOUBLE>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::FLOAT:
-            v = DirectiveToken<Directive::FLOAT>::Parse(source, m_index);
+            DirectiveToken<Directive::FLOAT>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::GLOBL:
-            v = DirectiveToken<Directive::GLOBL>::Parse(source, m_index);
+            DirectiveToken<Directive::GLOBL>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::HALF:
-            v = DirectiveToken<Directive::HALF>::Parse(source, m_index);
+            DirectiveToken<Directive::HALF>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::KDATA:
-            v = DirectiveToken<Directive::KDATA>::Parse(source, m_index);
+            DirectiveToken<Directive::KDATA>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::KTEXT:
-            v = DirectiveToken<Directive::KTEXT>::Parse(source, m_index);
+            DirectiveToken<Directive::KTEXT>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::SPACE:
-            v = DirectiveToken<Directive::SPACE>::Parse(source, m_index);
+            DirectiveToken<Directive::SPACE>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::TEXT:
-            v = DirectiveToken<Directive::TEXT>::Parse(source, m_index);
+            DirectiveToken<Directive::TEXT>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         case Directive::WORD:
-            v = DirectiveToken<Directive::WORD>::Parse(source, m_index);
+            DirectiveToken<Directive::WORD>::Parse(source, m_index, position, m_lines, m_tokens);
             break;
         }
-        m_tokens->insert(m_tokens->end(), v.begin(), v.end());
+        for (size_t i = first; i < m_tokens.Size(); ++i)
+        {
+            m_tokens[i]->m_position = position;
+        }
     }
 
 
-    void Lexer::ParseInstructionStatement(const std::u32string& source, Instruction instruction)
+    template<Char C>
+    void Lexer::ParseInstructionStatement(const std::basic_string<C>& source, Instruction instruction, uint32_t position)
     {
         size_t length = 0;
-        while (source[m_index] != U'\n') length++;
-        std::u32string_view instructionArgs(source.data() + m_index * sizeof(char32_t), length);
+        while (m_index + length < source.size() && source[m_index + length] != U'\n') length++;
+        std::basic_string_view<C> instructionArgs(source.data() + m_index, length);
         m_index += length;
 
+        size_t first = m_tokens.Size();
         switch (instruction)
         {
-        case NeoMIPS::ISA::Instructions::Instruction::ABS_D:
-            InstructionToken<Instruction::ABS_S>::Parse(instructionArgs);
-            break;
-        case NeoMIPS::ISA::Instructions::Instruction::ABS_S:
-            break;
-        case NeoMIPS::ISA::Instructions::Instruction::ADD:
+        case Instruction::ABS_D:
+            InstructionToken<Instruction::ABS_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ADD_D:
+        case Instruction::ABS_S:
+            InstructionToken<Instruction::ABS_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ADD_S:
+        case Instruction::ADD:
+            InstructionToken<Instruction::ADD>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ADDI:
+        case Instruction::ADD_D:
+            InstructionToken<Instruction::ADD_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ADDIU:
+        case Instruction::ADD_S:
+            InstructionToken<Instruction::ADD_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ADDU:
+        case Instruction::ADDI:
+            InstructionToken<Instruction::ADDI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::AND:
+        case Instruction::ADDIU:
+            InstructionToken<Instruction::ADDIU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ANDI:
+        case Instruction::ADDU:
+            InstructionToken<Instruction::ADDU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BC1F:
+        case Instruction::AND:
+            InstructionToken<Instruction::AND>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BC1T:
+        case Instruction::ANDI:
+            InstructionToken<Instruction::ANDI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BEQ:
+        case Instruction::BC1F:
+            InstructionToken<Instruction::BC1F>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BGEZ:
+        case Instruction::BC1T:
+            InstructionToken<Instruction::BC1T>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BGEZAL:
+        case Instruction::BEQ:
+            InstructionToken<Instruction::BEQ>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BGTZ:
+        case Instruction::BGEZ:
+            InstructionToken<Instruction::BGEZ>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BLEZ:
+        case Instruction::BGEZAL:
+            InstructionToken<Instruction::BGEZAL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BLTZ:
+        case Instruction::BGTZ:
+            InstructionToken<Instruction::BGTZ>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BLTZAL:
+        case Instruction::BNE:
+            InstructionToken<Instruction::BNE>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BNE:
+        case Instruction::BREAK:
+            InstructionToken<Instruction::BREAK>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::BREAK:
-        case NeoMIPS::ISA::Instructions::Instruction::C_EQ_D:
+        case Instruction::C_EQ_D:
+            InstructionToken<Instruction::C_EQ_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::C_EQ_S:
+        case Instruction::C_EQ_S:
+            InstructionToken<Instruction::C_EQ_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::C_LE_D:
+        case Instruction::C_LE_D:
+            InstructionToken<Instruction::C_LE_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::C_LE_S:
+        case Instruction::C_LE_S:
+            InstructionToken<Instruction::C_LE_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::C_LT_D:
+        case Instruction::C_LT_D:
+            InstructionToken<Instruction::C_LT_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::C_LT_S:
+        case Instruction::C_LT_S:
+            InstructionToken<Instruction::C_LT_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CEIL_W_D:
+        case Instruction::CEIL_W_D:
+            InstructionToken<Instruction::CEIL_W_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CEIL_W_S:
+        case Instruction::CEIL_W_S:
+            InstructionToken<Instruction::CEIL_W_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CLO:
+        case Instruction::CLO:
+            InstructionToken<Instruction::CLO>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CLZ:
+        case Instruction::CLZ:
+            InstructionToken<Instruction::CLZ>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CVT_D_S:
+        case Instruction::CVT_D_S:
+            InstructionToken<Instruction::CVT_D_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CVT_D_W:
+        case Instruction::CVT_D_W:
+            InstructionToken<Instruction::CVT_D_W>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CVT_S_D:
+        case Instruction::CVT_S_D:
+            InstructionToken<Instruction::CVT_S_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CVT_S_W:
+        case Instruction::CVT_S_W:
+            InstructionToken<Instruction::CVT_S_W>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CVT_W_D:
+        case Instruction::CVT_W_D:
+            InstructionToken<Instruction::CVT_W_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::CVT_W_S:
+        case Instruction::CVT_W_S:
+            InstructionToken<Instruction::CVT_W_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::DIV:
+        case Instruction::DIV:
+            InstructionToken<Instruction::DIV>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::DIV_D:
+        case Instruction::DIV_D:
+            InstructionToken<Instruction::DIV_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::DIV_S:
+        case Instruction::DIV_S:
+            InstructionToken<Instruction::DIV_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::DIVU:
+        case Instruction::DIVU:
+            InstructionToken<Instruction::DIVU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ERET:
+        case Instruction::ERET:
+            InstructionToken<Instruction::ERET>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::FLOOR_W_D:
+        case Instruction::FLOOR_W_D:
+            InstructionToken<Instruction::FLOOR_W_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::FLOOR_W_S:
+        case Instruction::FLOOR_W_S:
+            InstructionToken<Instruction::FLOOR_W_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::J:
+        case Instruction::J:
+            InstructionToken<Instruction::J>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::JAL:
+        case Instruction::JAL:
+            InstructionToken<Instruction::JAL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::JALR_RA:
+        case Instruction::JALR_RA: //"jalr $rs", the parser of jalr handles both forms
+        case Instruction::JALR:
+            InstructionToken<Instruction::JALR>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::JALR:
+        case Instruction::JR:
+            InstructionToken<Instruction::JR>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::JR:
+        case Instruction::LB:
+            InstructionToken<Instruction::LB>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LB:
+        case Instruction::LBU:
+            InstructionToken<Instruction::LBU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LBU:
+        case Instruction::LDC1:
+            InstructionToken<Instruction::LDC1>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LDC1:
+        case Instruction::LH:
+            InstructionToken<Instruction::LH>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LH:
+        case Instruction::LHU:
+            InstructionToken<Instruction::LHU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LHU:
+        case Instruction::LL:
+            InstructionToken<Instruction::LL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LL:
+        case Instruction::LUI:
+            InstructionToken<Instruction::LUI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LUI:
+        case Instruction::LW:
+            InstructionToken<Instruction::LW>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LW:
+        case Instruction::LWC1:
+            InstructionToken<Instruction::LWC1>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LWC1:
+        case Instruction::LWL:
+            InstructionToken<Instruction::LWL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LWL:
+        case Instruction::LWR:
+            InstructionToken<Instruction::LWR>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::LWR:
+        case Instruction::MADD:
+            InstructionToken<Instruction::MADD>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MADD:
+        case Instruction::MADDU:
+            InstructionToken<Instruction::MADDU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MADDU:
+        case Instruction::MFC0:
+            InstructionToken<Instruction::MFC0>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MFC0:
+        case Instruction::MFC1:
+            InstructionToken<Instruction::MFC1>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MFC1:
+        case Instruction::MFHI:
+            InstructionToken<Instruction::MFHI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MFHI:
+        case Instruction::MFLO:
+            InstructionToken<Instruction::MFLO>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MFLO:
+        case Instruction::MOV_D:
+            InstructionToken<Instruction::MOV_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOV_D:
+        case Instruction::MOV_S:
+            InstructionToken<Instruction::MOV_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOV_S:
+        case Instruction::MOVF:
+            InstructionToken<Instruction::MOVF>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVF:
+        case Instruction::MOVF_D:
+            InstructionToken<Instruction::MOVF_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVF_D:
+        case Instruction::MOVF_S:
+            InstructionToken<Instruction::MOVF_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVF_S:
+        case Instruction::MOVN:
+            InstructionToken<Instruction::MOVN>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVN:
+        case Instruction::MOVN_D:
+            InstructionToken<Instruction::MOVN_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVN_D:
+        case Instruction::MOVN_S:
+            InstructionToken<Instruction::MOVN_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVN_S:
+        case Instruction::MOVT:
+            InstructionToken<Instruction::MOVT>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVT:
+        case Instruction::MOVT_D:
+            InstructionToken<Instruction::MOVT_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVT_D:
+        case Instruction::MOVT_S:
+            InstructionToken<Instruction::MOVT_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVT_S:
+        case Instruction::MOVZ:
+            InstructionToken<Instruction::MOVZ>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVZ:
+        case Instruction::MOVZ_D:
+            InstructionToken<Instruction::MOVZ_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVZ_D:
+        case Instruction::MOVZ_S:
+            InstructionToken<Instruction::MOVZ_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MOVZ_S:
+        case Instruction::MSUB:
+            InstructionToken<Instruction::MSUB>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MSUB:
+        case Instruction::MSUBU:
+            InstructionToken<Instruction::MSUBU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MSUBU:
+        case Instruction::MTC0:
+            InstructionToken<Instruction::MTC0>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MTC0:
+        case Instruction::MTC1:
+            InstructionToken<Instruction::MTC1>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MTC1:
+        case Instruction::MTHI:
+            InstructionToken<Instruction::MTHI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MTHI:
+        case Instruction::MTLO:
+            InstructionToken<Instruction::MTLO>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MTLO:
+        case Instruction::MUL:
+            InstructionToken<Instruction::MUL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MUL:
+        case Instruction::MUL_D:
+            InstructionToken<Instruction::MUL_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MUL_D:
+        case Instruction::MUL_S:
+            InstructionToken<Instruction::MUL_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MUL_S:
+        case Instruction::MULT:
+            InstructionToken<Instruction::MULT>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MULT:
+        case Instruction::MULTU:
+            InstructionToken<Instruction::MULTU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::MULTU:
+        case Instruction::NEG_D:
+            InstructionToken<Instruction::NEG_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::NEG_D:
+        case Instruction::NEG_S:
+            InstructionToken<Instruction::NEG_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::NEG_S:
+        case Instruction::NOP:
+            InstructionToken<Instruction::NOP>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::NOP:
+        case Instruction::NOR:
+            InstructionToken<Instruction::NOR>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::NOR:
+        case Instruction::OR:
+            InstructionToken<Instruction::OR>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::OR:
+        case Instruction::ORI:
+            InstructionToken<Instruction::ORI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ORI:
+        case Instruction::ROUND_W_D:
+            InstructionToken<Instruction::ROUND_W_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ROUND_W_D:
+        case Instruction::ROUND_W_S:
+            InstructionToken<Instruction::ROUND_W_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::ROUND_W_S:
+        case Instruction::SB:
+            InstructionToken<Instruction::SB>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SB:
+        case Instruction::SC:
+            InstructionToken<Instruction::SC>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SC:
+        case Instruction::SDC1:
+            InstructionToken<Instruction::SDC1>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SDC1:
+        case Instruction::SH:
+            InstructionToken<Instruction::SH>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SH:
+        case Instruction::SLL:
+            InstructionToken<Instruction::SLL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SLL:
+        case Instruction::SLLV:
+            InstructionToken<Instruction::SLLV>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SLLV:
+        case Instruction::SLT:
+            InstructionToken<Instruction::SLT>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SLT:
+        case Instruction::SLTI:
+            InstructionToken<Instruction::SLTI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SLTI:
+        case Instruction::SLTIU:
+            InstructionToken<Instruction::SLTIU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SLTIU:
+        case Instruction::SLTU:
+            InstructionToken<Instruction::SLTU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SLTU:
+        case Instruction::SQRT_D:
+            InstructionToken<Instruction::SQRT_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SQRT_D:
+        case Instruction::SQRT_S:
+            InstructionToken<Instruction::SQRT_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SQRT_S:
+        case Instruction::SRA:
+            InstructionToken<Instruction::SRA>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SRA:
+        case Instruction::SRAV:
+            InstructionToken<Instruction::SRAV>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SRAV:
+        case Instruction::SRL:
+            InstructionToken<Instruction::SRL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SRL:
+        case Instruction::SRLV:
+            InstructionToken<Instruction::SRLV>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SRLV:
+        case Instruction::SUB:
+            InstructionToken<Instruction::SUB>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SUB:
+        case Instruction::SUB_D:
+            InstructionToken<Instruction::SUB_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SUB_D:
+        case Instruction::SUB_S:
+            InstructionToken<Instruction::SUB_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SUB_S:
+        case Instruction::SUBU:
+            InstructionToken<Instruction::SUBU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SUBU:
+        case Instruction::SW:
+            InstructionToken<Instruction::SW>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SW:
+        case Instruction::SWC1:
+            InstructionToken<Instruction::SWC1>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SWC1:
+        case Instruction::SWL:
+            InstructionToken<Instruction::SWL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SWL:
+        case Instruction::SWR:
+            InstructionToken<Instruction::SWR>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SWR:
+        case Instruction::SYSCALL:
+            InstructionToken<Instruction::SYSCALL>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::SYSCALL:
+        case Instruction::TEQ:
+            InstructionToken<Instruction::TEQ>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TEQ:
+        case Instruction::TEQI:
+            InstructionToken<Instruction::TEQI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TEQI:
+        case Instruction::TGE:
+            InstructionToken<Instruction::TGE>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TGE:
+        case Instruction::TGEI:
+            InstructionToken<Instruction::TGEI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TGEI:
+        case Instruction::TGEIU:
+            InstructionToken<Instruction::TGEIU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TGEIU:
+        case Instruction::TGEU:
+            InstructionToken<Instruction::TGEU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TGEU:
+        case Instruction::TLT:
+            InstructionToken<Instruction::TLT>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TLT:
+        case Instruction::TLTI:
+            InstructionToken<Instruction::TLTI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TLTI:
+        case Instruction::TLTIU:
+            InstructionToken<Instruction::TLTIU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TLTIU:
+        case Instruction::TLTU:
+            InstructionToken<Instruction::TLTU>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TLTU:
+        case Instruction::TNE:
+            InstructionToken<Instruction::TNE>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TNE:
+        case Instruction::TNEI:
+            InstructionToken<Instruction::TNEI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TNEI:
+        case Instruction::TRUNC_W_D:
+            InstructionToken<Instruction::TRUNC_W_D>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TRUNC_W_D:
+        case Instruction::TRUNC_W_S:
+            InstructionToken<Instruction::TRUNC_W_S>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::TRUNC_W_S:
+        case Instruction::XOR:
+            InstructionToken<Instruction::XOR>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
-        case NeoMIPS::ISA::Instructions::Instruction::XOR:
-            break;
-        case NeoMIPS::ISA::Instructions::Instruction::XORI:
-            break;
-        case NeoMIPS::ISA::Instructions::Instruction::invalid:
+        case Instruction::XORI:
+            InstructionToken<Instruction::XORI>::Parse(instructionArgs, position, m_lines, m_tokens);
             break;
         default:
-            break;
+            throw Error::InvalidInstructionException(m_lines.Where(position), "This instruction is not supported yet.");
+        }
+        for (size_t i = first; i < m_tokens.Size(); ++i)
+        {
+            m_tokens[i]->m_position = position;
+            if (m_tokens[i]->GetTokenType() != TokenType::Instruction) continue;
+
+            //only instructions kept as written are checked, expansions of pseudoinstructions build their operands themselves
+            InstructionTokenBase* token = static_cast<InstructionTokenBase*>(m_tokens[i]);
+            const ISA::InstructionDescription& description = ISA::describe(token->GetInstruction());
+            if (static_cast<bool>(token->m_parameters.m_archetype & description.m_archetypes) && !ISA::operands_fit(description.m_instruction, token->m_parameters))
+            {
+                throw Error::InvalidInstructionException(m_lines.Where(position), "An operand of " + to_ascii_string(description.m_mnemonic) + " is out of range.");
+            }
         }
     }
 
 
-    void Lexer::split_line(const std::u32string& source, std::vector<std::u32string>& strs)
+    template<Char C>
+    void Lexer::split_line(const std::basic_string<C>& source, std::vector<std::basic_string<C>>& strs)
     {
         while (source[m_index] != U'\n')
         {
-            std::u32string str;
+            std::basic_string<C> str;
             while (!is_separator(source[m_index]))
             {
                 str += source[m_index++];
@@ -641,4 +623,7 @@ namespace NeoMIPS
             strs.push_back(str);
         }
     }
+
+    template TokenArena Lexer::Tokenize(std::u8string& source, LineMap lines);
+    template TokenArena Lexer::Tokenize(std::u32string& source, LineMap lines);
 }
\ No newline at end of file
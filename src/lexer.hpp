@@ -1,6 +1,7 @@
 #pragma once
 #include "token.hpp"
 #include "mips32isa.hpp"
+#include "lineindex.hpp"
 
 namespace NeoMIPS
 {
@@ -8,34 +9,31 @@ namespace NeoMIPS
     {
     private:
         const argmap_t& m_options;
-        std::unique_ptr<std::vector<TokenBase*>> m_tokens;
+        TokenArena m_tokens;
         uint32_t m_index;
+        LineIndex m_lines;
 
-        void ResolveEQV(std::u32string& source);
-        void GetMacroDeclaratios(std::u32string& source, std::vector<MacroDeclaration>& macros);
-        void ResolveMacros(std::u32string& source);
-        void ExpandMacros(std::vector<MacroDeclaration>& macros, std::u32string& source);
-        void ParseTag(const std::u32string& source);
-        void ParseAlphabetCharacters(const std::u32string& source);
-        void ParseDirective(const std::u32string& source);
-        void ParseDirectiveStatement(const std::u32string& source, ISA::Directive directive);
-        void ParseInstructionStatement(const std::u32string& source, ISA::Instruction instruction);
-        void split_line(const std::u32string& source, std::vector<std::u32string>& strs);
-        void skip_comment(const std::u32string& source);
-        void InitialState(const std::u32string& source);
+        template<Char C> void ParseTag(const std::basic_string<C>& source);
+        template<Char C> void ParseAlphabetCharacters(const std::basic_string<C>& source);
+        template<Char C> void ParseDirective(const std::basic_string<C>& source);
+        //position is the offset of the statement, errors in it report its line
+        template<Char C> void ParseDirectiveStatement(const std::basic_string<C>& source, ISA::Directive directive, uint32_t position);
+        template<Char C> void ParseInstructionStatement(const std::basic_string<C>& source, ISA::Instruction instruction, uint32_t position);
+        template<Char C> void split_line(const std::basic_string<C>& source, std::vector<std::basic_string<C>>& strs);
+        template<Char C> void skip_comment(const std::basic_string<C>& source);
+        template<Char C> void InitialState(const std::basic_string<C>& source);
 
     public:
-        Lexer(const argmap_t& options) : m_options(options), m_tokens(new std::vector<TokenBase*>()), m_index(0) {};
+        Lexer(const argmap_t& options) : m_options(options), m_index(0) {};
         
-        std::unique_ptr<std::vector<TokenBase*>> Tokenize(std::u32string& source);
+        //Instantiated for UTF-8 (char8_t) and UTF-32 (char32_t) sources. The UTF-8 lexer works on the raw bytes and
+        //only decodes code points inside string literals and labels. The source must already be preprocessed.
+        //The tokens are handed over with the arena they were allocated from. lines maps the source back to the files
+        //it was preprocessed from, errors report the file and line a statement was written on
+        template<Char C>
+        TokenArena Tokenize(std::basic_string<C>& source, LineMap lines);
 
-        ~Lexer()
-        {
-            for (TokenBase* tb : *m_tokens)
-            {
-                delete tb;
-            }
-        }
-        
+        //Line starts of the last source, which is all that is needed of it to report errors once it is freed
+        LineIndex ReleaseLines() { return std::move(m_lines); }
     };
 }
\ No newline at end of file
@@ -1,15 +1,21 @@
 #include <utility>
 #include <optional>
-#include "include/ctre-unicode.hpp"
+#include <algorithm>
+#include <mutex>
+#include <deque>
+#include <unordered_map>
 #include "lexer_util.hpp"
 #include "util.hpp"
-#include "lexer_regex.hpp"
+#include "utf8.hpp"
+#include "operandscanner.hpp"
+#include "mnemonictable.hpp"
 
 namespace NeoMIPS
 {
 	using namespace ISA;
 	//Warning: this will make all information in the upper 3 bytes of each 32bit character lost
-	std::string to_ascii_string(const std::u32string& str, bool stopAtNewline = false)
+	template<Char C>
+	std::string to_ascii_string(const std::basic_string<C>& str, bool stopAtNewline)
 	{
 		std::string narrowStr;
 		for (char32_t c : str)
@@ -20,123 +26,165 @@ namespace NeoMIPS
 		return narrowStr;
 	}
 
-	std::u32string get_next_word(const std::u32string& str, uint32_t& offset)
+	template<Char C>
+	std::string to_ascii_string(std::basic_string_view<C> str)
 	{
-		std::u32string s;
-		while (!is_separator(str[offset]))
+		std::string narrowStr;
+		for (char32_t c : str)
 		{
-			s += str[offset++];
+			narrowStr += static_cast<char>(c);
 		}
-		return s;
+		return narrowStr;
 	}
 
-	uint32_t get_reg_index(const std::u32string_view& sv)
+	//The word is a view into the source, it stays valid as long as the source does
+	template<Char C>
+	std::basic_string_view<C> get_next_word(const std::basic_string<C>& str, uint32_t& offset)
 	{
-		switch (sv[0])
+		uint32_t start = offset;
+		while (offset < str.size() && !is_separator(str[offset]))
 		{
-		case U'$':
-			switch (sv[1])
-			{
-			case U'z':
-				return 0;
-			case U'a':
-				return sv[2] == U't' ? 1 : 4 + sv[2] - 48;
-			case U'v':
-				return 2 + sv[2] - 48;
-			case U't':
-				return sv[2]>=8 ? 24+sv[2]-8-48 : 8 + sv[2] - 48;
-			case U's':
-				return sv[2] == U'p' ? 29 : 16 + sv[2] - 48;
-			case U'k':
-				return 26 + sv[2] - 48;
-			case U'g':
-				return 28;
-			case U'f':
-				return sv[2] == U'p' ? 30 : (sv.size() == 3 ? sv[2] - 48 : (sv[2] - 48) * 10 + sv[3] - 48);
-			case U'r':
-				return 31;
-			}
-		default:
-			if (sv.size() == 2)
-			{
-				return sv[1] - 48;
-			}
-			else
-			{
-				return (sv[1] - 48) * 10 + sv[2] - 48;
-			}
+			offset++;
 		}
+		return std::basic_string_view<C>(str.data() + start, offset - start);
 	}
 
-
-	bool parse_instruction(const std::u32string_view& line, InstructionParameters& params, InstructionSyntacticArchetypes archetypes)
+	//Literals and labels are the only places where the byte oriented lexer needs actual code points
+	template<Char C>
+	char32_t read_code_point(const std::basic_string<C>& str, uint32_t& index)
 	{
-	
-		if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegLabelAsOffsetReg))
+		if constexpr (std::is_same_v<C, char8_t>)
 		{
-			if (auto [match, reg1, label, reg2] = ctre::search<Regex::regLabelAsOffsetRegPattern>(line); match)
-			{
-				
-			}
+			return Utf8::decode_one(str, index);
 		}
-		if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+		else
 		{
-			if (auto [match, reg1, label, immediate, reg2] = ctre::search<Regex::regLabelPlusImmOffsetForRegPattern>(line); match)
-			{
-
-			}
+			return str[index];
 		}
-		if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegLabelPlusImm))
+	}
+
+	namespace
+	{
+		//Names of every label seen by any lexer of the run, their position in m_names is their ID. A deque
+		//never moves its elements, so the keys of m_ids can view the names it holds
+		struct LabelPool
 		{
-			if (auto [match, reg1, label, immediate] = ctre::search<Regex::regLabelPlusImmPattern>(line); match)
+			std::mutex m_mutex;
+			std::deque<std::u32string> m_names;
+			std::unordered_map<std::u32string_view, uint32_t> m_ids;
+
+			LabelPool()
+			{
+				Add(U""); //NO_LABEL
+			}
+
+			uint32_t Add(std::u32string_view label)
 			{
+				auto id = m_ids.find(label);
+				if (id != m_ids.end()) return id->second;
 
+				uint32_t next = static_cast<uint32_t>(m_names.size());
+				m_ids.emplace(m_names.emplace_back(label), next);
+				return next;
 			}
+		};
+
+		LabelPool& label_pool()
+		{
+			static LabelPool pool;
+			return pool;
 		}
-		if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegOffsetForReg))
+	}
+
+	uint32_t intern_label(std::u32string_view label)
+	{
+		LabelPool& pool = label_pool();
+		std::lock_guard lock(pool.m_mutex);
+		return pool.Add(label);
+	}
+
+	std::u32string_view label_name(uint32_t label)
+	{
+		LabelPool& pool = label_pool();
+		std::lock_guard lock(pool.m_mutex);
+		return pool.m_names[label];
+	}
+
+	uint32_t label_count()
+	{
+		LabelPool& pool = label_pool();
+		std::lock_guard lock(pool.m_mutex);
+		return static_cast<uint32_t>(pool.m_names.size());
+	}
+
+	//Labels are identified by their ID so tokens look the same whatever encoding the source was lexed in, and
+	//nothing lexed points into the source. UTF-8 labels are decoded into a buffer of the thread first
+	template<Char C>
+	uint32_t to_label(std::basic_string_view<C> label)
+	{
+		if constexpr (std::is_same_v<C, char32_t>)
 		{
-			if (auto [match, reg1, offset, reg2] = ctre::search<Regex::regOffsetForRegPattern>(line); match)
-			{
-				
-			}
+			return intern_label(label);
 		}
-		if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::RegRegReg))
+		else
 		{
-			int count = 0;
-			//std::remove_reference_t<decltype(*ctre::range<Regex::regPattern>(std::declval<std::u32string>()).begin())> reg[3];
-			
-			std::u32string_view reg[3];
-			for (auto& match : ctre::range<Regex::regPattern>(line))
+			thread_local std::u32string decoded;
+			decoded.clear();
+			for (uint32_t i = 0; i < label.size(); ++i)
 			{
-				reg[count] = match;
-				count++;
+				decoded += Utf8::decode_one(label, i);
 			}
-			if (count == 3)
-			{
-				params.m_reg1 = get_reg_index(reg[0]);
-				params.m_reg2 = get_reg_index(reg[1]);
-				params.m_reg3 = get_reg_index(reg[2]);
-				return true;
-			}
-		}
-		if (static_cast<bool>(archetypes & InstructionSyntacticArchetypes::NoParams))
-		{
-			return true;
+			return intern_label(decoded);
 		}
-		return false;
 	}
 
-	int index_to_line(const std::u32string& str, int index)
+	template<Char C>
+	bool parse_instruction(const std::basic_string_view<C>& line, InstructionParameters& params, InstructionSyntacticArchetypes archetypes)
 	{
-		int counter = 0;
-		while (index >= 0)
+		OperandList operands;
+		if (!scan_operands(line, operands)) return false;
+
+		InstructionSyntacticArchetypes archetype = classify_operands(operands);
+		if (!static_cast<bool>(archetype & archetypes)) return false;
+
+		params.m_archetype = archetype;
+		uint32_t* regs[] = { &params.m_reg1, &params.m_reg2, &params.m_reg3 };
+		uint32_t regCount = 0;
+		bool negateImmediate = false;
+		for (uint32_t i = 0; i < operands.m_count; ++i)
 		{
-			if (str[index--] == U'\n')
+			const Operand& operand = operands.m_operands[i];
+			switch (operand.m_kind)
 			{
-				++counter;
+			case OperandKind::Reg:
+				*regs[regCount++] = operand.m_value;
+				break;
+			case OperandKind::Imm:
+				params.m_immediate = negateImmediate ? 0 - operand.m_value : operand.m_value;
+				break;
+			case OperandKind::Label:
+				params.m_label = to_label(line.substr(operand.m_start, operand.m_length));
+				break;
+			case OperandKind::Minus:
+				negateImmediate = true;
+				break;
+			default:
+				break;
 			}
 		}
-		return counter;
+
+		//memory operands carry the immediate as the displacement too
+		switch (archetype)
+		{
+		case InstructionSyntacticArchetypes::RegOffsetForReg:
+		case InstructionSyntacticArchetypes::RegLabelPlusImm:
+		case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
+			params.m_offset = params.m_immediate;
+			break;
+		default:
+			break;
+		}
+		return true;
 	}
 
 	bool is_space(const char32_t c)
@@ -165,25 +213,51 @@ namespace NeoMIPS
 		}
 	}
 
-	std::optional<Instruction> is_instruction(const std::u32string& str)
+	//Mnemonics are plain ASCII so they compare equal code unit by code unit in any encoding
+	template<Char C>
+	std::optional<Instruction> is_instruction(std::basic_string_view<C> str)
 	{
-		auto hit = std::find_if(INSTRUCTIONS.cbegin(), INSTRUCTIONS.cend(), [&](const std::pair<const std::u32string_view, Instruction>& p) constexpr {return p.first == str; });
-		return hit != INSTRUCTIONS.cend() ? std::make_optional((*hit).second) : std::nullopt;
+		return INSTRUCTION_TABLE.find(str);
 	}
 
-	std::optional<Directive> is_directive(const std::u32string& str)
+	template<Char C>
+	std::optional<Directive> is_directive(std::basic_string_view<C> str)
 	{
-		auto hit = std::find_if(ISA::DIRECTIVES.cbegin(), DIRECTIVES.cend(), [&](const std::pair<const std::u32string_view, Directive>& p) constexpr {return p.first == str; });
-		return hit != DIRECTIVES.cend() ? std::make_optional((*hit).second) : std::nullopt;
+		return DIRECTIVE_TABLE.find(str);
 	}
 
-	bool is_tag(const std::u32string& str, uint32_t index)
+	template<Char C>
+	bool is_label_name(std::basic_string_view<C> str)
 	{
-		while (is_separator(str[index]))index++;
-		for (; !is_separator(str[index]); ++index)
+		auto starts_label = [](uint32_t c) { return c >= 128 || (c >= U'a' && c <= U'z') || (c >= U'A' && c <= U'Z') || c == U'_' || c == U'.'; };
+		if (str.empty() || !starts_label(static_cast<uint32_t>(str[0]))) return false;
+		return std::all_of(str.begin() + 1, str.end(), [&](C c) { return starts_label(static_cast<uint32_t>(c)) || (c >= U'0' && c <= U'9'); });
+	}
+
+	template<Char C>
+	bool is_tag(const std::basic_string<C>& str, uint32_t index)
+	{
+		while (index < str.size() && is_separator(str[index]))index++;
+		for (; index < str.size() && !is_separator(str[index]); ++index)
 		{
-			if (str[index + 1] == U':') return true;
+			if (index + 1 < str.size() && str[index + 1] == U':') return true;
 		}
 		return false;
 	}
+
+	//The lexer runs either over the raw UTF-8 bytes or over a decoded UTF-32 copy of the source
+#define NEOMIPS_INSTANTIATE_LEXER_UTIL(C) \
+	template bool is_tag(const std::basic_string<C>& str, uint32_t index); \
+	template std::string to_ascii_string(const std::basic_string<C>& str, bool stopAtNewline); \
+	template std::string to_ascii_string(std::basic_string_view<C> str); \
+	template std::basic_string_view<C> get_next_word(const std::basic_string<C>& str, uint32_t& offset); \
+	template char32_t read_code_point(const std::basic_string<C>& str, uint32_t& index); \
+	template uint32_t to_label(std::basic_string_view<C> label); \
+	template bool is_label_name(std::basic_string_view<C> str); \
+	template bool parse_instruction(const std::basic_string_view<C>& line, InstructionParameters& params, InstructionSyntacticArchetypes archetypes); \
+	template std::optional<Instruction> is_instruction(std::basic_string_view<C> str); \
+	template std::optional<Directive> is_directive(std::basic_string_view<C> str);
+
+	NEOMIPS_INSTANTIATE_LEXER_UTIL(char8_t)
+	NEOMIPS_INSTANTIATE_LEXER_UTIL(char32_t)
 }
@@ -1,19 +1,37 @@
 #pragma once
+#include <optional>
 #include <string>
+#include <optional>
 #include "mips32isa.hpp"
 #include "types.hpp"
+#include "constraints.hpp"
 
 namespace NeoMIPS
 {
 	
-	int index_to_line(const std::u32string& str, int index);
 	bool is_space(const char32_t c);
 	bool is_separator(const char32_t c);
-	bool is_tag(const std::u32string& str, uint32_t index);
-	std::string to_ascii_string(const std::u32string& str, bool stopAtNewline = false);
-	std::u32string get_next_word(const std::u32string& str, uint32_t& offset);
-	uint32_t get_reg_index(const std::u32string_view& sv);
-	bool parse_instruction(const std::u32string_view& line, InstructionParameters& params, InstructionSyntacticArchetypes archetypes);
-	std::optional<ISA::Instructions::Instruction> is_instruction(const std::u32string& str);
-	std::optional<ISA::Directives::Directive> is_directive(const std::u32string& str);
+	template<Char C> bool is_tag(const std::basic_string<C>& str, uint32_t index);
+	template<Char C> std::string to_ascii_string(const std::basic_string<C>& str, bool stopAtNewline = false);
+	template<Char C> std::string to_ascii_string(std::basic_string_view<C> str);
+	template<Char C> std::basic_string_view<C> get_next_word(const std::basic_string<C>& str, uint32_t& offset);
+	template<Char C> char32_t read_code_point(const std::basic_string<C>& str, uint32_t& index);
+	//ID of a label, the same for every occurrence of the name in any file of the run. IDs are dense, so
+	//tables of labels can be flat vectors indexed by them. NO_LABEL is the ID of the empty name
+	template<Char C> uint32_t to_label(std::basic_string_view<C> label);
+	//Whether str can be a label: letters, '_', '.' or anything outside ASCII, then those or digits
+	template<Char C> bool is_label_name(std::basic_string_view<C> str);
+	uint32_t intern_label(std::u32string_view label);
+	std::u32string_view label_name(uint32_t label);
+	uint32_t label_count();
+	template<Char C> bool parse_instruction(const std::basic_string_view<C>& line, InstructionParameters& params, InstructionSyntacticArchetypes archetypes);
+	template<Char C> std::optional<ISA::Instructions::Instruction> is_instruction(std::basic_string_view<C> str);
+	template<Char C> std::optional<ISA::Directives::Directive> is_directive(std::basic_string_view<C> str);
+
+	//Builds an ASCII keyword in the code unit type of the source being lexed
+	template<Char C>
+	inline std::basic_string<C> widen(std::string_view ascii)
+	{
+		return std::basic_string<C>(ascii.begin(), ascii.end());
+	}
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <iterator>
+#include "lineindex.hpp"
+
+namespace NeoMIPS
+{
+    void LineMap::Add(uint32_t sourceLine)
+    {
+        ++m_lines;
+        if (!m_runs.empty())
+        {
+            const LineOrigin& last = m_runs.back();
+            if (last.m_file == 0 && last.m_sourceLine + (m_lines - last.m_line) == sourceLine) return;
+        }
+        m_runs.push_back(LineOrigin{ m_lines, 0, sourceLine });
+    }
+
+    void LineMap::Append(const LineMap& other)
+    {
+        std::vector<uint32_t> files;
+        for (const std::string& path : other.m_files)
+        {
+            auto found = std::find(m_files.begin(), m_files.end(), path);
+            files.push_back(static_cast<uint32_t>(found - m_files.begin()));
+            if (found == m_files.end()) m_files.push_back(path);
+        }
+
+        if (other.m_lines != 0 && (other.m_runs.empty() || other.m_runs.front().m_line != 1))
+        {
+            m_runs.push_back(LineOrigin{ m_lines + 1, files[0], 1 });
+        }
+        for (const LineOrigin& run : other.m_runs)
+        {
+            m_runs.push_back(LineOrigin{ m_lines + run.m_line, files[run.m_file], run.m_sourceLine });
+        }
+        m_lines += other.m_lines;
+    }
+
+    std::string LineMap::Where(uint32_t line) const
+    {
+        const std::string* path = &m_files[0];
+        auto next = std::upper_bound(m_runs.cbegin(), m_runs.cend(), line, [](uint32_t l, const LineOrigin& run) { return l < run.m_line; });
+        if (next != m_runs.cbegin())
+        {
+            const LineOrigin& run = *std::prev(next);
+            path = &m_files[run.m_file];
+            line = run.m_sourceLine + (line - run.m_line);
+        }
+        if (path->empty()) return std::to_string(line);
+        return *path + ":" + std::to_string(line);
+    }
+
+    template<Char C>
+    LineIndex::LineIndex(std::basic_string_view<C> source, LineMap map) : m_lineStarts{ 0 }, m_map(std::move(map))
+    {
+        //char_traits::find lowers to memchr for byte sized code units
+        size_t newline = 0;
+        while ((newline = source.find(static_cast<C>(U'\n'), newline)) != std::basic_string_view<C>::npos)
+        {
+            m_lineStarts.push_back(static_cast<uint32_t>(++newline));
+        }
+    }
+
+    uint32_t LineIndex::Line(uint32_t index) const
+    {
+        //the first line start past index is the start of the next line, so its position is the 1 based line number
+        return static_cast<uint32_t>(std::upper_bound(m_lineStarts.cbegin(), m_lineStarts.cend(), index) - m_lineStarts.cbegin());
+    }
+
+    std::string LineIndex::Where(uint32_t index) const
+    {
+        return m_map.Where(Line(index));
+    }
+
+    SourceLocation LineIndex::Locate(uint32_t index) const
+    {
+        uint32_t line = Line(index);
+        return SourceLocation{ line, index - m_lineStarts[line - 1] + 1 };
+    }
+
+    template LineIndex::LineIndex(std::basic_string_view<char8_t> source, LineMap map);
+    template LineIndex::LineIndex(std::basic_string_view<char32_t> source, LineMap map);
+}
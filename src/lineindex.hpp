@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "constraints.hpp"
+
+namespace NeoMIPS
+{
+    struct SourceLocation
+    {
+        uint32_t m_line;   //starting at 1
+        uint32_t m_column; //starting at 1, counted in code units of the source
+    };
+
+    //Where a run of lines of a preprocessed buffer was written: the file, as an index into the files of its LineMap,
+    //and the line the run starts at in it
+    struct LineOrigin
+    {
+        uint32_t m_line;       //first line of the run in the preprocessed buffer, starting at 1
+        uint32_t m_file;
+        uint32_t m_sourceLine; //starting at 1
+    };
+
+    //Maps the lines of a preprocessed buffer back to the files and lines they were written on, which differ from the
+    //lines of the buffer once an .include is spliced in. The preprocessor adds the lines one at a time as it writes
+    //them, and only a new run is stored when a line doesn't follow the previous one in the same file
+    class LineMap
+    {
+    private:
+        std::vector<std::string> m_files; //the first one is the file that was preprocessed
+        std::vector<LineOrigin> m_runs;
+        uint32_t m_lines = 0;
+
+    public:
+        explicit LineMap(const std::string& path = "") : m_files{ path } {};
+        LineMap(std::vector<std::string> files, std::vector<LineOrigin> runs, uint32_t lines) : m_files(std::move(files)), m_runs(std::move(runs)), m_lines(lines) {};
+
+        //The next line of the buffer was written on sourceLine of the first file
+        void Add(uint32_t sourceLine);
+        //The lines of other follow, as when the preprocessed file they map is spliced in
+        void Append(const LineMap& other);
+        //path:line a line of the buffer was written on, lines that were never added map to themselves in the first file
+        std::string Where(uint32_t line) const;
+
+        const std::vector<std::string>& Files() const { return m_files; }
+        const std::vector<LineOrigin>& Runs() const { return m_runs; }
+        uint32_t LineCount() const { return m_lines; }
+    };
+
+    //Offsets at which every line of a source buffer starts. It is built with a single pass over the buffer, after
+    //which the line of any offset is a binary search away instead of a backwards scan counting newlines
+    class LineIndex
+    {
+    private:
+        std::vector<uint32_t> m_lineStarts;
+        LineMap m_map;
+
+    public:
+        LineIndex() : m_lineStarts{ 0 } {};
+
+        //map tells which file and line every line of the source was written on, errors report them
+        template<Char C>
+        LineIndex(std::basic_string_view<C> source, LineMap map);
+
+        uint32_t Line(uint32_t index) const;
+        //path:line the offset was written on, the same form as the errors of the linker, only the line if there is no path
+        std::string Where(uint32_t index) const;
+        SourceLocation Locate(uint32_t index) const;
+        uint32_t LineCount() const { return static_cast<uint32_t>(m_lineStarts.size()); }
+        const LineMap& Map() const { return m_map; }
+    };
+}
@@ -0,0 +1,304 @@
+#include <algorithm>
+#include "linker.hpp"
+#include "lexer_util.hpp"
+#include "util.hpp"
+#include "error.hpp"
+
+namespace NeoMIPS
+{
+    namespace
+    {
+        //Units are placed at 8 byte boundaries so the alignment of .double and .align 3 holds across files
+        constexpr uint32_t UNIT_ALIGNMENT = 8;
+
+        template<Char C>
+        std::string where(const TranslationUnit<C>& unit, uint32_t position)
+        {
+            return unit.m_lines.Where(position);
+        }
+
+        //Segment selected by a directive, if it is one of the segment directives
+        bool segment_of(Directive directive, Segment& segment)
+        {
+            switch (directive)
+            {
+            case Directive::TEXT: segment = Segment::Text; return true;
+            case Directive::DATA: segment = Segment::Data; return true;
+            case Directive::KTEXT: segment = Segment::KText; return true;
+            case Directive::KDATA: segment = Segment::KData; return true;
+            default: return false;
+            }
+        }
+
+        constexpr bool is_code(Segment segment)
+        {
+            return segment == Segment::Text || segment == Segment::KText;
+        }
+
+        //Bytes of one value of a data directive, 1 for the ones emitting strings, bytes or space
+        constexpr uint32_t value_size(Directive directive)
+        {
+            switch (directive)
+            {
+            case Directive::HALF: return 2;
+            case Directive::WORD: case Directive::FLOAT: return 4;
+            case Directive::DOUBLE: return 8;
+            default: return 1;
+            }
+        }
+
+        void store_word(uint8_t* out, uint32_t word, std::endian endianness)
+        {
+            if (endianness == std::endian::big) word = __builtin_bswap32(word);
+            store_little_endian(out, word, 4);
+        }
+
+        const char* segment_name(Segment segment)
+        {
+            constexpr std::array<const char*, SEGMENT_COUNT> NAMES{ ".text", ".data", ".ktext", ".kdata" };
+            return NAMES[static_cast<size_t>(segment)];
+        }
+    }
+
+    template<Char C>
+    void Linker<C>::Measure(TranslationUnit<C>& unit, std::endian endianness)
+    {
+        Segment segment = Segment::Text;
+        std::array<uint32_t, SEGMENT_COUNT> offsets{};
+        auto instructions = [&unit](Segment segment) -> InstructionIR& { return segment == Segment::KText ? unit.m_ktextInstructions : unit.m_textInstructions; };
+        auto image = [&unit](Segment segment) -> std::vector<uint8_t>& { return segment == Segment::KData ? unit.m_kdata : unit.m_data; };
+
+        //Moves the end of the current segment forward to offset, filling code with nops and data with zeros
+        auto pad = [&](uint32_t& offset, uint32_t to)
+        {
+            if (is_code(segment)) instructions(segment).Pad((to - offset) / 4);
+            offset = to;
+        };
+        //labels with nothing placed after them yet, they name the value that follows and not its padding
+        std::vector<Symbol*> unplaced;
+
+        for (TokenBase* token : unit.m_tokens)
+        {
+            uint32_t& offset = offsets[static_cast<size_t>(segment)];
+            switch (token->GetTokenType())
+            {
+            case TokenType::Tag:
+            {
+                uint32_t label = static_cast<TagToken*>(token)->m_label;
+                auto [symbol, added] = unit.m_labels.emplace(label, Symbol{ segment, offset });
+                if (!added)
+                {
+                    throw Error::LinkException(where(unit, token->m_position), "The label " + to_ascii_string(label_name(label)) + " is defined more than once.");
+                }
+                unplaced.push_back(&symbol->second);
+                break;
+            }
+            case TokenType::Instruction:
+                if (!is_code(segment))
+                {
+                    throw Error::LinkException(where(unit, token->m_position), "Instructions can only be placed in the .text and .ktext segments.");
+                }
+                instructions(segment).Append(*static_cast<InstructionTokenBase*>(token));
+                offset += 4;
+                unplaced.clear();
+                break;
+            case TokenType::Directive:
+            {
+                DirectiveTokenBase* directive = static_cast<DirectiveTokenBase*>(token);
+                if (segment_of(directive->GetDirective(), segment))
+                {
+                    unplaced.clear();
+                    uint32_t address = directive->StartAddress();
+                    if (address == NO_ADDRESS) break;
+
+                    size_t s = static_cast<size_t>(segment);
+                    if (is_code(segment) && address % 4 != 0)
+                    {
+                        throw Error::LinkException(where(unit, token->m_position), std::string("The ") + segment_name(segment) + " segment can only start at a word aligned address.");
+                    }
+                    //the first address pins the start of the segment, the ones after it can only move forward
+                    if (unit.m_origins[s] == NO_ADDRESS && address >= offsets[s])
+                    {
+                        unit.m_origins[s] = address - offsets[s];
+                    }
+                    else if (unit.m_origins[s] == NO_ADDRESS || address - unit.m_origins[s] < offsets[s] || address < unit.m_origins[s])
+                    {
+                        throw Error::LinkException(where(unit, token->m_position), std::string("The ") + segment_name(segment) + " segment can't go back to " + to_hex(address) + ", the file has already placed data after it.");
+                    }
+                    pad(offsets[s], address - unit.m_origins[s]);
+                    break;
+                }
+                if (directive->GetDirective() == Directive::GLOBL)
+                {
+                    unit.m_globals.push_back(intern_label(static_cast<DirectiveToken<Directive::GLOBL>*>(directive)->GetSymbol()));
+                }
+
+                uint32_t size = directive->Size(offset);
+                if (size == 0) break;
+                for (Symbol* symbol : unplaced) symbol->m_offset += align_padding(offset, value_size(directive->GetDirective()));
+                unplaced.clear();
+                if (is_code(segment))
+                {
+                    //only .align can make room in code, and as the offset is a whole number of words so is its padding
+                    if (directive->GetDirective() != Directive::ALIGN)
+                    {
+                        throw Error::LinkException(where(unit, token->m_position), "Data can only be placed in the .data and .kdata segments.");
+                    }
+                    pad(offset, offset + size);
+                    break;
+                }
+                std::vector<uint8_t>& data = image(segment);
+                data.resize(offset + size);
+                directive->Emit(data.data() + offset, offset);
+                if (directive->GetDirective() == Directive::WORD)
+                {
+                    uint32_t label = static_cast<DirectiveToken<Directive::WORD>*>(directive)->GetLabel();
+                    if (label != NO_LABEL) unit.m_dataRelocations.push_back(DataRelocation{ segment, offset + size - 4, label, token->m_position });
+                }
+                //directives emit little endian, a big endian value is reversed after its padding
+                if (endianness == std::endian::big)
+                {
+                    auto end = data.begin() + offset + size;
+                    std::reverse(end - value_size(directive->GetDirective()), end);
+                }
+                offset += size;
+                break;
+            }
+            default:
+                break;
+            }
+        }
+        unit.m_sizes = offsets;
+        unit.m_data.resize(offsets[static_cast<size_t>(Segment::Data)]);
+        unit.m_kdata.resize(offsets[static_cast<size_t>(Segment::KData)]);
+    }
+
+    template<Char C>
+    void Linker<C>::Link(std::vector<std::unique_ptr<TranslationUnit<C>>>& units)
+    {
+        for (auto& unit : units)
+        {
+            for (size_t s = 0; s < SEGMENT_COUNT; ++s)
+            {
+                uint32_t size = (unit->m_sizes[s] + UNIT_ALIGNMENT - 1) & ~(UNIT_ALIGNMENT - 1);
+                uint32_t base = unit->m_origins[s] == NO_ADDRESS ? m_ends[s] : unit->m_origins[s];
+                if (base + uint64_t{ size } >= 0x100000000)
+                {
+                    throw Error::LinkException(unit->m_path, std::string("The ") + segment_name(static_cast<Segment>(s)) + " segment goes past the end of memory.");
+                }
+                if (unit->m_origins[s] != NO_ADDRESS && size > 0 && m_starts[s] != NO_ADDRESS && base < m_ends[s] && base + size > m_starts[s])
+                {
+                    throw Error::LinkException(unit->m_path, std::string("The ") + segment_name(static_cast<Segment>(s)) + " segment at " + to_hex(base) + " overlaps the one of a previous file.");
+                }
+
+                unit->m_bases[s] = base;
+                if (size == 0) continue;
+                m_ends[s] = m_starts[s] == NO_ADDRESS ? base + size : std::max(m_ends[s], base + size);
+                m_starts[s] = std::min(m_starts[s], base);
+            }
+            for (auto& [label, symbol] : unit->m_labels)
+            {
+                symbol.m_offset += unit->m_bases[static_cast<size_t>(symbol.m_segment)];
+            }
+        }
+
+        //every label of every unit is interned by now
+        m_globals.assign(label_count(), UNDEFINED);
+        m_exporters.assign(label_count(), nullptr);
+        for (auto& unit : units)
+        {
+            for (uint32_t label : unit->m_globals)
+            {
+                auto symbol = unit->m_labels.find(label);
+                if (symbol == unit->m_labels.end())
+                {
+                    throw Error::LinkException(unit->m_path, "The global label " + to_ascii_string(label_name(label)) + " is not defined in this file.");
+                }
+
+                const TranslationUnit<C>*& exporter = m_exporters[label];
+                if (exporter && exporter != unit.get())
+                {
+                    throw Error::LinkException(unit->m_path, "The global label " + to_ascii_string(label_name(label)) + " is also defined in " + exporter->m_path + ".");
+                }
+                if (!exporter) ++m_globalCount;
+                exporter = unit.get();
+                m_globals[label] = symbol->second.m_offset;
+            }
+        }
+    }
+
+    template<Char C>
+    uint32_t Linker<C>::Resolve(const TranslationUnit<C>& unit, uint32_t label, uint32_t position) const
+    {
+        if (auto local = unit.m_labels.find(label); local != unit.m_labels.end()) return local->second.m_offset;
+        if (label < m_globals.size() && m_globals[label] != UNDEFINED) return m_globals[label];
+        throw Error::LinkException(where(unit, position), "The label " + to_ascii_string(label_name(label)) + " is not defined.");
+    }
+
+    template<Char C>
+    void Linker<C>::Encode(TranslationUnit<C>& unit) const
+    {
+        auto encode = [&](const InstructionIR& instructions, Segment segment, std::vector<uint32_t>& out)
+        {
+            //every label is looked up once per unit, the IR refers to them by index
+            std::vector<uint32_t> addresses;
+            addresses.reserve(instructions.Labels().size());
+            for (uint32_t index = 0; index < instructions.Labels().size(); ++index)
+            {
+                addresses.push_back(Resolve(unit, instructions.Labels()[index], instructions.LabelPosition(index)));
+            }
+
+            out.resize(instructions.Size());
+            instructions.Encode(addresses, unit.m_bases[static_cast<size_t>(segment)], out.data());
+        };
+
+        encode(unit.m_textInstructions, Segment::Text, unit.m_text);
+        encode(unit.m_ktextInstructions, Segment::KText, unit.m_ktext);
+
+        for (const DataRelocation& relocation : unit.m_dataRelocations)
+        {
+            std::vector<uint8_t>& data = relocation.m_segment == Segment::KData ? unit.m_kdata : unit.m_data;
+            store_word(data.data() + relocation.m_offset, Resolve(unit, relocation.m_label, relocation.m_position), m_endianness);
+        }
+    }
+
+    template<Char C>
+    Program Linker<C>::Emit(const std::vector<std::unique_ptr<TranslationUnit<C>>>& units) const
+    {
+        Program program;
+        program.m_endianness = m_endianness;
+        for (size_t s = 0; s < SEGMENT_COUNT; ++s)
+        {
+            program.m_bases[s] = Start(static_cast<Segment>(s));
+            program.m_images[s].resize(End(static_cast<Segment>(s)) - program.m_bases[s]);
+        }
+
+        program.m_entry = program.m_bases[static_cast<size_t>(Segment::Text)];
+        size_t symbols = 0;
+        for (auto& unit : units) symbols += unit->m_labels.size();
+        program.m_symbols.reserve(symbols);
+
+        for (auto& unit : units)
+        {
+            auto offset = [&](Segment segment) { return unit->m_bases[static_cast<size_t>(segment)] - program.m_bases[static_cast<size_t>(segment)]; };
+
+            uint8_t* text = program.m_images[static_cast<size_t>(Segment::Text)].data() + offset(Segment::Text);
+            for (size_t i = 0; i < unit->m_text.size(); ++i) store_word(text + 4 * i, unit->m_text[i], m_endianness);
+            uint8_t* ktext = program.m_images[static_cast<size_t>(Segment::KText)].data() + offset(Segment::KText);
+            for (size_t i = 0; i < unit->m_ktext.size(); ++i) store_word(ktext + 4 * i, unit->m_ktext[i], m_endianness);
+            std::copy(unit->m_data.begin(), unit->m_data.end(), program.m_images[static_cast<size_t>(Segment::Data)].begin() + offset(Segment::Data));
+            std::copy(unit->m_kdata.begin(), unit->m_kdata.end(), program.m_images[static_cast<size_t>(Segment::KData)].begin() + offset(Segment::KData));
+
+            for (auto& [label, symbol] : unit->m_labels)
+            {
+                bool global = label < m_exporters.size() && m_exporters[label] == unit.get();
+                program.m_symbols.push_back(ProgramSymbol{ label, symbol.m_offset, symbol.m_segment, global });
+                if (global && label_name(label) == U"main") program.m_entry = symbol.m_offset;
+            }
+        }
+        return program;
+    }
+
+    template class Linker<char8_t>;
+    template class Linker<char32_t>;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "constraints.hpp"
+#include "filereader.hpp"
+#include "instructionir.hpp"
+#include "lineindex.hpp"
+#include "program.hpp"
+#include "token.hpp"
+
+namespace NeoMIPS
+{
+    constexpr uint32_t NO_ADDRESS = DirectiveTokenBase::NO_ADDRESS;
+
+    //Where each segment of the first unit starts, the units that follow are placed right after it
+    constexpr std::array<uint32_t, SEGMENT_COUNT> SEGMENT_BASES{ 0x00400000, 0x10010000, 0x80000180, 0x90000000 };
+
+    struct Symbol
+    {
+        Segment m_segment;
+        uint32_t m_offset; //from the start of the segment of the unit while measuring, absolute once linked
+    };
+
+    //A word of a data segment that holds the address of a label, written in when the unit is encoded
+    struct DataRelocation
+    {
+        Segment m_segment;
+        uint32_t m_offset;   //of the word from the start of the segment of the unit
+        uint32_t m_label;    //ID
+        uint32_t m_position; //of the directive in the source, for errors
+    };
+
+    //One source file of the program and everything produced from it. Units are loaded, preprocessed, lexed
+    //and measured independently, so every one of them can be handled by a different thread
+    template<Char C>
+    struct TranslationUnit
+    {
+        std::string m_path;
+        LineIndex m_lines; //of the preprocessed text, which is freed once it is lexed
+        TokenArena m_tokens;
+        std::unordered_map<uint32_t, Symbol> m_labels; //by label ID
+        std::vector<uint32_t> m_globals; //IDs of the labels the unit exports with .globl
+        std::array<uint32_t, SEGMENT_COUNT> m_sizes{};
+        std::array<uint32_t, SEGMENT_COUNT> m_bases{};
+        //Where a segment directive with an address pinned the start of each segment of the unit, or NO_ADDRESS
+        //if the linker is free to place it after the previous unit
+        std::array<uint32_t, SEGMENT_COUNT> m_origins{ NO_ADDRESS, NO_ADDRESS, NO_ADDRESS, NO_ADDRESS };
+        InstructionIR m_textInstructions;
+        InstructionIR m_ktextInstructions;
+        std::vector<uint32_t> m_text;
+        std::vector<uint32_t> m_ktext;
+        std::vector<uint8_t> m_data;
+        std::vector<uint8_t> m_kdata;
+        std::vector<DataRelocation> m_dataRelocations; //.word of a label
+
+        LoadStatistics m_loadStatistics{};
+        bool m_cached = false;
+
+        explicit TranslationUnit(const std::string& path) : m_path(path) {};
+        TranslationUnit(const TranslationUnit&) = delete;
+        TranslationUnit& operator=(const TranslationUnit&) = delete;
+    };
+
+    //Turns separately lexed units into one program. Measuring and encoding only touch their own unit and can
+    //run in parallel, linking is the sequential step in between: it places every unit after the previous one,
+    //or where its segment directives say, and resolves the labels that cross units. Each step is one pass
+    //over the tokens or the IR. Like in MARS, labels are local to their file unless declared
+    //with .globl, and a local label hides a global one with the same name
+    template<Char C>
+    class Linker
+    {
+    public:
+        static constexpr uint32_t UNDEFINED = 0xFFFFFFFF;
+
+    private:
+        //Indexed by label ID, so looking up a global label is an array access
+        std::vector<uint32_t> m_globals; //address of every global label or UNDEFINED
+        std::vector<const TranslationUnit<C>*> m_exporters;
+        size_t m_globalCount = 0;
+        std::array<uint32_t, SEGMENT_COUNT> m_ends = SEGMENT_BASES;
+        std::array<uint32_t, SEGMENT_COUNT> m_starts{ NO_ADDRESS, NO_ADDRESS, NO_ADDRESS, NO_ADDRESS }; //lowest address placed so far
+        std::endian m_endianness;
+
+        //Address of a label used at position of a linked unit, its own labels hide the global ones
+        uint32_t Resolve(const TranslationUnit<C>& unit, uint32_t label, uint32_t position) const;
+
+    public:
+        //Lays out the words of the program in the byte order of the endianness
+        explicit Linker(std::endian endianness = std::endian::little) : m_endianness(endianness) {}
+
+        //Collects the labels of the unit and the size of each of its segments, moves its instructions to the
+        //IR of their segment and writes its data segments, which don't depend on any label, in the byte order
+        //of the endianness
+        static void Measure(TranslationUnit<C>& unit, std::endian endianness = std::endian::little);
+
+        //Gives each unit its base addresses, in order, and builds the table of global labels
+        void Link(std::vector<std::unique_ptr<TranslationUnit<C>>>& units);
+
+        //First and one past the last address used in each segment by the units linked so far
+        uint32_t Start(Segment segment) const { return m_starts[static_cast<size_t>(segment)] == NO_ADDRESS ? m_ends[static_cast<size_t>(segment)] : m_starts[static_cast<size_t>(segment)]; }
+        uint32_t End(Segment segment) const { return m_ends[static_cast<size_t>(segment)]; }
+
+        //Resolves the labels used by the instructions of a linked unit and encodes them, and writes the addresses
+        //of the labels its data words hold
+        void Encode(TranslationUnit<C>& unit) const;
+
+        //Copies the encoded units into the images of the program, at their addresses
+        Program Emit(const std::vector<std::unique_ptr<TranslationUnit<C>>>& units) const;
+
+        size_t GlobalCount() const { return m_globalCount; }
+    };
+}
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "memory.hpp"
+#include "objectfile.hpp"
+#include "util.hpp"
+#include "error.hpp"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace NeoMIPS
+{
+    namespace
+    {
+        uint32_t load_little_endian(const uint8_t* bytes)
+        {
+            return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+        }
+
+        constexpr size_t FLAT_SIZE = static_cast<size_t>(uint64_t{ 1 } << 32);
+    }
+
+    Memory::Memory(uint32_t chunkMask, uint32_t maxResident) : m_chunkMask(chunkMask), m_maxResident(maxResident)
+    {
+        if (chunkMask < MIN_CHUNK_MASK || (chunkMask & (chunkMask + 1)) != 0)
+        {
+            throw Error::MemoryException("--memchunksize", "The chunk size " + to_hex(chunkMask) + " has to be one less than a power of two, from " + to_hex(MIN_CHUNK_MASK) + " up.");
+        }
+        m_chunkBits = static_cast<uint32_t>(std::popcount(chunkMask));
+        m_tableBits = (32 - m_chunkBits) / 2;
+        m_tlbShift = std::min<uint32_t>(m_chunkBits, 16);
+        if (chunkMask != FLAT_CHUNK_MASK)
+        {
+            m_pageTable.resize(size_t{ 1 } << (32 - m_chunkBits - m_tableBits));
+            return;
+        }
+
+#if defined(_WIN32)
+        throw Error::MemoryException("--memchunksize", "Flat memory needs mmap, which this host doesn't have.");
+#else
+        if constexpr (sizeof(void*) < 8) throw Error::MemoryException("--memchunksize", "Flat memory needs a host with 64-bit addresses.");
+        void* flat = mmap(nullptr, FLAT_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (flat == MAP_FAILED) throw Error::MemoryException("--memchunksize", "The 4 GiB of flat memory could not be reserved.");
+        m_flat = static_cast<uint8_t*>(flat);
+#endif
+    }
+
+    Memory::~Memory()
+    {
+#ifndef _WIN32
+        if (m_flat) munmap(m_flat, FLAT_SIZE);
+#endif
+        for (const Mapping& mapping : m_mappings)
+        {
+#ifndef _WIN32
+            if (mapping.m_mapped)
+            {
+                munmap(mapping.m_address, mapping.m_size);
+                continue;
+            }
+#endif
+            delete[] static_cast<uint8_t*>(mapping.m_address);
+        }
+    }
+
+    void Memory::AddRegion(uint32_t base, uint32_t size, uint8_t* data, bool executable, const std::string& where)
+    {
+        if (size == 0) return;
+        if (base + uint64_t{ size } > 0x100000000)
+        {
+            throw Error::MemoryException(where, "The region at " + to_hex(base) + " goes past the end of memory.");
+        }
+
+        if (!IsFree(base, size))
+        {
+            throw Error::MemoryException(where, "The region at " + to_hex(base) + " overlaps another one.");
+        }
+        auto next = std::upper_bound(m_regions.begin(), m_regions.end(), base, [](uint32_t address, const Region& region) { return address < region.m_base; });
+        m_regions.insert(next, Region{ base, size, data, executable });
+        //a span of flat memory may reach into the new region now
+        if (m_flat) m_tlb.fill(Region{ 0, 0, nullptr, false });
+    }
+
+    bool Memory::IsFree(uint32_t base, uint32_t size) const
+    {
+        auto next = std::upper_bound(m_regions.begin(), m_regions.end(), base, [](uint32_t address, const Region& region) { return address < region.m_base; });
+        bool overlapsPrevious = next != m_regions.begin() && std::prev(next)->m_base + uint64_t{ std::prev(next)->m_size } > base;
+        bool overlapsNext = next != m_regions.end() && base + uint64_t{ size } > next->m_base;
+        return !overlapsPrevious && !overlapsNext;
+    }
+
+    void Memory::Reserve(uint64_t bytes, uint32_t address)
+    {
+        if (m_resident + bytes > m_maxResident)
+        {
+            throw Error::MemoryException(to_hex(address), "The program needs more than the " + std::to_string(m_maxResident) + " bytes of memory --maxmemoryusage lets it use.");
+        }
+        m_resident += bytes;
+    }
+
+    void Memory::Allocate(uint32_t base, uint32_t size, bool executable)
+    {
+#ifndef _WIN32
+        if (m_flat)
+        {
+            //the pages are committed by the kernel when they are touched, zeroed
+            if (size == 0) return;
+            Reserve(size, base);
+            uintptr_t first = reinterpret_cast<uintptr_t>(m_flat + base) & ~static_cast<uintptr_t>(sysconf(_SC_PAGESIZE) - 1);
+            uintptr_t end = reinterpret_cast<uintptr_t>(m_flat + base) + size;
+            if (!IsFree(base, size) || mprotect(reinterpret_cast<void*>(first), end - first, PROT_READ | PROT_WRITE) != 0)
+            {
+                throw Error::MemoryException(to_hex(base), "The region at " + to_hex(base) + " could not be added to flat memory.");
+            }
+            AddRegion(base, size, m_flat + base, executable, to_hex(base));
+            return;
+        }
+#endif
+
+        //code is decoded from one block, everything else is paged
+        if (!executable)
+        {
+            AddRegion(base, size, nullptr, false, to_hex(base));
+            return;
+        }
+        Reserve(size, base);
+        uint8_t* data = new uint8_t[size]();
+        m_mappings.push_back(Mapping{ data, size, false });
+        AddRegion(base, size, data, executable, to_hex(base));
+    }
+
+    void Memory::Write(uint32_t address, const uint8_t* bytes, uint32_t size)
+    {
+        for (uint32_t done = 0; done < size;)
+        {
+            Region span = Peek(address + done);
+            if (span.m_size == 0) throw Error::MemoryException(to_hex(address + done), "Address " + to_hex(address + done) + " is not in memory.");
+            uint32_t piece = static_cast<uint32_t>(std::min<uint64_t>(size - done, uint64_t{ span.m_base } + span.m_size - (address + done)));
+            if (span.m_data || std::any_of(bytes + done, bytes + done + piece, [](uint8_t byte) { return byte != 0; }))
+            {
+                span = Span(address + done);
+                std::memcpy(span.m_data + (address + done - span.m_base), bytes + done, piece);
+            }
+            done += piece;
+        }
+    }
+
+    void Memory::Load(const Program& program)
+    {
+        for (size_t s = 0; s < SEGMENT_COUNT; ++s)
+        {
+            const std::vector<uint8_t>& image = program.m_images[s];
+            if (image.empty()) continue;
+            bool executable = static_cast<Segment>(s) == Segment::Text || static_cast<Segment>(s) == Segment::KText;
+            Allocate(program.m_bases[s], static_cast<uint32_t>(image.size()), executable);
+            Write(program.m_bases[s], image.data(), static_cast<uint32_t>(image.size()));
+        }
+        m_endianness = program.m_endianness;
+        m_entry = program.m_entry;
+    }
+
+    void Memory::MapImage(const std::string& path)
+    {
+        using namespace FlatImage;
+        uint8_t* bytes = nullptr;
+        size_t size = 0;
+
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.good())
+        {
+            throw Error::FileNotFoundException("", std::string("File \"").append(path).append("\" does not exist."));
+        }
+        size = static_cast<size_t>(file.tellg());
+        bytes = new uint8_t[size];
+        m_mappings.push_back(Mapping{ bytes, size, false });
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(bytes), size))
+        {
+            throw Error::FileReadException("", std::string("Could not read input file!"));
+        }
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw Error::FileNotFoundException("", std::string("File \"").append(path).append("\" does not exist."));
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < static_cast<off_t>(PAGE_SIZE))
+        {
+            close(fd);
+            throw Error::FileReadException(path, "The file is not a flat image.");
+        }
+
+        //writable but private: stores of the program land in its own copies of the pages, never in the file
+        size = static_cast<size_t>(st.st_size);
+        void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED)
+        {
+            throw Error::FileReadException(path, "Could not map the image into memory.");
+        }
+        bytes = static_cast<uint8_t*>(map);
+        m_mappings.push_back(Mapping{ map, size, true });
+#endif
+
+        if (size < PAGE_SIZE || load_little_endian(bytes) != MAGIC || load_little_endian(bytes + 4) != FORMAT)
+        {
+            throw Error::FileReadException(path, "The file is not a flat image of this version of NeoMIPS.");
+        }
+        m_entry = load_little_endian(bytes + 8);
+        m_endianness = load_little_endian(bytes + 12) ? std::endian::big : std::endian::little;
+
+        const uint8_t* segment = bytes + 16;
+        for (size_t s = 0; s < SEGMENT_COUNT; ++s, segment += sizeof(SegmentHeader))
+        {
+            uint32_t base = load_little_endian(segment);
+            uint32_t length = load_little_endian(segment + 4);
+            uint32_t offset = load_little_endian(segment + 8);
+            if (length == 0) continue;
+            if (offset % PAGE_SIZE != 0 || offset + uint64_t{ length } > size)
+            {
+                throw Error::FileReadException(path, "A segment of the image is outside of the file.");
+            }
+            bool executable = static_cast<Segment>(s) == Segment::Text || static_cast<Segment>(s) == Segment::KText;
+            if (m_flat)
+            {
+                //flat memory has every region at its own address, so the segment is copied there
+                Allocate(base, length, executable);
+                Write(base, bytes + offset, length);
+            }
+            else AddRegion(base, length, bytes + offset, executable, path);
+        }
+    }
+
+    uint8_t* Memory::Translate(uint32_t address, uint32_t size)
+    {
+        Region span = Span(address);
+        if (address - span.m_base + uint64_t{ size } > span.m_size) return nullptr;
+        return span.m_data + (address - span.m_base);
+    }
+
+    uint8_t* Memory::FindChunk(uint32_t address) const
+    {
+        const std::vector<Chunk>& table = m_pageTable[address >> (m_chunkBits + m_tableBits)];
+        if (table.empty()) return nullptr;
+        return table[(address >> m_chunkBits) & ((uint32_t{ 1 } << m_tableBits) - 1)].get();
+    }
+
+    Memory::Region Memory::SpanOf(const Region& region, uint32_t address, uint8_t* chunk) const
+    {
+        if (m_flat && !region.m_executable)
+        {
+            //regions sit at their own addresses, so neighbours without code are one block
+            size_t first = static_cast<size_t>(&region - m_regions.data()), last = first;
+            while (first > 0 && !m_regions[first - 1].m_executable && m_regions[first - 1].m_base + uint64_t{ m_regions[first - 1].m_size } == m_regions[first].m_base) --first;
+            while (last + 1 < m_regions.size() && !m_regions[last + 1].m_executable && m_regions[last].m_base + uint64_t{ m_regions[last].m_size } == m_regions[last + 1].m_base) ++last;
+            uint64_t end = uint64_t{ m_regions[last].m_base } + m_regions[last].m_size;
+            //a span can't be 4 GiB long, its size has to fit
+            uint32_t size = static_cast<uint32_t>(std::min<uint64_t>(end - m_regions[first].m_base, 0xFFFFFFFF));
+            return Region{ m_regions[first].m_base, size, m_regions[first].m_data, false };
+        }
+        if (region.m_data) return region;
+        uint32_t chunkBase = address & ~m_chunkMask;
+        uint32_t base = std::max(chunkBase, region.m_base);
+        uint64_t end = std::min(uint64_t{ chunkBase } + m_chunkMask + 1, uint64_t{ region.m_base } + region.m_size);
+        return Region{ base, static_cast<uint32_t>(end - base), chunk ? chunk + (base - chunkBase) : nullptr, false };
+    }
+
+    Memory::Region Memory::Span(uint32_t address)
+    {
+        Region& cached = m_tlb[(address >> m_tlbShift) % TLB_SIZE];
+        if (address - cached.m_base < cached.m_size) return cached;
+
+        const Region* region = Find(address);
+        if (!region) return Region{ 0, 0, nullptr, false };
+        uint8_t* chunk = nullptr;
+        if (!region->m_data)
+        {
+            //first touch of the chunk, its table too if it is the first one in it
+            chunk = FindChunk(address);
+            if (!chunk)
+            {
+                Reserve(uint64_t{ m_chunkMask } + 1, address);
+                std::vector<Chunk>& table = m_pageTable[address >> (m_chunkBits + m_tableBits)];
+                if (table.empty()) table.resize(size_t{ 1 } << m_tableBits);
+                Chunk& slot = table[(address >> m_chunkBits) & ((uint32_t{ 1 } << m_tableBits) - 1)];
+                slot.reset(new uint8_t[size_t{ m_chunkMask } + 1]());
+                chunk = slot.get();
+            }
+        }
+        cached = SpanOf(*region, address, chunk);
+        return cached;
+    }
+
+    Memory::Region Memory::Peek(uint32_t address) const
+    {
+        const Region* region = Find(address);
+        if (!region) return Region{ 0, 0, nullptr, false };
+        return SpanOf(*region, address, region->m_data ? nullptr : FindChunk(address));
+    }
+
+    const Memory::Region* Memory::Find(uint32_t address) const
+    {
+        auto next = std::upper_bound(m_regions.begin(), m_regions.end(), address, [](uint32_t address, const Region& region) { return address < region.m_base; });
+        if (next == m_regions.begin()) return nullptr;
+
+        const Region& region = *std::prev(next);
+        return address - region.m_base < region.m_size ? &region : nullptr;
+    }
+
+    bool is_flat_image(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        uint8_t magic[4]{};
+        return file.read(reinterpret_cast<char*>(magic), sizeof(magic)) && load_little_endian(magic) == FlatImage::MAGIC;
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "program.hpp"
+
+namespace NeoMIPS
+{
+    //Emulated address space, a set of regions of host memory that don't overlap. A region is either owned,
+    //allocated zeroed and filled by copying, or part of a private mapping of a flat image, whose pages the
+    //kernel only reads when they are touched and only copies when they are written. Owned regions without code
+    //are paged: their bytes live in chunks that are only allocated the first time they are touched, found
+    //through a two-level page table behind a small TLB of the chunks used last, so a stack at the top of memory
+    //and data at the bottom cost what they use. With chunks of the whole 4 GiB, memory is flat instead: one
+    //reservation without access or swap behind it holds every region at its own address and the kernel commits
+    //pages when they are touched, so neighbouring regions without code are one block of host memory that
+    //accesses go through with a single check. Everything owned together is capped
+    class Memory
+    {
+    public:
+        struct Region
+        {
+            uint32_t m_base;
+            uint32_t m_size;
+            uint8_t* m_data; //nullptr for a paged region, whose chunks hold its bytes
+            bool m_executable; //holds a code segment
+        };
+
+        static constexpr uint32_t DEFAULT_CHUNK_MASK = 0xFFFF;
+        static constexpr uint32_t MIN_CHUNK_MASK = 0xFFF;
+        static constexpr uint32_t FLAT_CHUNK_MASK = 0xFFFFFFFF;
+        static constexpr size_t TLB_SIZE = 16;
+
+    private:
+        struct Mapping
+        {
+            void* m_address;
+            size_t m_size;
+            bool m_mapped; //false if it was read into an owned buffer instead
+        };
+
+        using Chunk = std::unique_ptr<uint8_t[]>;
+
+        std::vector<Region> m_regions; //sorted by base
+        std::vector<Mapping> m_mappings;
+        //the top bits of an address pick a table, the next ones its chunk in the table, tables are empty until
+        //a chunk in them is touched
+        std::vector<std::vector<Chunk>> m_pageTable;
+        std::array<Region, TLB_SIZE> m_tlb{}; //spans resolved last, by the number of their chunk
+        uint8_t* m_flat = nullptr; //reservation of the whole address space when memory is flat
+        uint32_t m_chunkMask;
+        uint32_t m_chunkBits;
+        uint32_t m_tableBits;
+        uint32_t m_tlbShift; //of an address to the number of its TLB entry
+        uint64_t m_resident = 0; //bytes of owned regions and chunks
+        uint64_t m_maxResident;
+        std::endian m_endianness = std::endian::little;
+        uint32_t m_entry = 0;
+
+        void AddRegion(uint32_t base, uint32_t size, uint8_t* data, bool executable, const std::string& where);
+        //Counts bytes allocated for the program, throws if they go over the cap while allocating at address
+        void Reserve(uint64_t bytes, uint32_t address);
+        //Chunk that holds the address, nullptr if it wasn't touched yet
+        uint8_t* FindChunk(uint32_t address) const;
+        //Part of the region around the address that is in one block of host memory, m_data is nullptr if it is
+        //a chunk that wasn't touched yet
+        Region SpanOf(const Region& region, uint32_t address, uint8_t* chunk) const;
+
+    public:
+        //Chunks cover chunkMask + 1 bytes, which has to be a power of two from 4 KiB up, FLAT_CHUNK_MASK makes
+        //memory flat where the host has mmap and 64-bit addresses. maxResident caps the bytes allocated for
+        //regions and chunks
+        explicit Memory(uint32_t chunkMask = DEFAULT_CHUNK_MASK, uint32_t maxResident = 0xFFFFFFFF);
+        Memory(const Memory&) = delete;
+        Memory& operator=(const Memory&) = delete;
+        ~Memory();
+
+        //Adds a zeroed region, paged unless it is for code
+        void Allocate(uint32_t base, uint32_t size, bool executable = false);
+        //Whether no region has any of the size bytes at base
+        bool IsFree(uint32_t base, uint32_t size) const;
+        //Copies bytes into regions, chunks that would only get zeros stay untouched
+        void Write(uint32_t address, const uint8_t* bytes, uint32_t size);
+
+        //Copies the images of an assembled program into new regions
+        void Load(const Program& program);
+
+        //Maps a flat image written by write_flat_image copy-on-write, so nothing is read, lexed or encoded
+        void MapImage(const std::string& path);
+
+        //Host address of size bytes at address, nullptr if they aren't all inside one span
+        uint8_t* Translate(uint32_t address, uint32_t size);
+        //Region that holds the address, nullptr if there is none
+        const Region* Find(uint32_t address) const;
+        //Largest block of host memory around the address that accesses can go through: the whole region, or
+        //the part of the chunk that holds the address which is in the region, allocated the first time it is
+        //touched. Its size is 0 if the address is not mapped
+        Region Span(uint32_t address);
+        //Same without touching anything, m_data is nullptr for a chunk that only holds zeros so far
+        Region Peek(uint32_t address) const;
+
+        const std::vector<Region>& Regions() const { return m_regions; }
+        uint64_t ChunkSize() const { return uint64_t{ m_chunkMask } + 1; }
+        bool IsFlat() const { return m_flat != nullptr; }
+        uint64_t Resident() const { return m_resident; }
+        uint32_t Entry() const { return m_entry; }
+        std::endian Endianness() const { return m_endianness; }
+    };
+
+    //Whether the file starts like a flat image, so it can be run without assembling it
+    bool is_flat_image(const std::string& path);
+}
@@ -19,7 +19,12 @@ namespace NeoMIPS
                     D = 17, // Double
                     W = 20, // Word
                     L = 21, // Long
-                    PS = 22 //Paired single
+                    PS = 22, //Paired single
+
+                    //values of the same field that select a coprocessor operation instead of a format
+                    MF = 0, // Move from
+                    MT = 4, // Move to
+                    BC = 8  // Branch on condition
                 };
             }
             namespace cop
@@ -27,7 +32,10 @@ namespace NeoMIPS
                 enum cop : uint32_t
                 {
                     SPECIAL = 0b000000,
-                    COP1 = 0b010001
+                    REGIMM = 0b000001,
+                    COP0 = 0b010000,
+                    COP1 = 0b010001,
+                    SPECIAL2 = 0b011100
                 };
             }
         }
@@ -499,48 +507,7 @@ namespace NeoMIPS
             { Directives::Literals::WORD, Directive::WORD}}
         };
 
-        constexpr std::array<std::pair<const std::u32string_view, Instruction>, 154> INSTRUCTIONS
-        { {
-            {Instructions::Literals::ABS_D, Instruction::ABS_D} , {Instructions::Literals::ABS_S, Instruction::ABS_S},
-            {Instructions::Literals::ADD, Instruction::ADD}, {Instructions::Literals::ADD_D, Instruction::ADD_D}, {Instructions::Literals::ADD_S, Instruction::ADD_S}, {Instructions::Literals::ADDI, Instruction::ADDI},
-            {Instructions::Literals::ADDIU, Instruction::ADDIU}, {Instructions::Literals::ADDU, Instruction::ADDU}, {Instructions::Literals::AND, Instruction::AND}, {Instructions::Literals::ANDI, Instruction::ANDI},
-            {Instructions::Literals::BC1F, Instruction::BC1F}, {Instructions::Literals::BC1T, Instruction::BC1T},
-            {Instructions::Literals::BEQ, Instruction::BEQ}, {Instructions::Literals::BGEZ, Instruction::BGEZ}, {Instructions::Literals::BGEZAL, Instruction::BGEZAL}, {Instructions::Literals::BGTZ, Instruction::BGTZ},
-            {Instructions::Literals::BLEZ, Instruction::BLEZ}, {Instructions::Literals::BLTZ, Instruction::BLTZ}, {Instructions::Literals::BLTZAL, Instruction::BLTZAL}, {Instructions::Literals::BNE, Instruction::BNE},
-            {Instructions::Literals::BREAK, Instruction::BREAK}, {Instructions::Literals::C_EQ_D, Instruction::C_EQ_D},
-            {Instructions::Literals::C_EQ_S, Instruction::C_EQ_S}, {Instructions::Literals::C_LE_D, Instruction::C_LE_D},
-            {Instructions::Literals::C_LE_S, Instruction::C_LE_S}, {Instructions::Literals::C_LT_D, Instruction::C_LT_D},
-            {Instructions::Literals::C_LT_S, Instruction::C_LT_S}, { Instructions::Literals::CEIL_W_D,Instruction::CEIL_W_D},{Instructions::Literals::CEIL_W_S, Instruction::CEIL_W_S},
-            {Instructions::Literals::CLO, Instruction::CLO}, {Instructions::Literals::CLZ, Instruction::CLZ}, {Instructions::Literals::CVT_D_S, Instruction::CVT_D_S}, { Instructions::Literals::CVT_D_W, Instruction::CVT_D_W},
-            {Instructions::Literals::CVT_S_D, Instruction::CVT_S_D}, { Instructions::Literals::CVT_S_W, Instruction::CVT_S_W}, {Instructions::Literals::CVT_W_D, Instruction::CVT_W_D}, {Instructions::Literals::CVT_W_S, Instruction::CVT_W_S},
-            {Instructions::Literals::DIV, Instruction::DIV}, {Instructions::Literals::DIV_D, Instruction::DIV_D}, {Instructions::Literals::DIV_S, Instruction::DIV_S}, { Instructions::Literals::DIVU, Instruction::DIVU},
-            {Instructions::Literals::ERET, Instruction::ERET}, {Instructions::Literals::FLOOR_W_D, Instruction::FLOOR_W_D}, {Instructions::Literals::FLOOR_W_S, Instruction::FLOOR_W_S}, {Instructions::Literals::J, Instruction::J},
-            {Instructions::Literals::JAL, Instruction::JAL}, {Instructions::Literals::JALR_RA, Instruction::JALR_RA}, {Instructions::Literals::JALR, Instruction::JALR}, {Instructions::Literals::JR, Instruction::JR},
-            {Instructions::Literals::LB, Instruction::LB}, {Instructions::Literals::LBU, Instruction::LBU}, {Instructions::Literals::LDC1, Instruction::LDC1}, {Instructions::Literals::LH, Instruction::LH}, {Instructions::Literals::LHU, Instruction::LHU},
-            {Instructions::Literals::LL, Instruction::LL}, {Instructions::Literals::LUI, Instruction::LUI}, {Instructions::Literals::LW, Instruction::LW}, {Instructions::Literals::LWC1, Instruction::LWC1},
-            {Instructions::Literals::LWL, Instruction::LWL}, {Instructions::Literals::LWR, Instruction::LWR}, {Instructions::Literals::MADD, Instruction::MADD}, {Instructions::Literals::MADDU, Instruction::MADDU}, {Instructions::Literals::MFC0, Instruction::MFC0},
-            {Instructions::Literals::MFC1, Instruction::MFC1}, {Instructions::Literals::MFHI, Instruction::MFHI},{ Instructions::Literals::MFLO, Instruction::MFLO}, {Instructions::Literals::MOV_D, Instruction::MOV_D}, {Instructions::Literals::MOV_S, Instruction::MOV_S},
-            {Instructions::Literals::MOVF, Instruction::MOVF}, {Instructions::Literals::MOVF_D, Instruction::MOVF_D},
-            {Instructions::Literals::MOVF_S, Instruction::MOVF_S}, {Instructions::Literals::MOVN, Instruction::MOVN}, {Instructions::Literals::MOVN_D, Instruction::MOVN_D},
-            {Instructions::Literals::MOVN_S, Instruction::MOVN_S}, {Instructions::Literals::MOVT, Instruction::MOVT}, {Instructions::Literals::MOVT_D, Instruction::MOVT_D},
-            {Instructions::Literals::MOVT_S, Instruction::MOVT_S}, {Instructions::Literals::MOVZ, Instruction::MOVZ}, { Instructions::Literals::MOVZ_D, Instruction::MOVZ_D}, { Instructions::Literals::MOVZ_S, Instruction::MOVZ_S},
-            {Instructions::Literals::MSUB, Instruction::MSUB}, { Instructions::Literals::MSUBU, Instruction::MSUBU}, {Instructions::Literals::MTC0, Instruction::MTC0},{ Instructions::Literals::MTC1, Instruction::MTC1},
-            {Instructions::Literals::MTHI, Instruction::MTHI}, {Instructions::Literals::MTLO, Instruction::MTLO}, {Instructions::Literals::MUL, Instruction::MUL}, {Instructions::Literals::MUL_D, Instruction::MUL_D},
-            {Instructions::Literals::MUL_S, Instruction::MUL_S}, {Instructions::Literals::MULT, Instruction::MULT}, {Instructions::Literals::MULTU, Instruction::MULTU}, {Instructions::Literals::NEG_D, Instruction::NEG_D}, {Instructions::Literals::NEG_S, Instruction::NEG_S},
-            {Instructions::Literals::NOP, Instruction::NOP}, {Instructions::Literals::NOR, Instruction::NOR}, {Instructions::Literals::OR, Instruction::OR},
-            {Instructions::Literals::ORI, Instruction::ORI}, {Instructions::Literals::ROUND_W_D, Instruction::ROUND_W_D}, { Instructions::Literals::ROUND_W_S, Instruction::ROUND_W_S}, { Instructions::Literals::SB, Instruction::SB},
-            {Instructions::Literals::SC, Instruction::SC}, {Instructions::Literals::SDC1, Instruction::SDC1}, { Instructions::Literals::SH, Instruction::SH},
-            {Instructions::Literals::SLL, Instruction::SLL}, { Instructions::Literals::SLLV, Instruction::SLLV}, { Instructions::Literals::SLT, Instruction::SLT}, { Instructions::Literals::SLTI, Instruction::SLTI},
-            {Instructions::Literals::SLTIU, Instruction::SLTIU}, { Instructions::Literals::SLTU, Instruction::SLTU}, { Instructions::Literals::SQRT_D, Instruction::SQRT_D},
-            {Instructions::Literals::SQRT_S, Instruction::SQRT_S}, { Instructions::Literals::SRA, Instruction::SRA}, {Instructions::Literals::SRAV, Instruction::SRAV}, {Instructions::Literals::SRL, Instruction::SRL},
-            {Instructions::Literals::SRLV, Instruction::SRLV}, {Instructions::Literals::SUB, Instruction::SUB}, {Instructions::Literals::SUB_D, Instruction::SUB_D},
-            {Instructions::Literals::SUB_S, Instruction::SUB_S},{ Instructions::Literals::SUBU, Instruction::SUBU}, { Instructions::Literals::SW, Instruction::SW}, { Instructions::Literals::SWC1, Instruction::SWC1},
-            {Instructions::Literals::SWL, Instruction::SWL}, { Instructions::Literals::SWR, Instruction::SWR}, { Instructions::Literals::SYSCALL, Instruction::SYSCALL},
-            {Instructions::Literals::TEQ, Instruction::TEQ}, { Instructions::Literals::TEQI, Instruction::TEQI}, { Instructions::Literals::TGE, Instruction::TGE}, { Instructions::Literals::TGEI, Instruction::TGEI},
-            {Instructions::Literals::TGEIU, Instruction::TGEIU}, { Instructions::Literals::TGEU, Instruction::TGEU}, { Instructions::Literals::TLT, Instruction::TLT},
-            {Instructions::Literals::TLTU, Instruction::TLTU}, { Instructions::Literals::TNE, Instruction::TNE}, { Instructions::Literals::TNEI, Instruction::TNEI}, { Instructions::Literals::TRUNC_W_D, Instruction::TRUNC_W_D},
-            {Instructions::Literals::TRUNC_W_S, Instruction::TRUNC_W_S}, { Instructions::Literals::XOR, Instruction::XOR}, { Instructions::Literals::XORI, Instruction::XORI} }
-        };
+        //The mnemonics of the instructions are generated from their descriptions, see isadescription.hpp
 
         constexpr std::array<std::pair<const std::u32string_view, Pseudoinstruction>, 47> PSEUDOINSTRUCTIONS
         { {
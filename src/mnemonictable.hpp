@@ -0,0 +1,149 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include "constraints.hpp"
+#include "isadescription.hpp"
+
+namespace NeoMIPS
+{
+    //Minimal perfect hash (hash and displace) over a literal table, built entirely at compile time.
+    //A first hash picks a bucket, each bucket stores the seed of a second hash that sends all of its keys to
+    //distinct slots. A lookup is two hashes of the word, one slot load and one comparison, with no allocation.
+    //Keys are hashed by code unit, so mnemonics (which are ASCII) hash the same from UTF-8 and UTF-32 sources
+    template<typename Value, size_t N, size_t Buckets, size_t Slots>
+    class MnemonicTable
+    {
+        static_assert((Buckets & (Buckets - 1)) == 0 && (Slots & (Slots - 1)) == 0, "Table sizes must be powers of two");
+
+        struct Slot
+        {
+            std::u32string_view m_key;
+            Value m_value;
+        };
+
+        //keys sharing a first level bucket, the bucket count keeps this far from being reached
+        static constexpr size_t MAX_BUCKET_SIZE = 8;
+
+        std::array<uint32_t, Buckets> m_seeds{};
+        std::array<Slot, Slots> m_slots{};
+
+    public:
+        template<typename String>
+        static constexpr uint32_t hash(const String& str, uint32_t seed)
+        {
+            uint32_t h = 0x811C9DC5u ^ seed ^ static_cast<uint32_t>(str.size());
+            for (auto c : str)
+            {
+                h ^= static_cast<uint32_t>(c);
+                h *= 0x01000193u;
+            }
+            h ^= h >> 16;
+            h *= 0x85EBCA6Bu;
+            h ^= h >> 13;
+            return h;
+        }
+
+        consteval MnemonicTable(const std::array<std::pair<const std::u32string_view, Value>, N>& entries)
+        {
+            //group the keys by bucket. Empty literals (unused trailing array entries) are skipped, and so are
+            //repeated mnemonics (jalr is listed twice) so the first entry wins, as it did with a linear search
+            std::array<std::array<size_t, MAX_BUCKET_SIZE>, Buckets> members{};
+            std::array<size_t, Buckets> sizes{};
+            for (size_t i = 0; i < N; ++i)
+            {
+                if (entries[i].first.empty()) continue;
+                bool repeated = false;
+                for (size_t j = 0; j < i && !repeated; ++j) repeated = entries[j].first == entries[i].first;
+                if (repeated) continue;
+                size_t bucket = hash(entries[i].first, 0) & (Buckets - 1);
+                if (sizes[bucket] == MAX_BUCKET_SIZE) throw "Too many keys share a bucket, raise the bucket count";
+                members[bucket][sizes[bucket]++] = i;
+            }
+
+            //place the biggest buckets first while most slots are still free
+            std::array<size_t, Buckets> order{};
+            for (size_t b = 0; b < Buckets; ++b) order[b] = b;
+            for (size_t a = 0; a < Buckets; ++a)
+            {
+                for (size_t b = a + 1; b < Buckets; ++b)
+                {
+                    if (sizes[order[b]] > sizes[order[a]]) std::swap(order[a], order[b]);
+                }
+            }
+
+            std::array<bool, Slots> used{};
+            for (size_t bucket : order)
+            {
+                if (sizes[bucket] == 0) break;
+                for (uint32_t seed = 1;; ++seed)
+                {
+                    std::array<size_t, MAX_BUCKET_SIZE> placed{};
+                    bool fits = true;
+                    for (size_t k = 0; k < sizes[bucket] && fits; ++k)
+                    {
+                        placed[k] = hash(entries[members[bucket][k]].first, seed) & (Slots - 1);
+                        fits = !used[placed[k]];
+                        for (size_t j = 0; j < k && fits; ++j) fits = placed[j] != placed[k];
+                    }
+                    if (!fits) continue;
+
+                    m_seeds[bucket] = seed;
+                    for (size_t k = 0; k < sizes[bucket]; ++k)
+                    {
+                        used[placed[k]] = true;
+                        m_slots[placed[k]] = Slot{ entries[members[bucket][k]].first, entries[members[bucket][k]].second };
+                    }
+                    break;
+                }
+            }
+        }
+
+        template<Char C>
+        constexpr std::optional<Value> find(std::basic_string_view<C> word) const
+        {
+            if (word.empty()) return std::nullopt;
+            uint32_t seed = m_seeds[hash(word, 0) & (Buckets - 1)];
+            if (seed == 0) return std::nullopt;
+
+            const Slot& slot = m_slots[hash(word, seed) & (Slots - 1)];
+            if (slot.m_key.size() != word.size()) return std::nullopt;
+            for (size_t i = 0; i < word.size(); ++i)
+            {
+                if (slot.m_key[i] != static_cast<char32_t>(word[i])) return std::nullopt;
+            }
+            return slot.m_value;
+        }
+
+        //Every literal of the table has to be found again, mapping to the first entry that spells it
+        consteval bool finds_all(const std::array<std::pair<const std::u32string_view, Value>, N>& entries) const
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                if (entries[i].first.empty()) continue;
+                size_t first = 0;
+                while (entries[first].first != entries[i].first) ++first;
+                if (find(entries[i].first) != entries[first].second) return false;
+            }
+            return true;
+        }
+    };
+
+    namespace ISA
+    {
+        constexpr MnemonicTable<Instruction, INSTRUCTION_MNEMONICS.size(), 128, 256> INSTRUCTION_TABLE{ INSTRUCTION_MNEMONICS };
+        constexpr MnemonicTable<Directive, DIRECTIVES.size(), 16, 64> DIRECTIVE_TABLE{ DIRECTIVES };
+
+        static_assert(INSTRUCTION_TABLE.finds_all(INSTRUCTION_MNEMONICS));
+        static_assert(DIRECTIVE_TABLE.finds_all(DIRECTIVES));
+        static_assert(INSTRUCTION_TABLE.find(std::u32string_view(U"addiu")) == Instruction::ADDIU);
+        static_assert(INSTRUCTION_TABLE.find(std::u8string_view(u8"c.lt.s")) == Instruction::C_LT_S);
+        static_assert(!INSTRUCTION_TABLE.find(std::u32string_view(U"addiux")));
+        static_assert(INSTRUCTION_TABLE.find(std::u32string_view(U"tltiu")) == Instruction::TLTIU);
+        static_assert(INSTRUCTION_TABLE.find(std::u32string_view(U"jalr")) == Instruction::JALR_RA);
+        static_assert(DIRECTIVE_TABLE.find(std::u8string_view(u8".asciiz")) == Directive::ASCIIZ);
+        static_assert(!DIRECTIVE_TABLE.find(std::u32string_view(U"")));
+    }
+}
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <fstream>
+#include "objectfile.hpp"
+#include "lexer_util.hpp"
+#include "utf8.hpp"
+#include "error.hpp"
+
+namespace NeoMIPS
+{
+    namespace
+    {
+        //Output file built in memory, with its fields in the byte order of the file
+        class ObjectBuffer
+        {
+            std::string m_buffer;
+            std::endian m_endianness;
+
+        public:
+            explicit ObjectBuffer(std::endian endianness) : m_endianness(endianness) {}
+
+            size_t Size() const { return m_buffer.size(); }
+
+            void Put(uint32_t value, uint32_t size)
+            {
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    uint32_t shift = m_endianness == std::endian::little ? 8 * i : 8 * (size - 1 - i);
+                    m_buffer.push_back(static_cast<char>(value >> shift));
+                }
+            }
+
+            void Put8(uint32_t value) { Put(value, 1); }
+            void Put16(uint32_t value) { Put(value, 2); }
+            void Put32(uint32_t value) { Put(value, 4); }
+
+            void PutBytes(const std::vector<uint8_t>& bytes)
+            {
+                m_buffer.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            }
+
+            void PutBytes(std::string_view bytes)
+            {
+                m_buffer.append(bytes);
+            }
+
+            //Overwrites a field written before, for offsets only known once what follows is written
+            void Patch32(size_t position, uint32_t value)
+            {
+                for (uint32_t i = 0; i < 4; ++i)
+                {
+                    uint32_t shift = m_endianness == std::endian::little ? 8 * i : 8 * (3 - i);
+                    m_buffer[position + i] = static_cast<char>(value >> shift);
+                }
+            }
+
+            //Pads with zeros until the size is congruent with remainder modulo alignment
+            void Align(uint32_t alignment, uint32_t remainder = 0)
+            {
+                m_buffer.append((alignment + remainder % alignment - m_buffer.size() % alignment) % alignment, '\0');
+            }
+
+            void Write(const std::string& path) const
+            {
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                if (!file.write(m_buffer.data(), m_buffer.size()))
+                {
+                    throw Error::FileWriteException(path, "The output file could not be written.");
+                }
+            }
+        };
+
+        //Labels as ELF string tables keep them, UTF-8 and null terminated
+        uint32_t append_name(std::string& table, std::u32string_view name)
+        {
+            uint32_t offset = static_cast<uint32_t>(table.size());
+            for (char32_t c : name)
+            {
+                uint8_t bytes[4];
+                table.append(reinterpret_cast<const char*>(bytes), Utf8::encode_one(c, bytes));
+            }
+            table.push_back('\0');
+            return offset;
+        }
+
+        namespace Elf
+        {
+            constexpr uint16_t ET_EXEC = 2;
+            constexpr uint16_t EM_MIPS = 8;
+            constexpr uint32_t EF_MIPS_ARCH_32 = 0x50000000;
+            constexpr uint32_t PT_LOAD = 1;
+            constexpr uint32_t PF_X = 1, PF_W = 2, PF_R = 4;
+            constexpr uint32_t SHT_PROGBITS = 1, SHT_SYMTAB = 2, SHT_STRTAB = 3;
+            constexpr uint32_t SHF_WRITE = 1, SHF_ALLOC = 2, SHF_EXECINSTR = 4;
+            constexpr uint8_t STB_LOCAL = 0, STB_GLOBAL = 1;
+            constexpr uint8_t STT_NOTYPE = 0;
+            constexpr uint32_t HEADER_SIZE = 52, PROGRAM_HEADER_SIZE = 32, SECTION_HEADER_SIZE = 40, SYMBOL_SIZE = 16;
+
+            struct Section
+            {
+                uint32_t m_name;
+                uint32_t m_type;
+                uint32_t m_flags;
+                uint32_t m_address;
+                uint32_t m_offset;
+                uint32_t m_size;
+                uint32_t m_link;
+                uint32_t m_info;
+                uint32_t m_alignment;
+                uint32_t m_entrySize;
+            };
+        }
+
+        constexpr bool is_code(Segment segment)
+        {
+            return segment == Segment::Text || segment == Segment::KText;
+        }
+    }
+
+    void write_flat_image(const Program& program, const std::string& path)
+    {
+        using namespace FlatImage;
+        ObjectBuffer out(std::endian::little);
+        out.Put32(MAGIC);
+        out.Put32(FORMAT);
+        out.Put32(program.m_entry);
+        out.Put32(program.m_endianness == std::endian::big);
+
+        uint32_t offset = PAGE_SIZE;
+        for (size_t s = 0; s < SEGMENT_COUNT; ++s)
+        {
+            uint32_t size = static_cast<uint32_t>(program.m_images[s].size());
+            out.Put32(program.m_bases[s]);
+            out.Put32(size);
+            out.Put32(offset);
+            out.Put32(0);
+            offset += (size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+        }
+
+        for (const std::vector<uint8_t>& image : program.m_images)
+        {
+            out.Align(PAGE_SIZE);
+            out.PutBytes(image);
+        }
+        out.Write(path);
+    }
+
+    void write_elf(const Program& program, const std::string& path)
+    {
+        using namespace Elf;
+        constexpr std::array<std::u32string_view, SEGMENT_COUNT> NAMES{ U".text", U".data", U".ktext", U".kdata" };
+
+        std::vector<size_t> segments; //the ones with contents, in the order of their sections
+        for (size_t s = 0; s < SEGMENT_COUNT; ++s)
+        {
+            if (!program.m_images[s].empty()) segments.push_back(s);
+        }
+
+        //locals have to come before globals
+        std::vector<ProgramSymbol> symbols(program.m_symbols);
+        std::sort(symbols.begin(), symbols.end(), [](const ProgramSymbol& a, const ProgramSymbol& b)
+        {
+            if (a.m_global != b.m_global) return !a.m_global;
+            if (a.m_address != b.m_address) return a.m_address < b.m_address;
+            return label_name(a.m_label) < label_name(b.m_label);
+        });
+
+        std::string sectionNames(1, '\0');
+        std::string symbolNames(1, '\0');
+        std::vector<Section> sections(1, Section{});
+        std::array<uint16_t, SEGMENT_COUNT> sectionOf{};
+
+        ObjectBuffer out(program.m_endianness);
+        uint32_t headersSize = HEADER_SIZE + PROGRAM_HEADER_SIZE * static_cast<uint32_t>(segments.size());
+        std::vector<uint32_t> offsets;
+        {
+            //contents are placed at the same offset within a page as their address, so they can be mapped
+            uint32_t offset = headersSize;
+            for (size_t s : segments)
+            {
+                offset += (FlatImage::PAGE_SIZE + program.m_bases[s] % FlatImage::PAGE_SIZE - offset % FlatImage::PAGE_SIZE) % FlatImage::PAGE_SIZE;
+                offsets.push_back(offset);
+                offset += static_cast<uint32_t>(program.m_images[s].size());
+
+                Segment segment = static_cast<Segment>(s);
+                sectionOf[s] = static_cast<uint16_t>(sections.size());
+                sections.push_back(Section{ append_name(sectionNames, NAMES[s]), SHT_PROGBITS,
+                    SHF_ALLOC | (is_code(segment) ? SHF_EXECINSTR : SHF_WRITE), program.m_bases[s], offsets.back(),
+                    static_cast<uint32_t>(program.m_images[s].size()), 0, 0, is_code(segment) ? 4U : 8U, 0 });
+            }
+        }
+
+        uint16_t symbolTable = static_cast<uint16_t>(sections.size());
+        uint16_t symbolStrings = symbolTable + 1;
+        uint16_t sectionStrings = symbolTable + 2;
+        uint32_t firstGlobal = static_cast<uint32_t>(std::find_if(symbols.begin(), symbols.end(), [](const ProgramSymbol& symbol) { return symbol.m_global; }) - symbols.begin()) + 1;
+        sections.push_back(Section{ append_name(sectionNames, U".symtab"), SHT_SYMTAB, 0, 0, 0, SYMBOL_SIZE * static_cast<uint32_t>(symbols.size() + 1), symbolStrings, firstGlobal, 4, SYMBOL_SIZE });
+        sections.push_back(Section{ append_name(sectionNames, U".strtab"), SHT_STRTAB, 0, 0, 0, 0, 0, 0, 1, 0 });
+        sections.push_back(Section{ append_name(sectionNames, U".shstrtab"), SHT_STRTAB, 0, 0, 0, 0, 0, 0, 1, 0 });
+
+        //ELF header
+        out.Put8(0x7F); out.Put8('E'); out.Put8('L'); out.Put8('F');
+        out.Put8(1); //32 bits
+        out.Put8(program.m_endianness == std::endian::little ? 1 : 2);
+        out.Put8(1); //version
+        out.Align(16);
+        out.Put16(ET_EXEC);
+        out.Put16(EM_MIPS);
+        out.Put32(1);
+        out.Put32(program.m_entry);
+        out.Put32(HEADER_SIZE);
+        size_t sectionHeaderOffsetField = out.Size();
+        out.Put32(0); //section headers, patched below once their offset is known
+        out.Put32(EF_MIPS_ARCH_32);
+        out.Put16(HEADER_SIZE);
+        out.Put16(PROGRAM_HEADER_SIZE);
+        out.Put16(static_cast<uint16_t>(segments.size()));
+        out.Put16(SECTION_HEADER_SIZE);
+        out.Put16(static_cast<uint16_t>(sections.size()));
+        out.Put16(sectionStrings);
+
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            size_t s = segments[i];
+            uint32_t size = static_cast<uint32_t>(program.m_images[s].size());
+            out.Put32(PT_LOAD);
+            out.Put32(offsets[i]);
+            out.Put32(program.m_bases[s]);
+            out.Put32(program.m_bases[s]);
+            out.Put32(size);
+            out.Put32(size);
+            out.Put32(PF_R | (is_code(static_cast<Segment>(s)) ? PF_X : PF_W));
+            out.Put32(FlatImage::PAGE_SIZE);
+        }
+
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            out.Align(FlatImage::PAGE_SIZE, offsets[i]);
+            out.PutBytes(program.m_images[segments[i]]);
+        }
+
+        out.Align(4);
+        sections[symbolTable].m_offset = static_cast<uint32_t>(out.Size());
+        out.Put32(0); out.Put32(0); out.Put32(0); out.Put8(0); out.Put8(0); out.Put16(0);
+        for (const ProgramSymbol& symbol : symbols)
+        {
+            out.Put32(append_name(symbolNames, label_name(symbol.m_label)));
+            out.Put32(symbol.m_address);
+            out.Put32(0);
+            out.Put8(static_cast<uint8_t>((symbol.m_global ? STB_GLOBAL : STB_LOCAL) << 4 | STT_NOTYPE));
+            out.Put8(0);
+            out.Put16(sectionOf[static_cast<size_t>(symbol.m_segment)]);
+        }
+
+        auto putStrings = [&out](Section& section, const std::string& strings)
+        {
+            section.m_offset = static_cast<uint32_t>(out.Size());
+            section.m_size = static_cast<uint32_t>(strings.size());
+            out.PutBytes(strings);
+        };
+        putStrings(sections[symbolStrings], symbolNames);
+        putStrings(sections[sectionStrings], sectionNames);
+
+        out.Align(4);
+        uint32_t sectionHeaderOffset = static_cast<uint32_t>(out.Size());
+        for (const Section& section : sections)
+        {
+            out.Put32(section.m_name);
+            out.Put32(section.m_type);
+            out.Put32(section.m_flags);
+            out.Put32(section.m_address);
+            out.Put32(section.m_offset);
+            out.Put32(section.m_size);
+            out.Put32(section.m_link);
+            out.Put32(section.m_info);
+            out.Put32(section.m_alignment);
+            out.Put32(section.m_entrySize);
+        }
+        out.Patch32(sectionHeaderOffsetField, sectionHeaderOffset);
+        out.Write(path);
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include "program.hpp"
+
+namespace NeoMIPS
+{
+    //Flat image of an assembled program, made to be mapped back into memory instead of being read: a header
+    //page followed by the bytes of every segment, each one starting at a page boundary of the file. Fields of
+    //the header are little endian whatever the endianness of the program is
+    namespace FlatImage
+    {
+        constexpr uint32_t MAGIC = 0x494D4E4E; //"NNMI"
+        //Bump whenever the layout of the header changes
+        constexpr uint32_t FORMAT = 1;
+        constexpr uint32_t PAGE_SIZE = 4096;
+
+        struct SegmentHeader
+        {
+            uint32_t m_base;
+            uint32_t m_size;
+            uint32_t m_fileOffset; //multiple of PAGE_SIZE
+            uint32_t m_reserved;
+        };
+
+        struct Header
+        {
+            uint32_t m_magic;
+            uint32_t m_format;
+            uint32_t m_entry;
+            uint32_t m_bigEndian; //of the words in the segments
+            std::array<SegmentHeader, SEGMENT_COUNT> m_segments;
+        };
+    }
+
+    //Writes the program as a flat image, see FlatImage
+    void write_flat_image(const Program& program, const std::string& path);
+
+    //Writes the program as a linked ELF32 MIPS executable with one loadable segment and one section per
+    //segment of the program, in its endianness. Every label goes to the symbol table, the ones exported
+    //with .globl as global symbols
+    void write_elf(const Program& program, const std::string& path);
+}
@@ -0,0 +1,262 @@
+#include "operandscanner.hpp"
+
+namespace NeoMIPS
+{
+    namespace
+    {
+        enum CharacterClass : uint8_t
+        {
+            Invalid,
+            Blank,      //whitespace and commas, both only separate operands
+            Dollar,
+            Digit,
+            Word,       //letters, '_' and '.', anything that can continue a label
+            OpenParen,
+            CloseParen,
+            Plus,
+            Minus,
+            Comment
+        };
+
+        constexpr std::array<CharacterClass, 128> make_character_classes()
+        {
+            std::array<CharacterClass, 128> classes{};
+            classes[' '] = classes['\t'] = classes['\r'] = classes['\v'] = classes['\f'] = classes[','] = Blank;
+            classes['$'] = Dollar;
+            for (char c = '0'; c <= '9'; ++c) classes[c] = Digit;
+            for (char c = 'a'; c <= 'z'; ++c) classes[c] = Word;
+            for (char c = 'A'; c <= 'Z'; ++c) classes[c] = Word;
+            classes['_'] = classes['.'] = Word;
+            classes['('] = OpenParen;
+            classes[')'] = CloseParen;
+            classes['+'] = Plus;
+            classes['-'] = Minus;
+            classes['#'] = Comment;
+            return classes;
+        }
+
+        constexpr std::array<CharacterClass, 128> CHARACTER_CLASSES = make_character_classes();
+
+        //Everything outside ASCII is taken as part of a label, that is where emoji and other scripts end up
+        //whether the line holds UTF-8 bytes or UTF-32 code points
+        template<Char C>
+        constexpr CharacterClass classify(C c)
+        {
+            return static_cast<uint32_t>(c) < 128 ? CHARACTER_CLASSES[static_cast<uint32_t>(c)] : Word;
+        }
+
+        constexpr bool is_word(CharacterClass c)
+        {
+            return c == Word || c == Digit;
+        }
+
+        constexpr uint32_t NOT_A_REGISTER = 0xFFFFFFFF;
+
+        template<Char C>
+        uint32_t parse_register_name(std::basic_string_view<C> name)
+        {
+            auto digit = [](C c) -> uint32_t { return static_cast<uint32_t>(c) - U'0'; };
+            auto is_digit = [](C c) { return c >= U'0' && c <= U'9'; };
+
+            auto number = [&](std::basic_string_view<C> n) -> uint32_t
+            {
+                if (n.size() == 1 && is_digit(n[0])) return digit(n[0]);
+                if (n.size() == 2 && is_digit(n[0]) && is_digit(n[1]) && n[0] != U'0')
+                {
+                    uint32_t value = digit(n[0]) * 10 + digit(n[1]);
+                    return value < 32 ? value : NOT_A_REGISTER;
+                }
+                return NOT_A_REGISTER;
+            };
+
+            auto ranged = [&](uint32_t index, uint32_t base, uint32_t count) -> uint32_t
+            {
+                return index < count ? base + index : NOT_A_REGISTER;
+            };
+
+            if (name.empty()) return NOT_A_REGISTER;
+            if (is_digit(name[0])) return number(name);
+
+            if (name.size() == 2)
+            {
+                uint32_t d = is_digit(name[1]) ? digit(name[1]) : NOT_A_REGISTER;
+                switch (name[0])
+                {
+                case U'a':
+                    return name[1] == U't' ? 1 : ranged(d, 4, 4);
+                case U'v':
+                    return ranged(d, 2, 2);
+                case U't':
+                    return d < 8 ? 8 + d : ranged(d - 8, 24, 2);
+                case U's':
+                    return name[1] == U'p' ? 29 : (d == 8 ? 30 : ranged(d, 16, 8));
+                case U'k':
+                    return ranged(d, 26, 2);
+                case U'g':
+                    return name[1] == U'p' ? 28 : NOT_A_REGISTER;
+                case U'f':
+                    return name[1] == U'p' ? 30 : d;
+                case U'r':
+                    return name[1] == U'a' ? 31 : NOT_A_REGISTER;
+                default:
+                    return NOT_A_REGISTER;
+                }
+            }
+
+            if (name.size() == 3 && name[0] == U'f') return number(name.substr(1));
+            if (name.size() == 4 && name[0] == U'z' && name[1] == U'e' && name[2] == U'r' && name[3] == U'o') return 0;
+            return NOT_A_REGISTER;
+        }
+
+        template<Char C>
+        bool parse_number(std::basic_string_view<C> digits, bool negative, uint32_t& value)
+        {
+            uint64_t result = 0;
+            if (digits.size() > 2 && digits[0] == U'0' && (digits[1] == U'x' || digits[1] == U'X'))
+            {
+                if (digits.size() > 10) return false;
+                for (size_t i = 2; i < digits.size(); ++i)
+                {
+                    uint32_t c = static_cast<uint32_t>(digits[i]);
+                    uint32_t nibble;
+                    if (c >= U'0' && c <= U'9') nibble = c - U'0';
+                    else if (c >= U'a' && c <= U'f') nibble = c - U'a' + 10;
+                    else if (c >= U'A' && c <= U'F') nibble = c - U'A' + 10;
+                    else return false;
+                    result = (result << 4) | nibble;
+                }
+            }
+            else
+            {
+                for (C c : digits)
+                {
+                    if (c < U'0' || c > U'9') return false;
+                    result = result * 10 + (static_cast<uint32_t>(c) - U'0');
+                    if (result > 0xFFFFFFFFull) return false;
+                }
+            }
+
+            value = static_cast<uint32_t>(negative ? 0 - result : result);
+            return true;
+        }
+    }
+
+    template<Char C>
+    bool scan_operands(std::basic_string_view<C> line, OperandList& operands)
+    {
+        operands.m_count = 0;
+        size_t i = 0;
+        bool pendingSign = false;
+        bool negative = false;
+
+        auto push = [&](OperandKind kind, uint32_t value, size_t start, size_t length) -> bool
+        {
+            if (operands.m_count == MAX_OPERANDS) return false;
+            operands.m_operands[operands.m_count++] = Operand{ kind, value, static_cast<uint32_t>(start), static_cast<uint32_t>(length) };
+            return true;
+        };
+
+        while (i < line.size())
+        {
+            size_t start = i;
+            switch (classify(line[i]))
+            {
+            case Blank:
+                ++i;
+                break;
+            case Comment:
+                i = line.size();
+                break;
+            case Dollar:
+            {
+                while (++i < line.size() && is_word(classify(line[i])));
+                uint32_t reg = parse_register_name(line.substr(start + 1, i - start - 1));
+                if (reg == NOT_A_REGISTER || pendingSign || !push(OperandKind::Reg, reg, start, i - start)) return false;
+                break;
+            }
+            case Digit:
+            {
+                while (++i < line.size() && is_word(classify(line[i])));
+                uint32_t value;
+                if (!parse_number(line.substr(start, i - start), negative, value) || !push(OperandKind::Imm, value, start, i - start)) return false;
+                pendingSign = negative = false;
+                break;
+            }
+            case Word:
+            {
+                while (++i < line.size() && is_word(classify(line[i])));
+                if (pendingSign || !push(OperandKind::Label, 0, start, i - start)) return false;
+                break;
+            }
+            case OpenParen:
+                ++i;
+                if (pendingSign || !push(OperandKind::OpenParen, 0, start, 1)) return false;
+                break;
+            case CloseParen:
+                ++i;
+                if (pendingSign || !push(OperandKind::CloseParen, 0, start, 1)) return false;
+                break;
+            case Plus:
+            case Minus:
+            {
+                bool minus = classify(line[i]) == Minus;
+                ++i;
+                if (pendingSign) return false;
+                //after a label the sign is the offset operator of label+imm, anywhere else it belongs to the next number
+                if (operands.m_count != 0 && operands.m_operands[operands.m_count - 1].m_kind == OperandKind::Label)
+                {
+                    if (!push(minus ? OperandKind::Minus : OperandKind::Plus, 0, start, 1)) return false;
+                }
+                else
+                {
+                    pendingSign = true;
+                    negative = minus;
+                }
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return !pendingSign;
+    }
+
+    InstructionSyntacticArchetypes classify_operands(const OperandList& operands)
+    {
+        using enum OperandKind;
+        using A = InstructionSyntacticArchetypes;
+
+        uint32_t shape = 0;
+        for (uint32_t i = 0; i < operands.m_count; ++i)
+        {
+            OperandKind kind = operands.m_operands[i].m_kind;
+            shape = (shape << 3) | static_cast<uint32_t>(kind == Minus ? Plus : kind);
+        }
+
+        switch (shape)
+        {
+        case shape_of({}): return A::NoParams;
+        case shape_of({ Imm }): return A::Imm;
+        case shape_of({ Label }): return A::Label;
+        case shape_of({ Reg }): return A::Reg;
+        case shape_of({ Reg, Imm }): return A::RegImm;
+        case shape_of({ Reg, Label }): return A::RegLabel;
+        case shape_of({ Imm, Label }): return A::ImmLabel;
+        case shape_of({ Reg, Reg }): return A::RegReg;
+        case shape_of({ Reg, Reg, Reg }): return A::RegRegReg;
+        case shape_of({ Reg, Reg, Imm }): return A::RegRegImm;
+        case shape_of({ Reg, Reg, Label }): return A::RegRegLabel;
+        case shape_of({ Imm, Reg, Reg }): return A::ImmRegReg;
+        case shape_of({ Reg, OpenParen, Reg, CloseParen }): return A::RegMemReg;
+        case shape_of({ Reg, Imm, OpenParen, Reg, CloseParen }): return A::RegOffsetForReg;
+        case shape_of({ Reg, Imm, Label }): return A::RegImmLabel;
+        case shape_of({ Reg, Label, Plus, Imm }): return A::RegLabelPlusImm;
+        case shape_of({ Reg, Label, Plus, Imm, OpenParen, Reg, CloseParen }): return A::RegLabelPlusImmOffsetForReg;
+        case shape_of({ Reg, Label, OpenParen, Reg, CloseParen }): return A::RegLabelAsOffsetReg;
+        default: return static_cast<A>(0);
+        }
+    }
+
+    template bool scan_operands(std::basic_string_view<char8_t> line, OperandList& operands);
+    template bool scan_operands(std::basic_string_view<char32_t> line, OperandList& operands);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <initializer_list>
+#include "types.hpp"
+#include "constraints.hpp"
+
+namespace NeoMIPS
+{
+    enum class OperandKind : uint8_t
+    {
+        None,
+        Reg,
+        Imm,
+        Label,
+        OpenParen,
+        CloseParen,
+        Plus,
+        Minus
+    };
+
+    struct Operand
+    {
+        OperandKind m_kind;
+        uint32_t m_value; //register index or immediate
+        uint32_t m_start; //label position inside the scanned line
+        uint32_t m_length;
+    };
+
+    //No archetype has more than 8 operand tokens, the longest being reg, label, +, imm, (, reg, )
+    constexpr size_t MAX_OPERANDS = 8;
+
+    struct OperandList
+    {
+        std::array<Operand, MAX_OPERANDS> m_operands;
+        uint32_t m_count;
+    };
+
+    //Packs the kinds of an operand list into one integer, 3 bits per operand, so the syntactic shape of
+    //a whole line can be compared against the shape of every archetype with a single switch
+    constexpr uint32_t shape_of(std::initializer_list<OperandKind> kinds)
+    {
+        uint32_t shape = 0;
+        for (OperandKind kind : kinds)
+        {
+            shape = (shape << 3) | static_cast<uint32_t>(kind);
+        }
+        return shape;
+    }
+
+    //Splits an instruction's operand list into registers, immediates, labels, parentheses and signs in a single
+    //pass. Returns false on characters that cannot start any operand, malformed registers or out of range numbers
+    template<Char C>
+    bool scan_operands(std::basic_string_view<C> line, OperandList& operands);
+
+    //Archetype matching the shape of the scanned operands, or 0 if the shape is not a valid archetype
+    InstructionSyntacticArchetypes classify_operands(const OperandList& operands);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace NeoMIPS
+{
+    enum class Segment : uint8_t
+    {
+        Text,
+        Data,
+        KText,
+        KData,
+        Count
+    };
+
+    constexpr size_t SEGMENT_COUNT = static_cast<size_t>(Segment::Count);
+
+    struct ProgramSymbol
+    {
+        uint32_t m_label; //ID
+        uint32_t m_address;
+        Segment m_segment;
+        bool m_global;
+    };
+
+    //The assembled program: one image per segment, covering every address from the first to the last one
+    //the units used, and every label defined by them
+    struct Program
+    {
+        std::endian m_endianness = std::endian::little; //of the words in the images
+        uint32_t m_entry = 0; //the global main if there is one, the start of .text otherwise
+        std::array<uint32_t, SEGMENT_COUNT> m_bases{};
+        std::array<std::vector<uint8_t>, SEGMENT_COUNT> m_images;
+        std::vector<ProgramSymbol> m_symbols;
+    };
+}
@@ -1,9 +1,15 @@
 #pragma once
+#include <bit>
 #include <vector>
 #include <string>
 #include "mips32isa.hpp"
+#include "isadescription.hpp"
 #include "util.hpp"
 #include "lexer_util.hpp"
+#include "lineindex.hpp"
+#include "tokenstream.hpp"
+#include "tokenarena.hpp"
+#include "utf8.hpp"
 #include "error.hpp"
 
 namespace NeoMIPS
@@ -14,33 +20,56 @@ namespace NeoMIPS
     using namespace ISA::Encoding;
 
 
-    enum class TokenType
-    {
-        Directive,
-        Instruction,
-        Pseudoinstruction,
-        Tag
-    };
-
-    class TokenBase
-    {
-    public:
-        virtual TokenType GetTokenType() = 0;
-    };
-
     class InstructionTokenBase : public TokenBase
     {
     public:
         InstructionTokenBase() : m_parameters() {};
         InstructionParameters m_parameters;
         virtual TokenType GetTokenType() { return TokenType::Instruction; }
+        virtual Instruction GetInstruction() const = 0;
         virtual uint32_t Encode() = 0;
-        virtual void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos)
+        virtual void ResolveLabel(const std::vector<uint32_t>& /*addresses*/, uint32_t /*currentMemPos*/)
+        {
+        }
+
+        virtual bool Serialize(TokenWriter& out) const override
+        {
+            out.Write(GetInstruction());
+            out.Write(m_parameters.m_reg1);
+            out.Write(m_parameters.m_reg2);
+            out.Write(m_parameters.m_reg3);
+            out.Write(m_parameters.m_offset);
+            out.Write(m_parameters.m_immediate);
+            out.Write(m_parameters.m_resolvedLabel);
+            out.Write(m_parameters.m_archetype);
+            out.WriteString(label_name(m_parameters.m_label)); //by name, IDs are only valid within a run
+            return true;
+        }
+
+        //Counterpart of Serialize once the instruction has been read and its token created
+        void DeserializeParameters(TokenReader& in)
         {
-            return;
+            m_parameters.m_reg1 = in.Read<uint32_t>();
+            m_parameters.m_reg2 = in.Read<uint32_t>();
+            m_parameters.m_reg3 = in.Read<uint32_t>();
+            m_parameters.m_offset = in.Read<uint32_t>();
+            m_parameters.m_immediate = in.Read<uint32_t>();
+            m_parameters.m_resolvedLabel = in.Read<uint32_t>();
+            m_parameters.m_archetype = in.Read<InstructionSyntacticArchetypes>();
+            m_parameters.m_label = intern_label(in.ReadString<char32_t>());
         }
     };
 
+    //Gives every instruction token its identity, so tokens can be told apart without knowing their type.
+    //The encoding comes from the description of the instruction, see INSTRUCTION_DESCRIPTIONS
+    template<ISA::Instruction I>
+    class InstructionTokenOf : public InstructionTokenBase
+    {
+    public:
+        virtual Instruction GetInstruction() const override { return I; }
+        uint32_t Encode() override { return ISA::encode(I, m_parameters); }
+    };
+
     class PseudoinstructionTokenBase : public TokenBase
     {
     public:
@@ -49,10 +78,159 @@ namespace NeoMIPS
         virtual TokenType GetTokenType() { return TokenType::Pseudoinstruction; }
     };
 
+    //Token of one instruction. Its Parse gets the operands and the offset of the statement, the line of which
+    //any error in the operands reports
+    template<ISA::Instruction I>
+    class InstructionToken : public InstructionTokenOf<I>
+    {
+    };
+
+    //Every instruction has its own token, declared here so the tokens of pseudoinstructions and the parsers
+    //can use any of them before its definition
+    template<> class InstructionToken<Instruction::ABS_D>;
+    template<> class InstructionToken<Instruction::ABS_S>;
+    template<> class InstructionToken<Instruction::ADD>;
+    template<> class InstructionToken<Instruction::ADD_D>;
+    template<> class InstructionToken<Instruction::ADD_S>;
+    template<> class InstructionToken<Instruction::ADDI>;
+    template<> class InstructionToken<Instruction::ADDIU>;
+    template<> class InstructionToken<Instruction::ADDU>;
+    template<> class InstructionToken<Instruction::AND>;
+    template<> class InstructionToken<Instruction::ANDI>;
+    template<> class InstructionToken<Instruction::BC1F>;
+    template<> class InstructionToken<Instruction::BC1T>;
+    template<> class InstructionToken<Instruction::BEQ>;
+    template<> class InstructionToken<Instruction::BGEZ>;
+    template<> class InstructionToken<Instruction::BGEZAL>;
+    template<> class InstructionToken<Instruction::BGTZ>;
+    template<> class InstructionToken<Instruction::BNE>;
+    template<> class InstructionToken<Instruction::BREAK>;
+    template<> class InstructionToken<Instruction::C_EQ_D>;
+    template<> class InstructionToken<Instruction::C_EQ_S>;
+    template<> class InstructionToken<Instruction::C_LE_D>;
+    template<> class InstructionToken<Instruction::C_LE_S>;
+    template<> class InstructionToken<Instruction::C_LT_D>;
+    template<> class InstructionToken<Instruction::C_LT_S>;
+    template<> class InstructionToken<Instruction::CEIL_W_D>;
+    template<> class InstructionToken<Instruction::CEIL_W_S>;
+    template<> class InstructionToken<Instruction::CLO>;
+    template<> class InstructionToken<Instruction::CLZ>;
+    template<> class InstructionToken<Instruction::CVT_D_S>;
+    template<> class InstructionToken<Instruction::CVT_D_W>;
+    template<> class InstructionToken<Instruction::CVT_S_D>;
+    template<> class InstructionToken<Instruction::CVT_S_W>;
+    template<> class InstructionToken<Instruction::CVT_W_D>;
+    template<> class InstructionToken<Instruction::CVT_W_S>;
+    template<> class InstructionToken<Instruction::DIV>;
+    template<> class InstructionToken<Instruction::DIVU>;
+    template<> class InstructionToken<Instruction::DIV_D>;
+    template<> class InstructionToken<Instruction::DIV_S>;
+    template<> class InstructionToken<Instruction::ERET>;
+    template<> class InstructionToken<Instruction::FLOOR_W_D>;
+    template<> class InstructionToken<Instruction::FLOOR_W_S>;
+    template<> class InstructionToken<Instruction::J>;
+    template<> class InstructionToken<Instruction::JAL>;
+    template<> class InstructionToken<Instruction::JALR>;
+    template<> class InstructionToken<Instruction::JR>;
+    template<> class InstructionToken<Instruction::LB>;
+    template<> class InstructionToken<Instruction::LBU>;
+    template<> class InstructionToken<Instruction::LDC1>;
+    template<> class InstructionToken<Instruction::LH>;
+    template<> class InstructionToken<Instruction::LHU>;
+    template<> class InstructionToken<Instruction::LL>;
+    template<> class InstructionToken<Instruction::LUI>;
+    template<> class InstructionToken<Instruction::LW>;
+    template<> class InstructionToken<Instruction::LWC1>;
+    template<> class InstructionToken<Instruction::LWL>;
+    template<> class InstructionToken<Instruction::LWR>;
+    template<> class InstructionToken<Instruction::MADD>;
+    template<> class InstructionToken<Instruction::MADDU>;
+    template<> class InstructionToken<Instruction::MFC0>;
+    template<> class InstructionToken<Instruction::MFC1>;
+    template<> class InstructionToken<Instruction::MFHI>;
+    template<> class InstructionToken<Instruction::MFLO>;
+    template<> class InstructionToken<Instruction::MOV_D>;
+    template<> class InstructionToken<Instruction::MOV_S>;
+    template<> class InstructionToken<Instruction::MOVF>;
+    template<> class InstructionToken<Instruction::MOVF_D>;
+    template<> class InstructionToken<Instruction::MOVF_S>;
+    template<> class InstructionToken<Instruction::MOVN>;
+    template<> class InstructionToken<Instruction::MOVN_D>;
+    template<> class InstructionToken<Instruction::MOVN_S>;
+    template<> class InstructionToken<Instruction::MOVT>;
+    template<> class InstructionToken<Instruction::MOVT_D>;
+    template<> class InstructionToken<Instruction::MOVT_S>;
+    template<> class InstructionToken<Instruction::MOVZ>;
+    template<> class InstructionToken<Instruction::MOVZ_D>;
+    template<> class InstructionToken<Instruction::MOVZ_S>;
+    template<> class InstructionToken<Instruction::MSUB>;
+    template<> class InstructionToken<Instruction::MSUBU>;
+    template<> class InstructionToken<Instruction::MTC0>;
+    template<> class InstructionToken<Instruction::MTC1>;
+    template<> class InstructionToken<Instruction::MTHI>;
+    template<> class InstructionToken<Instruction::MTLO>;
+    template<> class InstructionToken<Instruction::MUL>;
+    template<> class InstructionToken<Instruction::MUL_D>;
+    template<> class InstructionToken<Instruction::MUL_S>;
+    template<> class InstructionToken<Instruction::MULT>;
+    template<> class InstructionToken<Instruction::MULTU>;
+    template<> class InstructionToken<Instruction::NEG_D>;
+    template<> class InstructionToken<Instruction::NEG_S>;
+    template<> class InstructionToken<Instruction::NOP>;
+    template<> class InstructionToken<Instruction::NOR>;
+    template<> class InstructionToken<Instruction::OR>;
+    template<> class InstructionToken<Instruction::ORI>;
+    template<> class InstructionToken<Instruction::ROUND_W_D>;
+    template<> class InstructionToken<Instruction::ROUND_W_S>;
+    template<> class InstructionToken<Instruction::SB>;
+    template<> class InstructionToken<Instruction::SC>;
+    template<> class InstructionToken<Instruction::SDC1>;
+    template<> class InstructionToken<Instruction::SH>;
+    template<> class InstructionToken<Instruction::SLL>;
+    template<> class InstructionToken<Instruction::SLLV>;
+    template<> class InstructionToken<Instruction::SLT>;
+    template<> class InstructionToken<Instruction::SLTI>;
+    template<> class InstructionToken<Instruction::SLTIU>;
+    template<> class InstructionToken<Instruction::SLTU>;
+    template<> class InstructionToken<Instruction::SQRT_D>;
+    template<> class InstructionToken<Instruction::SQRT_S>;
+    template<> class InstructionToken<Instruction::SRL>;
+    template<> class InstructionToken<Instruction::SRLV>;
+    template<> class InstructionToken<Instruction::SRA>;
+    template<> class InstructionToken<Instruction::SRAV>;
+    template<> class InstructionToken<Instruction::SUB>;
+    template<> class InstructionToken<Instruction::SUB_D>;
+    template<> class InstructionToken<Instruction::SUB_S>;
+    template<> class InstructionToken<Instruction::SUBU>;
+    template<> class InstructionToken<Instruction::SW>;
+    template<> class InstructionToken<Instruction::SWC1>;
+    template<> class InstructionToken<Instruction::SWL>;
+    template<> class InstructionToken<Instruction::SWR>;
+    template<> class InstructionToken<Instruction::SYSCALL>;
+    template<> class InstructionToken<Instruction::TEQ>;
+    template<> class InstructionToken<Instruction::TEQI>;
+    template<> class InstructionToken<Instruction::TGE>;
+    template<> class InstructionToken<Instruction::TGEI>;
+    template<> class InstructionToken<Instruction::TGEIU>;
+    template<> class InstructionToken<Instruction::TGEU>;
+    template<> class InstructionToken<Instruction::TLT>;
+    template<> class InstructionToken<Instruction::TLTI>;
+    template<> class InstructionToken<Instruction::TLTIU>;
+    template<> class InstructionToken<Instruction::TLTU>;
+    template<> class InstructionToken<Instruction::TNE>;
+    template<> class InstructionToken<Instruction::TNEI>;
+    template<> class InstructionToken<Instruction::TRUNC_W_D>;
+    template<> class InstructionToken<Instruction::TRUNC_W_S>;
+    template<> class InstructionToken<Instruction::XOR>;
+    template<> class InstructionToken<Instruction::XORI>;
+
+    //Creates the token of the instruction in the arena. Through its base, which is complete wherever a parser
+    //is defined, so the token can be filled in before the definition of its own class
     template<ISA::Instruction I>
-    class InstructionToken : public InstructionTokenBase
+    InstructionTokenBase* emplace_instruction(TokenArena& tokens)
     {
-    };
+        return tokens.Emplace<InstructionToken<I>>();
+    }
 
     template<ISA::Pseudoinstruction I>
     class PseudoinstructionToken : public PseudoinstructionTokenBase
@@ -65,32 +243,84 @@ namespace NeoMIPS
     public:
         virtual Directive GetDirective() = 0;
         virtual TokenType GetTokenType() { return TokenType::Directive; }
+        static constexpr uint32_t NO_ADDRESS = 0xFFFFFFFF;
+
+        //Bytes the directive takes in its segment when placed at offset, padding included. Directives that
+        //don't emit data take none
+        virtual uint32_t Size(uint32_t /*offset*/) const { return 0; }
+        //Writes the data of the directive placed at offset to out, which points to that offset of a zeroed
+        //segment image with room for Size(offset) bytes, so padding is left as it is
+        virtual void Emit(uint8_t* /*out*/, uint32_t /*offset*/) const {}
+        //Address given to a segment directive, NO_ADDRESS if the segment goes on where it was left
+        virtual uint32_t StartAddress() const { return NO_ADDRESS; }
 
     };
 
+    //Token of one directive. Its Parse reads from index on and gets the offset of the statement too, errors
+    //report the line of the statement as index may already be past its end
     template<ISA::Directive D>
     class DirectiveToken : public DirectiveTokenBase
     {
         virtual Directive GetDirective() override { return Directive::invalid; }
     };
 
+    //Label definition, the "name:" that can start a statement
+    class TagToken : public TokenBase
+    {
+    public:
+        uint32_t m_label;
+        TagToken(uint32_t label) : m_label(label) {}
+        virtual TokenType GetTokenType() { return TokenType::Tag; }
+        virtual bool Serialize(TokenWriter& out) const override { out.WriteString(label_name(m_label)); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<TagToken>(intern_label(in.ReadString<char32_t>())); }
+    };
+
+    //Strings are stored as UTF-8, as they are read from the source
+    inline uint32_t string_size(std::u32string_view str)
+    {
+        uint32_t size = 0;
+        for (char32_t c : str) size += Utf8::encoded_length(c);
+        return size;
+    }
+
+    //Padding needed to place data of the given size at its natural alignment
+    constexpr uint32_t align_padding(uint32_t offset, uint32_t size)
+    {
+        return (size - offset % size) % size;
+    }
+
+    //Data is laid out little endian, as MARS does
+    inline void store_little_endian(uint8_t* out, uint64_t value, uint32_t size)
+    {
+        for (uint32_t i = 0; i < size; ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    inline void store_string(uint8_t* out, std::u32string_view str)
+    {
+        for (char32_t c : str) out += Utf8::encode_one(c, out);
+    }
+
     //Specializations for directives
 
     template<>
     class DirectiveToken<ISA::Directive::ALIGN> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         uint32_t m_alignment;
         DirectiveToken(uint32_t alignment) : m_alignment(alignment) {}
     public:
         virtual Directive GetDirective() override { return Directive::ALIGN; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t Size(uint32_t offset) const override { return align_padding(offset, 1U << m_alignment); }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_alignment); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_alignment)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
             while (!isdigit(source[index])) //skip whitespace
             {
                 if (source[index++] == U'\n')
                 {
-                    throw Error::InvalidDirectiveException(std::to_string(index_to_line(source, index)), "ALIGN directive must be followed by an alignment value.");
+                    throw Error::InvalidDirectiveException(lines.Where(position), "ALIGN directive must be followed by an alignment value.");
                 }
             }
 
@@ -98,31 +328,26 @@ namespace NeoMIPS
 
             if (alignment >= 0 && alignment < 4)
             {
-                tokens.emplace_back(new DirectiveToken(alignment));
+                tokens.Emplace<DirectiveToken>(alignment);
             }
-            else throw Error::InvalidDirectiveException(std::to_string(index_to_line(source, index)), "Alignment can only be 0(0 bytes), 1(2 bytes), 2(4bytes) or 3(8 bytes).");
-            return tokens;
+            else throw Error::InvalidDirectiveException(lines.Where(position), "Alignment can only be 0(0 bytes), 1(2 bytes), 2(4bytes) or 3(8 bytes).");
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::ASCII> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         std::u32string m_string;
-        DirectiveToken(const std::u32string& string) : m_string(string)
-        {
-            if (string.empty())
-            {
-                throw Error::InvalidDirectiveException("", "Can't have an empty string.");
-            }
-        }
-        static void ParseStringLiteral(const std::u32string& source, uint32_t& index, std::vector<NeoMIPS::TokenBase*>& tokens)
+        DirectiveToken(const std::u32string& string) : m_string(string) {}
+        template<Char C>
+        static void ParseStringLiteral(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
             while (source[index] != U'"' && source[index] != '\'') //skip whitespace
             {
                 if (source[index++] == U'\n')
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "ASCII directive must be followed by a string literal in quotations.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "ASCII directive must be followed by a string literal in quotations.");
                 }
             }
             std::u32string str;
@@ -130,12 +355,12 @@ namespace NeoMIPS
             {
                 if (source[index] == U'\n')
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "ASCII directive must be followed by a string literal in quotations.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "ASCII directive must be followed by a string literal in quotations.");
                 }
 
                 if (source[index] != U'\\')
                 {
-                    str += source[index];
+                    str += read_code_point(source, index);
                 }
                 else //parse escape sequence
                 {
@@ -172,24 +397,33 @@ namespace NeoMIPS
                         index += 8;
                         break;
                     default:
-                        throw Error::InvalidEscapeSequenceException(std::to_string(index_to_line(source, index)), std::string("Error while parsing ASCII directive: \"").append(to_ascii_string(source.substr(index, 2))).append("\" is not a valid escape sequence."));
+                        throw Error::InvalidEscapeSequenceException(lines.Where(position), std::string("Error while parsing ASCII directive: \"").append(to_ascii_string(source.substr(index, 2))).append("\" is not a valid escape sequence."));
                     }
                 }
                 index++;
             }
             index++;
-            tokens.emplace_back(new DirectiveToken(str));
+            if (str.empty())
+            {
+                throw Error::InvalidDirectiveException(lines.Where(position), "Can't have an empty string.");
+            }
+            tokens.Emplace<DirectiveToken>(str);
         }
     public:
         virtual Directive GetDirective() override { return Directive::ASCII; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t Size(uint32_t /*offset*/) const override { return string_size(m_string); }
+        virtual void Emit(uint8_t* out, uint32_t /*offset*/) const override { store_string(out, m_string); }
+        virtual bool Serialize(TokenWriter& out) const override { out.WriteString(std::u32string_view(m_string)); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.ReadString<char32_t>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
             bool anotherString = false;
             do
             {
-                ParseStringLiteral(source, index, tokens);
-                while (source[index] != U'\n')
+                anotherString = false;
+                ParseStringLiteral(source, index, position, lines, tokens);
+                while (index < source.size() && source[index] != U'\n')
                 {
                     if (source[index++] == U',')
                     {
@@ -198,8 +432,6 @@ namespace NeoMIPS
                     }
                 }
             } while (anotherString);
-
-            return tokens;
         }
 
     };
@@ -207,21 +439,17 @@ namespace NeoMIPS
     template<>
     class DirectiveToken<ISA::Directive::ASCIIZ> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         std::u32string m_string;
-        DirectiveToken(const std::u32string& string) : m_string(string)
-        {
-            if (string.empty())
-            {
-                throw Error::InvalidDirectiveException("unknown", "Can't have an empty string.");
-            }
-        }
-        static void ParseStringLiteral(const std::u32string& source, uint32_t& index, std::vector<NeoMIPS::TokenBase*>& tokens)
+        DirectiveToken(const std::u32string& string) : m_string(string) {}
+        template<Char C>
+        static void ParseStringLiteral(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
             while (source[index] != U'"' && source[index] != '\'') //skip whitespace
             {
                 if (source[index++] == U'\n')
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "ASCIIZ directive must be followed by a string literal in quotations.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "ASCIIZ directive must be followed by a string literal in quotations.");
                 }
             }
             std::u32string str;
@@ -229,12 +457,12 @@ namespace NeoMIPS
             {
                 if (source[index] == U'\n')
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "ASCIIZ directive must be followed by a string literal in quotations.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "ASCIIZ directive must be followed by a string literal in quotations.");
                 }
 
                 if (source[index] != U'\\')
                 {
-                    str += source[index];
+                    str += read_code_point(source, index);
                 }
                 else //parse escape sequence
                 {
@@ -268,25 +496,30 @@ namespace NeoMIPS
                         str += static_cast<char32_t>(to_integer(to_ascii_string(source.substr(index, 8)).c_str(), NeoMIPS::IntBase::hex));
                         break;
                     default:
-                        throw Error::InvalidEscapeSequenceException(std::to_string(index_to_line(source, index)), std::string("Error while parsing ASCIIZ directive: \"").append(to_ascii_string(source.substr(index, 2))).append("\" is not a valid escape sequence."));
+                        throw Error::InvalidEscapeSequenceException(lines.Where(position), std::string("Error while parsing ASCIIZ directive: \"").append(to_ascii_string(source.substr(index, 2))).append("\" is not a valid escape sequence."));
                     }
                 }
                 index++;
             }
             index++;
             str += U'\0';
-            tokens.emplace_back(reinterpret_cast<TokenBase*>(new DirectiveToken(str)));
+            tokens.Emplace<DirectiveToken>(str);
         }
     public:
         virtual Directive GetDirective() override { return Directive::ASCIIZ; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t Size(uint32_t /*offset*/) const override { return string_size(m_string); } //the terminator is part of m_string
+        virtual void Emit(uint8_t* out, uint32_t /*offset*/) const override { store_string(out, m_string); }
+        virtual bool Serialize(TokenWriter& out) const override { out.WriteString(std::u32string_view(m_string)); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.ReadString<char32_t>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
             bool anotherString = false;
             do
             {
-                ParseStringLiteral(source, index, tokens);
-                while (source[index] != U'\n')
+                anotherString = false;
+                ParseStringLiteral(source, index, position, lines, tokens);
+                while (index < source.size() && source[index] != U'\n')
                 {
                     if (source[index++] == U',')
                     {
@@ -295,47 +528,51 @@ namespace NeoMIPS
                     }
                 }
             } while (anotherString);
-
-            return tokens;
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::BYTE> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         uint8_t m_byte;
         DirectiveToken(uint8_t byte) : m_byte(byte) {}
     public:
         virtual Directive GetDirective() override { return Directive::BYTE; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t Size(uint32_t /*offset*/) const override { return 1; }
+        virtual void Emit(uint8_t* out, uint32_t /*offset*/) const override { *out = m_byte; }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_byte); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_byte)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
 
             bool anotherByte = false;
             do
             {
+                anotherByte = false;
                 while (is_separator(source[index]))
                 {
                     if (source[index++] == U'\n')
                     {
-                        throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "BYTE directive must be followed by a valid integer literal.");
+                        throw Error::InvalidSyntaxException(lines.Where(position), "BYTE directive must be followed by a valid integer literal.");
                     }
                 }
-                if (source[index - 1] == U'+' || source[index - 1] == U'-') index--;
                 std::u32string str;
-                while (!is_separator(source[index]))
+                if (source[index - 1] == U'+' || source[index - 1] == U'-') str += source[index - 1]; //the sign stopped the skip as a separator
+                while (index < source.size() && !is_separator(source[index]))
                 {
                     str += source[index++];
                 }
                 try
                 {
-                    tokens.emplace_back(new DirectiveToken(static_cast<uint8_t>(to_integer(to_ascii_string(str).c_str()))));
+                    tokens.Emplace<DirectiveToken>(static_cast<uint8_t>(to_integer(to_ascii_string(str).c_str())));
                 }
-                catch (std::exception& e)
+                catch (const Error::IntegerParsingException&)
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing integer literal.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing integer literal.");
                 }
-                while (source[index] != U'\n')
+                while (index < source.size() && source[index] != U'\n')
                 {
                     if (source[index++] == U',')
                     {
@@ -344,42 +581,43 @@ namespace NeoMIPS
                     }
                 }
             } while (anotherByte);
-            return tokens;
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::DATA> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         uint32_t m_startAddr;
         DirectiveToken(uint32_t startAddr) : m_startAddr(startAddr) {}
     public:
         virtual Directive GetDirective() override { return Directive::DATA; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t StartAddress() const override { return m_startAddr; }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_startAddr); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_startAddr)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
-            while (is_separator(source[index]))
+            while (index < source.size() && source[index] != U'\n' && is_separator(source[index])) ++index;
+            //without an address the segment goes on where it was left, the '\n' is left to end the statement
+            if (index == source.size() || source[index] == U'\n')
             {
-                if (source[index++] == U'\n')
-                {
-                    tokens.emplace_back(new DirectiveToken(0x10000000));
-                    return tokens;
-                }
+                tokens.Emplace<DirectiveToken>(NO_ADDRESS);
+                return;
             }
             std::u32string str;
-            while (!is_separator(source[index]))
+            while (index < source.size() && !is_separator(source[index]))
             {
                 str += source[index++];
             }
             try
             {
-                tokens.emplace_back(new DirectiveToken(to_integer(to_ascii_string(str).c_str())));
+                tokens.Emplace<DirectiveToken>(to_integer(to_ascii_string(str).c_str()));
             }
-            catch (std::exception& e)
+            catch (const Error::IntegerParsingException&)
             {
-                throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing integer literal.");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing integer literal.");
             }
-            return tokens;
         }
     };
 
@@ -387,38 +625,44 @@ namespace NeoMIPS
     template<>
     class DirectiveToken<Directive::DOUBLE> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         double m_double;
         DirectiveToken(double d) : m_double(d) {}
     public:
         virtual Directive GetDirective() override { return Directive::DOUBLE; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t Size(uint32_t offset) const override { return align_padding(offset, 8) + 8; }
+        virtual void Emit(uint8_t* out, uint32_t offset) const override { store_little_endian(out + align_padding(offset, 8), std::bit_cast<uint64_t>(m_double), 8); }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_double); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_double)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
             bool anotherDouble = false;
             do
             {
+                anotherDouble = false;
                 while (is_separator(source[index]))
                 {
                     if (source[index++] == U'\n')
                     {
-                        throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "DOUBLE directive must be followed by a valid double literal.");
+                        throw Error::InvalidSyntaxException(lines.Where(position), "DOUBLE directive must be followed by a valid double literal.");
                     }
                 }
-                if (source[index - 1] == U'+' || source[index - 1] == U'-') index--;
                 std::u32string str;
-                while (!is_separator(source[index]))
+                if (source[index - 1] == U'+' || source[index - 1] == U'-') str += source[index - 1]; //the sign stopped the skip as a separator
+                while (index < source.size() && !is_separator(source[index]))
                 {
                     str += source[index++];
                 }
                 try
                 {
-                    tokens.emplace_back(new DirectiveToken((to_double(to_ascii_string(str)))));
+                    tokens.Emplace<DirectiveToken>((to_double(to_ascii_string(str))));
                 }
                 catch (std::exception& e)
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing double literal.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing double literal.");
                 }
-                while (source[index] != U'\n')
+                while (index < source.size() && source[index] != U'\n')
                 {
                     if (source[index++] == U',')
                     {
@@ -427,7 +671,6 @@ namespace NeoMIPS
                     }
                 }
             } while (anotherDouble);
-            return tokens;
         }
     };
 
@@ -435,38 +678,44 @@ namespace NeoMIPS
     template<>
     class DirectiveToken<Directive::FLOAT> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         float m_float;
         DirectiveToken(float f) : m_float(f) {}
     public:
         virtual Directive GetDirective() override { return Directive::FLOAT; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t Size(uint32_t offset) const override { return align_padding(offset, 4) + 4; }
+        virtual void Emit(uint8_t* out, uint32_t offset) const override { store_little_endian(out + align_padding(offset, 4), std::bit_cast<uint32_t>(m_float), 4); }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_float); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_float)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
             bool anotherFloat = false;
             do
             {
+                anotherFloat = false;
                 while (is_separator(source[index]))
                 {
                     if (source[index++] == U'\n')
                     {
-                        throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "FLOAT directive must be followed by a valid float literal.");
+                        throw Error::InvalidSyntaxException(lines.Where(position), "FLOAT directive must be followed by a valid float literal.");
                     }
                 }
-                if (source[index - 1] == U'+' || source[index - 1] == U'-') index--;
                 std::u32string str;
-                while (!is_separator(source[index]))
+                if (source[index - 1] == U'+' || source[index - 1] == U'-') str += source[index - 1]; //the sign stopped the skip as a separator
+                while (index < source.size() && !is_separator(source[index]))
                 {
                     str += source[index++];
                 }
                 try
                 {
-                    tokens.emplace_back(new DirectiveToken((to_float(to_ascii_string(str)))));
+                    tokens.Emplace<DirectiveToken>((to_float(to_ascii_string(str))));
                 }
                 catch (std::exception& e)
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing float literal.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing float literal.");
                 }
-                while (source[index] != U'\n')
+                while (index < source.size() && source[index] != U'\n')
                 {
                     if (source[index++] == U',')
                     {
@@ -475,67 +724,76 @@ namespace NeoMIPS
                     }
                 }
             } while (anotherFloat);
-            return tokens;
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::GLOBL> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         std::u32string m_globalSymbol;
         DirectiveToken(const std::u32string& symbol) : m_globalSymbol(symbol) {}
     public:
         virtual Directive GetDirective() override { return Directive::GLOBL; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        std::u32string_view GetSymbol() const { return m_globalSymbol; }
+        virtual bool Serialize(TokenWriter& out) const override { out.WriteString(std::u32string_view(m_globalSymbol)); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.ReadString<char32_t>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t /*position*/, const LineIndex& /*lines*/, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
             std::u32string str;
             while (is_space(source[index])) index++;
             while (!is_separator(source[index]))
             {
-                str += source[index++];
+                str += read_code_point(source, index);
+                index++;
             }
-            tokens.emplace_back(new DirectiveToken(str));
-            return tokens;
+            tokens.Emplace<DirectiveToken>(str);
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::HALF> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         uint16_t m_half;
         DirectiveToken(uint16_t half) : m_half(half) {}
     public:
         virtual Directive GetDirective() override { return Directive::HALF; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t Size(uint32_t offset) const override { return align_padding(offset, 2) + 2; }
+        virtual void Emit(uint8_t* out, uint32_t offset) const override { store_little_endian(out + align_padding(offset, 2), m_half, 2); }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_half); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_half)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
 
             bool anotherHalf = false;
             do
             {
+                anotherHalf = false;
                 while (is_separator(source[index]))
                 {
                     if (source[index++] == U'\n')
                     {
-                        throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "HALF directive must be followed by a valid integer literal.");
+                        throw Error::InvalidSyntaxException(lines.Where(position), "HALF directive must be followed by a valid integer literal.");
                     }
                 }
-                if (source[index - 1] == U'+' || source[index - 1] == U'-') index--;
                 std::u32string str;
-                while (!is_separator(source[index]))
+                if (source[index - 1] == U'+' || source[index - 1] == U'-') str += source[index - 1]; //the sign stopped the skip as a separator
+                while (index < source.size() && !is_separator(source[index]))
                 {
                     str += source[index++];
                 }
                 try
                 {
-                    tokens.emplace_back(new DirectiveToken(to_float(to_ascii_string(str))));
+                    tokens.Emplace<DirectiveToken>(to_float(to_ascii_string(str)));
                 }
-                catch (std::exception& e)
+                catch (const Error::IntegerParsingException&)
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing half literal.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing half literal.");
                 }
-                while (source[index] != U'\n')
+                while (index < source.size() && source[index] != U'\n')
                 {
                     if (source[index++] == U',')
                     {
@@ -544,116 +802,124 @@ namespace NeoMIPS
                     }
                 }
             } while (anotherHalf);
-            return tokens;
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::KDATA> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         uint32_t m_startAddr;
         DirectiveToken(uint32_t startAddr) : m_startAddr(startAddr) {}
     public:
         virtual Directive GetDirective() override { return Directive::KDATA; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t StartAddress() const override { return m_startAddr; }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_startAddr); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_startAddr)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
-            while (is_separator(source[index]))
+            while (index < source.size() && source[index] != U'\n' && is_separator(source[index])) ++index;
+            //without an address the segment goes on where it was left, the '\n' is left to end the statement
+            if (index == source.size() || source[index] == U'\n')
             {
-                if (source[index++] == U'\n')
-                {
-                    tokens.emplace_back(new DirectiveToken(0x90000000));
-                    return tokens;
-                }
+                tokens.Emplace<DirectiveToken>(NO_ADDRESS);
+                return;
             }
             std::u32string str;
-            while (!is_separator(source[index]))
+            while (index < source.size() && !is_separator(source[index]))
             {
                 str += source[index++];
             }
             try
             {
-                tokens.emplace_back(new DirectiveToken(to_integer(to_ascii_string(str).c_str())));
+                tokens.Emplace<DirectiveToken>(to_integer(to_ascii_string(str).c_str()));
             }
-            catch (std::exception& e)
+            catch (const Error::IntegerParsingException&)
             {
-                throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing integer literal.");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing integer literal.");
             }
-            return tokens;
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::KTEXT> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         uint32_t m_startAddr;
         DirectiveToken(uint32_t startAddr) : m_startAddr(startAddr) {}
     public:
         virtual Directive GetDirective() override { return Directive::KTEXT; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t StartAddress() const override { return m_startAddr; }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_startAddr); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_startAddr)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
-            while (is_separator(source[index]))
+            while (index < source.size() && source[index] != U'\n' && is_separator(source[index])) ++index;
+            //without an address the segment goes on where it was left, the '\n' is left to end the statement
+            if (index == source.size() || source[index] == U'\n')
             {
-                if (source[index++] == U'\n')
-                {
-                    tokens.emplace_back(new DirectiveToken(0x80000000));
-                    return tokens;
-                }
+                tokens.Emplace<DirectiveToken>(NO_ADDRESS);
+                return;
             }
             std::u32string str;
-            while (!is_separator(source[index]))
+            while (index < source.size() && !is_separator(source[index]))
             {
                 str += source[index++];
             }
             try
             {
-                tokens.emplace_back(new DirectiveToken(to_integer(to_ascii_string(str).c_str())));
+                tokens.Emplace<DirectiveToken>(to_integer(to_ascii_string(str).c_str()));
             }
-            catch (std::exception& e)
+            catch (const Error::IntegerParsingException&)
             {
-                throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing integer literal.");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing integer literal.");
             }
-            return tokens;
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::SPACE> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         uint16_t m_space;
         DirectiveToken(uint32_t space) : m_space(space) {}
     public:
         virtual Directive GetDirective() override { return Directive::SPACE; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t Size(uint32_t /*offset*/) const override { return m_space; }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_space); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_space)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
 
             bool anotherSpace = false;
             do
             {
+                anotherSpace = false;
                 while (is_separator(source[index]))
                 {
                     if (source[index++] == U'\n')
                     {
-                        throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "SPACE directive must be followed by a valid integer literal.");
+                        throw Error::InvalidSyntaxException(lines.Where(position), "SPACE directive must be followed by a valid integer literal.");
                     }
                 }
-                if (source[index - 1] == U'+' || source[index - 1] == U'-') index--;
                 std::u32string str;
-                while (!is_separator(source[index]))
+                if (source[index - 1] == U'+' || source[index - 1] == U'-') str += source[index - 1]; //the sign stopped the skip as a separator
+                while (index < source.size() && !is_separator(source[index]))
                 {
                     str += source[index++];
                 }
                 try
                 {
-                    tokens.emplace_back(new DirectiveToken(static_cast<uint32_t>(to_integer(to_ascii_string(str).c_str()))));
+                    tokens.Emplace<DirectiveToken>(static_cast<uint32_t>(to_integer(to_ascii_string(str).c_str())));
                 }
-                catch (std::exception& e)
+                catch (const Error::IntegerParsingException&)
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing integer literal.");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing integer literal.");
                 }
-                while (source[index] != U'\n')
+                while (index < source.size() && source[index] != U'\n')
                 {
                     if (source[index++] == U',')
                     {
@@ -662,46 +928,65 @@ namespace NeoMIPS
                     }
                 }
             } while (anotherSpace);
-            return tokens;
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::WORD> : public DirectiveTokenBase
     {
-        uint16_t m_word;
-        DirectiveToken(uint32_t word) : m_word(word) {}
+        friend class TokenArena;
+        uint32_t m_word;
+        uint32_t m_label; //ID of the label the word holds the address of, or NO_LABEL
+        DirectiveToken(uint32_t word, uint32_t label = NO_LABEL) : m_word(word), m_label(label) {}
     public:
         virtual Directive GetDirective() override { return Directive::WORD; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        //A word with a label is emitted as 0, the linker writes the address in once the label is placed
+        uint32_t GetLabel() const { return m_label; }
+        virtual uint32_t Size(uint32_t offset) const override { return align_padding(offset, 4) + 4; }
+        virtual void Emit(uint8_t* out, uint32_t offset) const override { store_little_endian(out + align_padding(offset, 4), m_word, 4); }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_word); out.WriteString(label_name(m_label)); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens)
+        {
+            uint32_t word = in.Read<decltype(m_word)>();
+            return tokens.Emplace<DirectiveToken>(word, intern_label(in.ReadString<char32_t>()));
+        }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
 
             bool anotherWord = false;
             do
             {
+                anotherWord = false;
                 while (is_separator(source[index]))
                 {
                     if (source[index++] == U'\n')
                     {
-                        throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "WORD directive must be followed by a valid integer literal.");
+                        throw Error::InvalidSyntaxException(lines.Where(position), "WORD directive must be followed by a valid integer literal.");
                     }
                 }
-                if (source[index - 1] == U'+' || source[index - 1] == U'-') index--;
                 std::u32string str;
-                while (!is_separator(source[index]))
+                bool sign = source[index - 1] == U'+' || source[index - 1] == U'-';
+                if (sign) str += source[index - 1]; //the sign stopped the skip as a separator
+                uint32_t start = index;
+                while (index < source.size() && !is_separator(source[index]))
                 {
                     str += source[index++];
                 }
-                try
+                std::basic_string_view<C> word = std::basic_string_view<C>(source).substr(start, index - start);
+                if (!sign && is_label_name(word))
                 {
-                    tokens.emplace_back(new DirectiveToken(static_cast<uint32_t>(to_integer(to_ascii_string(str).c_str()))));
+                    tokens.Emplace<DirectiveToken>(0, to_label(word));
                 }
-                catch (std::exception& e)
+                else try
                 {
-                    throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing integer literal.");
+                    tokens.Emplace<DirectiveToken>(static_cast<uint32_t>(to_integer(to_ascii_string(str).c_str())));
                 }
-                while (source[index] != U'\n')
+                catch (const Error::IntegerParsingException&)
+                {
+                    throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing integer literal.");
+                }
+                while (index < source.size() && source[index] != U'\n')
                 {
                     if (source[index++] == U',')
                     {
@@ -710,134 +995,113 @@ namespace NeoMIPS
                     }
                 }
             } while (anotherWord);
-            return tokens;
         }
     };
 
     template<>
     class DirectiveToken<ISA::Directive::TEXT> : public DirectiveTokenBase
     {
+        friend class TokenArena;
         uint32_t m_startAddr;
         DirectiveToken(uint32_t startAddr) : m_startAddr(startAddr) {}
     public:
         virtual Directive GetDirective() override { return Directive::TEXT; }
-        static std::vector<TokenBase*> Parse(const std::u32string& source, uint32_t& index)
+        virtual uint32_t StartAddress() const override { return m_startAddr; }
+        virtual bool Serialize(TokenWriter& out) const override { out.Write(m_startAddr); return true; }
+        static TokenBase* Deserialize(TokenReader& in, TokenArena& tokens) { return tokens.Emplace<DirectiveToken>(in.Read<decltype(m_startAddr)>()); }
+        template<Char C>
+        static void Parse(const std::basic_string<C>& source, uint32_t& index, uint32_t position, const LineIndex& lines, TokenArena& tokens)
         {
-            std::vector<TokenBase*> tokens;
-            while (is_separator(source[index]))
+            while (index < source.size() && source[index] != U'\n' && is_separator(source[index])) ++index;
+            //without an address the segment goes on where it was left, the '\n' is left to end the statement
+            if (index == source.size() || source[index] == U'\n')
             {
-                if (source[index++] == U'\n')
-                {
-                    tokens.emplace_back(new DirectiveToken(0x04000000));
-                    return tokens;
-                }
+                tokens.Emplace<DirectiveToken>(NO_ADDRESS);
+                return;
             }
             std::u32string str;
-            while (!is_separator(source[index]))
+            while (index < source.size() && !is_separator(source[index]))
             {
                 str += source[index++];
             }
             try
             {
-                tokens.emplace_back(new DirectiveToken(to_integer(to_ascii_string(str).c_str())));
+                tokens.Emplace<DirectiveToken>(to_integer(to_ascii_string(str).c_str()));
             }
-            catch (std::exception& e)
+            catch (const Error::IntegerParsingException&)
             {
-                throw Error::InvalidSyntaxException(std::to_string(index_to_line(source, index)), "Error parsing integer literal.");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Error parsing integer literal.");
             }
-            return tokens;
         }
     };
 
     //Specializations for instructions
 
     template<>
-    class InstructionToken<Instruction::ABS_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::ABS_D> : public InstructionTokenOf<Instruction::ABS_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ABS_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the abs.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the abs.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000101;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ABS_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::ABS_S> : public InstructionTokenOf<Instruction::ABS_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ABS_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the abs.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the abs.s instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000101;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ADD> : public InstructionTokenBase
+    class InstructionToken<Instruction::ADD> : public InstructionTokenOf<Instruction::ADD>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ADD).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the add instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the add instruction");
             }
             else
             {
@@ -845,40 +1109,40 @@ namespace NeoMIPS
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()))->m_parameters = params;
-                            return vec;
+                            emplace_instruction<Instruction::ADDI>(tokens)->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::ADD>*>(vec.emplace_back(new InstructionToken<Instruction::ADD>()));
+                            auto c = emplace_instruction<Instruction::ADD>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = params.m_reg2;
                             c->m_parameters.m_reg3 = 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                 }
@@ -886,193 +1150,137 @@ namespace NeoMIPS
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000;
-            instruction |= 0b100000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ADD_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::ADD_D> : public InstructionTokenOf<Instruction::ADD_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
-            auto i = static_cast<InstructionToken<Instruction::ADD_D>*>(vec.emplace_back(new InstructionToken<Instruction::ADD_D>()));
-            if (!parse_instruction(instructionStr, i->m_parameters, InstructionSyntacticArchetypes::RegRegReg))
+            auto i = emplace_instruction<Instruction::ADD_D>(tokens);
+            if (!parse_instruction(instructionStr, i->m_parameters, ISA::describe(Instruction::ADD_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the add.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the add.d instruction");
             }
             if (i->m_parameters.m_reg1 % 2 != 0 || i->m_parameters.m_reg2 % 2 != 0 || i->m_parameters.m_reg3 % 2 != 0)
             {
-                throw  Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                throw  Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ADD_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::ADD_S> : public InstructionTokenOf<Instruction::ADD_S>
     {
-        InstructionToken() : InstructionTokenBase() {}
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
-            auto i = static_cast<InstructionToken<Instruction::ADD_S>*>(vec.emplace_back(new InstructionToken<Instruction::ADD_S>()));
-            if (!parse_instruction(instructionStr, i->m_parameters, InstructionSyntacticArchetypes::RegRegReg))
+            auto i = emplace_instruction<Instruction::ADD_S>(tokens);
+            if (!parse_instruction(instructionStr, i->m_parameters, ISA::describe(Instruction::ADD_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the add.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the add.s instruction");
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ADDI> : public InstructionTokenBase
+    class InstructionToken<Instruction::ADDI> : public InstructionTokenOf<Instruction::ADDI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ADDI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the addi instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the addi instruction");
             }
             else
             {
                 if (std::in_range<int16_t>(params.m_immediate))
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else if (!keepPseudoinstructions)
                 {
-                    auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                    auto a = emplace_instruction<Instruction::LUI>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_immediate = params.m_immediate >> 16;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                    auto b = emplace_instruction<Instruction::ORI>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 1;
                     b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::ADD>*>(vec.emplace_back(new InstructionToken<Instruction::ADD>()));
+                    auto c = emplace_instruction<Instruction::ADD>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_reg2 = params.m_reg2;
                     c->m_parameters.m_reg3 = 1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
                 }
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b001000 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ADDIU> : public InstructionTokenBase
+    class InstructionToken<Instruction::ADDIU> : public InstructionTokenOf<Instruction::ADDIU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ADDIU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the addiu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the addiu instruction");
             }
-            else if (!keepPseudoinstructions)
+            //only an immediate the instruction can't sign extend is built in $at
+            else if (!keepPseudoinstructions && !std::in_range<int16_t>(static_cast<int32_t>(params.m_immediate)))
             {
-                auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                auto a = emplace_instruction<Instruction::LUI>(tokens);
                 a->m_parameters.m_reg1 = 1;
                 a->m_parameters.m_immediate = params.m_immediate >> 16;
                 a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                auto b = emplace_instruction<Instruction::ORI>(tokens);
                 b->m_parameters.m_reg1 = 1;
                 b->m_parameters.m_reg2 = 1;
                 b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                 b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                auto c = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                auto c = emplace_instruction<Instruction::ADDU>(tokens);
                 c->m_parameters.m_reg1 = params.m_reg1;
                 c->m_parameters.m_reg2 = params.m_reg2;
                 c->m_parameters.m_reg3 = 1;
                 c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                return vec;
+                return;
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b001001 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ADDU> : public InstructionTokenBase
+    class InstructionToken<Instruction::ADDU> : public InstructionTokenOf<Instruction::ADDU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ADDU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the addu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the addu instruction");
             }
             else
             {
@@ -1080,33 +1288,33 @@ namespace NeoMIPS
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ADD>*>(vec.emplace_back(new InstructionToken<Instruction::ADD>()));
+                        auto c = emplace_instruction<Instruction::ADD>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
 
                     }
                 }
@@ -1114,31 +1322,19 @@ namespace NeoMIPS
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000;
-            instruction |= 0b100001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::AND> : public InstructionTokenBase
+    class InstructionToken<Instruction::AND> : public InstructionTokenOf<Instruction::AND>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm | InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::AND).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the and instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the and instruction");
             }
             else
             {
@@ -1146,8 +1342,8 @@ namespace NeoMIPS
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegImm:
                     params.m_reg2 = params.m_reg1;
@@ -1155,43 +1351,31 @@ namespace NeoMIPS
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
-                        static_cast<InstructionToken<Instruction::ANDI>*>(vec.emplace_back(new InstructionToken<Instruction::ANDI>()))->m_parameters = params;
-                        return vec;
+                        emplace_instruction<Instruction::ANDI>(tokens)->m_parameters = params;
+                        return;
                     }
                 }
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000;
-            instruction |= 0b100100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ANDI> : public InstructionTokenBase
+    class InstructionToken<Instruction::ANDI> : public InstructionTokenOf<Instruction::ANDI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm | InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ANDI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the and instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the and instruction");
             }
             else
             {
@@ -1203,174 +1387,142 @@ namespace NeoMIPS
                 {
                     if (std::in_range<uint16_t>(params.m_immediate))
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
                         if (keepPseudoinstructions)
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
-                            auto c = static_cast<InstructionToken<Instruction::ADD>*>(vec.emplace_back(new InstructionToken<Instruction::AND>()));
+                            auto c = emplace_instruction<Instruction::AND>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = params.m_reg2;
                             c->m_parameters.m_reg3 = 1;
-                            return vec;
+                            return;
                         }
                     }
                 }
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b001100 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<ISA::Pseudoinstruction::B> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::Label))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the b instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the b instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
-                    auto a = static_cast<InstructionToken<Instruction::BGEZ>*>(vec.emplace_back(new InstructionToken<Instruction::BGEZ>()));
+                    auto a = emplace_instruction<Instruction::BGEZ>(tokens);
                     a->m_parameters.m_reg1 = 0;
                     a->m_parameters.m_label = params.m_label;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
             }
         }
     };
 
     template<>
-    class InstructionToken<Instruction::BC1F> : public InstructionTokenBase
+    class InstructionToken<Instruction::BC1F> : public InstructionTokenOf<Instruction::BC1F>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::Label | InstructionSyntacticArchetypes::ImmLabel))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::BC1F).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bc1f instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bc1f instruction");
             }
             else
             {
                 if (params.m_archetype == InstructionSyntacticArchetypes::Label)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
                 }
                 else if (params.m_immediate > 7 || params.m_immediate < 0)
                 {
-                    throw Error::InvalidSyntaxException("?", "Flag for instruction bc1f must be in the [0-7] range");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "Flag for instruction bc1f must be in the [0-7] range");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
                 }
-                return vec;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= 0b01000 << 21;
-            instruction |= m_parameters.m_immediate << 18;
-            instruction |= 0b0 << 17;
-            instruction |= 0b0 << 16;
-            instruction |= m_parameters.m_resolvedLabel & 0xFFFF; //here, m_resolvedLabel must be ((labelAddress - currentAddress) >> 2). IMPORTANT!
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::BC1T> : public InstructionTokenBase
+    class InstructionToken<Instruction::BC1T> : public InstructionTokenOf<Instruction::BC1T>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::Label | InstructionSyntacticArchetypes::ImmLabel))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::BC1T).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bc1t instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bc1t instruction");
             }
             else
             {
                 if (params.m_archetype == InstructionSyntacticArchetypes::Label)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
                 }
                 else if (params.m_immediate > 7 || params.m_immediate < 0)
                 {
-                    throw Error::InvalidSyntaxException("?", "Flag for instruction bc1t must be in the [0-7] range");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "Flag for instruction bc1t must be in the [0-7] range");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
                 }
-                return vec;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= 0b01000 << 21;
-            instruction |= m_parameters.m_immediate << 18;
-            instruction |= 0b0 << 17;
-            instruction |= 0b1 << 16;
-            instruction |= m_parameters.m_resolvedLabel & 0xFFFF; //here, m_resolvedLabel must be ((labelAddress - currentAddress) >> 2). IMPORTANT!
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::BEQ> : public InstructionTokenBase
+    class InstructionToken<Instruction::BEQ> : public InstructionTokenOf<Instruction::BEQ>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::BEQ).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the beq instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the beq instruction");
             }
             else
             {
@@ -1378,49 +1530,49 @@ namespace NeoMIPS
                 {
                 case InstructionSyntacticArchetypes::RegRegLabel:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                            auto a = emplace_instruction<Instruction::ADDI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_immediate = params.m_immediate;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                            auto b = emplace_instruction<Instruction::BEQ>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = params.m_reg1;
                             b->m_parameters.m_label = params.m_label;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                            auto c = emplace_instruction<Instruction::BEQ>(tokens);
                             c->m_parameters.m_reg1 = 1;
                             c->m_parameters.m_reg2 = params.m_reg1;
                             c->m_parameters.m_label = params.m_label;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                 }
@@ -1428,47 +1580,37 @@ namespace NeoMIPS
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000100 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_resolvedLabel & 0xFFFF; //here, m_resolvedLabel must be ((labelAddress - currentAddress) >> 2). IMPORTANT!
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<ISA::Pseudoinstruction::BEQZ> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the beqz instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the beqz instruction");
             }
             else if (!keepPseudoinstructions)
             {
-                auto a = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                auto a = emplace_instruction<Instruction::BEQ>(tokens);
                 a->m_parameters.m_reg1 = params.m_reg1;
                 a->m_parameters.m_reg2 = 0;
                 a->m_parameters.m_label = params.m_label;
                 a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                return vec;
+                return;
             }
             else
             {
-                auto a = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                auto a = emplace_instruction<Instruction::BEQ>(tokens);
                 a->m_parameters.m_reg1 = params.m_reg1;
                 a->m_parameters.m_reg2 = 0;
                 a->m_parameters.m_label = params.m_label;
                 a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                return vec;
+                return;
             }
         }
     };
@@ -1477,13 +1619,13 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::BGE> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bge instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bge instruction");
             }
             else
             {
@@ -1493,69 +1635,69 @@ namespace NeoMIPS
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto a = emplace_instruction<Instruction::SLT>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = params.m_reg1;
                         a->m_parameters.m_reg3 = params.m_reg2;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto b = emplace_instruction<Instruction::BEQ>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 0;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                 }
                 case InstructionSyntacticArchetypes::RegImmLabel:
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::SLTI>*>(vec.emplace_back(new InstructionToken<Instruction::SLTI>()));
+                            auto a = emplace_instruction<Instruction::SLTI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_reg2 = params.m_reg1;
                             a->m_parameters.m_immediate = params.m_immediate;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                            auto b = emplace_instruction<Instruction::BEQ>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 0;
                             b->m_parameters.m_label = params.m_label;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                            auto c = emplace_instruction<Instruction::SLT>(tokens);
                             c->m_parameters.m_reg1 = 1;
                             c->m_parameters.m_reg2 = params.m_reg1;
                             c->m_parameters.m_reg3 = 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                            auto d = emplace_instruction<Instruction::BEQ>(tokens);
                             d->m_parameters.m_reg1 = 1;
                             d->m_parameters.m_reg2 = 0;
                             d->m_parameters.m_label = params.m_label;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                 }
@@ -1568,13 +1710,13 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::BGEU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bgeu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bgeu instruction");
             }
             else
             {
@@ -1584,70 +1726,70 @@ namespace NeoMIPS
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
 
-                        auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto a = emplace_instruction<Instruction::SLT>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = params.m_reg1;
                         a->m_parameters.m_reg3 = params.m_reg2;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto b = emplace_instruction<Instruction::BEQ>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 0;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                 }
                 case InstructionSyntacticArchetypes::RegImmLabel:
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
                         if (std::in_range<uint16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::SLTIU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTIU>()));
+                            auto a = emplace_instruction<Instruction::SLTIU>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_reg2 = params.m_reg1;
                             a->m_parameters.m_immediate = params.m_immediate;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                            auto b = emplace_instruction<Instruction::BEQ>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 0;
                             b->m_parameters.m_label = params.m_label;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                            auto c = emplace_instruction<Instruction::SLTU>(tokens);
                             c->m_parameters.m_reg1 = 1;
                             c->m_parameters.m_reg2 = params.m_reg1;
                             c->m_parameters.m_reg3 = 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                            auto d = emplace_instruction<Instruction::BEQ>(tokens);
                             d->m_parameters.m_reg1 = 1;
                             d->m_parameters.m_reg2 = 0;
                             d->m_parameters.m_label = params.m_label;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                 }
@@ -1657,144 +1799,124 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::BGEZ> : public InstructionTokenBase
+    class InstructionToken<Instruction::BGEZ> : public InstructionTokenOf<Instruction::BGEZ>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegLabel))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::BGEZ).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bgez instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bgez instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000001 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b00001 << 16;
-            instruction |= m_parameters.m_resolvedLabel & 0xFFFF; //here, m_resolvedLabel must be ((labelAddress - currentAddress) >> 2). IMPORTANT!
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::BGEZAL> : public InstructionTokenBase
+    class InstructionToken<Instruction::BGEZAL> : public InstructionTokenOf<Instruction::BGEZAL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegLabel))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::BGEZAL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bgezal instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bgezal instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000001 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b10001 << 16;
-            instruction |= m_parameters.m_resolvedLabel & 0xFFFF; //here, m_resolvedLabel must be ((labelAddress - currentAddress) >> 2). IMPORTANT!
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<ISA::Pseudoinstruction::BGT> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bgtu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bgtu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegLabel:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                    auto a = emplace_instruction<Instruction::SLT>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_reg3 = params.m_reg1;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                    auto b = emplace_instruction<Instruction::BNE>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 0;
                     b->m_parameters.m_label = params.m_label;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegImmLabel:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto b = emplace_instruction<Instruction::SLT>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto c = emplace_instruction<Instruction::BNE>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 0;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto c = emplace_instruction<Instruction::SLT>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto d = emplace_instruction<Instruction::BEQ>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 0;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -1807,82 +1929,82 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::BGTU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bgtu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bgtu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegLabel:
                 {
 
-                    auto a = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                    auto a = emplace_instruction<Instruction::SLTU>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_reg3 = params.m_reg1;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                    auto b = emplace_instruction<Instruction::BNE>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 0;
                     b->m_parameters.m_label = params.m_label;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegImmLabel:
                 {
                     if (std::in_range<uint16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto b = emplace_instruction<Instruction::SLTU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto c = emplace_instruction<Instruction::BNE>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 0;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto c = emplace_instruction<Instruction::SLTU>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_reg3 = params.m_reg1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto d = emplace_instruction<Instruction::BEQ>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 0;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -1892,115 +2014,105 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::BGTZ> : public InstructionTokenBase
+    class InstructionToken<Instruction::BGTZ> : public InstructionTokenOf<Instruction::BGTZ>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegLabel))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::BGTZ).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bgtz instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bgtz instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000111 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_resolvedLabel & 0xFFFF; //here, m_resolvedLabel must be ((labelAddress - currentAddress) >> 2). IMPORTANT!
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<ISA::Pseudoinstruction::BLE> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ble instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ble instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegLabel:
                 {
 
-                    auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                    auto a = emplace_instruction<Instruction::SLT>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_reg3 = params.m_reg1;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                    auto b = emplace_instruction<Instruction::BEQ>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 0;
                     b->m_parameters.m_label = params.m_label;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegImmLabel:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = params.m_reg1;
                         a->m_parameters.m_immediate = -1;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLTI>*>(vec.emplace_back(new InstructionToken<Instruction::SLTI>()));
+                        auto b = emplace_instruction<Instruction::SLTI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto c = emplace_instruction<Instruction::BNE>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 0;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto c = emplace_instruction<Instruction::SLT>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto d = emplace_instruction<Instruction::BNE>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 0;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -2013,81 +2125,81 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::BLEU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bleu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bleu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegLabel:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                    auto a = emplace_instruction<Instruction::SLT>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_reg3 = params.m_reg1;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                    auto b = emplace_instruction<Instruction::BNE>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 0;
                     b->m_parameters.m_label = params.m_label;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegImmLabel:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = params.m_reg1;
                         a->m_parameters.m_immediate = -1;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLTI>*>(vec.emplace_back(new InstructionToken<Instruction::SLTI>()));
+                        auto b = emplace_instruction<Instruction::SLTI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto c = emplace_instruction<Instruction::BNE>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 0;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto c = emplace_instruction<Instruction::SLTU>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_reg3 = params.m_reg1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto d = emplace_instruction<Instruction::BEQ>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 0;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -2100,76 +2212,76 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::BLT> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the blt instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the blt instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegLabel:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                    auto a = emplace_instruction<Instruction::SLT>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = params.m_reg1;
                     a->m_parameters.m_reg3 = params.m_reg2;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                    auto b = emplace_instruction<Instruction::BNE>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 0;
                     b->m_parameters.m_label = params.m_label;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegImmLabel:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SLTI>*>(vec.emplace_back(new InstructionToken<Instruction::SLTI>()));
+                        auto a = emplace_instruction<Instruction::SLTI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = params.m_reg1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto b = emplace_instruction<Instruction::BNE>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 0;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto c = emplace_instruction<Instruction::SLT>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto d = emplace_instruction<Instruction::BNE>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 0;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -2182,36 +2294,36 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::BLTU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bltu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bltu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegLabel:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                    auto a = emplace_instruction<Instruction::SLTU>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = params.m_reg1;
                     a->m_parameters.m_reg3 = params.m_reg2;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                    auto b = emplace_instruction<Instruction::BNE>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 0;
                     b->m_parameters.m_label = params.m_label;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegImmLabel:
@@ -2219,40 +2331,40 @@ namespace NeoMIPS
 
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SLTIU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTIU>()));
+                        auto a = emplace_instruction<Instruction::SLTIU>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = params.m_reg1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto b = emplace_instruction<Instruction::BNE>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 0;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto c = emplace_instruction<Instruction::SLTU>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto d = emplace_instruction<Instruction::BNE>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 0;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -2262,64 +2374,64 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::BNE> : public InstructionTokenBase
+    class InstructionToken<Instruction::BNE> : public InstructionTokenOf<Instruction::BNE>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegLabel | InstructionSyntacticArchetypes::RegImmLabel))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::BNE).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bne instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bne instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegLabel:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto b = emplace_instruction<Instruction::BNE>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = params.m_reg1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto c = emplace_instruction<Instruction::BNE>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -2327,40 +2439,30 @@ namespace NeoMIPS
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000101 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_resolvedLabel & 0xFFFF; //here, m_resolvedLabel must be ((labelAddress - currentAddress) >> 2). IMPORTANT!
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<ISA::Pseudoinstruction::BNEZ> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegLabel))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the bnez instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the bnez instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
-                    auto a = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                    auto a = emplace_instruction<Instruction::BNE>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = 0;
                     a->m_parameters.m_label = params.m_label;
@@ -2372,1031 +2474,722 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::BREAK> : public InstructionTokenBase
+    class InstructionToken<Instruction::BREAK> : public InstructionTokenOf<Instruction::BREAK>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::NoParams | InstructionSyntacticArchetypes::Imm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::BREAK).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the break instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the break instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_immediate << 6;
-            instruction |= 0b001101;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::C_EQ_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::C_EQ_D> : public InstructionTokenOf<Instruction::C_EQ_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::ImmRegReg | InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::C_EQ_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the c.eq.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the c.eq.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= m_parameters.m_immediate & 0b111 << 8;
-            instruction |= 0b00 << 6;
-            instruction |= 0b11 << 4;
-            instruction |= 0b0010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::C_EQ_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::C_EQ_S> : public InstructionTokenOf<Instruction::C_EQ_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::ImmRegReg | InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::C_EQ_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the c.eq.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the c.eq.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= m_parameters.m_immediate & 0b111 << 8;
-            instruction |= 0b00 << 6;
-            instruction |= 0b11 << 4;
-            instruction |= 0b0010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::C_LE_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::C_LE_D> : public InstructionTokenOf<Instruction::C_LE_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::ImmRegReg | InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::C_LE_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the c.le.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the c.le.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= m_parameters.m_immediate & 0b111 << 8;
-            instruction |= 0b00 << 6;
-            instruction |= 0b11 << 4;
-            instruction |= 0b1110;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::C_LE_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::C_LE_S> : public InstructionTokenOf<Instruction::C_LE_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::ImmRegReg | InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::C_LE_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the c.le.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the c.le.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= m_parameters.m_immediate & 0b111 << 8;
-            instruction |= 0b00 << 6;
-            instruction |= 0b11 << 4;
-            instruction |= 0b1110;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::C_LT_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::C_LT_D> : public InstructionTokenOf<Instruction::C_LT_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::ImmRegReg | InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::C_LT_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the c.lt.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the c.lt.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw  Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw  Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= m_parameters.m_immediate & 0b111 << 8;
-            instruction |= 0b00 << 6;
-            instruction |= 0b11 << 4;
-            instruction |= 0b0100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::C_LT_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::C_LT_S> : public InstructionTokenOf<Instruction::C_LT_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::ImmRegReg | InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::C_LT_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the c.lt.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the c.lt.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero initialization takes care of setting m_immediate to 0 in case user does not provide it
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= m_parameters.m_immediate & 0b111 << 8;
-            instruction |= 0b00 << 6;
-            instruction |= 0b11 << 4;
-            instruction |= 0b0100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CEIL_W_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::CEIL_W_D> : public InstructionTokenOf<Instruction::CEIL_W_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CEIL_W_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ceil.w.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ceil.w.d instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001110;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CEIL_W_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::CEIL_W_S> : public InstructionTokenOf<Instruction::CEIL_W_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CEIL_W_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ceil.w.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ceil.w.s instruction");
             }
             else
             {
 
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001110;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CLO> : public InstructionTokenBase
+    class InstructionToken<Instruction::CLO> : public InstructionTokenOf<Instruction::CLO>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CLO).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the clo instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the clo instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b011100 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg2 << 16; //yes, this is correct
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b100001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CLZ> : public InstructionTokenBase
+    class InstructionToken<Instruction::CLZ> : public InstructionTokenOf<Instruction::CLZ>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CLZ).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the clz instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the clz instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b011100 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg2 << 16; //yes, this is correct
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b100000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CVT_D_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::CVT_D_S> : public InstructionTokenOf<Instruction::CVT_D_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CVT_D_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the cvt.d.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the cvt.d.s instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "The destination operand of the cvt.d.s instruction must be an even-numbered register");
+                    throw Error::InvalidInstructionException(lines.Where(position), "The destination operand of the cvt.d.s instruction must be an even-numbered register");
                 }
 
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b100001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CVT_D_W> : public InstructionTokenBase
+    class InstructionToken<Instruction::CVT_D_W> : public InstructionTokenOf<Instruction::CVT_D_W>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CVT_D_W).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the cvt.d.w instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the cvt.d.w instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "The destination operand of the cvt.d.w instruction must be an even-numbered register");
+                    throw Error::InvalidInstructionException(lines.Where(position), "The destination operand of the cvt.d.w instruction must be an even-numbered register");
                 }
 
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= 0b10100 << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b100001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CVT_S_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::CVT_S_D> : public InstructionTokenOf<Instruction::CVT_S_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CVT_S_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the cvt.s.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the cvt.s.d instruction");
             }
             else
             {
 
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b100000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CVT_S_W> : public InstructionTokenBase
+    class InstructionToken<Instruction::CVT_S_W> : public InstructionTokenOf<Instruction::CVT_S_W>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CVT_S_W).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the cvt.s.w instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the cvt.s.w instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= 0b10100 << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b100000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CVT_W_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::CVT_W_D> : public InstructionTokenOf<Instruction::CVT_W_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CVT_W_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the cvt.w.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the cvt.w.d instruction");
             }
             else
             {
 
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b100100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::CVT_W_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::CVT_W_S> : public InstructionTokenOf<Instruction::CVT_W_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::CVT_W_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the cvt.w.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the cvt.w.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b100100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::DIV> : public InstructionTokenBase
+    class InstructionToken<Instruction::DIV> : public InstructionTokenOf<Instruction::DIV>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg | InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::DIV).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the div instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the div instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegReg:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
 
-                    auto a = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                    auto a = emplace_instruction<Instruction::BNE>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg3;
                     a->m_parameters.m_reg2 = 0;
                     a->m_parameters.m_immediate = 1;
                     //a->m_parameters.m_label = U"%NEXT_NEXT_INSTRUCTION"; //internal macro to signal the next next instruction (+8 bytes or +2 words). Must be translated to 2
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()))->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;;
-                    auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                    emplace_instruction<Instruction::BREAK>(tokens)->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;;
+                    auto b = tokens.Emplace<InstructionToken>();
                     b->m_parameters.m_reg1 = params.m_reg2;
                     b->m_parameters.m_reg2 = params.m_reg3;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                    auto c = emplace_instruction<Instruction::MFLO>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
 
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg2;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto c = emplace_instruction<Instruction::MFLO>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg2;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto d = emplace_instruction<Instruction::MFLO>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= 0b0000000000 << 6;
-            instruction |= 0b011010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::DIVU> : public InstructionTokenBase
+    class InstructionToken<Instruction::DIVU> : public InstructionTokenOf<Instruction::DIVU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg | InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::DIVU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the divu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the divu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegReg:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
 
-                    auto a = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                    auto a = emplace_instruction<Instruction::BNE>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg3;
                     a->m_parameters.m_reg2 = 0;
                     a->m_parameters.m_immediate = 1;
                     //a->m_parameters.m_label = U"%NEXT_NEXT_INSTRUCTION"; //internal macro to signal not the next instruction, but the next next
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()))->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                    emplace_instruction<Instruction::BREAK>(tokens)->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
+                    auto b = tokens.Emplace<InstructionToken>();
                     b->m_parameters.m_reg1 = params.m_reg2;
                     b->m_parameters.m_reg2 = params.m_reg3;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                    auto c = emplace_instruction<Instruction::MFLO>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg2;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto c = emplace_instruction<Instruction::MFLO>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg2;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto d = emplace_instruction<Instruction::MFLO>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= 0b0000000000 << 6;
-            instruction |= 0b011011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::DIV_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::DIV_D> : public InstructionTokenOf<Instruction::DIV_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::DIV_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the div.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the div.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0 || params.m_reg3 % 2 != 0)
                 {
-                    throw Error::InvalidSyntaxException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidSyntaxException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::DIV_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::DIV_S> : public InstructionTokenOf<Instruction::DIV_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::DIV_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the div.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the div.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ERET> : public InstructionTokenBase
+    class InstructionToken<Instruction::ERET> : public InstructionTokenOf<Instruction::ERET>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::NoParams))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ERET).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the eret instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the eret instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
-                return vec;
+                tokens.Emplace<InstructionToken>();
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010000 << 26;
-            instruction |= 0b1 << 25;
-            instruction |= 0b0000000000000000000 << 6;
-            instruction |= 0b011111;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::FLOOR_W_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::FLOOR_W_D> : public InstructionTokenOf<Instruction::FLOOR_W_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::FLOOR_W_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the floor.w.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the floor.w.d instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001111;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::FLOOR_W_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::FLOOR_W_S> : public InstructionTokenOf<Instruction::FLOOR_W_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::FLOOR_W_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the floor.w.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the floor.w.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001111;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::J> : public InstructionTokenBase
+    class InstructionToken<Instruction::J> : public InstructionTokenOf<Instruction::J>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::Label))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::J).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the j instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the j instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000010 << 26;
-            instruction |= m_parameters.m_resolvedLabel; //this is the address of the label. Important to note the difference from the branch instructions
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::JAL> : public InstructionTokenBase
+    class InstructionToken<Instruction::JAL> : public InstructionTokenOf<Instruction::JAL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::Label))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::JAL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the jal instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the jal instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000011 << 26;
-            instruction |= m_parameters.m_resolvedLabel; //this is the address of the label. Important to note the difference from the branch instructions
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::JALR> : public InstructionTokenBase
+    class InstructionToken<Instruction::JALR> : public InstructionTokenOf<Instruction::JALR>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::Reg | InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::JALR).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the jalr instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the jalr instruction");
             }
             else
             {
@@ -3405,74 +3198,52 @@ namespace NeoMIPS
                     params.m_reg2 = params.m_reg1;
                     params.m_reg1 = 31;
                 }
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b001001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::JR> : public InstructionTokenBase
+    class InstructionToken<Instruction::JR> : public InstructionTokenOf<Instruction::JR>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::Label))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::JR).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the jr instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the jr instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b000000000000000 << 6;
-            instruction |= 0b001000;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::LA> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the la instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the la instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -3480,106 +3251,106 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_immediate = 0;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDIU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDIU>()));
+                        auto a = emplace_instruction<Instruction::ADDIU>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_offset >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_offset & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ADD>*>(vec.emplace_back(new InstructionToken<Instruction::ADD>()));
+                        auto c = emplace_instruction<Instruction::ADD>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ADD>*>(vec.emplace_back(new InstructionToken<Instruction::ADD>()));
+                        auto c = emplace_instruction<Instruction::ADD>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ADD>*>(vec.emplace_back(new InstructionToken<Instruction::ADD>()));
+                        auto c = emplace_instruction<Instruction::ADD>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -3588,23 +3359,23 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::LB> : public InstructionTokenBase
+    class InstructionToken<Instruction::LB> : public InstructionTokenOf<Instruction::LB>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LB).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lb instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lb instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -3614,162 +3385,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b100000 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::LBU> : public InstructionTokenBase
+    class InstructionToken<Instruction::LBU> : public InstructionTokenOf<Instruction::LBU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LBU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lbu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lbu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -3779,141 +3539,130 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b100100 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
@@ -3922,24 +3671,24 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::LD> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ld instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ld instruction");
             }
             else
             {
                 if (params.m_reg1 == 31)
                 {
-                    throw Error::InvalidInstructionException("?", "Destination register for instruction ld can't be register $ra(GPR 31)");
+                    throw Error::InvalidInstructionException(lines.Where(position), "Destination register for instruction ld can't be register $ra(GPR 31)");
                 }
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -3947,212 +3696,212 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto a = emplace_instruction<Instruction::LW>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_offset = 0;
-                        auto b = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto b = emplace_instruction<Instruction::LW>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1 + 1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_offset = 4;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto b = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                            auto b = emplace_instruction<Instruction::LW>(tokens);
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = params.m_reg2;
                             b->m_parameters.m_offset = params.m_offset;
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = (params.m_immediate + 4) >> 15;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
-                            b->m_parameters.m_reg1 = 1;
-                            b->m_parameters.m_reg2 = 1;
-                            b->m_parameters.m_reg3 = params.m_reg2;
-                            auto b = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
-                            b->m_parameters.m_reg1 = params.m_reg1 + 1;
-                            b->m_parameters.m_reg2 = 1;
-                            b->m_parameters.m_offset = (params.m_immediate + 4) & 0xFFFF;
-                            return vec;
+                            auto c = emplace_instruction<Instruction::ADDU>(tokens);
+                            c->m_parameters.m_reg1 = 1;
+                            c->m_parameters.m_reg2 = 1;
+                            c->m_parameters.m_reg3 = params.m_reg2;
+                            auto d = emplace_instruction<Instruction::LW>(tokens);
+                            d->m_parameters.m_reg1 = params.m_reg1 + 1;
+                            d->m_parameters.m_reg2 = 1;
+                            d->m_parameters.m_offset = (params.m_immediate + 4) & 0xFFFF;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                            auto c = emplace_instruction<Instruction::LW>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto d = emplace_instruction<Instruction::LUI>(tokens);
                             d->m_parameters.m_reg1 = 1;
                             d->m_parameters.m_immediate = (params.m_offset + 4) >> 16;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto e = emplace_instruction<Instruction::ADDU>(tokens);
                             e->m_parameters.m_reg1 = 1;
                             e->m_parameters.m_reg2 = 1;
                             e->m_parameters.m_reg3 = params.m_reg2;
                             e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto f = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                            auto f = emplace_instruction<Instruction::LW>(tokens);
                             f->m_parameters.m_reg1 = params.m_reg1 + 1;
                             f->m_parameters.m_reg2 = 1;
                             f->m_parameters.m_offset = (params.m_offset + 4) & 0xFFFF;
                             f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
 
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto b = emplace_instruction<Instruction::LW>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_immediate = (params.m_immediate + 4) >> 16;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto d = emplace_instruction<Instruction::LW>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1 + 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_offset = (params.m_immediate + 4) & 0xFFFF;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto b = emplace_instruction<Instruction::LW>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_immediate = 4; //don't forget to shift it right later
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto d = emplace_instruction<Instruction::LW>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1 + 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_offset = 4;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label; // don't forget to shift right 16 bits
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto c = emplace_instruction<Instruction::LW>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto d = emplace_instruction<Instruction::LUI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_immediate = 4;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
-                        b->m_parameters.m_reg1 = 1;
-                        b->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_reg3 = params.m_reg2;
-                        b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto e = emplace_instruction<Instruction::ADDU>(tokens);
+                        e->m_parameters.m_reg1 = 1;
+                        e->m_parameters.m_reg2 = 1;
+                        e->m_parameters.m_reg3 = params.m_reg2;
+                        e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
+                        auto f = emplace_instruction<Instruction::LW>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1 + 1;
                         f->m_parameters.m_reg2 = 1;
                         f->m_parameters.m_offset = 4;
                         f->m_parameters.m_label = params.m_label;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto b = emplace_instruction<Instruction::LW>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_immediate = params.m_immediate + 4;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto d = emplace_instruction<Instruction::LW>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1 + 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_offset = params.m_immediate + 4;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto c = emplace_instruction<Instruction::LW>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_offset = params.m_immediate;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto d = emplace_instruction<Instruction::LUI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_immediate = params.m_immediate + 4;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto e = emplace_instruction<Instruction::ADDU>(tokens);
                         e->m_parameters.m_reg1 = 1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg2;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::LW>*>(vec.emplace_back(new InstructionToken<Instruction::LW>()));
+                        auto f = emplace_instruction<Instruction::LW>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1 + 1;
                         f->m_parameters.m_reg2 = 1;
                         f->m_parameters.m_offset = params.m_immediate + 4;
                         f->m_parameters.m_label = params.m_label;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -4161,27 +3910,27 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::LDC1> : public InstructionTokenBase
+    class InstructionToken<Instruction::LDC1> : public InstructionTokenOf<Instruction::LDC1>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LDC1).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ldc1 instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ldc1 instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -4189,144 +3938,133 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label; // don't forget to shift right 16 bits
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_offset = params.m_immediate;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b110101 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
@@ -4334,25 +4072,25 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::L_D> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the l.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the l.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0)
                 {
-                    Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
 
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -4360,105 +4098,105 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LDC1>*>(vec.emplace_back(new InstructionToken<Instruction::LDC1>()));
+                        auto a = emplace_instruction<Instruction::LDC1>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_offset = 0;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LDC1>*>(vec.emplace_back(new InstructionToken<Instruction::LDC1>()));
+                        auto a = emplace_instruction<Instruction::LDC1>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_offset = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_offset >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LDC1>*>(vec.emplace_back(new InstructionToken<Instruction::LDC1>()));
+                        auto c = emplace_instruction<Instruction::LDC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LDC1>*>(vec.emplace_back(new InstructionToken<Instruction::LDC1>()));
+                        auto b = emplace_instruction<Instruction::LDC1>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LDC1>*>(vec.emplace_back(new InstructionToken<Instruction::LDC1>()));
+                        auto c = emplace_instruction<Instruction::LDC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LDC1>*>(vec.emplace_back(new InstructionToken<Instruction::LDC1>()));
+                        auto b = emplace_instruction<Instruction::LDC1>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LDC1>*>(vec.emplace_back(new InstructionToken<Instruction::LDC1>()));
+                        auto c = emplace_instruction<Instruction::LDC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -4470,20 +4208,20 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::L_S> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the l.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the l.s instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -4491,105 +4229,105 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LWC1>*>(vec.emplace_back(new InstructionToken<Instruction::LWC1>()));
+                        auto a = emplace_instruction<Instruction::LWC1>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_offset = 0;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LWC1>*>(vec.emplace_back(new InstructionToken<Instruction::LWC1>()));
+                        auto a = emplace_instruction<Instruction::LWC1>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_offset = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_offset >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LWC1>*>(vec.emplace_back(new InstructionToken<Instruction::LWC1>()));
+                        auto c = emplace_instruction<Instruction::LWC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LWC1>*>(vec.emplace_back(new InstructionToken<Instruction::LWC1>()));
+                        auto b = emplace_instruction<Instruction::LWC1>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LWC1>*>(vec.emplace_back(new InstructionToken<Instruction::LWC1>()));
+                        auto c = emplace_instruction<Instruction::LWC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LWC1>*>(vec.emplace_back(new InstructionToken<Instruction::LWC1>()));
+                        auto b = emplace_instruction<Instruction::LWC1>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LWC1>*>(vec.emplace_back(new InstructionToken<Instruction::LWC1>()));
+                        auto c = emplace_instruction<Instruction::LWC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -4598,23 +4336,23 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::LH> : public InstructionTokenBase
+    class InstructionToken<Instruction::LH> : public InstructionTokenOf<Instruction::LH>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LH).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lh instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lh instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -4624,162 +4362,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
-        {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b100001 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::LHU> : public InstructionTokenBase
+    class InstructionToken<Instruction::LHU> : public InstructionTokenOf<Instruction::LHU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LHU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lhu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lhu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -4789,141 +4516,130 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
-        {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b100101 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
@@ -4931,53 +4647,53 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::LI> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the li instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the li instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDIU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDIU>()));
+                        auto a = emplace_instruction<Instruction::ADDIU>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else if (std::in_range<uint16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto a = emplace_instruction<Instruction::ORI>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                 }
             }
@@ -4985,23 +4701,23 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::LL> : public InstructionTokenBase
+    class InstructionToken<Instruction::LL> : public InstructionTokenOf<Instruction::LL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ll instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ll instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -5011,192 +4727,171 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b110000 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::LUI> : public InstructionTokenBase
+    class InstructionToken<Instruction::LUI> : public InstructionTokenOf<Instruction::LUI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LUI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lui instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lui instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b001111 << 26;
-            instruction |= 0b000000 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_immediate & 0xFFFF;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::LW> : public InstructionTokenBase
+    class InstructionToken<Instruction::LW> : public InstructionTokenOf<Instruction::LW>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LW).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lw instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lw instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -5206,162 +4901,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b100011 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::LWC1> : public InstructionTokenBase
+    class InstructionToken<Instruction::LWC1> : public InstructionTokenOf<Instruction::LWC1>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LWC1).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lwc1 instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lwc1 instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -5371,162 +5055,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
-        {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b110001 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::LWL> : public InstructionTokenBase
+    class InstructionToken<Instruction::LWL> : public InstructionTokenOf<Instruction::LWL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LWL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lwl instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lwl instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -5536,162 +5209,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
-        {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b100010 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::LWR> : public InstructionTokenBase
+    class InstructionToken<Instruction::LWR> : public InstructionTokenOf<Instruction::LWR>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::LWR).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the lwr instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the lwr instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -5701,1104 +5363,807 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b100110 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::MADD> : public InstructionTokenBase
+    class InstructionToken<Instruction::MADD> : public InstructionTokenOf<Instruction::MADD>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MADD).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the madd instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the madd instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b011100 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MADDU> : public InstructionTokenBase
+    class InstructionToken<Instruction::MADDU> : public InstructionTokenOf<Instruction::MADDU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MADDU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the maddu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the maddu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b011100 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= 0b1;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MFC0> : public InstructionTokenBase
+    class InstructionToken<Instruction::MFC0> : public InstructionTokenOf<Instruction::MFC0>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MFC0).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mfc0 instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mfc0 instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010000 << 26;
-            instruction |= 0b00000 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MFC1> : public InstructionTokenBase
+    class InstructionToken<Instruction::MFC1> : public InstructionTokenOf<Instruction::MFC1>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MFC1).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mfc1 instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mfc1 instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= 0b00000 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::MFC1_D> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mfc1.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mfc1.d instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken<Pseudoinstruction::MFC1_D>()))->m_parameters = params;
-                    return vec;
+                    static_cast<PseudoinstructionToken*>(tokens.Emplace<PseudoinstructionToken<Pseudoinstruction::MFC1_D>>())->m_parameters = params;
+                    return;
                 }
                 else
                 {
-                    static_cast<InstructionToken<Instruction::MFC1>*>(vec.emplace_back(new InstructionToken<Instruction::MFC1>()))->m_parameters = params;
-                    auto a = static_cast<InstructionToken<Instruction::MFC1>*>(vec.emplace_back(new InstructionToken<Instruction::MFC1>()));
+                    emplace_instruction<Instruction::MFC1>(tokens)->m_parameters = params;
+                    auto a = emplace_instruction<Instruction::MFC1>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1 + 1;
                     a->m_parameters.m_reg2 = params.m_reg2 + 1;
-                    return vec;
+                    return;
                 }
             }
         }
     };
 
     template<>
-    class InstructionToken<Instruction::MFHI> : public InstructionTokenBase
+    class InstructionToken<Instruction::MFHI> : public InstructionTokenOf<Instruction::MFHI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MFHI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mfhi instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mfhi instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b010000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MFLO> : public InstructionTokenBase
+    class InstructionToken<Instruction::MFLO> : public InstructionTokenOf<Instruction::MFLO>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MFLO).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mflo instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mflo instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b010010;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::MOVE> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the move instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the move instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken<Pseudoinstruction::MOVE>()))->m_parameters = params;
-                    return vec;
+                    static_cast<PseudoinstructionToken*>(tokens.Emplace<PseudoinstructionToken<Pseudoinstruction::MOVE>>())->m_parameters = params;
+                    return;
                 }
                 else
                 {
-                    auto a = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                    auto a = emplace_instruction<Instruction::ADDU>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1 + 1;
                     a->m_parameters.m_reg2 = 0;
                     a->m_parameters.m_reg2 = params.m_reg2;
-                    return vec;
+                    return;
                 }
             }
         }
     };
 
     template<>
-    class InstructionToken<Instruction::MOV_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOV_D> : public InstructionTokenOf<Instruction::MOV_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOV_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mov.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mov.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };;
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000110;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOV_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOV_S> : public InstructionTokenOf<Instruction::MOV_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOV_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mov.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mov.s instruction");
             }
             else
             {
 
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000110;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVF> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVF> : public InstructionTokenOf<Instruction::MOVF>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVF).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movf instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movf instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero init. should take care
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero init. should take care
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_immediate << 18;
-            instruction |= 0b00 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b000001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVF_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVF_D> : public InstructionTokenOf<Instruction::MOVF_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVF_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movf.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movf.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero init. should take care
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params; //zero init. should take care
+                    return;
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_immediate << 18;
-            instruction |= 0b00 << 16;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b010001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVF_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVF_S> : public InstructionTokenOf<Instruction::MOVF_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVF_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movf.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movf.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero init. should take care
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero init. should take care
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_immediate << 18;
-            instruction |= 0b00 << 16;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b010001;
-            return instruction;
-        }
     };
 
 
     template<>
-    class InstructionToken<Instruction::MOVN> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVN> : public InstructionTokenOf<Instruction::MOVN>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVN).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movn instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movn instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b001011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVN_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVN_D> : public InstructionTokenOf<Instruction::MOVN_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVN_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movn.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movn.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg3 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVN_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVN_S> : public InstructionTokenOf<Instruction::MOVN_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVN_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movn.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movn.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= fmt::S;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg3 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVT> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVT> : public InstructionTokenOf<Instruction::MOVT>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVT).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movt instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movt instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero init. should take care
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero init. should take care
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_immediate << 18;
-            instruction |= 0b01 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b000001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVT_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVT_D> : public InstructionTokenOf<Instruction::MOVT_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVT_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movt.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movt.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero init. should take care
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params; //zero init. should take care
+                    return;
                 }
-            }
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_immediate << 18;
-            instruction |= 0b01 << 16;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b010001;
-            return instruction;
+            }
         }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVT_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVT_S> : public InstructionTokenOf<Instruction::MOVT_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVT_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movt.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movt.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params; //zero init. should take care
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params; //zero init. should take care
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_immediate << 18;
-            instruction |= 0b01 << 16;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b010001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVZ> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVZ> : public InstructionTokenOf<Instruction::MOVZ>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVZ).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movz instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movz instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b001010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVZ_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVZ_D> : public InstructionTokenOf<Instruction::MOVZ_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVZ_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movz.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movz.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 else
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg3 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MOVZ_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::MOVZ_S> : public InstructionTokenOf<Instruction::MOVZ_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MOVZ_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the movz.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the movz.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= fmt::S;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg3 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MSUB> : public InstructionTokenBase
+    class InstructionToken<Instruction::MSUB> : public InstructionTokenOf<Instruction::MSUB>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MSUB).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the msub instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the msub instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b011100 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= 0b000100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MSUBU> : public InstructionTokenBase
+    class InstructionToken<Instruction::MSUBU> : public InstructionTokenOf<Instruction::MSUBU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MSUBU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the msubu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the msubu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b011100 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= 0b000101;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MTC0> : public InstructionTokenBase
+    class InstructionToken<Instruction::MTC0> : public InstructionTokenOf<Instruction::MTC0>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MTC0).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mtc0 instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mtc0 instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010000 << 26;
-            instruction |= 0b00100 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= 0b000 << 3; //'sel' parameter is not supported (yet?)
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MTC1> : public InstructionTokenBase
+    class InstructionToken<Instruction::MTC1> : public InstructionTokenOf<Instruction::MTC1>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MTC1).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mtc1 instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mtc1 instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= 0b00100 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::MTC1_D> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mtc1.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mtc1.d instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
-                    auto a = static_cast<InstructionToken<Instruction::MTC1>*>(vec.emplace_back(new InstructionToken<Instruction::MTC1>()));
+                    auto a = emplace_instruction<Instruction::MTC1>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::MTC1>*>(vec.emplace_back(new InstructionToken<Instruction::MTC1>()));
+                    auto b = emplace_instruction<Instruction::MTC1>(tokens);
                     b->m_parameters.m_reg1 = params.m_reg1 + 1;
                     b->m_parameters.m_reg2 = params.m_reg2 + 1;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
             }
         }
     };
 
     template<>
-    class InstructionToken<Instruction::MTHI> : public InstructionTokenBase
+    class InstructionToken<Instruction::MTHI> : public InstructionTokenOf<Instruction::MTHI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MTHI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mthi instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mthi instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b010001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MTLO> : public InstructionTokenBase
+    class InstructionToken<Instruction::MTLO> : public InstructionTokenOf<Instruction::MTLO>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MTLO).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mtlo instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mtlo instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b010011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MUL> : public InstructionTokenBase
+    class InstructionToken<Instruction::MUL> : public InstructionTokenOf<Instruction::MUL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MUL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mul instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mul instruction");
             }
             else
             {
@@ -6806,49 +6171,49 @@ namespace NeoMIPS
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                            auto a = emplace_instruction<Instruction::ADDI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_reg3 = params.m_immediate;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = params.m_reg2;
                             b->m_parameters.m_reg3 = 1;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = params.m_reg2;
                             c->m_parameters.m_reg3 = 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                 }
@@ -6856,213 +6221,177 @@ namespace NeoMIPS
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b011100 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000;
-            instruction |= 0b000010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MUL_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::MUL_D> : public InstructionTokenOf<Instruction::MUL_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MUL_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mul.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mul.d instruction");
             }
             else
             {
-                if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0 || params.m_reg3 % 2 == 0)
+                if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0 || params.m_reg3 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MUL_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::MUL_S> : public InstructionTokenOf<Instruction::MUL_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MUL_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mul.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mul.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000010;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::MULO> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mulo instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mulo instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
 
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::MULT>*>(vec.emplace_back(new InstructionToken<Instruction::MULT>()));
+                    auto a = emplace_instruction<Instruction::MULT>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg2;
                     a->m_parameters.m_reg2 = params.m_reg3;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                    auto b = emplace_instruction<Instruction::MFHI>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                    auto c = emplace_instruction<Instruction::MFLO>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto d = static_cast<InstructionToken<Instruction::SRA>*>(vec.emplace_back(new InstructionToken<Instruction::SRA>()));
+                    auto d = emplace_instruction<Instruction::SRA>(tokens);
                     d->m_parameters.m_reg1 = params.m_reg1;
                     d->m_parameters.m_reg2 = params.m_reg1;
                     d->m_parameters.m_immediate = 31;
                     d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto e = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                    auto e = emplace_instruction<Instruction::BEQ>(tokens);
                     e->m_parameters.m_reg1 = 1;
                     e->m_parameters.m_reg2 = params.m_reg1;
                     e->m_parameters.m_immediate = 1;
                     e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto f = static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()));
+                    auto f = emplace_instruction<Instruction::BREAK>(tokens);
                     f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto g = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                    auto g = emplace_instruction<Instruction::MFLO>(tokens);
                     g->m_parameters.m_reg1 = params.m_reg1;
                     g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
 
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_reg3 = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::MULT>*>(vec.emplace_back(new InstructionToken<Instruction::MULT>()));
+                        auto b = emplace_instruction<Instruction::MULT>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg2;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                        auto c = emplace_instruction<Instruction::MFHI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto d = emplace_instruction<Instruction::MFLO>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SRA>*>(vec.emplace_back(new InstructionToken<Instruction::SRA>()));
+                        auto e = emplace_instruction<Instruction::SRA>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = params.m_reg1;
                         e->m_parameters.m_immediate = 31;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto f = emplace_instruction<Instruction::BEQ>(tokens);
                         f->m_parameters.m_reg1 = 1;
                         f->m_parameters.m_reg2 = params.m_reg1;
                         f->m_parameters.m_immediate = 1;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto g = static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()));
+                        auto g = emplace_instruction<Instruction::BREAK>(tokens);
                         g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto h = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto h = emplace_instruction<Instruction::MFLO>(tokens);
                         h->m_parameters.m_reg1 = params.m_reg1;
                         h->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::MULT>*>(vec.emplace_back(new InstructionToken<Instruction::MULT>()));
+                        auto c = emplace_instruction<Instruction::MULT>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg2;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                        auto d = emplace_instruction<Instruction::MFHI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto e = emplace_instruction<Instruction::MFLO>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::SRA>*>(vec.emplace_back(new InstructionToken<Instruction::SRA>()));
+                        auto f = emplace_instruction<Instruction::SRA>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1;
                         f->m_parameters.m_reg2 = params.m_reg1;
                         f->m_parameters.m_immediate = 31;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto g = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto g = emplace_instruction<Instruction::BEQ>(tokens);
                         g->m_parameters.m_reg1 = 1;
                         g->m_parameters.m_reg2 = params.m_reg1;
                         g->m_parameters.m_immediate = 1;
                         g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto h = static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()));
+                        auto h = emplace_instruction<Instruction::BREAK>(tokens);
                         h->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto i = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto i = emplace_instruction<Instruction::MFLO>(tokens);
                         i->m_parameters.m_reg1 = params.m_reg1;
                         i->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -7076,103 +6405,103 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::MULOU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mulou instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mulou instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
 
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::MULTU>*>(vec.emplace_back(new InstructionToken<Instruction::MULTU>()));
+                    auto a = emplace_instruction<Instruction::MULTU>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg2;
                     a->m_parameters.m_reg2 = params.m_reg3;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                    auto b = emplace_instruction<Instruction::MFHI>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                    auto c = emplace_instruction<Instruction::BEQ>(tokens);
                     c->m_parameters.m_reg1 = 1;
                     c->m_parameters.m_reg2 = 0;
                     c->m_parameters.m_immediate = 1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto d = static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()));
+                    auto d = emplace_instruction<Instruction::BREAK>(tokens);
                     d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto e = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                    auto e = emplace_instruction<Instruction::MFLO>(tokens);
                     e->m_parameters.m_reg1 = params.m_reg1;
                     e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
 
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_reg3 = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::MULTU>*>(vec.emplace_back(new InstructionToken<Instruction::MULTU>()));
+                        auto b = emplace_instruction<Instruction::MULTU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg2;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                        auto c = emplace_instruction<Instruction::MFHI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto d = emplace_instruction<Instruction::BEQ>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 0;
                         d->m_parameters.m_immediate = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()));
+                        auto e = emplace_instruction<Instruction::BREAK>(tokens);
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto f = emplace_instruction<Instruction::MFLO>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::MULTU>*>(vec.emplace_back(new InstructionToken<Instruction::MULTU>()));
+                        auto c = emplace_instruction<Instruction::MULTU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg2;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                        auto d = emplace_instruction<Instruction::MFHI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::BEQ>*>(vec.emplace_back(new InstructionToken<Instruction::BEQ>()));
+                        auto e = emplace_instruction<Instruction::BEQ>(tokens);
                         e->m_parameters.m_reg1 = 1;
                         e->m_parameters.m_reg2 = 0;
                         e->m_parameters.m_immediate = 1;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()));
+                        auto f = emplace_instruction<Instruction::BREAK>(tokens);
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto g = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto g = emplace_instruction<Instruction::MFLO>(tokens);
                         g->m_parameters.m_reg1 = params.m_reg1;
                         g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -7183,135 +6512,115 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::MULT> : public InstructionTokenBase
+    class InstructionToken<Instruction::MULT> : public InstructionTokenOf<Instruction::MULT>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MULT).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mult instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mult instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= 0b011000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::MULTU> : public InstructionTokenBase
+    class InstructionToken<Instruction::MULTU> : public InstructionTokenOf<Instruction::MULTU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::MULTU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the multu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the multu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= 0b011001;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::MULU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the mulu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the mulu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::MULTU>*>(vec.emplace_back(new InstructionToken<Instruction::MULTU>()));
+                    auto a = emplace_instruction<Instruction::MULTU>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg2;
                     a->m_parameters.m_reg2 = params.m_reg3;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                    auto b = emplace_instruction<Instruction::MFLO>(tokens);
                     b->m_parameters.m_reg1 = params.m_reg1;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
 
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_reg3 = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto a = static_cast<InstructionToken<Instruction::MULTU>*>(vec.emplace_back(new InstructionToken<Instruction::MULTU>()));
-                        a->m_parameters.m_reg1 = params.m_reg2;
-                        a->m_parameters.m_reg2 = 1;
-                        a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto b = emplace_instruction<Instruction::MULTU>(tokens);
+                        b->m_parameters.m_reg1 = params.m_reg2;
+                        b->m_parameters.m_reg2 = 1;
+                        b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
+                        auto c = emplace_instruction<Instruction::MFLO>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::MULTU>*>(vec.emplace_back(new InstructionToken<Instruction::MULTU>()));
+                        auto c = emplace_instruction<Instruction::MULTU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg2;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::MFLO>*>(vec.emplace_back(new InstructionToken<Instruction::MFLO>()));
+                        auto d = emplace_instruction<Instruction::MFLO>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -7325,26 +6634,26 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::NEG> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the neg instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the neg instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
-                auto a = static_cast<InstructionToken<Instruction::SUB>*>(vec.emplace_back(new InstructionToken<Instruction::SUB>()));
+                auto a = emplace_instruction<Instruction::SUB>(tokens);
                 a->m_parameters.m_reg1 = params.m_reg1;
                 a->m_parameters.m_reg2 = 0;
                 a->m_parameters.m_reg3 = params.m_reg2;
-                return vec;
+                return;
             }
         }
     };
@@ -7353,266 +6662,216 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::NEGU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the negu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the negu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
-                auto a = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                auto a = emplace_instruction<Instruction::SUBU>(tokens);
                 a->m_parameters.m_reg1 = params.m_reg1;
                 a->m_parameters.m_reg2 = 0;
                 a->m_parameters.m_reg3 = params.m_reg2;
-                return vec;
+                return;
             }
         }
     };
 
     template<>
-    class InstructionToken<Instruction::NEG_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::NEG_D> : public InstructionTokenOf<Instruction::NEG_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::NEG_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the neg.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the neg.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0 || params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b000111;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::NEG_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::NEG_S> : public InstructionTokenOf<Instruction::NEG_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::NEG_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the neg.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the neg.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b000111;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::NOP> : public InstructionTokenBase
+    class InstructionToken<Instruction::NOP> : public InstructionTokenOf<Instruction::NOP>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::NoParams))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::NOP).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the nop instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the nop instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::NOR> : public InstructionTokenBase
+    class InstructionToken<Instruction::NOR> : public InstructionTokenOf<Instruction::NOR>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::NOR).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the nor instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the nor instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b100111;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::NOT> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the not instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the not instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
-                    auto a = static_cast<InstructionToken<Instruction::NOR>*>(vec.emplace_back(new InstructionToken<Instruction::NOR>()));
+                    auto a = emplace_instruction<Instruction::NOR>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_reg3 = 0;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
             }
         }
     };
 
     template<>
-    class InstructionToken<Instruction::OR> : public InstructionTokenBase
+    class InstructionToken<Instruction::OR> : public InstructionTokenOf<Instruction::OR>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm | InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::OR).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the or instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the or instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else 
                 {
                     if (!std::in_range<uint16_t>(params.m_immediate))
                     {
-                        throw Error::InvalidInstructionException("?", "immediate for or instruction must be in the unsigned 16 bit int range");
+                        throw Error::InvalidInstructionException(lines.Where(position), "immediate for or instruction must be in the unsigned 16 bit int range");
                     }
                     switch (params.m_archetype)
                     {
                     case InstructionSyntacticArchetypes::RegRegReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegRegImm:
                     {
-                        static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()))->m_parameters = params;
-                        return vec;
+                        emplace_instruction<Instruction::ORI>(tokens)->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto a = emplace_instruction<Instruction::ORI>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg1;
                         a->m_parameters.m_immediate = params.m_immediate;
-                        return vec;
+                        return;
                     }
                     }
                 }
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b100101;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ORI> : public InstructionTokenBase
+    class InstructionToken<Instruction::ORI> : public InstructionTokenOf<Instruction::ORI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm | InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ORI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ori instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ori instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -7622,53 +6881,53 @@ namespace NeoMIPS
                     {
                         if (std::in_range<uint16_t>(params.m_immediate))
                         {
-                            static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()))->m_parameters = params;
-                            return vec;
+                            emplace_instruction<Instruction::ORI>(tokens)->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                            auto c = emplace_instruction<Instruction::OR>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = params.m_reg2;
                             c->m_parameters.m_reg3 = 1;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<uint16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto a = emplace_instruction<Instruction::ORI>(tokens);
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = params.m_reg1;
                             a->m_parameters.m_immediate = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                            auto c = emplace_instruction<Instruction::OR>(tokens);
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = params.m_reg1;
                             c->m_parameters.m_reg3 = 1;
-                            return vec;
+                            return;
                         }
                     }
                     }
@@ -7676,106 +6935,72 @@ namespace NeoMIPS
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b001101 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_immediate & 0xFFFF;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ROUND_W_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::ROUND_W_D> : public InstructionTokenOf<Instruction::ROUND_W_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ROUND_W_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the round.w.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the round.w.d instruction");
             }
             else
             {
                 if (params.m_reg2 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "The destination operand of the round.w.d instruction must be an even-numbered register");
+                    throw Error::InvalidInstructionException(lines.Where(position), "The destination operand of the round.w.d instruction must be an even-numbered register");
                 }
 
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::COP1 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::ROUND_W_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::ROUND_W_S> : public InstructionTokenOf<Instruction::ROUND_W_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::ROUND_W_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the round.w.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the round.w.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::COP1 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001100;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::REM> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the rem instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the rem instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -7783,60 +7008,60 @@ namespace NeoMIPS
                     {
                     case InstructionSyntacticArchetypes::RegRegReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto a = emplace_instruction<Instruction::BNE>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg3;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = 1;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()));
+                        auto b = emplace_instruction<Instruction::BREAK>(tokens);
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::DIV>*>(vec.emplace_back(new InstructionToken<Instruction::DIV>()));
+                        auto c = emplace_instruction<Instruction::DIV>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg2;
                         c->m_parameters.m_reg2 = params.m_reg3;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                        auto d = emplace_instruction<Instruction::MFHI>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegRegImm:
                     {
 
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                            auto a = emplace_instruction<Instruction::ADDI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_reg3 = params.m_immediate;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::DIV>*>(vec.emplace_back(new InstructionToken<Instruction::DIV>()));
+                            auto b = emplace_instruction<Instruction::DIV>(tokens);
                             b->m_parameters.m_reg1 = params.m_reg2;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                            auto c = emplace_instruction<Instruction::MFHI>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::DIV>*>(vec.emplace_back(new InstructionToken<Instruction::DIV>()));
+                            auto c = emplace_instruction<Instruction::DIV>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg2;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                            auto d = emplace_instruction<Instruction::MFHI>(tokens);
                             d->m_parameters.m_reg1 = params.m_reg1;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
 
                     }
@@ -7851,20 +7076,20 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::REMU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the remu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the remu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -7872,60 +7097,60 @@ namespace NeoMIPS
                     {
                     case InstructionSyntacticArchetypes::RegRegReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::BNE>*>(vec.emplace_back(new InstructionToken<Instruction::BNE>()));
+                        auto a = emplace_instruction<Instruction::BNE>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg3;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = 1;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::BREAK>*>(vec.emplace_back(new InstructionToken<Instruction::BREAK>()));
+                        auto b = emplace_instruction<Instruction::BREAK>(tokens);
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::DIVU>*>(vec.emplace_back(new InstructionToken<Instruction::DIVU>()));
+                        auto c = emplace_instruction<Instruction::DIVU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg2;
                         c->m_parameters.m_reg2 = params.m_reg3;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                        auto d = emplace_instruction<Instruction::MFHI>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegRegImm:
                     {
 
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                            auto a = emplace_instruction<Instruction::ADDI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_reg3 = params.m_immediate;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::DIVU>*>(vec.emplace_back(new InstructionToken<Instruction::DIVU>()));
+                            auto b = emplace_instruction<Instruction::DIVU>(tokens);
                             b->m_parameters.m_reg1 = params.m_reg2;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                            auto c = emplace_instruction<Instruction::MFHI>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::DIVU>*>(vec.emplace_back(new InstructionToken<Instruction::DIVU>()));
+                            auto c = emplace_instruction<Instruction::DIVU>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg2;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::MFHI>*>(vec.emplace_back(new InstructionToken<Instruction::MFHI>()));
+                            auto d = emplace_instruction<Instruction::MFHI>(tokens);
                             d->m_parameters.m_reg1 = params.m_reg1;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
 
                     }
@@ -7941,20 +7166,20 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::ROL> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the rol instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the rol instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -7962,46 +7187,46 @@ namespace NeoMIPS
                     {
                     case InstructionSyntacticArchetypes::RegRegReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto a = emplace_instruction<Instruction::SUBU>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_reg3 = params.m_reg3;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SRLV>*>(vec.emplace_back(new InstructionToken<Instruction::SRLV>()));
+                        auto b = emplace_instruction<Instruction::SRLV>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_reg3 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLLV>*>(vec.emplace_back(new InstructionToken<Instruction::SLLV>()));
+                        auto c = emplace_instruction<Instruction::SLLV>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = params.m_reg3;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto d = emplace_instruction<Instruction::OR>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = params.m_reg1;
                         d->m_parameters.m_reg3 = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegRegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SRL>*>(vec.emplace_back(new InstructionToken<Instruction::SRLV>()));
+                        auto a = emplace_instruction<Instruction::SRLV>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLLV>()));
+                        auto b = emplace_instruction<Instruction::SLLV>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_immediate = params.m_immediate;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto c = emplace_instruction<Instruction::OR>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                        
 
                     }
@@ -8016,20 +7241,20 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::ROR> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ror instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ror instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -8037,46 +7262,46 @@ namespace NeoMIPS
                     {
                     case InstructionSyntacticArchetypes::RegRegReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto a = emplace_instruction<Instruction::SUBU>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_reg3 = params.m_reg3;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLLV>*>(vec.emplace_back(new InstructionToken<Instruction::SLLV>()));
+                        auto b = emplace_instruction<Instruction::SLLV>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_reg3 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SRLV>*>(vec.emplace_back(new InstructionToken<Instruction::SRLV>()));
+                        auto c = emplace_instruction<Instruction::SRLV>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = params.m_reg3;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto d = emplace_instruction<Instruction::OR>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = params.m_reg1;
                         d->m_parameters.m_reg3 = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegRegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto a = emplace_instruction<Instruction::SLL>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SRL>*>(vec.emplace_back(new InstructionToken<Instruction::SRL>()));
+                        auto b = emplace_instruction<Instruction::SRL>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_immediate = params.m_immediate;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto c = emplace_instruction<Instruction::OR>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                     }
@@ -8089,25 +7314,25 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::S_D> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the s.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the s.d instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0)
                 {
-                    Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
 
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -8115,105 +7340,105 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SDC1>*>(vec.emplace_back(new InstructionToken<Instruction::SDC1>()));
+                        auto a = emplace_instruction<Instruction::SDC1>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_offset = 0;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SDC1>*>(vec.emplace_back(new InstructionToken<Instruction::SDC1>()));
+                        auto a = emplace_instruction<Instruction::SDC1>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_offset = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_offset >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SDC1>*>(vec.emplace_back(new InstructionToken<Instruction::SDC1>()));
+                        auto c = emplace_instruction<Instruction::SDC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SDC1>*>(vec.emplace_back(new InstructionToken<Instruction::SDC1>()));
+                        auto b = emplace_instruction<Instruction::SDC1>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SDC1>*>(vec.emplace_back(new InstructionToken<Instruction::SDC1>()));
+                        auto c = emplace_instruction<Instruction::SDC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SDC1>*>(vec.emplace_back(new InstructionToken<Instruction::SDC1>()));
+                        auto b = emplace_instruction<Instruction::SDC1>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SDC1>*>(vec.emplace_back(new InstructionToken<Instruction::SDC1>()));
+                        auto c = emplace_instruction<Instruction::SDC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -8225,20 +7450,20 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::S_S> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the s.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the s.s instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -8246,105 +7471,105 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SWC1>*>(vec.emplace_back(new InstructionToken<Instruction::SWC1>()));
+                        auto a = emplace_instruction<Instruction::SWC1>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_offset = 0;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SWC1>*>(vec.emplace_back(new InstructionToken<Instruction::SWC1>()));
+                        auto a = emplace_instruction<Instruction::SWC1>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_offset = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_offset >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SWC1>*>(vec.emplace_back(new InstructionToken<Instruction::SWC1>()));
+                        auto c = emplace_instruction<Instruction::SWC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SWC1>*>(vec.emplace_back(new InstructionToken<Instruction::SWC1>()));
+                        auto b = emplace_instruction<Instruction::SWC1>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SWC1>*>(vec.emplace_back(new InstructionToken<Instruction::SWC1>()));
+                        auto c = emplace_instruction<Instruction::SWC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SWC1>*>(vec.emplace_back(new InstructionToken<Instruction::SWC1>()));
+                        auto b = emplace_instruction<Instruction::SWC1>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SWC1>*>(vec.emplace_back(new InstructionToken<Instruction::SWC1>()));
+                        auto c = emplace_instruction<Instruction::SWC1>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -8353,23 +7578,23 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::SB> : public InstructionTokenBase
+    class InstructionToken<Instruction::SB> : public InstructionTokenOf<Instruction::SB>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SB).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sb instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sb instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -8379,162 +7604,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
-        {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b101000 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::SC> : public InstructionTokenBase
+    class InstructionToken<Instruction::SC> : public InstructionTokenOf<Instruction::SC>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SC).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sc instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sc instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -8544,142 +7758,130 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
-        {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            //before Release 6 the opcode is 0b111000. Starting in release 6 it's 011111
-            instruction |= 0b111000 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
@@ -8687,24 +7889,24 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::SD> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sd instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sd instruction");
             }
             else
             {
                 if (params.m_reg1 == 31)
                 {
-                    throw Error::InvalidInstructionException("?", "Destination register for instruction sd can't be register $ra(GPR 31)");
+                    throw Error::InvalidInstructionException(lines.Where(position), "Destination register for instruction sd can't be register $ra(GPR 31)");
                 }
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -8712,212 +7914,212 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto a = emplace_instruction<Instruction::SW>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_offset = 0;
-                        auto b = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto b = emplace_instruction<Instruction::SW>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1 + 1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_offset = 4;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto b = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                            auto b = emplace_instruction<Instruction::SW>(tokens);
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = params.m_reg2;
                             b->m_parameters.m_offset = params.m_offset;
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = (params.m_immediate + 4) >> 15;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
-                            b->m_parameters.m_reg1 = 1;
-                            b->m_parameters.m_reg2 = 1;
-                            b->m_parameters.m_reg3 = params.m_reg2;
-                            auto b = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
-                            b->m_parameters.m_reg1 = params.m_reg1 + 1;
-                            b->m_parameters.m_reg2 = 1;
-                            b->m_parameters.m_offset = (params.m_immediate + 4) & 0xFFFF;
-                            return vec;
+                            auto c = emplace_instruction<Instruction::ADDU>(tokens);
+                            c->m_parameters.m_reg1 = 1;
+                            c->m_parameters.m_reg2 = 1;
+                            c->m_parameters.m_reg3 = params.m_reg2;
+                            auto d = emplace_instruction<Instruction::SW>(tokens);
+                            d->m_parameters.m_reg1 = params.m_reg1 + 1;
+                            d->m_parameters.m_reg2 = 1;
+                            d->m_parameters.m_offset = (params.m_immediate + 4) & 0xFFFF;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                            auto c = emplace_instruction<Instruction::SW>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto d = emplace_instruction<Instruction::LUI>(tokens);
                             d->m_parameters.m_reg1 = 1;
                             d->m_parameters.m_immediate = (params.m_offset + 4) >> 16;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto e = emplace_instruction<Instruction::ADDU>(tokens);
                             e->m_parameters.m_reg1 = 1;
                             e->m_parameters.m_reg2 = 1;
                             e->m_parameters.m_reg3 = params.m_reg2;
                             e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto f = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                            auto f = emplace_instruction<Instruction::SW>(tokens);
                             f->m_parameters.m_reg1 = params.m_reg1 + 1;
                             f->m_parameters.m_reg2 = 1;
                             f->m_parameters.m_offset = (params.m_offset + 4) & 0xFFFF;
                             f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
 
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto b = emplace_instruction<Instruction::SW>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_immediate = (params.m_immediate + 4) >> 16;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto d = emplace_instruction<Instruction::SW>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1 + 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_offset = (params.m_immediate + 4) & 0xFFFF;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto b = emplace_instruction<Instruction::SW>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_immediate = 4; //don't forget to shift it right later
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto d = emplace_instruction<Instruction::SW>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1 + 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_offset = 4;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label; // don't forget to shift right 16 bits
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto c = emplace_instruction<Instruction::SW>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto d = emplace_instruction<Instruction::LUI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_immediate = 4;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
-                        b->m_parameters.m_reg1 = 1;
-                        b->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_reg3 = params.m_reg2;
-                        b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto e = emplace_instruction<Instruction::ADDU>(tokens);
+                        e->m_parameters.m_reg1 = 1;
+                        e->m_parameters.m_reg2 = 1;
+                        e->m_parameters.m_reg3 = params.m_reg2;
+                        e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
+                        auto f = emplace_instruction<Instruction::SW>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1 + 1;
                         f->m_parameters.m_reg2 = 1;
                         f->m_parameters.m_offset = 4;
                         f->m_parameters.m_label = params.m_label;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto b = emplace_instruction<Instruction::SW>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_immediate = params.m_immediate + 4;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto d = emplace_instruction<Instruction::SW>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1 + 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_offset = params.m_immediate + 4;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto c = emplace_instruction<Instruction::SW>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_offset = params.m_immediate;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto d = emplace_instruction<Instruction::LUI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_immediate = params.m_immediate + 4;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto e = emplace_instruction<Instruction::ADDU>(tokens);
                         e->m_parameters.m_reg1 = 1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg2;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::SW>*>(vec.emplace_back(new InstructionToken<Instruction::SW>()));
+                        auto f = emplace_instruction<Instruction::SW>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1 + 1;
                         f->m_parameters.m_reg2 = 1;
                         f->m_parameters.m_offset = params.m_immediate + 4;
                         f->m_parameters.m_label = params.m_label;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -8926,27 +8128,27 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::SDC1> : public InstructionTokenBase
+    class InstructionToken<Instruction::SDC1> : public InstructionTokenOf<Instruction::SDC1>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SDC1).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sdc1 instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sdc1 instruction");
             }
             else
             {
                 if (params.m_reg1 % 2 != 0)
                 {
-                    throw Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                    throw Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
                 }
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -8954,144 +8156,133 @@ namespace NeoMIPS
                     {
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegOffsetForReg:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label; // don't forget to shift right 16 bits
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_offset = params.m_immediate;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
-        {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b111101 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
@@ -9100,96 +8291,96 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::SEQ> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the seq instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the seq instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                    auto a = emplace_instruction<Instruction::SUBU>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_reg3 = params.m_reg3;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                    auto b = emplace_instruction<Instruction::ORI>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = 1;
                     a->m_parameters.m_immediate = 1;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                    auto c = emplace_instruction<Instruction::SLTU>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_reg2 = params.m_reg1;
                     c->m_parameters.m_reg3 = 1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto b = emplace_instruction<Instruction::SUBU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_reg3 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto c = emplace_instruction<Instruction::ORI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_immediate = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto d = emplace_instruction<Instruction::SLTU>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = params.m_reg1;
                         d->m_parameters.m_reg3 = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto c = emplace_instruction<Instruction::SUBU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto d = emplace_instruction<Instruction::ORI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_immediate = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto e = emplace_instruction<Instruction::SLTU>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = params.m_reg1;
                         e->m_parameters.m_reg3 = 1;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -9202,96 +8393,96 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::SGE> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sge instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sge instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                    auto a = emplace_instruction<Instruction::SLT>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_reg3 = params.m_reg3;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                    auto b = emplace_instruction<Instruction::ORI>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = 1;
                     a->m_parameters.m_immediate = 1;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                    auto c = emplace_instruction<Instruction::SUBU>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_reg2 = 1;
                     c->m_parameters.m_reg3 = params.m_reg1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto b = emplace_instruction<Instruction::SLT>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_reg3 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto c = emplace_instruction<Instruction::ORI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_immediate = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto d = emplace_instruction<Instruction::SUBU>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_reg3 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto c = emplace_instruction<Instruction::SLT>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto d = emplace_instruction<Instruction::ORI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_immediate = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto e = emplace_instruction<Instruction::SUBU>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg1;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -9304,96 +8495,96 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::SGEU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sgeu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sgeu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                    auto a = emplace_instruction<Instruction::SLTU>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg2;
                     a->m_parameters.m_reg3 = params.m_reg3;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                    auto b = emplace_instruction<Instruction::ORI>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_reg2 = 1;
                     a->m_parameters.m_immediate = 1;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                    auto c = emplace_instruction<Instruction::SUBU>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_reg2 = 1;
                     c->m_parameters.m_reg3 = params.m_reg1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto b = emplace_instruction<Instruction::SLTU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_reg3 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto c = emplace_instruction<Instruction::ORI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_immediate = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto d = emplace_instruction<Instruction::SUBU>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_reg3 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto c = emplace_instruction<Instruction::SLTU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto d = emplace_instruction<Instruction::ORI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_immediate = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto e = emplace_instruction<Instruction::SUBU>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg1;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -9406,67 +8597,67 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::SGT> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sgt instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sgt instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                    auto a = emplace_instruction<Instruction::SLT>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg3;
                     a->m_parameters.m_reg3 = params.m_reg2;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
 
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto b = emplace_instruction<Instruction::SLT>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto c = emplace_instruction<Instruction::SLT>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_reg3 = params.m_reg2;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -9480,67 +8671,67 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::SGTU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sgtu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sgtu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                    auto a = emplace_instruction<Instruction::SLT>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg3;
                     a->m_parameters.m_reg3 = params.m_reg2;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
 
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto b = emplace_instruction<Instruction::SLTU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto c = emplace_instruction<Instruction::SLTU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_reg3 = params.m_reg2;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -9551,23 +8742,23 @@ namespace NeoMIPS
 
 
     template<>
-    class InstructionToken<Instruction::SH> : public InstructionTokenBase
+    class InstructionToken<Instruction::SH> : public InstructionTokenOf<Instruction::SH>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SH).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sh instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sh instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -9577,141 +8768,130 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
-        {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b101001 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
@@ -9720,96 +8900,96 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::SLE> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sle instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sle instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                    auto a = emplace_instruction<Instruction::SLT>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg3;
                     a->m_parameters.m_reg3 = params.m_reg2;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                    auto b = emplace_instruction<Instruction::ORI>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 1;
                     b->m_parameters.m_immediate = 1;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                    auto c = emplace_instruction<Instruction::SUBU>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_reg2 = 1;
                     c->m_parameters.m_reg3 = params.m_reg1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto b = emplace_instruction<Instruction::SLT>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto c = emplace_instruction<Instruction::ORI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_immediate = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto d = emplace_instruction<Instruction::SUBU>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_reg3 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLT>*>(vec.emplace_back(new InstructionToken<Instruction::SLT>()));
+                        auto c = emplace_instruction<Instruction::SLT>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_reg3 = params.m_reg2;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto d = emplace_instruction<Instruction::ORI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_immediate = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto e = emplace_instruction<Instruction::SUBU>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg1;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -9823,96 +9003,96 @@ namespace NeoMIPS
     class PseudoinstructionToken<ISA::Pseudoinstruction::SLEU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sleu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sleu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                    auto a = emplace_instruction<Instruction::SLTU>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg3;
                     a->m_parameters.m_reg3 = params.m_reg2;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                    auto b = emplace_instruction<Instruction::ORI>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 1;
                     b->m_parameters.m_immediate = 1;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                    auto c = emplace_instruction<Instruction::SUBU>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_reg2 = 1;
                     c->m_parameters.m_reg3 = params.m_reg1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto b = emplace_instruction<Instruction::SLTU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto c = emplace_instruction<Instruction::ORI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_immediate = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto d = emplace_instruction<Instruction::SUBU>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_reg3 = params.m_reg1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto c = emplace_instruction<Instruction::SLTU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_reg3 = params.m_reg2;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto d = emplace_instruction<Instruction::ORI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = 1;
                         d->m_parameters.m_immediate = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto e = emplace_instruction<Instruction::SUBU>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg1;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -9922,400 +9102,286 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::SLL> : public InstructionTokenBase
+    class InstructionToken<Instruction::SLL> : public InstructionTokenOf<Instruction::SLL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SLL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sll instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sll instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= 0b00000 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= m_parameters.m_immediate << 6;
-            instruction |= 0b000000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SLLV> : public InstructionTokenBase
+    class InstructionToken<Instruction::SLLV> : public InstructionTokenOf<Instruction::SLLV>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SLLV).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sllv instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sllv instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg3 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b000100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SLT> : public InstructionTokenBase
+    class InstructionToken<Instruction::SLT> : public InstructionTokenOf<Instruction::SLT>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SLT).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the slt instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the slt instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b101010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SLTI> : public InstructionTokenBase
+    class InstructionToken<Instruction::SLTI> : public InstructionTokenOf<Instruction::SLTI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SLTI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the slti instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the slti instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b001010 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SLTIU> : public InstructionTokenBase
+    class InstructionToken<Instruction::SLTIU> : public InstructionTokenOf<Instruction::SLTIU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SLTIU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sltiu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sltiu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b001011 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SLTU> : public InstructionTokenBase
+    class InstructionToken<Instruction::SLTU> : public InstructionTokenOf<Instruction::SLTU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SLTU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sltu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sltu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b101011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SQRT_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::SQRT_D> : public InstructionTokenOf<Instruction::SQRT_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SQRT_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sqrt.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sqrt.d instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SQRT_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::SQRT_S> : public InstructionTokenOf<Instruction::SQRT_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SQRT_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sqrt.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sqrt.s instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b010001 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SRL> : public InstructionTokenBase
+    class InstructionToken<Instruction::SRL> : public InstructionTokenOf<Instruction::SRL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SRL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the srl instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the srl instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= 0b00000 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= m_parameters.m_immediate << 6;
-            instruction |= 0b000010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SRLV> : public InstructionTokenBase
+    class InstructionToken<Instruction::SRLV> : public InstructionTokenOf<Instruction::SRLV>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SRLV).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the srlv instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the srlv instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg3 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b000110;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<ISA::Pseudoinstruction::SNE> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sne instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sne instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 switch (params.m_archetype)
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    auto a = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                    auto a = emplace_instruction<Instruction::SUBU>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = params.m_reg3;
                     a->m_parameters.m_reg3 = params.m_reg2;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                    auto b = emplace_instruction<Instruction::SLTU>(tokens);
                     b->m_parameters.m_reg1 = params.m_reg1;
                     b->m_parameters.m_reg2 = 0;
                     b->m_parameters.m_reg3 = params.m_reg1;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
 
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (std::in_range<int16_t>(params.m_immediate))
                     {
-                        auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                        auto a = emplace_instruction<Instruction::ADDI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_reg2 = 0;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto b = emplace_instruction<Instruction::SUBU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_reg3 = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto c = emplace_instruction<Instruction::SLTU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 0;
                         c->m_parameters.m_reg3 = params.m_reg3;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                        auto c = emplace_instruction<Instruction::SUBU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::SLTU>*>(vec.emplace_back(new InstructionToken<Instruction::SLTU>()));
+                        auto d = emplace_instruction<Instruction::SLTU>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = 0;
                         d->m_parameters.m_reg3 = params.m_reg3;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
 
                 }
@@ -10325,80 +9391,56 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::SRA> : public InstructionTokenBase
+    class InstructionToken<Instruction::SRA> : public InstructionTokenOf<Instruction::SRA>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SRA).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sra instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sra instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= 0b00000 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg3 << 11;
-            instruction |= m_parameters.m_immediate << 6;
-            instruction |= 0b000011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SRAV> : public InstructionTokenBase
+    class InstructionToken<Instruction::SRAV> : public InstructionTokenOf<Instruction::SRAV>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SRAV).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the srav instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the srav instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg3 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000 << 6;
-            instruction |= 0b000111;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SUB> : public InstructionTokenBase
+    class InstructionToken<Instruction::SUB> : public InstructionTokenOf<Instruction::SUB>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SUB).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sub instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sub instruction");
             }
             else
             {
@@ -10406,48 +9448,48 @@ namespace NeoMIPS
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                            auto a = emplace_instruction<Instruction::ADDI>(tokens);
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_immediate = params.m_immediate;
-                            auto b = static_cast<InstructionToken<Instruction::SUB>*>(vec.emplace_back(new InstructionToken<Instruction::SUB>()));
+                            auto b = emplace_instruction<Instruction::SUB>(tokens);
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = params.m_reg2;
                             b->m_parameters.m_reg3 = 1;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::SUB>*>(vec.emplace_back(new InstructionToken<Instruction::SUB>()));
+                            auto c = emplace_instruction<Instruction::SUB>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = params.m_reg2;
                             c->m_parameters.m_reg3 = 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                 }
@@ -10455,128 +9497,91 @@ namespace NeoMIPS
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000;
-            instruction |= 0b100010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SUB_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::SUB_D> : public InstructionTokenOf<Instruction::SUB_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
-            auto i = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
-            if (!parse_instruction(instructionStr, i->m_parameters, InstructionSyntacticArchetypes::RegRegReg))
+            auto i = tokens.Emplace<InstructionToken>();
+            if (!parse_instruction(instructionStr, i->m_parameters, ISA::describe(Instruction::SUB_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sub.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sub.d instruction");
             }
             if (i->m_parameters.m_reg1 % 2 != 0 || i->m_parameters.m_reg2 % 2 != 0 || i->m_parameters.m_reg3 % 2 != 0)
             {
-                throw  Error::InvalidInstructionException("?", "64 bit floating point instructions must use even-numbered registers");
+                throw  Error::InvalidInstructionException(lines.Where(position), "64 bit floating point instructions must use even-numbered registers");
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::COP1 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SUB_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::SUB_S> : public InstructionTokenOf<Instruction::SUB_S>
     {
-        InstructionToken() : InstructionTokenBase() {}
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
-            auto i = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
-            if (!parse_instruction(instructionStr, i->m_parameters, InstructionSyntacticArchetypes::RegRegReg))
+            auto i = tokens.Emplace<InstructionToken>();
+            if (!parse_instruction(instructionStr, i->m_parameters, ISA::describe(Instruction::SUB_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sub.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sub.s instruction");
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::COP1 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b000001;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::SUBI> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the subi instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the subi instruction");
             }
             else
             {
                 if (std::in_range<int16_t>(params.m_immediate))
                 {
-                    auto a = static_cast<InstructionToken<Instruction::ADDI>*>(vec.emplace_back(new InstructionToken<Instruction::ADDI>()));
+                    auto a = emplace_instruction<Instruction::ADDI>(tokens);
                     a->m_parameters.m_reg1 = params.m_reg1;
                     a->m_parameters.m_reg2 = 0;
                     a->m_parameters.m_immediate = params.m_immediate;
-                    auto b = static_cast<InstructionToken<Instruction::SUB>*>(vec.emplace_back(new InstructionToken<Instruction::SUB>()));
+                    auto b = emplace_instruction<Instruction::SUB>(tokens);
                     b->m_parameters.m_reg1 = params.m_reg1;
                     b->m_parameters.m_reg2 = params.m_reg2;
                     b->m_parameters.m_reg3 = 1;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
                 else if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
-                    auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                    auto a = emplace_instruction<Instruction::LUI>(tokens);
                     a->m_parameters.m_reg1 = 1;
                     a->m_parameters.m_immediate = params.m_immediate >> 16;
                     a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                    auto b = emplace_instruction<Instruction::ORI>(tokens);
                     b->m_parameters.m_reg1 = 1;
                     b->m_parameters.m_reg2 = 1;
                     b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                     b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    auto c = static_cast<InstructionToken<Instruction::SUB>*>(vec.emplace_back(new InstructionToken<Instruction::SUB>()));
+                    auto c = emplace_instruction<Instruction::SUB>(tokens);
                     c->m_parameters.m_reg1 = params.m_reg1;
                     c->m_parameters.m_reg2 = params.m_reg2;
                     c->m_parameters.m_reg3 = 1;
                     c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                    return vec;
+                    return;
                 }
             }
         }
@@ -10586,51 +9591,51 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::SUBIU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the subiu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the subiu instruction");
             }
             if (keepPseudoinstructions)
             {
-                static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                return;
             }
             else
             {
-                auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                auto a = emplace_instruction<Instruction::LUI>(tokens);
                 a->m_parameters.m_reg1 = 1;
                 a->m_parameters.m_immediate = params.m_immediate >> 16;
                 a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                auto b = emplace_instruction<Instruction::ORI>(tokens);
                 b->m_parameters.m_reg1 = 1;
                 b->m_parameters.m_reg2 = 1;
                 b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                 b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                auto c = static_cast<InstructionToken<Instruction::SUBU>*>(vec.emplace_back(new InstructionToken<Instruction::SUBU>()));
+                auto c = emplace_instruction<Instruction::SUBU>(tokens);
                 c->m_parameters.m_reg1 = params.m_reg1;
                 c->m_parameters.m_reg2 = params.m_reg2;
                 c->m_parameters.m_reg3 = 1;
                 c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                return vec;
+                return;
             }
         }
     };
 
     template<>
-    class InstructionToken<Instruction::SUBU> : public InstructionTokenBase
+    class InstructionToken<Instruction::SUBU> : public InstructionTokenOf<Instruction::SUBU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SUBU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the subu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the subu instruction");
             }
             else
             {
@@ -10638,33 +9643,33 @@ namespace NeoMIPS
                 {
                 case InstructionSyntacticArchetypes::RegRegReg:
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 case InstructionSyntacticArchetypes::RegRegImm:
                 {
                     if (keepPseudoinstructions)
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     else
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                        auto b = emplace_instruction<Instruction::ORI>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SUB>*>(vec.emplace_back(new InstructionToken<Instruction::SUB>()));
+                        auto c = emplace_instruction<Instruction::SUB>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg2;
                         c->m_parameters.m_reg3 = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
 
                     }
                 }
@@ -10672,38 +9677,26 @@ namespace NeoMIPS
                 }
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b00000;
-            instruction |= 0b100011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::SW> : public InstructionTokenBase
+    class InstructionToken<Instruction::SW> : public InstructionTokenOf<Instruction::SW>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SW).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the sw instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the sw instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -10713,162 +9706,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b101011 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::SWC1> : public InstructionTokenBase
+    class InstructionToken<Instruction::SWC1> : public InstructionTokenOf<Instruction::SWC1>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SWC1).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the swc1 instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the swc1 instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -10878,162 +9860,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b111001 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::SWL> : public InstructionTokenBase
+    class InstructionToken<Instruction::SWL> : public InstructionTokenOf<Instruction::SWL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SWL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the swl instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the swl instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -11043,162 +10014,151 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b101010 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::SWR> : public InstructionTokenBase
+    class InstructionToken<Instruction::SWR> : public InstructionTokenOf<Instruction::SWR>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SWR).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the swr instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the swr instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -11208,557 +10168,411 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate)) //real instruction version
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto c = tokens.Emplace<InstructionToken>();
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto a = tokens.Emplace<InstructionToken>();
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = 0;
                             a->m_parameters.m_offset = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                            auto b = tokens.Emplace<InstructionToken>();
                             b->m_parameters.m_reg1 = params.m_reg1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_offset = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto b = tokens.Emplace<InstructionToken>();
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_immediate; //the sum of the address of the label and and imm is done in ResolveLabel and the high 16 bits are extracted there
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()));
+                        auto c = tokens.Emplace<InstructionToken>();
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
-                        b->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
+                        c->m_parameters.m_offset = params.m_immediate; //the sum of the address of the label and and imm is done in Encode and the high 16 bits are extracted there
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
             }
         }
 
-        void ResolveLabel(const std::unordered_map<std::u32string_view, uint32_t>& table, uint32_t currentMemPos) override
+        void ResolveLabel(const std::vector<uint32_t>& addresses, uint32_t /*currentMemPos*/) override
         {
-            m_parameters.m_resolvedLabel = m_parameters.m_label.empty() ? 0 : table.at(m_parameters.m_label);
-        }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            uint32_t address = m_parameters.m_resolvedLabel + m_parameters.m_offset;
-            instruction |= 0b101110 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= address & 0xFFFF;
-            return instruction;
+            m_parameters.m_resolvedLabel = m_parameters.m_label == NO_LABEL ? 0 : addresses[m_parameters.m_label];
         }
     };
 
     template<>
-    class InstructionToken<Instruction::SYSCALL> : public InstructionTokenBase
+    class InstructionToken<Instruction::SYSCALL> : public InstructionTokenOf<Instruction::SYSCALL>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::NoParams))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::SYSCALL).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the syscall instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the syscall instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_immediate << 6;
-            instruction |= 0b001100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TEQ> : public InstructionTokenBase
+    class InstructionToken<Instruction::TEQ> : public InstructionTokenOf<Instruction::TEQ>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TEQ).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the teq instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the teq instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            //there are 10 bits here avaiable for software implementations. To access them, read the instruction from memory
-            instruction |= 0b110100;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TEQI> : public InstructionTokenBase
+    class InstructionToken<Instruction::TEQI> : public InstructionTokenOf<Instruction::TEQI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TEQI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the teqi instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the teqi instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000001 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b01100 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TGE> : public InstructionTokenBase
+    class InstructionToken<Instruction::TGE> : public InstructionTokenOf<Instruction::TGE>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TGE).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tge instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tge instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            //there are 10 bits here avaiable for software implementations. To access them, read the instruction from memory
-            instruction |= 0b110000;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TGEI> : public InstructionTokenBase
+    class InstructionToken<Instruction::TGEI> : public InstructionTokenOf<Instruction::TGEI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TGEI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tgei instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tgei instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000001 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b01000 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TGEIU> : public InstructionTokenBase
+    class InstructionToken<Instruction::TGEIU> : public InstructionTokenOf<Instruction::TGEIU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TGEIU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tgeiu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tgeiu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000001 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b01001 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TGEU> : public InstructionTokenBase
+    class InstructionToken<Instruction::TGEU> : public InstructionTokenOf<Instruction::TGEU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TGEU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tgeu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tgeu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            //there are 10 bits here avaiable for software implementations. To access them, read the instruction from memory
-            instruction |= 0b110001;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TLT> : public InstructionTokenBase
+    class InstructionToken<Instruction::TLT> : public InstructionTokenOf<Instruction::TLT>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TLT).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tlt instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tlt instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            //there are 10 bits here avaiable for software implementations. To access them, read the instruction from memory
-            instruction |= 0b110010;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TLTI> : public InstructionTokenBase
+    class InstructionToken<Instruction::TLTI> : public InstructionTokenOf<Instruction::TLTI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TLTI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tlti instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tlti instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000001 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b01010 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TLTIU> : public InstructionTokenBase
+    class InstructionToken<Instruction::TLTIU> : public InstructionTokenOf<Instruction::TLTIU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TLTIU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tltiu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tltiu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000001 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b01011 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TLTU> : public InstructionTokenBase
+    class InstructionToken<Instruction::TLTU> : public InstructionTokenOf<Instruction::TLTU>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TLTU).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tltu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tltu instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            //there are 10 bits here avaiable for software implementations. To access them, read the instruction from memory
-            instruction |= 0b110011;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TNE> : public InstructionTokenBase
+    class InstructionToken<Instruction::TNE> : public InstructionTokenOf<Instruction::TNE>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TNE).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tne instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tne instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= m_parameters.m_reg2 << 16;
-            //there are 10 bits here avaiable for software implementations. To access them, read the instruction from memory
-            instruction |= 0b110110;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TNEI> : public InstructionTokenBase
+    class InstructionToken<Instruction::TNEI> : public InstructionTokenOf<Instruction::TNEI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TNEI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the tnei instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the tnei instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b000001 << 26;
-            instruction |= m_parameters.m_reg1 << 21;
-            instruction |= 0b01110 << 16;
-            instruction |= m_parameters.m_immediate;
-            return instruction;
-        }
     };
 
     template<>
     class PseudoinstructionToken<Pseudoinstruction::ULH> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ulh instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ulh instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -11768,293 +10582,293 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::LB>*>(vec.emplace_back(new InstructionToken<Instruction::LB>()));
+                            auto c = emplace_instruction<Instruction::LB>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset + 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                            auto d = emplace_instruction<Instruction::LBU>(tokens);
                             d->m_parameters.m_reg1 = 1;
                             d->m_parameters.m_reg2 = params.m_reg2;
                             d->m_parameters.m_offset = params.m_offset;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto e = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                            auto e = emplace_instruction<Instruction::SLL>(tokens);
                             e->m_parameters.m_reg1 = params.m_reg1;
                             e->m_parameters.m_reg2 = params.m_reg1;
                             e->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                             e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto f = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                            auto f = emplace_instruction<Instruction::OR>(tokens);
                             f->m_parameters.m_reg1 = params.m_reg1;
                             f->m_parameters.m_reg2 = params.m_reg1;
                             f->m_parameters.m_reg3 = 1;
                             f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::LB>*>(vec.emplace_back(new InstructionToken<Instruction::LB>()));
+                            auto c = emplace_instruction<Instruction::LB>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = (params.m_offset & 0xFFFF) + 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto d = emplace_instruction<Instruction::LUI>(tokens);
                             d->m_parameters.m_reg1 = 1;
                             d->m_parameters.m_immediate = params.m_offset >> 16;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto e = emplace_instruction<Instruction::ADDU>(tokens);
                             e->m_parameters.m_reg1 = 1;
                             e->m_parameters.m_reg2 = 1;
                             e->m_parameters.m_reg3 = params.m_reg2;
                             e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto f = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                            auto f = emplace_instruction<Instruction::LBU>(tokens);
                             f->m_parameters.m_reg1 = 1;
                             f->m_parameters.m_reg2 = params.m_reg2;
                             f->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto g = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                            auto g = emplace_instruction<Instruction::SLL>(tokens);
                             g->m_parameters.m_reg1 = params.m_reg1;
                             g->m_parameters.m_reg2 = params.m_reg1;
                             g->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                             g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto h = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                            auto h = emplace_instruction<Instruction::OR>(tokens);
                             h->m_parameters.m_reg1 = params.m_reg1;
                             h->m_parameters.m_reg2 = params.m_reg1;
                             h->m_parameters.m_reg3 = 1;
                             h->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LB>*>(vec.emplace_back(new InstructionToken<Instruction::LB>()));
+                        auto a = emplace_instruction<Instruction::LB>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_offset = 1;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto b = emplace_instruction<Instruction::LBU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_offset = 0;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto c = emplace_instruction<Instruction::SLL>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto d = emplace_instruction<Instruction::OR>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = params.m_reg1;
                         d->m_parameters.m_reg3 = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_offset >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LB>*>(vec.emplace_back(new InstructionToken<Instruction::LB>()));
+                        auto b = emplace_instruction<Instruction::LB>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = (params.m_offset & 0xFFFF) + 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_immediate = params.m_offset >> 16;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto d = emplace_instruction<Instruction::LBU>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = params.m_reg2;
                         d->m_parameters.m_offset = params.m_offset & 0xFFFF;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto e = emplace_instruction<Instruction::SLL>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = params.m_reg1;
                         e->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto f = emplace_instruction<Instruction::OR>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1;
                         f->m_parameters.m_reg2 = params.m_reg1;
                         f->m_parameters.m_reg3 = 1;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LB>*>(vec.emplace_back(new InstructionToken<Instruction::LB>()));
+                        auto b = emplace_instruction<Instruction::LB>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_offset = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto d = emplace_instruction<Instruction::LBU>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = params.m_reg2;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto e = emplace_instruction<Instruction::SLL>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = params.m_reg1;
                         e->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto f = emplace_instruction<Instruction::OR>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1;
                         f->m_parameters.m_reg2 = params.m_reg1;
                         f->m_parameters.m_reg3 = 1;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LB>*>(vec.emplace_back(new InstructionToken<Instruction::LB>()));
+                        auto c = emplace_instruction<Instruction::LB>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_offset = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto d = emplace_instruction<Instruction::LUI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto e = emplace_instruction<Instruction::ADDU>(tokens);
                         e->m_parameters.m_reg1 = 1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg2;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto f = emplace_instruction<Instruction::LBU>(tokens);
                         f->m_parameters.m_reg1 = 1;
                         f->m_parameters.m_reg2 = params.m_reg2;
                         f->m_parameters.m_label = params.m_label;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto g = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto g = emplace_instruction<Instruction::SLL>(tokens);
                         g->m_parameters.m_reg1 = params.m_reg1;
                         g->m_parameters.m_reg2 = params.m_reg1;
                         g->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto h = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto h = emplace_instruction<Instruction::OR>(tokens);
                         h->m_parameters.m_reg1 = params.m_reg1;
                         h->m_parameters.m_reg2 = params.m_reg1;
                         h->m_parameters.m_reg3 = 1;
                         h->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LB>*>(vec.emplace_back(new InstructionToken<Instruction::LB>()));
+                        auto b = emplace_instruction<Instruction::LB>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_offset = params.m_immediate + 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_immediate = params.m_immediate;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto d = emplace_instruction<Instruction::LBU>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = params.m_reg2;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_offset = params.m_immediate;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto e = emplace_instruction<Instruction::SLL>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = params.m_reg1;
                         e->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto f = emplace_instruction<Instruction::OR>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1;
                         f->m_parameters.m_reg2 = params.m_reg1;
                         f->m_parameters.m_reg3 = 1;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LB>*>(vec.emplace_back(new InstructionToken<Instruction::LB>()));
+                        auto c = emplace_instruction<Instruction::LB>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_offset = params.m_immediate + 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto d = emplace_instruction<Instruction::LUI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_immediate = params.m_immediate;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto e = emplace_instruction<Instruction::ADDU>(tokens);
                         e->m_parameters.m_reg1 = 1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg2;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto f = emplace_instruction<Instruction::LBU>(tokens);
                         f->m_parameters.m_reg1 = 1;
                         f->m_parameters.m_reg2 = params.m_reg2;
                         f->m_parameters.m_offset = params.m_immediate;
                         f->m_parameters.m_label = params.m_label;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto g = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto g = emplace_instruction<Instruction::SLL>(tokens);
                         g->m_parameters.m_reg1 = params.m_reg1;
                         g->m_parameters.m_reg2 = params.m_reg1;
                         g->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto h = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto h = emplace_instruction<Instruction::OR>(tokens);
                         h->m_parameters.m_reg1 = params.m_reg1;
                         h->m_parameters.m_reg2 = params.m_reg1;
                         h->m_parameters.m_reg3 = 1;
                         h->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -12066,20 +10880,20 @@ namespace NeoMIPS
     class PseudoinstructionToken<Pseudoinstruction::ULHU> : public PseudoinstructionTokenBase
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
             if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegMemReg | InstructionSyntacticArchetypes::RegImm | InstructionSyntacticArchetypes::RegOffsetForReg | InstructionSyntacticArchetypes::RegLabel | InstructionSyntacticArchetypes::RegLabelAsOffsetReg | InstructionSyntacticArchetypes::RegLabelPlusImm | InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the ulhu instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the ulhu instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<PseudoinstructionToken*>(vec.emplace_back(new PseudoinstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<PseudoinstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -12089,293 +10903,293 @@ namespace NeoMIPS
                     {
                         if (std::in_range<int16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                            auto c = emplace_instruction<Instruction::LBU>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = params.m_offset + 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                            auto d = emplace_instruction<Instruction::LBU>(tokens);
                             d->m_parameters.m_reg1 = 1;
                             d->m_parameters.m_reg2 = params.m_reg2;
                             d->m_parameters.m_offset = params.m_offset;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto e = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                            auto e = emplace_instruction<Instruction::SLL>(tokens);
                             e->m_parameters.m_reg1 = params.m_reg1;
                             e->m_parameters.m_reg2 = params.m_reg1;
                             e->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                             e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto f = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                            auto f = emplace_instruction<Instruction::OR>(tokens);
                             f->m_parameters.m_reg1 = params.m_reg1;
                             f->m_parameters.m_reg2 = params.m_reg1;
                             f->m_parameters.m_reg3 = 1;
                             f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_offset >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto b = emplace_instruction<Instruction::ADDU>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_reg3 = params.m_reg2;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                            auto c = emplace_instruction<Instruction::LBU>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = 1;
                             c->m_parameters.m_offset = (params.m_offset & 0xFFFF) + 1;
                             c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto d = emplace_instruction<Instruction::LUI>(tokens);
                             d->m_parameters.m_reg1 = 1;
                             d->m_parameters.m_immediate = params.m_offset >> 16;
                             d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                            auto e = emplace_instruction<Instruction::ADDU>(tokens);
                             e->m_parameters.m_reg1 = 1;
                             e->m_parameters.m_reg2 = 1;
                             e->m_parameters.m_reg3 = params.m_reg2;
                             e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto f = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                            auto f = emplace_instruction<Instruction::LBU>(tokens);
                             f->m_parameters.m_reg1 = 1;
                             f->m_parameters.m_reg2 = params.m_reg2;
                             f->m_parameters.m_offset = params.m_offset & 0xFFFF;
                             f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto g = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                            auto g = emplace_instruction<Instruction::SLL>(tokens);
                             g->m_parameters.m_reg1 = params.m_reg1;
                             g->m_parameters.m_reg2 = params.m_reg1;
                             g->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                             g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto h = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                            auto h = emplace_instruction<Instruction::OR>(tokens);
                             h->m_parameters.m_reg1 = params.m_reg1;
                             h->m_parameters.m_reg2 = params.m_reg1;
                             h->m_parameters.m_reg3 = 1;
                             h->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            return vec;
+                            return;
                         }
                     }
                     case  InstructionSyntacticArchetypes::RegMemReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto a = emplace_instruction<Instruction::LBU>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg2;
                         a->m_parameters.m_offset = 1;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto b = emplace_instruction<Instruction::LBU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = params.m_reg2;
                         b->m_parameters.m_offset = 0;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto c = emplace_instruction<Instruction::SLL>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = params.m_reg1;
                         c->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto d = emplace_instruction<Instruction::OR>(tokens);
                         d->m_parameters.m_reg1 = params.m_reg1;
                         d->m_parameters.m_reg2 = params.m_reg1;
                         d->m_parameters.m_reg3 = 1;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_immediate = params.m_offset >> 16;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto b = emplace_instruction<Instruction::LBU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_offset = (params.m_offset & 0xFFFF) + 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_immediate = params.m_offset >> 16;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto d = emplace_instruction<Instruction::LBU>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = params.m_reg2;
                         d->m_parameters.m_offset = params.m_offset & 0xFFFF;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto e = emplace_instruction<Instruction::SLL>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = params.m_reg1;
                         e->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto f = emplace_instruction<Instruction::OR>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1;
                         f->m_parameters.m_reg2 = params.m_reg1;
                         f->m_parameters.m_reg3 = 1;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabel:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto b = emplace_instruction<Instruction::LBU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_offset = 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto d = emplace_instruction<Instruction::LBU>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = params.m_reg2;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto e = emplace_instruction<Instruction::SLL>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = params.m_reg1;
                         e->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto f = emplace_instruction<Instruction::OR>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1;
                         f->m_parameters.m_reg2 = params.m_reg1;
                         f->m_parameters.m_reg3 = 1;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelAsOffsetReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto c = emplace_instruction<Instruction::LBU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_offset = 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto d = emplace_instruction<Instruction::LUI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto e = emplace_instruction<Instruction::ADDU>(tokens);
                         e->m_parameters.m_reg1 = 1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg2;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto f = emplace_instruction<Instruction::LBU>(tokens);
                         f->m_parameters.m_reg1 = 1;
                         f->m_parameters.m_reg2 = params.m_reg2;
                         f->m_parameters.m_label = params.m_label;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto g = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto g = emplace_instruction<Instruction::SLL>(tokens);
                         g->m_parameters.m_reg1 = params.m_reg1;
                         g->m_parameters.m_reg2 = params.m_reg1;
                         g->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto h = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto h = emplace_instruction<Instruction::OR>(tokens);
                         h->m_parameters.m_reg1 = params.m_reg1;
                         h->m_parameters.m_reg2 = params.m_reg1;
                         h->m_parameters.m_reg3 = 1;
                         h->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto b = emplace_instruction<Instruction::LBU>(tokens);
                         b->m_parameters.m_reg1 = params.m_reg1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_label = params.m_label;
                         b->m_parameters.m_offset = params.m_immediate + 1;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto c = emplace_instruction<Instruction::LUI>(tokens);
                         c->m_parameters.m_reg1 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_immediate = params.m_immediate;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto d = emplace_instruction<Instruction::LBU>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_reg2 = params.m_reg2;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_offset = params.m_immediate;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto e = emplace_instruction<Instruction::SLL>(tokens);
                         e->m_parameters.m_reg1 = params.m_reg1;
                         e->m_parameters.m_reg2 = params.m_reg1;
                         e->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto f = emplace_instruction<Instruction::OR>(tokens);
                         f->m_parameters.m_reg1 = params.m_reg1;
                         f->m_parameters.m_reg2 = params.m_reg1;
                         f->m_parameters.m_reg3 = 1;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegLabelPlusImmOffsetForReg:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto a = emplace_instruction<Instruction::LUI>(tokens);
                         a->m_parameters.m_reg1 = 1;
                         a->m_parameters.m_label = params.m_label;
                         a->m_parameters.m_immediate = params.m_immediate;
                         a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto b = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto b = emplace_instruction<Instruction::ADDU>(tokens);
                         b->m_parameters.m_reg1 = 1;
                         b->m_parameters.m_reg2 = 1;
                         b->m_parameters.m_reg3 = params.m_reg2;
                         b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto c = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto c = emplace_instruction<Instruction::LBU>(tokens);
                         c->m_parameters.m_reg1 = params.m_reg1;
                         c->m_parameters.m_reg2 = 1;
                         c->m_parameters.m_label = params.m_label;
                         c->m_parameters.m_offset = params.m_immediate + 1;
                         c->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto d = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                        auto d = emplace_instruction<Instruction::LUI>(tokens);
                         d->m_parameters.m_reg1 = 1;
                         d->m_parameters.m_label = params.m_label;
                         d->m_parameters.m_immediate = params.m_immediate;
                         d->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto e = static_cast<InstructionToken<Instruction::ADDU>*>(vec.emplace_back(new InstructionToken<Instruction::ADDU>()));
+                        auto e = emplace_instruction<Instruction::ADDU>(tokens);
                         e->m_parameters.m_reg1 = 1;
                         e->m_parameters.m_reg2 = 1;
                         e->m_parameters.m_reg3 = params.m_reg2;
                         e->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto f = static_cast<InstructionToken<Instruction::LBU>*>(vec.emplace_back(new InstructionToken<Instruction::LBU>()));
+                        auto f = emplace_instruction<Instruction::LBU>(tokens);
                         f->m_parameters.m_reg1 = 1;
                         f->m_parameters.m_reg2 = params.m_reg2;
                         f->m_parameters.m_offset = params.m_immediate;
                         f->m_parameters.m_label = params.m_label;
                         f->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto g = static_cast<InstructionToken<Instruction::SLL>*>(vec.emplace_back(new InstructionToken<Instruction::SLL>()));
+                        auto g = emplace_instruction<Instruction::SLL>(tokens);
                         g->m_parameters.m_reg1 = params.m_reg1;
                         g->m_parameters.m_reg2 = params.m_reg1;
                         g->m_parameters.m_immediate = 8; //the 8 here refers to the 8 bits of each byte
                         g->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        auto h = static_cast<InstructionToken<Instruction::OR>*>(vec.emplace_back(new InstructionToken<Instruction::OR>()));
+                        auto h = emplace_instruction<Instruction::OR>(tokens);
                         h->m_parameters.m_reg1 = params.m_reg1;
                         h->m_parameters.m_reg2 = params.m_reg1;
                         h->m_parameters.m_reg3 = 1;
                         h->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                        return vec;
+                        return;
                     }
                     }
                 }
@@ -12384,152 +11198,117 @@ namespace NeoMIPS
     };
 
     template<>
-    class InstructionToken<Instruction::TRUNC_W_D> : public InstructionTokenBase
+    class InstructionToken<Instruction::TRUNC_W_D> : public InstructionTokenOf<Instruction::TRUNC_W_D>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TRUNC_W_D).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the trunc.w.d instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the trunc.w.d instruction");
             }
             else
             {
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::COP1 << 26;
-            instruction |= fmt::D << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001101;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::TRUNC_W_S> : public InstructionTokenBase
+    class InstructionToken<Instruction::TRUNC_W_S> : public InstructionTokenOf<Instruction::TRUNC_W_S>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegReg))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::TRUNC_W_S).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the trunc.w.s instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the trunc.w.s instruction");
             }
             else
             {
 
-                static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                return vec;
+                tokens.Emplace<InstructionToken>()->m_parameters = params;
+                return;
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::COP1 << 26;
-            instruction |= fmt::S << 21;
-            instruction |= 0b00000 << 16;
-            instruction |= m_parameters.m_reg2 << 11;
-            instruction |= m_parameters.m_reg1 << 6;
-            instruction |= 0b001101;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::XOR> : public InstructionTokenBase
+    class InstructionToken<Instruction::XOR> : public InstructionTokenOf<Instruction::XOR>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegReg | InstructionSyntacticArchetypes::RegRegImm | InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::XOR).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the xor instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the xor instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
                     if (!std::in_range<uint16_t>(params.m_immediate))
                     {
-                        throw Error::InvalidInstructionException("?", "immediate for or instruction must be in the unsigned 16 bit int range");
+                        throw Error::InvalidInstructionException(lines.Where(position), "immediate for or instruction must be in the unsigned 16 bit int range");
                     }
                     switch (params.m_archetype)
                     {
                     case InstructionSyntacticArchetypes::RegRegReg:
                     {
-                        static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                        return vec;
+                        tokens.Emplace<InstructionToken>()->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegRegImm:
                     {
-                        static_cast<InstructionToken<Instruction::XORI>*>(vec.emplace_back(new InstructionToken<Instruction::XORI>()))->m_parameters = params;
-                        return vec;
+                        emplace_instruction<Instruction::XORI>(tokens)->m_parameters = params;
+                        return;
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
-                        auto a = static_cast<InstructionToken<Instruction::XORI>*>(vec.emplace_back(new InstructionToken<Instruction::XORI>()));
+                        auto a = emplace_instruction<Instruction::XORI>(tokens);
                         a->m_parameters.m_reg1 = params.m_reg1;
                         a->m_parameters.m_reg2 = params.m_reg1;
                         a->m_parameters.m_immediate = params.m_immediate;
-                        return vec;
+                        return;
                     }
                     }
                 }
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= cop::SPECIAL << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg3 << 16;
-            instruction |= m_parameters.m_reg1 << 11;
-            instruction |= 0b100110;
-            return instruction;
-        }
     };
 
     template<>
-    class InstructionToken<Instruction::XORI> : public InstructionTokenBase
+    class InstructionToken<Instruction::XORI> : public InstructionTokenOf<Instruction::XORI>
     {
     public:
-        static std::vector<TokenBase*> Parse(const std::u32string_view& instructionStr, bool keepPseudoinstructions = false)
+        template<Char C>
+        static void Parse(const std::basic_string_view<C>& instructionStr, uint32_t position, const LineIndex& lines, TokenArena& tokens, bool keepPseudoinstructions = false)
         {
-            std::vector<TokenBase*> vec;
             InstructionParameters params{};
-            if (!parse_instruction(instructionStr, params, InstructionSyntacticArchetypes::RegRegImm | InstructionSyntacticArchetypes::RegImm))
+            if (!parse_instruction(instructionStr, params, ISA::describe(Instruction::XORI).m_archetypes))
             {
-                throw Error::InvalidSyntaxException("?", "Invalid syntax for the xori instruction");
+                throw Error::InvalidSyntaxException(lines.Where(position), "Invalid syntax for the xori instruction");
             }
             else
             {
                 if (keepPseudoinstructions)
                 {
-                    static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                    return vec;
+                    tokens.Emplace<InstructionToken>()->m_parameters = params;
+                    return;
                 }
                 else
                 {
@@ -12539,53 +11318,53 @@ namespace NeoMIPS
                     {
                         if (std::in_range<uint16_t>(params.m_immediate))
                         {
-                            static_cast<InstructionToken*>(vec.emplace_back(new InstructionToken()))->m_parameters = params;
-                            return vec;
+                            tokens.Emplace<InstructionToken>()->m_parameters = params;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::XOR>*>(vec.emplace_back(new InstructionToken<Instruction::XOR>()));
+                            auto c = emplace_instruction<Instruction::XOR>(tokens);
                             c->m_parameters.m_reg1 = params.m_reg1;
                             c->m_parameters.m_reg2 = params.m_reg2;
                             c->m_parameters.m_reg3 = 1;
-                            return vec;
+                            return;
                         }
                     }
                     case InstructionSyntacticArchetypes::RegImm:
                     {
                         if (std::in_range<uint16_t>(params.m_immediate))
                         {
-                            auto a = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto a = emplace_instruction<Instruction::ORI>(tokens);
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = params.m_reg1;
                             a->m_parameters.m_immediate = params.m_immediate;
-                            return vec;
+                            return;
                         }
                         else
                         {
-                            auto a = static_cast<InstructionToken<Instruction::LUI>*>(vec.emplace_back(new InstructionToken<Instruction::LUI>()));
+                            auto a = emplace_instruction<Instruction::LUI>(tokens);
                             a->m_parameters.m_reg1 = 1;
                             a->m_parameters.m_immediate = params.m_immediate >> 16;
                             a->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto b = static_cast<InstructionToken<Instruction::ORI>*>(vec.emplace_back(new InstructionToken<Instruction::ORI>()));
+                            auto b = emplace_instruction<Instruction::ORI>(tokens);
                             b->m_parameters.m_reg1 = 1;
                             b->m_parameters.m_reg2 = 1;
                             b->m_parameters.m_immediate = params.m_immediate & 0xFFFF;
                             b->m_parameters.m_archetype = InstructionSyntacticArchetypes::CompilerGenerated;
-                            auto c = static_cast<InstructionToken<Instruction::XOR>*>(vec.emplace_back(new InstructionToken<Instruction::XOR>()));
+                            auto c = emplace_instruction<Instruction::XOR>(tokens);
                             a->m_parameters.m_reg1 = params.m_reg1;
                             a->m_parameters.m_reg2 = params.m_reg1;
                             c->m_parameters.m_reg3 = 1;
-                            return vec;
+                            return;
                         }
                     }
                     }
@@ -12593,16 +11372,6 @@ namespace NeoMIPS
 
             }
         }
-
-        uint32_t Encode() override
-        {
-            uint32_t instruction{ 0U };
-            instruction |= 0b001110 << 26;
-            instruction |= m_parameters.m_reg2 << 21;
-            instruction |= m_parameters.m_reg1 << 16;
-            instruction |= m_parameters.m_immediate & 0xFFFF;
-            return instruction;
-        }
     };
 
 }
@@ -0,0 +1,60 @@
+#include "tokenarena.hpp"
+
+namespace NeoMIPS
+{
+    TokenArena::TokenArena(TokenArena&& other) noexcept : m_blocks(std::move(other.m_blocks)), m_cursor(other.m_cursor), m_end(other.m_end),
+        m_tokens(std::move(other.m_tokens)), m_allocations(other.m_allocations)
+    {
+        other.m_blocks.clear();
+        other.m_tokens.clear();
+        other.m_cursor = other.m_end = nullptr;
+        other.m_allocations = 0;
+    }
+
+    TokenArena& TokenArena::operator=(TokenArena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            m_blocks = std::move(other.m_blocks);
+            m_tokens = std::move(other.m_tokens);
+            m_cursor = other.m_cursor;
+            m_end = other.m_end;
+            m_allocations = other.m_allocations;
+            other.m_blocks.clear();
+            other.m_tokens.clear();
+            other.m_cursor = other.m_end = nullptr;
+            other.m_allocations = 0;
+        }
+        return *this;
+    }
+
+    void* TokenArena::Allocate(size_t size, size_t alignment)
+    {
+        uintptr_t cursor = reinterpret_cast<uintptr_t>(m_cursor);
+        uintptr_t aligned = (cursor + alignment - 1) & ~(alignment - 1);
+        if (m_cursor == nullptr || aligned + size > reinterpret_cast<uintptr_t>(m_end))
+        {
+            //blocks come from new[], aligned for any token
+            m_blocks.emplace_back(new std::byte[BLOCK_SIZE]);
+            ++m_allocations;
+            m_cursor = m_blocks.back().get();
+            m_end = m_cursor + BLOCK_SIZE;
+            aligned = reinterpret_cast<uintptr_t>(m_cursor);
+        }
+        m_cursor = reinterpret_cast<std::byte*>(aligned + size);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void TokenArena::Release()
+    {
+        //every token is destroyed in place, the memory goes back with the blocks
+        for (TokenBase* token : m_tokens)
+        {
+            token->~TokenBase();
+        }
+        m_tokens.clear();
+        m_blocks.clear();
+        m_cursor = m_end = nullptr;
+    }
+}
\ No newline at end of file
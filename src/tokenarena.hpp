@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "tokenbase.hpp"
+
+namespace NeoMIPS
+{
+    //Owns the tokens lexed from one source. Tokens are constructed one after the other inside big blocks
+    //instead of being allocated one by one, and they are all destroyed and the blocks freed at once when the
+    //arena goes away. It is also the list of tokens, in the order they were created
+    class TokenArena
+    {
+    private:
+        //Holds about a thousand instruction tokens
+        static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+        std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+        std::byte* m_cursor;
+        std::byte* m_end;
+        std::vector<TokenBase*> m_tokens;
+        uint64_t m_allocations; //blocks plus reallocations of m_tokens, for --stats
+
+        void* Allocate(size_t size, size_t alignment);
+        void Release();
+
+    public:
+        TokenArena() : m_cursor(nullptr), m_end(nullptr), m_allocations(0) {};
+        TokenArena(TokenArena&& other) noexcept;
+        TokenArena& operator=(TokenArena&& other) noexcept;
+        TokenArena(const TokenArena&) = delete;
+        TokenArena& operator=(const TokenArena&) = delete;
+        ~TokenArena() { Release(); }
+
+        template<typename T, typename... Args>
+        T* Emplace(Args&&... args)
+        {
+            static_assert(sizeof(T) <= BLOCK_SIZE, "Tokens must fit in a block");
+            T* token = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if (m_tokens.size() == m_tokens.capacity()) ++m_allocations;
+            m_tokens.push_back(token);
+            return token;
+        }
+
+        void Reserve(size_t tokens)
+        {
+            if (tokens > m_tokens.capacity()) ++m_allocations;
+            m_tokens.reserve(tokens);
+        }
+
+        size_t Size() const { return m_tokens.size(); }
+        bool Empty() const { return m_tokens.empty(); }
+        TokenBase* operator[](size_t index) const { return m_tokens[index]; }
+        std::vector<TokenBase*>::const_iterator begin() const { return m_tokens.begin(); }
+        std::vector<TokenBase*>::const_iterator end() const { return m_tokens.end(); }
+
+        uint64_t Allocations() const { return m_allocations; }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include "tokenstream.hpp"
+
+namespace NeoMIPS
+{
+    enum class TokenType
+    {
+        Directive,
+        Instruction,
+        Pseudoinstruction,
+        Tag
+    };
+
+    class TokenBase
+    {
+    public:
+        uint32_t m_position = 0; //offset of the statement in the source, LineIndex turns it into a line and column
+        virtual ~TokenBase() = default;
+        virtual TokenType GetTokenType() = 0;
+        //Writes the contents of the token for the token cache. Tokens that can't be cached return false
+        virtual bool Serialize(TokenWriter& /*out*/) const { return false; }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include "tokencache.hpp"
+#include "includecache.hpp"
+#include "filereader.hpp"
+#include "util.hpp"
+#include "error.hpp"
+
+#ifndef NEOMIPS_VERSION
+#define NEOMIPS_VERSION "unknown"
+#endif
+
+namespace NeoMIPS
+{
+    namespace
+    {
+        constexpr uint32_t MAGIC = 0x43544D4E; //"NMTC"
+        //Bump whenever the layout of a token or of the file changes
+        constexpr uint32_t FORMAT = 5;
+
+        uint64_t hash_file(const std::string& path)
+        {
+            MappedFile file(path);
+            return hash_bytes(file.View().data(), file.Size());
+        }
+
+        template<ISA::Instruction I>
+        InstructionTokenBase* make_instruction_token(TokenArena& tokens)
+        {
+            //instructions the lexer can't produce have no token of their own
+            if constexpr (std::is_abstract_v<InstructionToken<I>>) return nullptr;
+            else return tokens.Emplace<InstructionToken<I>>();
+        }
+
+        template<size_t... Is>
+        constexpr auto make_instruction_factories(std::index_sequence<Is...>)
+        {
+            return std::array<InstructionTokenBase* (*)(TokenArena&), sizeof...(Is)>{ &make_instruction_token<static_cast<ISA::Instruction>(Is)>... };
+        }
+
+        constexpr auto INSTRUCTION_FACTORIES = make_instruction_factories(std::make_index_sequence<static_cast<size_t>(ISA::Instruction::invalid)>());
+
+        TokenBase* read_directive(Directive directive, TokenReader& in, TokenArena& tokens)
+        {
+            switch (directive)
+            {
+            case Directive::ALIGN: return DirectiveToken<Directive::ALIGN>::Deserialize(in, tokens);
+            case Directive::ASCII: return DirectiveToken<Directive::ASCII>::Deserialize(in, tokens);
+            case Directive::ASCIIZ: return DirectiveToken<Directive::ASCIIZ>::Deserialize(in, tokens);
+            case Directive::BYTE: return DirectiveToken<Directive::BYTE>::Deserialize(in, tokens);
+            case Directive::DATA: return DirectiveToken<Directive::DATA>::Deserialize(in, tokens);
+            case Directive::DOUBLE: return DirectiveToken<Directive::DOUBLE>::Deserialize(in, tokens);
+            case Directive::FLOAT: return DirectiveToken<Directive::FLOAT>::Deserialize(in, tokens);
+            case Directive::GLOBL: return DirectiveToken<Directive::GLOBL>::Deserialize(in, tokens);
+            case Directive::HALF: return DirectiveToken<Directive::HALF>::Deserialize(in, tokens);
+            case Directive::KDATA: return DirectiveToken<Directive::KDATA>::Deserialize(in, tokens);
+            case Directive::KTEXT: return DirectiveToken<Directive::KTEXT>::Deserialize(in, tokens);
+            case Directive::SPACE: return DirectiveToken<Directive::SPACE>::Deserialize(in, tokens);
+            case Directive::TEXT: return DirectiveToken<Directive::TEXT>::Deserialize(in, tokens);
+            case Directive::WORD: return DirectiveToken<Directive::WORD>::Deserialize(in, tokens);
+            default: return nullptr;
+            }
+        }
+
+        TokenBase* read_instruction(TokenReader& in, TokenArena& tokens)
+        {
+            size_t instruction = static_cast<size_t>(in.Read<Instruction>());
+            if (instruction >= INSTRUCTION_FACTORIES.size()) return nullptr;
+            InstructionTokenBase* token = INSTRUCTION_FACTORIES[instruction](tokens);
+            if (token != nullptr) token->DeserializeParameters(in);
+            return token;
+        }
+
+        //Recreates the next token at the end of tokens, returns nullptr if it is not valid
+        TokenBase* read_token(TokenReader& in, TokenArena& tokens)
+        {
+            TokenType type = in.Read<TokenType>();
+            uint32_t position = in.Read<uint32_t>();
+            TokenBase* token = nullptr;
+            switch (type)
+            {
+            case TokenType::Directive:
+                token = read_directive(in.Read<Directive>(), in, tokens);
+                break;
+            case TokenType::Instruction:
+                token = read_instruction(in, tokens);
+                break;
+            case TokenType::Tag:
+                token = TagToken::Deserialize(in, tokens);
+                break;
+            default:
+                break;
+            }
+            if (token != nullptr) token->m_position = position;
+            return token;
+        }
+    }
+
+    template<Char C>
+    std::filesystem::path TokenCache<C>::EntryPath(const std::string& canonicalSource) const
+    {
+        std::ostringstream name;
+        name << std::hex << hash_bytes(canonicalSource.data(), canonicalSource.size()) << ".utf" << sizeof(C) * 8 << ".nmtc";
+        return m_directory / name.str();
+    }
+
+    template<Char C>
+    bool TokenCache<C>::Load(const std::string& sourcePath, Entry& entry) const
+    {
+        std::ifstream file(EntryPath(canonical_path(sourcePath)), std::ios::binary);
+        if (!file.good()) return false;
+        std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        TokenReader in(buffer);
+        if (in.Read<uint32_t>() != MAGIC || in.Read<uint32_t>() != FORMAT || in.ReadString<char>() != NEOMIPS_VERSION || in.Read<uint8_t>() != sizeof(C))
+        {
+            return false;
+        }
+
+        uint32_t dependencies = in.Read<uint32_t>();
+        for (uint32_t i = 0; i < dependencies && in.Good(); ++i)
+        {
+            std::string path = in.ReadString<char>();
+            uint64_t hash = in.Read<uint64_t>();
+            try
+            {
+                if (hash_file(path) != hash) return false;
+            }
+            catch (const Error::NeoMIPSException&)
+            {
+                return false;
+            }
+        }
+
+        Entry loaded;
+        loaded.m_source = in.ReadString<C>();
+        //the first file is the source, named as it was given this time
+        std::vector<std::string> files;
+        uint32_t fileCount = in.Read<uint32_t>();
+        for (uint32_t i = 0; i < fileCount && in.Good(); ++i) files.push_back(in.ReadString<char>());
+        if (!in.Good() || files.empty()) return false;
+        files[0] = sourcePath;
+        std::vector<LineOrigin> runs;
+        uint32_t runCount = in.Read<uint32_t>();
+        for (uint32_t i = 0; i < runCount && in.Good(); ++i) runs.push_back(LineOrigin{ in.Read<uint32_t>(), in.Read<uint32_t>(), in.Read<uint32_t>() });
+        uint32_t lines = in.Read<uint32_t>();
+        if (!in.Good() || std::any_of(runs.begin(), runs.end(), [&](const LineOrigin& run) { return run.m_file >= files.size(); })) return false;
+        loaded.m_lines = LineMap(std::move(files), std::move(runs), lines);
+
+        uint32_t count = in.Read<uint32_t>();
+        loaded.m_tokens.Reserve(count);
+        for (uint32_t i = 0; i < count && in.Good(); ++i)
+        {
+            if (read_token(in, loaded.m_tokens) == nullptr) break;
+        }
+
+        if (!in.Good() || !in.AtEnd() || loaded.m_tokens.Size() != count)
+        {
+            return false;
+        }
+        entry = std::move(loaded);
+        return true;
+    }
+
+    template<Char C>
+    bool TokenCache<C>::Store(const std::string& sourcePath, const std::vector<std::string>& dependencies, std::basic_string_view<C> source, const LineMap& lines, const TokenArena& tokens) const
+    {
+        TokenWriter out;
+        out.Write(MAGIC);
+        out.Write(FORMAT);
+        out.WriteString(std::string_view(NEOMIPS_VERSION));
+        out.Write(static_cast<uint8_t>(sizeof(C)));
+
+        std::string canonicalSource = canonical_path(sourcePath);
+        out.Write(static_cast<uint32_t>(dependencies.size() + 1));
+        out.WriteString(std::string_view(canonicalSource));
+        out.Write(hash_file(canonicalSource));
+        for (const std::string& dependency : dependencies)
+        {
+            out.WriteString(std::string_view(dependency));
+            out.Write(hash_file(dependency));
+        }
+
+        out.WriteString(source);
+        out.Write(static_cast<uint32_t>(lines.Files().size()));
+        for (const std::string& path : lines.Files()) out.WriteString(std::string_view(path));
+        out.Write(static_cast<uint32_t>(lines.Runs().size()));
+        for (const LineOrigin& run : lines.Runs())
+        {
+            out.Write(run.m_line);
+            out.Write(run.m_file);
+            out.Write(run.m_sourceLine);
+        }
+        out.Write(lines.LineCount());
+        out.Write(static_cast<uint32_t>(tokens.Size()));
+        for (TokenBase* token : tokens)
+        {
+            out.Write(token->GetTokenType());
+            out.Write(token->m_position);
+            if (token->GetTokenType() == TokenType::Directive) out.Write(static_cast<DirectiveTokenBase*>(token)->GetDirective());
+            if (!token->Serialize(out)) return false;
+        }
+
+        //write to a temporary file and rename it, so a concurrent run never sees half an entry
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+        std::filesystem::path path = EntryPath(canonicalSource);
+        std::filesystem::path temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.write(out.Buffer().data(), out.Buffer().size())) return false;
+        }
+        std::filesystem::rename(temporary, path, error);
+        return !error;
+    }
+
+    template class TokenCache<char8_t>;
+    template class TokenCache<char32_t>;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "constraints.hpp"
+#include "token.hpp"
+
+namespace NeoMIPS
+{
+    //On-disk cache of preprocessed and tokenized sources, enabled with --cache-dir. There is one entry per
+    //source file and encoding. An entry is only used if it was written by the same NeoMIPS version and token
+    //format, and the source and every file it included still hash the same as when it was written
+    template<Char C>
+    class TokenCache
+    {
+    private:
+        std::filesystem::path m_directory;
+
+        std::filesystem::path EntryPath(const std::string& canonicalSource) const;
+
+    public:
+        struct Entry
+        {
+            std::basic_string<C> m_source; //preprocessed text the tokens were lexed from
+            LineMap m_lines; //of the source back to the files it was preprocessed from
+            TokenArena m_tokens;
+        };
+
+        explicit TokenCache(const std::string& directory) : m_directory(directory) {};
+
+        //Returns false if there is no valid entry for the source
+        bool Load(const std::string& sourcePath, Entry& entry) const;
+
+        //Returns false if some token can't be cached, nothing is written then
+        bool Store(const std::string& sourcePath, const std::vector<std::string>& dependencies, std::basic_string_view<C> source, const LineMap& lines, const TokenArena& tokens) const;
+    };
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace NeoMIPS
+{
+    //Flat binary encoding of tokens for the token cache. Values are stored in host byte order, the cache is
+    //only ever read back by the same build on the same machine
+    class TokenWriter
+    {
+    private:
+        std::string m_buffer;
+
+    public:
+        template<typename T>
+        void Write(T value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename C>
+        void WriteString(std::basic_string_view<C> str)
+        {
+            Write(static_cast<uint32_t>(str.size()));
+            m_buffer.append(reinterpret_cast<const char*>(str.data()), str.size() * sizeof(C));
+        }
+
+        const std::string& Buffer() const { return m_buffer; }
+    };
+
+    class TokenReader
+    {
+    private:
+        const char* m_data;
+        const char* m_end;
+        bool m_good;
+
+    public:
+        TokenReader(std::string_view buffer) : m_data(buffer.data()), m_end(buffer.data() + buffer.size()), m_good(true) {};
+
+        //Reading past the end yields zeroes and clears Good(), so a truncated file is noticed once at the end
+        template<typename T>
+        T Read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value{};
+            if (m_end - m_data < static_cast<ptrdiff_t>(sizeof(T)))
+            {
+                m_good = false;
+                m_data = m_end;
+                return value;
+            }
+            std::memcpy(&value, m_data, sizeof(T));
+            m_data += sizeof(T);
+            return value;
+        }
+
+        template<typename C>
+        std::basic_string<C> ReadString()
+        {
+            uint32_t size = Read<uint32_t>();
+            if (static_cast<size_t>(m_end - m_data) / sizeof(C) < size)
+            {
+                m_good = false;
+                m_data = m_end;
+                return {};
+            }
+            std::basic_string<C> str(size, C{});
+            std::memcpy(str.data(), m_data, size * sizeof(C));
+            m_data += size * sizeof(C);
+            return str;
+        }
+
+        bool Good() const { return m_good; }
+        bool AtEnd() const { return m_data == m_end; }
+    };
+}
@@ -4,6 +4,7 @@
 #include <unordered_map>
 #include <memory>
 #include "option.hpp"
+#include "constraints.hpp"
 
 namespace NeoMIPS
 {
@@ -17,6 +18,12 @@ namespace NeoMIPS
 		utf32
 	};
 
+	enum class OutputFormat
+	{
+		binary,
+		elf
+	};
+
 	enum class IntBase
 	{
 		decimal,
@@ -47,14 +54,15 @@ namespace NeoMIPS
         CompilerGenerated = 1 << 30
 	};
 
-	inline InstructionSyntacticArchetypes operator| (InstructionSyntacticArchetypes a, InstructionSyntacticArchetypes b) { return static_cast<InstructionSyntacticArchetypes>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b)); }
-	inline InstructionSyntacticArchetypes operator& (InstructionSyntacticArchetypes a, InstructionSyntacticArchetypes b) { return static_cast<InstructionSyntacticArchetypes>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b)); }
+	constexpr InstructionSyntacticArchetypes operator| (InstructionSyntacticArchetypes a, InstructionSyntacticArchetypes b) { return static_cast<InstructionSyntacticArchetypes>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b)); }
+	constexpr InstructionSyntacticArchetypes operator& (InstructionSyntacticArchetypes a, InstructionSyntacticArchetypes b) { return static_cast<InstructionSyntacticArchetypes>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b)); }
 	
-	struct MacroDeclaration
+	template<Char C>
+	struct BasicMacroDeclaration
 	{
-		std::u32string m_name;
-		std::vector<std::u32string> m_params;
-		std::u32string m_body;
+		std::basic_string<C> m_name;
+		std::vector<std::basic_string<C>> m_params;
+		std::basic_string<C> m_body;
 	};
 
 	struct InstructionParameters
@@ -65,7 +73,10 @@ namespace NeoMIPS
 		uint32_t m_offset;
 		uint32_t m_immediate;
 		uint32_t m_resolvedLabel;
-		std::u32string_view m_label;
+		uint32_t m_label; //ID of the label, see intern_label
 		InstructionSyntacticArchetypes m_archetype;
 	};
+
+	//ID of the empty label name, so zero initialized parameters have no label
+	constexpr uint32_t NO_LABEL = 0;
 }
@@ -0,0 +1,212 @@
+#include <bit>
+#include <cstdint>
+#include "utf8.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#include <immintrin.h>
+#define NEOMIPS_SSE2
+#if defined(__GNUC__)
+//AVX2 kernels are compiled through target attributes and picked at runtime, so the build does not need -mavx2
+#define NEOMIPS_AVX2
+#endif
+#endif
+
+namespace NeoMIPS
+{
+    namespace Utf8
+    {
+        namespace
+        {
+#ifdef NEOMIPS_AVX2
+            const bool hasAvx2 = __builtin_cpu_supports("avx2");
+
+            __attribute__((target("avx2"))) size_t ascii_prefix_avx2(const char8_t* data, size_t size)
+            {
+                size_t i = 0;
+                for (; i + 32 <= size; i += 32)
+                {
+                    uint32_t mask = _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+                    if (mask != 0) return i + std::countr_zero(mask);
+                }
+                return i;
+            }
+
+            __attribute__((target("avx2"))) size_t count_code_points_avx2(const char8_t* data, size_t size, size_t& i)
+            {
+                size_t count = 0;
+                const __m256i threshold = _mm256_set1_epi8(-65); //continuation bytes are 0x80-0xBF, that is -128..-65 as int8
+                for (; i + 32 <= size; i += 32)
+                {
+                    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                    count += std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, threshold))));
+                }
+                return count;
+            }
+
+            __attribute__((target("avx2"))) void widen_ascii_avx2(const char8_t* data, size_t size, char32_t* dest, size_t& i)
+            {
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m256i wide = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(data + i)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), wide);
+                }
+            }
+#endif
+
+#ifdef NEOMIPS_SSE2
+            size_t ascii_prefix_sse2(const char8_t* data, size_t size)
+            {
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    uint32_t mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+                    if (mask != 0) return i + std::countr_zero(mask);
+                }
+                return i;
+            }
+
+            void widen_ascii_sse2(const char8_t* data, size_t size, char32_t* dest, size_t& i)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                for (; i + 16 <= size; i += 16)
+                {
+                    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                    __m128i lo = _mm_unpacklo_epi8(v, zero);
+                    __m128i hi = _mm_unpackhi_epi8(v, zero);
+                    __m128i* out = reinterpret_cast<__m128i*>(dest + i);
+                    _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+                    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+                    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+                    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+                }
+            }
+#endif
+
+            //Length of the run of ASCII bytes at the start of the buffer
+            size_t ascii_prefix(const char8_t* data, size_t size)
+            {
+                size_t i = 0;
+#ifdef NEOMIPS_AVX2
+                if (hasAvx2) i = ascii_prefix_avx2(data, size);
+                if (i < size && data[i] >= 0x80) return i;
+#endif
+#ifdef NEOMIPS_SSE2
+                i += ascii_prefix_sse2(data + i, size - i);
+#endif
+                while (i < size && data[i] < 0x80) ++i;
+                return i;
+            }
+
+            //Decodes one multibyte sequence, returns its length or 0 if it is malformed
+            uint32_t decode_sequence(const char8_t* data, size_t size, char32_t& codePoint)
+            {
+                uint32_t length = sequence_length(data[0]);
+                if (length < 2 || length > size) return 0;
+
+                char32_t c = data[0] & (0xFF >> (length + 1));
+                for (uint32_t k = 1; k < length; ++k)
+                {
+                    if (!is_continuation(data[k])) return 0;
+                    c = (c << 6) | (data[k] & 0x3F);
+                }
+
+                //two byte overlongs are already rejected by the lead byte check
+                if ((length == 3 && c < 0x800) || (length == 4 && c < 0x10000)) return 0;
+                if ((c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF) return 0;
+
+                codePoint = c;
+                return length;
+            }
+        }
+
+        bool is_ascii(const char8_t* data, size_t size)
+        {
+            return ascii_prefix(data, size) == size;
+        }
+
+        size_t count_code_points(const char8_t* data, size_t size)
+        {
+            size_t i = 0;
+            size_t count = 0;
+#ifdef NEOMIPS_AVX2
+            if (hasAvx2) count += count_code_points_avx2(data, size, i);
+#endif
+#ifdef NEOMIPS_SSE2
+            const __m128i threshold = _mm_set1_epi8(-65);
+            for (; i + 16 <= size; i += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                count += std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, threshold))));
+            }
+#endif
+            for (; i < size; ++i)
+            {
+                if (!is_continuation(data[i])) ++count;
+            }
+            return count;
+        }
+
+        void widen_ascii(const char8_t* data, size_t size, char32_t* dest)
+        {
+            size_t i = 0;
+#ifdef NEOMIPS_AVX2
+            if (hasAvx2) widen_ascii_avx2(data, size, dest, i);
+#endif
+#ifdef NEOMIPS_SSE2
+            widen_ascii_sse2(data, size, dest, i);
+#endif
+            for (; i < size; ++i)
+            {
+                dest[i] = data[i];
+            }
+        }
+
+        size_t decode(const char8_t* data, size_t size, char32_t* dest)
+        {
+            size_t in = 0;
+            size_t out = 0;
+            while (in < size)
+            {
+                //bulk copy the ASCII run, then fall back to scalar decoding for the sequence that ended it
+                size_t run = ascii_prefix(data + in, size - in);
+                widen_ascii(data + in, run, dest + out);
+                in += run;
+                out += run;
+                if (in == size) break;
+
+                uint32_t length = decode_sequence(data + in, size - in, dest[out]);
+                if (length == 0) return SIZE_MAX;
+                in += length;
+                ++out;
+            }
+            return out;
+        }
+
+        bool validate(const char8_t* data, size_t size)
+        {
+            size_t in = 0;
+            char32_t discard;
+            while (in < size)
+            {
+                in += ascii_prefix(data + in, size - in);
+                if (in == size) break;
+
+                uint32_t length = decode_sequence(data + in, size - in, discard);
+                if (length == 0) return false;
+                in += length;
+            }
+            return true;
+        }
+
+        char32_t decode_one(std::u8string_view str, uint32_t& index)
+        {
+            if (str[index] < 0x80) return str[index];
+
+            char32_t codePoint;
+            uint32_t length = decode_sequence(str.data() + index, str.size() - index, codePoint);
+            if (length == 0) return U'\uFFFD';
+            index += length - 1;
+            return codePoint;
+        }
+    }
+}
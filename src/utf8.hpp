@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace NeoMIPS
+{
+    namespace Utf8
+    {
+        //Returns true if every byte in [data, data + size) is below 0x80
+        bool is_ascii(const char8_t* data, size_t size);
+
+        //Number of code points in a UTF-8 buffer, i.e. the number of bytes that are not continuation bytes.
+        //The result is only meaningful for valid UTF-8, validation is done by decode()
+        size_t count_code_points(const char8_t* data, size_t size);
+
+        //Widens an all-ASCII buffer, dest must have room for size code points
+        void widen_ascii(const char8_t* data, size_t size, char32_t* dest);
+
+        //Validating UTF-8 to UTF-32 transcoder. dest must have room for count_code_points(data, size) code points.
+        //Returns the number of code points written or SIZE_MAX if the input is not well formed UTF-8
+        size_t decode(const char8_t* data, size_t size, char32_t* dest);
+
+        //Checks that the buffer is well formed UTF-8 without transcoding it
+        bool validate(const char8_t* data, size_t size);
+
+        //Decodes the code point that starts at str[index] and leaves index on its last byte, so code that walks
+        //the buffer one element at a time sees a single element per code point. Malformed input yields U+FFFD
+        char32_t decode_one(std::u8string_view str, uint32_t& index);
+
+        //Length of the sequence introduced by a lead byte, 0 for continuation or invalid bytes
+        constexpr uint32_t sequence_length(char8_t lead)
+        {
+            if (lead < 0x80) return 1;
+            if (lead < 0xC2) return 0;
+            if (lead < 0xE0) return 2;
+            if (lead < 0xF0) return 3;
+            if (lead < 0xF5) return 4;
+            return 0;
+        }
+
+        constexpr bool is_continuation(char8_t c)
+        {
+            return (c & 0xC0) == 0x80;
+        }
+
+        //Bytes taken by a code point once encoded
+        constexpr uint32_t encoded_length(char32_t c)
+        {
+            if (c < 0x80) return 1;
+            if (c < 0x800) return 2;
+            if (c < 0x10000) return 3;
+            return 4;
+        }
+
+        //Writes the sequence of a code point to dest, which needs room for encoded_length(c) bytes. Returns
+        //the number of bytes written
+        constexpr uint32_t encode_one(char32_t c, uint8_t* dest)
+        {
+            if (c < 0x80)
+            {
+                dest[0] = static_cast<uint8_t>(c);
+                return 1;
+            }
+            if (c < 0x800)
+            {
+                dest[0] = static_cast<uint8_t>(0xC0 | c >> 6);
+                dest[1] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+                return 2;
+            }
+            if (c < 0x10000)
+            {
+                dest[0] = static_cast<uint8_t>(0xE0 | c >> 12);
+                dest[1] = static_cast<uint8_t>(0x80 | (c >> 6 & 0x3F));
+                dest[2] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+                return 3;
+            }
+            dest[0] = static_cast<uint8_t>(0xF0 | c >> 18);
+            dest[1] = static_cast<uint8_t>(0x80 | (c >> 12 & 0x3F));
+            dest[2] = static_cast<uint8_t>(0x80 | (c >> 6 & 0x3F));
+            dest[3] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+            return 4;
+        }
+    }
+}
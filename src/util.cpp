@@ -35,4 +35,24 @@ namespace NeoMIPS
 	{
 		return std::strtod(str.c_str(), nullptr);
 	}
+
+	uint64_t hash_bytes(const void* data, size_t size, uint64_t seed)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		uint64_t hash = seed;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	std::string to_hex(uint32_t value)
+	{
+		constexpr char DIGITS[] = "0123456789abcdef";
+		std::string text = "0x00000000";
+		for (size_t i = 9; value; --i, value >>= 4) text[i] = DIGITS[value & 0xF];
+		return text;
+	}
 }
\ No newline at end of file
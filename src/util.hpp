@@ -27,6 +27,10 @@ namespace NeoMIPS
 	}
 
 	int64_t to_integer(const char* str, IntBase base = IntBase::any);
+	//64 bit FNV-1a, pass the previous result as seed to hash several buffers as one
+	uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0xCBF29CE484222325ull);
+	//Address as messages print it, 0x and eight lowercase digits
+	std::string to_hex(uint32_t value);
 	float to_float(const std::string& str);
 	double to_double(const std::string& str);
 
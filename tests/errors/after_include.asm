@@ -0,0 +1,6 @@
+# the included file has three lines and the .include none in the output, the bad operands are still on line 6
+.include "errors/after_include.inc"
+.text
+main:
+    nop
+    addu $t0, $t1
@@ -0,0 +1,4 @@
+# the list on line 3 ends with a comma, the error is found past the end of the line
+.data
+.word 1,
+.text
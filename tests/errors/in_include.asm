@@ -0,0 +1,6 @@
+# the bad operands are on line 3 of the included file, not of this one
+.text
+main:
+    nop
+.include "errors/in_include.inc"
+    nop
@@ -0,0 +1,5 @@
+# the bad operands are on line 4
+.text
+main:
+    addu $t0, $t1
+    nop
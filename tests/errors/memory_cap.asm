@@ -0,0 +1,10 @@
+# the code fits under the cap, the first store into the data segment doesn't
+.data
+buffer: .space 16
+.text
+main:
+    lui $t0, 0x1001
+    addiu $t1, $zero, 1
+    sw $t1, 0($t0)
+    addiu $v0, $zero, 10
+    syscall
@@ -0,0 +1,18 @@
+# addiu into $zero followed by bne on $zero compares 0, not the sum it discarded
+.text
+main:
+    addiu $t0, $zero, 0
+    addiu $t1, $zero, 1
+    addiu $zero, $t0, 1
+    bne $zero, $t1, taken
+    addiu $a0, $zero, 0
+    addiu $v0, $zero, 1
+    syscall
+    addiu $v0, $zero, 10
+    syscall
+taken:
+    addiu $a0, $zero, 1
+    addiu $v0, $zero, 1
+    syscall
+    addiu $v0, $zero, 10
+    syscall
@@ -0,0 +1,21 @@
+# the inner loop gets hot and is translated, then every pass of the outer loop stores a new
+# immediate into its addiu, so the block is invalidated and translated again 40 times
+.text
+main:
+    addiu $s0, $zero, 40        # passes of the outer loop
+    addiu $a0, $zero, 0
+    lui $t2, 0x0040
+    ori $t2, $t2, 0x0020        # address of the patched addiu
+    lui $t1, 0x2484             # addiu $a0, $a0, 0
+outer:
+    addiu $s1, $zero, 300
+    addu $t3, $t1, $s0
+    sw $t3, 0($t2)
+inner:
+    addiu $a0, $a0, 0
+    addiu $s1, $s1, -1
+    bne $s1, $zero, inner
+    addiu $s0, $s0, -1
+    bne $s0, $zero, outer
+    addiu $v0, $zero, 1         # 300 * (40 + 39 + ... + 1)
+    syscall
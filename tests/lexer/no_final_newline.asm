@@ -0,0 +1,6 @@
+# the file ends right after the last syscall
+.text
+main:
+    addiu $a0, $zero, 42
+    addiu $v0, $zero, 1
+    syscall
\ No newline at end of file
@@ -0,0 +1,15 @@
+# syscall and nop have no operands, each one ends at its own line
+.text
+main:
+    addiu $a0, $zero, 42
+    addiu $v0, $zero, 1
+    syscall
+    nop
+    addiu $a0, $zero, 10
+    addiu $v0, $zero, 11
+    syscall
+    addiu $a0, $zero, 7
+    addiu $v0, $zero, 1
+    syscall
+    addiu $v0, $zero, 10
+    syscall
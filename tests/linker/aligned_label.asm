@@ -0,0 +1,9 @@
+# a label in front of a value that needs padding names the value, not the padding
+        .data
+b:      .byte 1
+d:      .double -2.5
+        .text
+main:
+        ldc1    $f12, d
+        addiu   $v0, $zero, 3
+        syscall
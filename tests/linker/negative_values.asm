@@ -0,0 +1,17 @@
+# a sign in front of a value is part of the literal, not a separator before it
+        .data
+d:      .double -2.5
+w:      .word -1, +2
+h:      .half -3
+        .text
+main:
+        lw      $a0, w
+        addiu   $v0, $zero, 1
+        syscall
+        lw      $a0, w + 4
+        syscall
+        lh      $a0, h
+        syscall
+        ldc1    $f12, d
+        addiu   $v0, $zero, 3
+        syscall
@@ -0,0 +1,21 @@
+# a word can hold the address of a label, the program jumps through a table of them and loads a word it
+# found with lui of a label
+.data
+table: .word first, second, 7
+value: .word 42
+.text
+main:
+    lui $t0, table
+    lw $t1, 4($t0)
+    jr $t1
+first:
+    addiu $a0, $zero, 1
+    addiu $v0, $zero, 1
+    syscall
+second:
+    lui $t2, value
+    lw $a0, 12($t2)
+    addiu $v0, $zero, 1
+    syscall
+    addiu $v0, $zero, 10
+    syscall
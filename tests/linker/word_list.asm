@@ -0,0 +1,18 @@
+# a list of words is laid out value after value, little endian, at the start of .data
+.data
+words: .word 1, 2, 3
+.text
+main:
+    lui $s0, 0x1001
+    addiu $s1, $s0, 12
+next:
+    lbu $a0, 0($s0)
+    addiu $v0, $zero, 1
+    syscall
+    addiu $a0, $zero, 32
+    addiu $v0, $zero, 11
+    syscall
+    addiu $s0, $s0, 1
+    bne $s0, $s1, next
+    addiu $v0, $zero, 10
+    syscall